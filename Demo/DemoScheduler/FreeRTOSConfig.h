@@ -39,12 +39,15 @@
  * See http://www.freertos.org/a00110.html
  *----------------------------------------------------------*/
 
-#define configUSE_TRACE_FACILITY 0
+#define configUSE_TRACE_FACILITY 1
+#define configUSE_TRACE_BUFFER 1  // 1 = Record the scheduler events in xTraceBuffer, decoded by tools/traceToJson.py
 #define configGENERATE_RUN_TIME_STATS 0
 
-#define configUSE_TICKLESS_IDLE         0
+#define configUSE_TICKLESS_IDLE         1  // 1 = SysTick is stopped while idle, until the next release, wake up or server replenishment
 #define configUSE_PREEMPTION			1
 #define configUSE_APERIODIC_PREEMPTION	1
+#define configUSE_POLLING_SERVER		1
+#define configUSE_APERIODIC_SERVER		1  // 1 = xTaskServerCreate() available, aperiodic tasks run from the server once it exists
 #define configUSE_IDLE_HOOK				0
 #define configUSE_TICK_HOOK				1
 #define configCPU_CLOCK_HZ				( ( unsigned long ) 25000000 )
@@ -59,8 +62,24 @@
 #define configCHECK_FOR_STACK_OVERFLOW	2
 #define configUSE_MALLOC_FAILED_HOOK	1
 #define configUSE_QUEUE_SETS			1
+#define configUSE_ZERO_COPY_QUEUES		1  // 1 = xQueueCreateZeroCopy() available, queues that hand out their slots instead of copying items
 #define configUSE_COUNTING_SEMAPHORES	1
 #define configUSE_HAIRCUT_PREEMPTION  	1  // 1 = Allow preemption, 0 = No preemption
+#define configUSE_APERIODIC_BUDGET		0  // 1 = Enforce the uxDuration budget of aperiodic tasks (needs configUSE_POLLING_SERVER)
+#define configAPERIODIC_OVERRUN_POLICY	tskAPERIODIC_OVERRUN_THROTTLE
+#define configAPERIODIC_THROTTLE_TICKS	( ( TickType_t ) 10 )
+#define configUSE_APERIODIC_OVERRUN_HOOK	0
+#define configUSE_READY_HEAP			1  // 1 = Order the periodic ready list and the server jobs with a binary heap instead of a sorted list
+#define configREADY_HEAP_LENGTH			64
+#define configUSE_EDF_SCHEDULER			0  // 1 = Schedule periodic and aperiodic jobs by absolute deadline (needs configUSE_APERIODIC_SERVER 0)
+#define configUSE_DEADLINE_MISS_HOOK	1
+#define configUSE_ADMISSION_CONTROL		0  // 1 = Refuse periodic and aperiodic tasks that would make the task set unschedulable
+#define configADMISSION_RM_TEST			tskADMISSION_HYPERBOLIC
+#define configUSE_STACK_RESOURCE_POLICY	1  // 1 = xTaskResourceCreate() available, resources shared under the Stack Resource Policy
+#define configUSE_SCHEDULER_STATS		1  // 1 = uxTaskGetSchedulerStats() available, per task response time and lateness
+#define configUSE_TASK_POOL			1  // 1 = xTaskPoolCreate() available, short lived tasks created from preallocated TCB and stack slots
+#define configUSE_APERIODIC_JOBS		1  // 1 = xTaskSubmitJob() available, aperiodic jobs run by preallocated worker tasks
+#define configAPERIODIC_JOB_QUEUE_LENGTH	32
 
 #define configMAX_PRIORITIES			( 9UL )
 #define configQUEUE_REGISTRY_SIZE		10
@@ -71,9 +90,12 @@
 #define configTIMER_TASK_PRIORITY		( configMAX_PRIORITIES - 4 )
 #define configTIMER_QUEUE_LENGTH		20
 #define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE * 2 )
+#define configUSE_TIMER_WHEEL			1  // 1 = Keep the active timers in a hierarchical timing wheel instead of a sorted list
+#define configUSE_ISR_TIMERS			1  // 1 = vTimerSetISRContext() makes a timer run its callback in the tick interrupt
 
 #define configUSE_TASK_NOTIFICATIONS	1
 #define configTASK_NOTIFICATION_ARRAY_ENTRIES 3
+#define configUSE_SPSC_QUEUES			1  // 1 = Build spsc_queue.c, which waits on the last notification index
 
 /* Set the following definitions to 1 to include the API function, or zero
 to exclude the API function. */
@@ -96,6 +118,8 @@ to exclude the API function. */
 #define INCLUDE_xTaskGetHandle					1
 #define INCLUDE_xTaskCreateAperiodic			1
 #define INCLUDE_xTaskCreatePeriodic			    1
+#define INCLUDE_vTaskEndJob						1
+#define INCLUDE_xTaskReleaseJobFromISR			1  // 1 = vTaskWaitForRelease() and xTaskReleaseJobFromISR() available, used by hrTimer.c
 
 
 /* This demo makes use of one or more example stats formatting functions.  These
@@ -127,6 +151,29 @@ machine on which the test is developed). */
 	#define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ );
 #endif
 
+/* Time base of uxTaskGetSchedulerStats(), implemented in main.c.  Counts core
+clock cycles, so there are configCPU_CLOCK_HZ / configTICK_RATE_HZ per tick. */
+#ifndef __IASMARM__
+	void vConfigureSchedulerStatsTimer( void );
+	uint32_t ulGetSchedulerStatsTime( void );
+#endif
+#define portCONFIGURE_TIMER_FOR_SCHEDULER_STATS()	vConfigureSchedulerStatsTimer()
+#define portGET_SCHEDULER_STATS_TIME()				ulGetSchedulerStatsTime()
+#define configSCHEDULER_STATS_COUNTS_PER_TICK		( configCPU_CLOCK_HZ / configTICK_RATE_HZ )
+
+/* Tickless idle wakes up on the last tick before the next timer of hrTimer.c,
+so the tick count is up to date when the timer releases a job. */
+#ifndef __IASMARM__
+	uint64_t ullHRTimerLimitIdleTicks( uint64_t ullExpectedIdleTicks );
+#endif
+#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )	( x ) = ( TickType_t ) ullHRTimerLimitIdleTicks( ( uint64_t ) ( x ) )
+
+/* printf() output buffer of uartDriver.c, and what a task that finds it full
+does: drop the rest (uartTX_FULL_DROP, 0) so no job is delayed by the console,
+or wait for room (uartTX_FULL_BLOCK, 1). */
+#define uartTX_BUFFER_SIZE						2048
+#define uartTX_FULL_POLICY						0
+
 #define intqHIGHER_PRIORITY		( configMAX_PRIORITIES - 5 )
 #define bktPRIMARY_PRIORITY		( configMAX_PRIORITIES - 3 )
 #define bktSECONDARY_PRIORITY	( configMAX_PRIORITIES - 4 )
@@ -27,9 +27,9 @@
 
 #include <stdarg.h>
 
-#define UART0_ADDRESS 	( 0x40004000UL )
-#define UART0_DATA		( * ( ( ( volatile unsigned int * )( UART0_ADDRESS + 0UL ) ) ) )
-#define putchar(c)      UART0_DATA = c
+#include "uartDriver.h"
+
+#define putchar(c)      vUARTPutChar( ( char ) ( c ) )
 
 static int tiny_print( char **out, const char *format, va_list args, unsigned int buflen );
 
@@ -49,6 +49,8 @@ extern void xPortPendSVHandler( void );
 extern void xPortSysTickHandler( void );
 extern void TIMER0_Handler( void );
 extern void TIMER1_Handler( void );
+extern void UARTTX0_Handler( void );
+extern void DUALTIMER_Handler( void );
 
 /* Exception handlers. */
 static void HardFault_Handler( void ) __attribute__( ( naked ) );
@@ -78,7 +80,7 @@ const uint32_t* isr_vector[] __attribute__((section(".isr_vector"))) =
     ( uint32_t * ) &xPortPendSVHandler, // PendSV handler    -2
     ( uint32_t * ) &xPortSysTickHandler,// SysTick_Handler   -1
     0,
-    0,
+    ( uint32_t * ) UARTTX0_Handler,    // UART 0 TX
     0,
     0,
     0,
@@ -87,7 +89,7 @@ const uint32_t* isr_vector[] __attribute__((section(".isr_vector"))) =
     0,
     ( uint32_t * ) TIMER0_Handler,     // Timer 0
 	( uint32_t * ) TIMER1_Handler,     // Timer 1
-    0,
+    ( uint32_t * ) DUALTIMER_Handler,  // Dual timer
     0,
     0,
     0, // Ethernet   13
@@ -0,0 +1,213 @@
+/*
+ * FreeRTOS V202212.01
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/*-----------------------------------------------------------
+ * Application specific definitions.
+ *
+ * These definitions should be adjusted for your particular hardware and
+ * application requirements.
+ *
+ * THESE PARAMETERS ARE DESCRIBED WITHIN THE 'CONFIGURATION' SECTION OF THE
+ * FreeRTOS API DOCUMENTATION AVAILABLE ON THE FreeRTOS.org WEB SITE.
+ *
+ * See http://www.freertos.org/a00110.html
+ *----------------------------------------------------------*/
+
+/* Host build of the scheduler demos on the Posix port.  Keep the scheduler
+options in step with ../../FreeRTOSConfig.h, only the hardware specific
+settings differ. */
+
+#define configUSE_TRACE_FACILITY 1
+#define configUSE_TRACE_BUFFER 1  // 1 = Record the scheduler events in xTraceBuffer, decoded by tools/traceToJson.py
+#define configGENERATE_RUN_TIME_STATS 0
+
+/* The scheduler options under #ifndef can be set from the command line, see
+DEFINES in the Makefile.  The options that need configUSE_POLLING_SERVER follow
+it, so -DconfigUSE_POLLING_SERVER=0 builds the stock fixed priority scheduler
+(for the benchmark program only, the other demos need periodic tasks). */
+#ifndef configNUMBER_OF_CORES
+	#define configNUMBER_OF_CORES		1  // Simulated cores, see portmacro.h.  Tickless idle, the aperiodic server and the SRP are single core only
+#endif
+#define configUSE_CORE_AFFINITY			1  // 1 = vTaskCoreAffinitySet() available with more than one core
+#ifndef configUSE_PARTITIONED_SCHEDULING
+	#define configUSE_PARTITIONED_SCHEDULING	0  // 1 = Periodic tasks bin-packed onto the cores, each core schedules its own (needs configUSE_ADMISSION_CONTROL 0)
+#endif
+#define configPARTITION_HEURISTIC		tskPARTITION_FIRST_FIT
+#define configUSE_TASK_SPLITTING		configUSE_PARTITIONED_SCHEDULING  // 1 = A periodic task that fits no core is split between two
+#ifndef configUSE_TICKLESS_IDLE
+	#define configUSE_TICKLESS_IDLE		( configNUMBER_OF_CORES == 1 )  // 1 = Idle time is skipped up to the next release, wake up or server replenishment in one step
+#endif
+#define configUSE_PREEMPTION			1
+#define configUSE_APERIODIC_PREEMPTION	1
+#ifndef configUSE_POLLING_SERVER
+	#define configUSE_POLLING_SERVER		1
+#endif
+#ifndef configUSE_APERIODIC_SERVER
+	#define configUSE_APERIODIC_SERVER		( configUSE_POLLING_SERVER && ( configNUMBER_OF_CORES == 1 ) )  // 1 = xTaskServerCreate() available, aperiodic tasks run from the server once it exists
+#endif
+#define configUSE_IDLE_HOOK				1  // Advances the virtual time, see main_posix.c
+#define configUSE_TICK_HOOK				1
+#define configCPU_CLOCK_HZ				( ( unsigned long ) 25000000 )
+#define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
+#define configMINIMAL_STACK_SIZE		( ( unsigned short ) 4096 )  // Each task is a pthread, 80 words is below PTHREAD_STACK_MIN
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 16 * 1024 * 1024 ) )  // Used by HEAP=heap_4 or heap_tlsf only: the benchmark creates up to 256 tasks of 4096 word stacks
+#define configMAX_TASK_NAME_LEN			( 12 )
+#define configUSE_16_BIT_TICKS			0
+#define configIDLE_SHOULD_YIELD			0
+#define configUSE_MUTEXES				1
+#define configUSE_RECURSIVE_MUTEXES		1
+#define configCHECK_FOR_STACK_OVERFLOW	2
+#define configUSE_MALLOC_FAILED_HOOK	1
+#define configUSE_QUEUE_SETS			1
+#define configUSE_ZERO_COPY_QUEUES		1  // 1 = xQueueCreateZeroCopy() available, queues that hand out their slots instead of copying items
+#define configUSE_COUNTING_SEMAPHORES	1
+#define configUSE_HAIRCUT_PREEMPTION  	1  // 1 = Allow preemption, 0 = No preemption
+#define configUSE_APERIODIC_BUDGET		0  // 1 = Enforce the uxDuration budget of aperiodic tasks (needs configUSE_POLLING_SERVER)
+#define configAPERIODIC_OVERRUN_POLICY	tskAPERIODIC_OVERRUN_THROTTLE
+#define configAPERIODIC_THROTTLE_TICKS	( ( TickType_t ) 10 )
+#define configUSE_APERIODIC_OVERRUN_HOOK	0
+#define configUSE_READY_HEAP			configUSE_POLLING_SERVER  // 1 = Order the periodic ready list and the server jobs with a binary heap instead of a sorted list
+#define configREADY_HEAP_LENGTH			272  // The benchmark sweeps up to 256 ready tasks
+#ifndef configUSE_EDF_SCHEDULER
+	#define configUSE_EDF_SCHEDULER			0  // 1 = Schedule periodic and aperiodic jobs by absolute deadline (needs configUSE_APERIODIC_SERVER 0)
+#endif
+#define configUSE_DEADLINE_MISS_HOOK	configUSE_POLLING_SERVER
+#ifndef configUSE_ADMISSION_CONTROL
+	#define configUSE_ADMISSION_CONTROL		0  // 1 = Refuse periodic and aperiodic tasks that would make the task set unschedulable
+#endif
+#define configADMISSION_RM_TEST			tskADMISSION_HYPERBOLIC
+#define configUSE_STACK_RESOURCE_POLICY	( configUSE_POLLING_SERVER && ( configNUMBER_OF_CORES == 1 ) )  // 1 = xTaskResourceCreate() available, resources shared under the Stack Resource Policy
+#define configUSE_SCHEDULER_STATS		configUSE_POLLING_SERVER  // 1 = uxTaskGetSchedulerStats() available, per task response time and lateness
+#define configUSE_TASK_POOL			1  // 1 = xTaskPoolCreate() available, short lived tasks created from preallocated TCB and stack slots
+#define configUSE_APERIODIC_JOBS		configUSE_POLLING_SERVER  // 1 = xTaskSubmitJob() available, aperiodic jobs run by preallocated worker tasks
+#define configAPERIODIC_JOB_QUEUE_LENGTH	32  // The workload demo keeps up to 32 jobs pending
+
+#define configMAX_PRIORITIES			( 9UL )
+#define configQUEUE_REGISTRY_SIZE		10
+#define configSUPPORT_STATIC_ALLOCATION	1
+
+/* Timer related defines. */
+#define configUSE_TIMERS				1
+#define configTIMER_TASK_PRIORITY		( configMAX_PRIORITIES - 4 )
+#define configTIMER_QUEUE_LENGTH		20
+#define configTIMER_TASK_STACK_DEPTH	( configMINIMAL_STACK_SIZE * 2 )
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL		1  // 1 = Keep the active timers in a hierarchical timing wheel instead of a sorted list
+#endif
+#ifndef configUSE_ISR_TIMERS
+	#define configUSE_ISR_TIMERS		1  // 1 = vTimerSetISRContext() makes a timer run its callback in the tick interrupt
+#endif
+
+#define configUSE_TASK_NOTIFICATIONS	1
+#define configTASK_NOTIFICATION_ARRAY_ENTRIES 3
+#ifndef configUSE_SPSC_QUEUES
+	#define configUSE_SPSC_QUEUES		1  // 1 = Build spsc_queue.c, which waits on the last notification index
+#endif
+
+/* Set the following definitions to 1 to include the API function, or zero
+to exclude the API function. */
+
+#define INCLUDE_vTaskPrioritySet				1
+#define INCLUDE_uxTaskPriorityGet				1
+#define INCLUDE_vTaskDelete						1
+#define INCLUDE_vTaskCleanUpResources			0
+#define INCLUDE_vTaskSuspend					1
+#define INCLUDE_vTaskDelayUntil					1
+#define INCLUDE_vTaskDelay						1
+#define INCLUDE_uxTaskGetStackHighWaterMark		1
+#define INCLUDE_xTaskGetSchedulerState			1
+#define INCLUDE_xTimerGetTimerDaemonTaskHandle	1
+#define INCLUDE_xTaskGetIdleTaskHandle			1
+#define INCLUDE_xSemaphoreGetMutexHolder		1
+#define INCLUDE_eTaskGetState					1
+#define INCLUDE_xTimerPendFunctionCall			1
+#define INCLUDE_xTaskAbortDelay					1
+#define INCLUDE_xTaskGetHandle					1
+#define INCLUDE_xTaskCreateAperiodic			1
+#define INCLUDE_xTaskCreatePeriodic			    1
+#define INCLUDE_vTaskEndJob						configUSE_POLLING_SERVER
+#define INCLUDE_xTaskReleaseJobFromISR			configUSE_POLLING_SERVER  // 1 = vTaskWaitForRelease() and xTaskReleaseJobFromISR() available, used by hrTimer.c
+
+
+/* This demo makes use of one or more example stats formatting functions.  These
+format the raw data provided by the uxTaskGetSystemState() function in to human
+readable ASCII form.  See the notes in the implementation of vTaskList() within
+FreeRTOS/Source/tasks.c for limitations. */
+#define configUSE_STATS_FORMATTING_FUNCTIONS	0
+
+/* The Posix port has no optimised task selection. */
+#define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+
+/* Virtual time: ticks run as fast as the host can take them and idle time is
+skipped, see portmacro.h.  Set from the Makefile, make VIRTUAL_TIME=0 runs in
+real time. */
+#ifndef configUSE_VIRTUAL_TIME
+	#define configUSE_VIRTUAL_TIME				1
+#endif
+#define configVIRTUAL_TICK_MICROSECONDS			100	// Host time a tick takes while a task runs
+
+/* The Win32 target is capable of running all the tests tasks at the same
+ * time. */
+#define configRUN_ADDITIONAL_TESTS				1
+
+/* The test that checks the trigger level on stream buffers requires an
+allowable margin of error on slower processors (slower than the Win32
+machine on which the test is developed). */
+#define configSTREAM_BUFFER_TRIGGER_LEVEL_TEST_MARGIN   4
+
+void vAssertCalled( const char *pcFileName, uint32_t ulLine );
+#define configASSERT( x ) if( ( x ) == 0 ) vAssertCalled( __FILE__, __LINE__ );
+
+/* Time base of uxTaskGetSchedulerStats(), implemented in main_posix.c.  Counts
+ticks in virtual time, where a tick takes no fixed host time, and host
+microseconds otherwise. */
+uint32_t ulGetSchedulerStatsTime( void );
+#define portGET_SCHEDULER_STATS_TIME()				ulGetSchedulerStatsTime()
+#if ( configUSE_VIRTUAL_TIME == 1 )
+	#define configSCHEDULER_STATS_COUNTS_PER_TICK	1
+#else
+	#define configSCHEDULER_STATS_COUNTS_PER_TICK	( 1000000 / configTICK_RATE_HZ )
+#endif
+
+/* The timers of hrTimer.c fire from the tick hook, so tickless idle must not
+step over the tick that fires the next one. */
+uint64_t ullHRTimerLimitIdleTicks( uint64_t ullExpectedIdleTicks );
+#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )	( x ) = ( TickType_t ) ullHRTimerLimitIdleTicks( ( uint64_t ) ( x ) )
+
+/* stdio takes a lock that a tick can leave held by a switched out task, so the
+demos' printf() goes through iHostPrintf() in main_posix.c, which masks the
+tick while it writes. */
+int iHostPrintf( const char *pcFormat, ... );
+#define printf		iHostPrintf
+
+#define intqHIGHER_PRIORITY		( configMAX_PRIORITIES - 5 )
+#define bktPRIMARY_PRIORITY		( configMAX_PRIORITIES - 3 )
+#define bktSECONDARY_PRIORITY	( configMAX_PRIORITIES - 4 )
+
+#endif /* FREERTOS_CONFIG_H */
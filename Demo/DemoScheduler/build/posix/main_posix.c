@@ -0,0 +1,442 @@
+/******************************************************************************
+ * Host build of the scheduler demos on the FreeRTOS Posix port.
+ *
+ * Every task is a pthread and the tick is a SIGALRM, so the demos run as
+ * normal Linux processes, without the cross compiler or QEMU.  With
+ * configUSE_VIRTUAL_TIME set to 1 (the default, see FreeRTOSConfig.h) the tick
+ * runs as fast as the host can take it and idle time is skipped, so a run of
+ * several simulated minutes takes seconds or less.  make BACKEND=ucontext
+ * builds on the single thread Posix port instead (Posix_Ucontext), where every
+ * task runs on the host thread of the process and a context switch is a stack
+ * switch in user space.
+ *
+ * The same source builds three programs, as the barber shop of demoScheduler.c
+ * and of ../demoBarber.c share their symbol names:
+ * RTOSDemo runs the demos of this directory, RTOSDemoSync (mainSYNC_DEMOS set
+ * to 1) the synchronisation demos of the parent directory, and RTOSBench
+ * (mainBENCH_DEMOS set to 1) only the scheduler benchmark, so it also builds
+ * without the polling server.  The demo is named on the command line:
+ *
+ *     ./output/RTOSDemo edf
+ *     ./output/RTOSDemoSync dinner -t 600000
+ *
+ * -t stops the run after that many milliseconds of simulated time, which the
+ * synchronisation demos need as they never end by themselves.
+ *
+ * The workload demo takes the load to replay with -w, either a generator
+ * (poisson or bursty, seeded with -s) or a trace written by
+ * tools/workloadGen.py:
+ *
+ *     ./output/RTOSDemo workload -w bursty -s 7
+ *     ./output/RTOSDemo workload -w trace.csv
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#ifndef mainSYNC_DEMOS
+	#define mainSYNC_DEMOS	0
+#endif
+
+#ifndef mainBENCH_DEMOS
+	#define mainBENCH_DEMOS	0
+#endif
+
+/* Above every task of the demos, so the run is stopped on time. */
+#define mainSTOP_TASK_PRIORITY	( configMAX_PRIORITIES - 1 )
+
+#if ( mainSYNC_DEMOS == 1 )
+	extern int demoBarber( void );
+	extern void demoDinner( void );
+	extern void demoSmokers( void );
+#elif ( mainBENCH_DEMOS == 1 )
+	extern int main_sched_bench( void );
+	extern void vSchedBenchTickHook( void );
+#else
+	extern int main_scheduler( void );
+	extern int main_server( void );
+	extern int main_ready_bench( void );
+	extern int main_edf( void );
+	extern int main_admission( void );
+	extern int main_srp( void );
+	extern int main_workload( void );
+	extern void vWorkloadSetSource( const char *pcSource );
+	extern void vWorkloadSetSeed( uint32_t ulSeed );
+	extern int main_sched_bench( void );
+	extern void vSchedBenchTickHook( void );
+	extern int main_hrtimer( void );
+	extern int main_spsc( void );
+	extern int main_timer_bench( void );
+	extern int main_isr_timer( void );
+	extern int main_smp( void );
+	extern void vSpscTickHook( void );
+#endif
+
+/* Fires the expired timers of hrTimer.c. */
+extern void vHRTimerTickHook( void );
+
+/*
+ * Start the demo called pcName.  Only returns if the demo ends the scheduler,
+ * or if there is no such demo, in which case pdFAIL is returned.
+ */
+static BaseType_t prvRunDemo( const char *pcName );
+
+/*
+ * Ends the run after xRunTicks of simulated time.
+ */
+static void prvStopTask( void *pvParameters );
+
+/*
+ * Prints how much simulated time the run took in host time, at exit.
+ */
+static void prvPrintRunTime( void );
+
+static uint64_t prvHostTimeMicroseconds( void );
+
+/*-----------------------------------------------------------*/
+
+static TickType_t xRunTicks = 0;
+static uint64_t ullStartTime;
+
+/*-----------------------------------------------------------*/
+
+int main( int argc, char *argv[] )
+{
+const char *pcDemo = NULL;
+int iArg;
+
+	for( iArg = 1; iArg < argc; iArg++ )
+	{
+		if( ( strcmp( argv[ iArg ], "-t" ) == 0 ) && ( iArg + 1 < argc ) )
+		{
+			xRunTicks = pdMS_TO_TICKS( strtoul( argv[ ++iArg ], NULL, 10 ) );
+		}
+		#if ( mainSYNC_DEMOS == 0 ) && ( mainBENCH_DEMOS == 0 )
+			else if( ( strcmp( argv[ iArg ], "-w" ) == 0 ) && ( iArg + 1 < argc ) )
+			{
+				vWorkloadSetSource( argv[ ++iArg ] );
+			}
+			else if( ( strcmp( argv[ iArg ], "-s" ) == 0 ) && ( iArg + 1 < argc ) )
+			{
+				vWorkloadSetSeed( ( uint32_t ) strtoul( argv[ ++iArg ], NULL, 10 ) );
+			}
+		#endif
+		else
+		{
+			pcDemo = argv[ iArg ];
+		}
+	}
+
+	if( pcDemo == NULL )
+	{
+		#if ( mainSYNC_DEMOS == 1 )
+			pcDemo = "barber";
+		#elif ( mainBENCH_DEMOS == 1 )
+			pcDemo = "sched_bench";
+		#else
+			pcDemo = "scheduler";
+		#endif
+	}
+
+	if( xRunTicks > 0 )
+	{
+		xTaskCreate( prvStopTask, "Stop", configMINIMAL_STACK_SIZE, NULL, mainSTOP_TASK_PRIORITY, NULL );
+	}
+
+	ullStartTime = prvHostTimeMicroseconds();
+	atexit( prvPrintRunTime );
+
+	if( prvRunDemo( pcDemo ) == pdFAIL )
+	{
+		#if ( mainSYNC_DEMOS == 1 )
+			fprintf( stderr, "usage: %s [barber|dinner|smokers] [-t ms]\n", argv[ 0 ] );
+		#elif ( mainBENCH_DEMOS == 1 )
+			fprintf( stderr, "usage: %s [sched_bench]\n", argv[ 0 ] );
+		#else
+			fprintf( stderr, "usage: %s [scheduler|server|ready_bench|edf|admission|srp|workload|sched_bench|hrtimer|spsc|timer_bench|isr_timer|smp] [-t ms] [-w poisson|bursty|trace] [-s seed]\n", argv[ 0 ] );
+		#endif
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvRunDemo( const char *pcName )
+{
+	#if ( mainSYNC_DEMOS == 1 )
+	{
+		if( strcmp( pcName, "barber" ) == 0 )
+		{
+			demoBarber();
+		}
+		else if( strcmp( pcName, "dinner" ) == 0 )
+		{
+			demoDinner();
+		}
+		else if( strcmp( pcName, "smokers" ) == 0 )
+		{
+			demoSmokers();
+		}
+		else
+		{
+			return pdFAIL;
+		}
+	}
+	#elif ( mainBENCH_DEMOS == 1 )
+	{
+		if( strcmp( pcName, "sched_bench" ) == 0 )
+		{
+			main_sched_bench();
+		}
+		else
+		{
+			return pdFAIL;
+		}
+	}
+	#else
+	{
+		if( strcmp( pcName, "scheduler" ) == 0 )
+		{
+			main_scheduler();
+		}
+		else if( strcmp( pcName, "server" ) == 0 )
+		{
+			main_server();
+		}
+		else if( strcmp( pcName, "ready_bench" ) == 0 )
+		{
+			main_ready_bench();
+		}
+		else if( strcmp( pcName, "edf" ) == 0 )
+		{
+			main_edf();
+		}
+		else if( strcmp( pcName, "admission" ) == 0 )
+		{
+			main_admission();
+		}
+		else if( strcmp( pcName, "srp" ) == 0 )
+		{
+			main_srp();
+		}
+		else if( strcmp( pcName, "workload" ) == 0 )
+		{
+			main_workload();
+		}
+		else if( strcmp( pcName, "sched_bench" ) == 0 )
+		{
+			main_sched_bench();
+		}
+		else if( strcmp( pcName, "hrtimer" ) == 0 )
+		{
+			main_hrtimer();
+		}
+		else if( strcmp( pcName, "spsc" ) == 0 )
+		{
+			main_spsc();
+		}
+		else if( strcmp( pcName, "timer_bench" ) == 0 )
+		{
+			main_timer_bench();
+		}
+		else if( strcmp( pcName, "isr_timer" ) == 0 )
+		{
+			main_isr_timer();
+		}
+		else if( strcmp( pcName, "smp" ) == 0 )
+		{
+			main_smp();
+		}
+		else
+		{
+			return pdFAIL;
+		}
+	}
+	#endif
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvStopTask( void *pvParameters )
+{
+	( void ) pvParameters;
+
+	vTaskDelay( xRunTicks );
+
+	/* Some demos never return from vTaskStartScheduler(), so end the process
+	from here.  Every other task is switched out, and printf() is serialised,
+	so no stdio lock is held. */
+	exit( EXIT_SUCCESS );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPrintRunTime( void )
+{
+uint64_t ullHostTime = prvHostTimeMicroseconds() - ullStartTime;
+TickType_t xTicks = xTaskGetTickCount();
+
+	fprintf( stderr, "\n[ %s time ] %lu ms simulated in %lu.%03lu ms of host time\n",
+			 ( configUSE_VIRTUAL_TIME == 1 ) ? "virtual" : "real",
+			 ( unsigned long ) ( xTicks * portTICK_PERIOD_MS ),
+			 ( unsigned long ) ( ullHostTime / 1000ULL ),
+			 ( unsigned long ) ( ullHostTime % 1000ULL ) );
+
+	#if ( configUSE_TICKLESS_IDLE == 1 )
+	{
+		fprintf( stderr, "[ tickless idle ] %lu of %lu ticks skipped\n",
+				 ulPortGetSuppressedTicks(),
+				 ( unsigned long ) xTicks );
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvHostTimeMicroseconds( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+	return ( uint64_t ) xNow.tv_sec * 1000000ULL + ( uint64_t ) xNow.tv_nsec / 1000ULL;
+}
+/*-----------------------------------------------------------*/
+
+int iHostPrintf( const char *pcFormat, ... )
+{
+va_list xArgs;
+int iReturn;
+BaseType_t xSchedulerStarted = ( xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED );
+
+	/* Once the scheduler runs, a tick inside vprintf() could switch to a task
+	that blocks on the stdout lock held by the task switched out. */
+	if( xSchedulerStarted != pdFALSE )
+	{
+		taskENTER_CRITICAL();
+	}
+
+	va_start( xArgs, pcFormat );
+	iReturn = vprintf( pcFormat, xArgs );
+	va_end( xArgs );
+	fflush( stdout );
+
+	if( xSchedulerStarted != pdFALSE )
+	{
+		taskEXIT_CRITICAL();
+	}
+
+	return iReturn;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulGetSchedulerStatsTime( void )
+{
+	#if ( configUSE_VIRTUAL_TIME == 1 )
+	{
+		/* A tick takes no fixed host time, so there is nothing finer. */
+		return ( uint32_t ) xTaskGetTickCount();
+	}
+	#else
+	{
+		return ( uint32_t ) prvHostTimeMicroseconds();
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+	/* Skip the idle time in virtual time, a no-op otherwise or with tickless
+	idle, where portSUPPRESS_TICKS_AND_SLEEP() skips it. */
+	vPortAdvanceVirtualTime();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+	#if ( mainSYNC_DEMOS == 0 )
+	{
+		vSchedBenchTickHook();
+	}
+	#endif
+
+	#if ( mainSYNC_DEMOS == 0 ) && ( mainBENCH_DEMOS == 0 )
+	{
+		vSpscTickHook();
+	}
+	#endif
+
+	vHRTimerTickHook();
+}
+/*-----------------------------------------------------------*/
+
+#if ( ( mainSYNC_DEMOS == 1 ) || ( mainBENCH_DEMOS == 1 ) ) && ( configUSE_DEADLINE_MISS_HOOK == 1 )
+
+	/* demoEdf.c provides the hook in RTOSDemo. */
+	void vApplicationDeadlineMissHook( TaskHandle_t xTask )
+	{
+		( void ) xTask;
+	}
+
+#endif
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	fprintf( stderr, "Malloc failed\n" );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( TaskHandle_t pxTask, char *pcTaskName )
+{
+	( void ) pxTask;
+
+	fprintf( stderr, "Stack overflow in %s\n", pcTaskName );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+void vAssertCalled( const char *pcFileName, uint32_t ulLine )
+{
+	fprintf( stderr, "ASSERT! Line %lu, file %s\n", ( unsigned long ) ulLine, pcFileName );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+/* configUSE_STATIC_ALLOCATION is set to 1, so the application must provide an
+implementation of vApplicationGetIdleTaskMemory() to provide the memory that is
+used by the Idle task. */
+void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
+{
+static StaticTask_t xIdleTaskTCB;
+static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+	*ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+	*ppxIdleTaskStackBuffer = uxIdleTaskStack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+/*-----------------------------------------------------------*/
+
+/* configUSE_STATIC_ALLOCATION and configUSE_TIMERS are both set to 1, so the
+application must provide an implementation of vApplicationGetTimerTaskMemory()
+to provide the memory that is used by the Timer service task. */
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer, uint32_t *pulTimerTaskStackSize )
+{
+static StaticTask_t xTimerTaskTCB;
+static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+
+	*ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+	*ppxTimerTaskStackBuffer = uxTimerTaskStack;
+	*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * Admission control demo.
+ *
+ * Offers a list of periodic tasks to the kernel one at a time and prints which
+ * ones the admission test accepts.  The set is chosen so that under rate
+ * monotonic scheduling one task passes the hyperbolic bound but not the Liu and
+ * Layland bound, while under EDF all of them fit.  With the aperiodic server
+ * the server is created first, as it counts as a periodic task, and a few
+ * aperiodic jobs are then checked against its capacity.  The accepted tasks run
+ * for a while and the deadline misses of each periodic task are printed.
+ *
+ * Requires configUSE_ADMISSION_CONTROL set to 1.  Change configADMISSION_RM_TEST
+ * or configUSE_EDF_SCHEDULER to compare the tests.
+ */
+
+#if ( configUSE_ADMISSION_CONTROL == 1 )
+
+#define ADMISSION_RUN_TIME  pdMS_TO_TICKS( 2000 )
+#define NUM_PERIODIC        5
+#define NUM_APERIODIC       4
+
+#define SERVER_CAPACITY     pdMS_TO_TICKS( 20 )
+#define SERVER_PERIOD       pdMS_TO_TICKS( 100 )
+
+typedef struct {
+    const char *name;
+    TickType_t period;     // Period for a periodic task, relative deadline for an aperiodic one
+    TickType_t wcet;
+    TaskHandle_t handle;   // NULL if the task was not admitted
+} AdmissionTask_t;
+
+static AdmissionTask_t periodicTasks[NUM_PERIODIC] = {
+    {"P1", pdMS_TO_TICKS( 50 ),  pdMS_TO_TICKS( 10 ), NULL},  // U = 0.20
+    {"P2", pdMS_TO_TICKS( 100 ), pdMS_TO_TICKS( 25 ), NULL},  // U = 0.25
+    {"P3", pdMS_TO_TICKS( 400 ), pdMS_TO_TICKS( 44 ), NULL},  // U = 0.11
+    {"P4", pdMS_TO_TICKS( 250 ), pdMS_TO_TICKS( 50 ), NULL},  // U = 0.20
+    {"P5", pdMS_TO_TICKS( 125 ), pdMS_TO_TICKS( 20 ), NULL},  // U = 0.16
+};
+
+static AdmissionTask_t aperiodicTasks[NUM_APERIODIC] = {
+    {"A1", pdMS_TO_TICKS( 100 ), pdMS_TO_TICKS( 15 ), NULL},
+    {"A2", pdMS_TO_TICKS( 200 ), pdMS_TO_TICKS( 10 ), NULL},
+    {"A3", pdMS_TO_TICKS( 150 ), pdMS_TO_TICKS( 30 ), NULL},
+    {"A4", pdMS_TO_TICKS( 400 ), pdMS_TO_TICKS( 20 ), NULL},
+};
+
+/* Spin until the calling task has been running for xTicks ticks.  A jump of
+ * more than one tick means the task was preempted, so only single steps count. */
+static void prvBusyWork(TickType_t xTicks) {
+    TickType_t xLast = xTaskGetTickCount();
+    TickType_t xDone = 0;
+
+    while (xDone < xTicks) {
+        TickType_t xNow = xTaskGetTickCount();
+        if (xNow != xLast) {
+            if ((TickType_t) (xNow - xLast) == 1) {
+                xDone++;
+            }
+            xLast = xNow;
+        }
+    }
+}
+
+static void vPeriodicTask(void *pvParameters) {
+    AdmissionTask_t *task = (AdmissionTask_t *)pvParameters;
+    TickType_t xWakeTime = xTaskGetTickCount();
+
+    for (;;) {
+        prvBusyWork(task->wcet);
+#if ( INCLUDE_vTaskEndJob == 1 )
+        ( void ) xWakeTime;
+        vTaskEndJob();
+#else
+        vTaskDelayUntil(&xWakeTime, task->period);
+#endif
+    }
+}
+
+static void vAperiodicTask(void *pvParameters) {
+    AdmissionTask_t *task = (AdmissionTask_t *)pvParameters;
+
+    prvBusyWork(task->wcet);
+    vTaskDelete(NULL);
+}
+
+static void prvPrintResult(const AdmissionTask_t *task, BaseType_t result, const char *kind) {
+    printf("  \033[95m%s\033[0m %-9s C = %3ums, %s = %3ums  ->  %s\n", task->name, kind,
+           (unsigned) (task->wcet * portTICK_PERIOD_MS),
+           (kind[0] == 'p') ? "T" : "D",
+           (unsigned) (task->period * portTICK_PERIOD_MS),
+           (result == pdPASS) ? "\033[1;92mADMITTED\033[0m" :
+           (result == errSCHEDULE_NOT_ADMITTED) ? "\033[1;91mREJECTED\033[0m" : "\033[1;91mERROR\033[0m");
+}
+
+/* Not a periodic task, so it only runs while no job is ready. */
+static void vMonitorTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    vTaskDelay(ADMISSION_RUN_TIME);
+
+#if ( INCLUDE_vTaskEndJob == 1 )
+    printf("\n\t\033[1;45m[*] ADMITTED TASKS DATA [*]\033[0m\n");
+    printf("  +------+--------+--------+\n");
+    printf("  | Task | Jobs   | Misses |\n");
+    printf("  +------+--------+--------+\n");
+    for (int i = 0; i < NUM_PERIODIC; i++) {
+        TaskJobStatus_t status;
+        if (periodicTasks[i].handle == NULL) {
+            continue;
+        }
+        vTaskGetJobStatus(periodicTasks[i].handle, &status);
+        printf("  | %-4s | %-6u | \033[1;%dm%-6u\033[0m |\n", periodicTasks[i].name,
+               (unsigned) status.uxJobNumber,
+               (status.uxDeadlineMisses == 0) ? 92 : 91,
+               (unsigned) status.uxDeadlineMisses);
+    }
+    printf("  +------+--------+--------+\n");
+#endif
+
+    vTaskEndScheduler();
+}
+
+int main_admission(void) {
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    printf("\t\033[1;45m[*] ADMISSION CONTROL - EDF, U <= 1 [*]\033[0m\n");
+#elif ( configADMISSION_RM_TEST == tskADMISSION_LIU_LAYLAND )
+    printf("\t\033[1;45m[*] ADMISSION CONTROL - RM, LIU AND LAYLAND BOUND [*]\033[0m\n");
+#else
+    printf("\t\033[1;45m[*] ADMISSION CONTROL - RM, HYPERBOLIC BOUND [*]\033[0m\n");
+#endif
+
+#if ( configUSE_APERIODIC_SERVER == 1 )
+    BaseType_t serverResult = xTaskServerCreate(eServerDeferrable, SERVER_CAPACITY, SERVER_PERIOD);
+    printf("  \033[95mServer\033[0m             C = %3ums, T = %3ums  ->  %s\n",
+           (unsigned) (SERVER_CAPACITY * portTICK_PERIOD_MS),
+           (unsigned) (SERVER_PERIOD * portTICK_PERIOD_MS),
+           (serverResult == pdPASS) ? "\033[1;92mADMITTED\033[0m" : "\033[1;91mREJECTED\033[0m");
+#endif
+
+    for (int i = 0; i < NUM_PERIODIC; i++) {
+        BaseType_t result = xTaskCreatePeriodic(vPeriodicTask, periodicTasks[i].name, configMINIMAL_STACK_SIZE,
+                                                &periodicTasks[i], tskIDLE_PRIORITY + 2, periodicTasks[i].period,
+                                                periodicTasks[i].wcet, &periodicTasks[i].handle);
+        if (result != pdPASS) {
+            periodicTasks[i].handle = NULL;
+        }
+        prvPrintResult(&periodicTasks[i], result, "periodic");
+    }
+
+    // Without the server or EDF aperiodic tasks only run in the background and are always accepted.
+#if ( ( configUSE_APERIODIC_SERVER == 1 ) || ( configUSE_EDF_SCHEDULER == 1 ) )
+    for (int i = 0; i < NUM_APERIODIC; i++) {
+        BaseType_t result = xTaskCreateAperiodic(vAperiodicTask, aperiodicTasks[i].name, configMINIMAL_STACK_SIZE,
+                                                 &aperiodicTasks[i], tskIDLE_PRIORITY + 1, aperiodicTasks[i].wcet,
+                                                 aperiodicTasks[i].period, &aperiodicTasks[i].handle);
+        prvPrintResult(&aperiodicTasks[i], result, "aperiodic");
+    }
+#endif
+
+    xTaskCreate(vMonitorTask, "Monitor", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 1, NULL);
+
+    vTaskStartScheduler();
+    return 0;
+}
+
+#else
+
+int main_admission(void) {
+    printf("\033[91mThe admission demo requires configUSE_ADMISSION_CONTROL set to 1\033[0m\n");
+    return 0;
+}
+
+#endif /* configUSE_ADMISSION_CONTROL */
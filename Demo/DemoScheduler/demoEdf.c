@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * EDF demo.
+ *
+ * Two periodic tasks with a total utilisation of 20/50 + 40/70 = 0.97.  That is
+ * above the rate monotonic bound for two tasks (0.83), and the task with the
+ * longer period does miss deadlines under fixed priorities, but it is below 1,
+ * so under EDF every job completes in time.  Build once with
+ * configUSE_EDF_SCHEDULER set to 0 and once with it set to 1 to compare.
+ *
+ * With configUSE_SCHEDULER_STATS set to 1 the response time and lateness of
+ * each task are printed too.
+ *
+ * Requires INCLUDE_vTaskEndJob.  configUSE_EDF_SCHEDULER also requires
+ * configUSE_APERIODIC_SERVER to be 0.
+ */
+
+#define EDF_RUN_TIME        pdMS_TO_TICKS( 3500 )  // 10 hyperperiods
+#define NUM_TASKS           2
+
+#if ( INCLUDE_vTaskEndJob == 1 )
+
+typedef struct {
+    const char *name;
+    TickType_t period;
+    TickType_t wcet;
+    TaskHandle_t handle;
+} EdfTask_t;
+
+static EdfTask_t tasks[NUM_TASKS] = {
+    {"T1", pdMS_TO_TICKS( 50 ), pdMS_TO_TICKS( 20 ), NULL},
+    {"T2", pdMS_TO_TICKS( 70 ), pdMS_TO_TICKS( 40 ), NULL},
+};
+
+static volatile UBaseType_t totalMisses = 0;
+
+#if ( configUSE_DEADLINE_MISS_HOOK == 1 )
+/* Runs in the tick interrupt, so only count the miss here. */
+void vApplicationDeadlineMissHook(TaskHandle_t xTask) {
+    ( void ) xTask;
+    totalMisses++;
+}
+#endif
+
+/* Spin until the calling task has been running for xTicks ticks.  A jump of
+ * more than one tick means the task was preempted, so only single steps count. */
+static void prvBusyWork(TickType_t xTicks) {
+    TickType_t xLast = xTaskGetTickCount();
+    TickType_t xDone = 0;
+
+    while (xDone < xTicks) {
+        TickType_t xNow = xTaskGetTickCount();
+        if (xNow != xLast) {
+            if ((TickType_t) (xNow - xLast) == 1) {
+                xDone++;
+            }
+            xLast = xNow;
+        }
+    }
+}
+
+static void vEdfTask(void *pvParameters) {
+    EdfTask_t *task = (EdfTask_t *)pvParameters;
+
+    for (;;) {
+        prvBusyWork(task->wcet);
+        vTaskEndJob();
+    }
+}
+
+#if ( configUSE_SCHEDULER_STATS == 1 )
+/* Scheduler statistics counts to microseconds. */
+static int prvStatsToUs(int64_t counts) {
+    return (int) (counts * (int64_t) (1000 * portTICK_PERIOD_MS) / (int64_t) configSCHEDULER_STATS_COUNTS_PER_TICK);
+}
+
+static void prvPrintSchedulerStats(void) {
+    TaskSchedulerStats_t stats[NUM_TASKS];
+    UBaseType_t count = uxTaskGetSchedulerStats(stats, NUM_TASKS);
+
+    printf("\n\t\033[1;45m[*] RESPONSE TIMES (us) [*]\033[0m\n");
+    printf("  +------+--------+--------+--------+--------------+--------------+\n");
+    printf("  | Task | Best   | Avg    | Worst  | Avg lateness | Max lateness |\n");
+    printf("  +------+--------+--------+--------+--------------+--------------+\n");
+    for (UBaseType_t i = 0; i < count; i++) {
+        printf("  | %-4s | %-6d | %-6d | %-6d | %-12d | \033[1;%dm%-12d\033[0m |\n", stats[i].pcTaskName,
+               prvStatsToUs(stats[i].ulBestResponse),
+               prvStatsToUs(stats[i].ulAverageResponse),
+               prvStatsToUs(stats[i].ulWorstResponse),
+               prvStatsToUs(stats[i].llAverageLateness),
+               (stats[i].llWorstLateness > 0) ? 91 : 92,
+               prvStatsToUs(stats[i].llWorstLateness));
+    }
+    printf("  +------+--------+--------+--------+--------------+--------------+\n");
+}
+#endif
+
+/* Not a periodic task, so it only runs while no job is ready. */
+static void vMonitorTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    vTaskDelay(EDF_RUN_TIME);
+
+    printf("\n\t\033[1;45m[*] %s DATA [*]\033[0m\n", (configUSE_EDF_SCHEDULER == 1) ? "EDF" : "RM");
+    printf("  +------+--------+--------+-------------------+\n");
+    printf("  | Task | Jobs   | Misses | Last response(ms) |\n");
+    printf("  +------+--------+--------+-------------------+\n");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        TaskJobStatus_t status;
+        vTaskGetJobStatus(tasks[i].handle, &status);
+        printf("  | %-4s | %-6u | \033[1;%dm%-6u\033[0m | %-17u |\n", tasks[i].name,
+               (unsigned) status.uxJobNumber,
+               (status.uxDeadlineMisses == 0) ? 92 : 91,
+               (unsigned) status.uxDeadlineMisses,
+               (unsigned) (status.xResponseTime * portTICK_PERIOD_MS));
+    }
+    printf("  +------+--------+--------+-------------------+\n");
+#if ( configUSE_SCHEDULER_STATS == 1 )
+    prvPrintSchedulerStats();
+#endif
+#if ( configUSE_DEADLINE_MISS_HOOK == 1 )
+    printf("  \033[95mMISS HOOK CALLS = \033[1m%u\033[0m\n", (unsigned) totalMisses);
+#endif
+
+    vTaskEndScheduler();
+}
+
+int main_edf(void) {
+    for (int i = 0; i < NUM_TASKS; i++) {
+        xTaskCreatePeriodic(vEdfTask, tasks[i].name, configMINIMAL_STACK_SIZE, &tasks[i],
+                            tskIDLE_PRIORITY + 2, tasks[i].period, tasks[i].wcet, &tasks[i].handle);
+    }
+    xTaskCreate(vMonitorTask, "Monitor", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 1, NULL);
+
+    printf("\t\033[1;45m[*] %s SCHEDULER [*]\033[0m\n", (configUSE_EDF_SCHEDULER == 1) ? "EDF" : "RM");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        printf("  \033[95m%s\033[0m: period \033[1m%ums\033[0m, execution \033[1m%ums\033[0m\n", tasks[i].name,
+               (unsigned) (tasks[i].period * portTICK_PERIOD_MS),
+               (unsigned) (tasks[i].wcet * portTICK_PERIOD_MS));
+    }
+
+    vTaskStartScheduler();
+    return 0;
+}
+
+#else
+
+int main_edf(void) {
+    printf("\033[91mThe EDF demo requires INCLUDE_vTaskEndJob set to 1\033[0m\n");
+    return 0;
+}
+
+#endif /* INCLUDE_vTaskEndJob */
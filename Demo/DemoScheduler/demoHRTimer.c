@@ -0,0 +1,137 @@
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "hrTimer.h"
+
+/*
+ * High resolution timer demo.
+ *
+ * A control loop runs every 500us, half a tick, with a deadline of 400us, and
+ * a filter of its output every 1500us, which is not a whole number of ticks
+ * either.  Both are released by hrTimer.c rather than by the tick, and the
+ * monitor prints, in microseconds, how late each job started after its release
+ * (jitter) and how long it took to complete (response), with the deadline
+ * misses.  With vTaskEndJob() both would be released on tick boundaries only,
+ * up to a full tick late.
+ *
+ * In the host build the timers fire from the tick hook, so the control loop is
+ * released twice per tick and misses half of its deadlines there: run it on
+ * the board or under QEMU for the sub-tick figures.
+ *
+ * Requires INCLUDE_xTaskReleaseJobFromISR.
+ */
+
+#define HR_RUN_TIME         pdMS_TO_TICKS( 2000 )
+#define NUM_TASKS           2
+
+#if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+
+typedef struct {
+    const char *name;
+    uint32_t periodUs;
+    uint32_t deadlineUs;
+    uint32_t wcetUs;
+    TaskHandle_t handle;
+} HRTask_t;
+
+static HRTask_t tasks[NUM_TASKS] = {
+    {"Ctrl",   500,  400,  100, NULL},
+    {"Filter", 1500, 1500, 200, NULL},
+};
+
+#define SETPOINT            1000
+#define FILTER_LENGTH       8
+
+/* Plant state and controller output, in fixed point. */
+static volatile int32_t plantOutput = 0;
+static int32_t integral = 0;
+static int32_t filtered = 0;
+
+/* A PI controller driving a first order plant towards SETPOINT. */
+static void vControlTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    for (;;) {
+        int32_t error = SETPOINT - plantOutput;
+        integral += error;
+        int32_t command = (error / 2) + (integral / 16);
+        plantOutput += (command - plantOutput) / 8;
+        vHRTaskEndJob();
+    }
+}
+
+/* Moving average of the plant output. */
+static void vFilterTask(void *pvParameters) {
+    ( void ) pvParameters;
+    int32_t window[FILTER_LENGTH] = { 0 };
+    int32_t sum = 0;
+    unsigned next = 0;
+
+    for (;;) {
+        sum += plantOutput - window[next];
+        window[next] = plantOutput;
+        next = (next + 1) % FILTER_LENGTH;
+        filtered = sum / FILTER_LENGTH;
+        vHRTaskEndJob();
+    }
+}
+
+/* Not a periodic task, so it only runs while no job is ready. */
+static void vMonitorTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    vTaskDelay(HR_RUN_TIME);
+
+    printf("\n\t\033[1;45m[*] HIGH RESOLUTION RELEASES [*]\033[0m\n");
+    printf("  +--------+-------------+---------------+--------+--------+---------------+-------------------+---------------------+\n");
+    printf("  | Task   | Period (us) | Deadline (us) | Jobs   | Misses | Late releases | Worst jitter (us) | Worst response (us) |\n");
+    printf("  +--------+-------------+---------------+--------+--------+---------------+-------------------+---------------------+\n");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        HRTaskStatus_t status;
+        vHRTaskGetStatus(tasks[i].handle, &status);
+        printf("  | %-6s | %-11u | %-13u | %-6u | \033[1;%dm%-6u\033[0m | %-13u | %-17u | %-19u |\n", tasks[i].name,
+               (unsigned) tasks[i].periodUs,
+               (unsigned) tasks[i].deadlineUs,
+               (unsigned) status.uxJobs,
+               (status.uxDeadlineMisses == 0) ? 92 : 91,
+               (unsigned) status.uxDeadlineMisses,
+               (unsigned) status.uxLateReleases,
+               (unsigned) status.ulWorstJitterUs,
+               (unsigned) status.ulWorstResponseUs);
+    }
+    printf("  +--------+-------------+---------------+--------+--------+---------------+-------------------+---------------------+\n");
+    printf("  \033[95mPLANT OUTPUT = \033[1m%d\033[0m\033[95m (setpoint %d, filtered %d)\033[0m\n",
+           (int) plantOutput, SETPOINT, (int) filtered);
+
+    vTaskEndScheduler();
+}
+
+int main_hrtimer(void) {
+    vHRTimerInit();
+
+    xHRTaskCreatePeriodic(vControlTask, tasks[0].name, configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2,
+                          tasks[0].periodUs, tasks[0].deadlineUs, tasks[0].wcetUs, &tasks[0].handle);
+    xHRTaskCreatePeriodic(vFilterTask, tasks[1].name, configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 2,
+                          tasks[1].periodUs, tasks[1].deadlineUs, tasks[1].wcetUs, &tasks[1].handle);
+    xTaskCreate(vMonitorTask, "Monitor", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 1, NULL);
+
+    printf("\t\033[1;45m[*] HIGH RESOLUTION TIMER [*]\033[0m\n");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        printf("  \033[95m%s\033[0m: period \033[1m%uus\033[0m, deadline \033[1m%uus\033[0m, tick \033[1m%uus\033[0m\n", tasks[i].name,
+               (unsigned) tasks[i].periodUs,
+               (unsigned) tasks[i].deadlineUs,
+               (unsigned) (1000 * portTICK_PERIOD_MS));
+    }
+
+    vTaskStartScheduler();
+    return 0;
+}
+
+#else
+
+int main_hrtimer(void) {
+    printf("\033[91mThe high resolution timer demo requires INCLUDE_xTaskReleaseJobFromISR set to 1\033[0m\n");
+    return 0;
+}
+
+#endif
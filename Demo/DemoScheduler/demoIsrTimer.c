@@ -0,0 +1,156 @@
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+#include "hrTimer.h"
+
+/*
+ * ISR timer demo.
+ *
+ * Two auto-reload timers share the same period and are started together, so
+ * they are due on the same ticks.  Each one releases a task of its own through
+ * a task notification: the first is a regular timer, whose callback runs in
+ * the timer service task, the second is turned into an ISR timer with
+ * vTimerSetISRContext(), so its callback runs in the tick interrupt.  A busy
+ * task with a priority above the timer service task, but below the released
+ * tasks, keeps the processor for a few ticks at a time.
+ *
+ * The monitor prints, for each timer, the releases, the worst and average
+ * latency from the tick the timer was due on to the start of the released task
+ * in microseconds, and the worst lateness in ticks.  The daemon timer waits
+ * for the busy task; the ISR timer does not.  In virtual time the clock of
+ * hrTimer.c only moves with the tick, so latency within a tick shows as 0.
+ *
+ * Requires configUSE_ISR_TIMERS.
+ */
+
+#define ISR_RUN_TIME        pdMS_TO_TICKS( 2000 )
+#define TIMER_PERIOD        10    // Ticks
+#define BUSY_TICKS          3     // Ticks the busy task keeps the processor for
+#define BUSY_PAUSE          4     // Ticks it then blocks for
+#define RELEASE_RING        8
+#define NUM_TIMERS          2
+
+#if ( configUSE_ISR_TIMERS == 1 )
+
+typedef struct {
+    const char *name;
+    TaskHandle_t handle;
+    uint32_t releases;
+    uint64_t worstUs;
+    uint64_t totalUs;
+    TickType_t worstLate;
+} Released_t;
+
+static Released_t released[NUM_TIMERS] = {
+    {"daemon timer", NULL, 0, 0, 0, 0},
+    {"ISR timer",    NULL, 0, 0, 0, 0},
+};
+
+/* Time of each due tick, as seen by the ISR timer callback. */
+static volatile uint64_t releaseUs[RELEASE_RING];
+static volatile uint32_t isrExpiries = 0;
+static TickType_t xFirstDue = 0;
+
+static void vDaemonCallback(TimerHandle_t xTimer) {
+    ( void ) xTimer;
+    xTaskNotifyGive(released[0].handle);
+}
+
+/* Runs in the tick interrupt: FromISR API only, and the kernel yields on the
+ * way out if the released task has the higher priority. */
+static void vISRCallback(TimerHandle_t xTimer) {
+    ( void ) xTimer;
+    releaseUs[isrExpiries % RELEASE_RING] = ullHRTimerGetTimeUs();
+    isrExpiries++;
+    vTaskNotifyGiveFromISR(released[1].handle, NULL);
+}
+
+static void vReleasedTask(void *pvParameters) {
+    Released_t *task = (Released_t *) pvParameters;
+
+    for (;;) {
+        // One release per notification, even if several are pending.
+        ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+
+        uint64_t nowUs = ullHRTimerGetTimeUs();
+        TickType_t late = xTaskGetTickCount() - (xFirstDue + task->releases * TIMER_PERIOD);
+        uint64_t latency = nowUs - releaseUs[task->releases % RELEASE_RING];
+
+        task->totalUs += latency;
+        if (latency > task->worstUs) {
+            task->worstUs = latency;
+        }
+        if (late > task->worstLate) {
+            task->worstLate = late;
+        }
+        task->releases++;
+    }
+}
+
+static void vBusyTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    for (;;) {
+        TickType_t xStart = xTaskGetTickCount();
+        while (xTaskGetTickCount() - xStart < BUSY_TICKS) {
+        }
+        vTaskDelay(BUSY_PAUSE);
+    }
+}
+
+static void vMonitorTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    vTaskDelay(ISR_RUN_TIME);
+
+    printf("  +--------------+----------+-----------------------+------------+\n");
+    printf("  | Released by  | Releases | Latency worst/avg us  | Worst late |\n");
+    printf("  +--------------+----------+-----------------------+------------+\n");
+    for (int i = 0; i < NUM_TIMERS; i++) {
+        Released_t *task = &released[i];
+        uint64_t average = (task->releases > 0) ? task->totalUs / task->releases : 0;
+
+        printf("  | %-12s | %-8u | %9llu / %-9llu | \033[1;%dm%-4u ticks\033[0m |\n", task->name,
+               (unsigned) task->releases, (unsigned long long) task->worstUs, (unsigned long long) average,
+               (task->worstLate == 0) ? 92 : 91, (unsigned) task->worstLate);
+    }
+    printf("  +--------------+----------+-----------------------+------------+\n");
+    vTaskEndScheduler();
+}
+
+int main_isr_timer(void) {
+    TimerHandle_t xDaemonTimer = xTimerCreate("Daemon", TIMER_PERIOD, pdTRUE, NULL, vDaemonCallback);
+    TimerHandle_t xISRTimer = xTimerCreate("ISR", TIMER_PERIOD, pdTRUE, NULL, vISRCallback);
+
+    vHRTimerInit();
+
+    // Converted while dormant; from now on its commands act at once.
+    vTimerSetISRContext(xISRTimer, pdTRUE);
+    xFirstDue = xTaskGetTickCount() + TIMER_PERIOD;
+    xTimerStart(xDaemonTimer, 0);
+    xTimerStart(xISRTimer, 0);
+
+    for (int i = 0; i < NUM_TIMERS; i++) {
+        xTaskCreate(vReleasedTask, released[i].name, configMINIMAL_STACK_SIZE * 2, &released[i],
+                    configTIMER_TASK_PRIORITY + 2, &released[i].handle);
+    }
+    xTaskCreate(vBusyTask, "Busy", configMINIMAL_STACK_SIZE, NULL, configTIMER_TASK_PRIORITY + 1, NULL);
+    xTaskCreate(vMonitorTask, "Monitor", configMINIMAL_STACK_SIZE * 2, NULL, configMAX_PRIORITIES - 1, NULL);
+
+    printf("\t\033[1;45m[*] ISR TIMER DEMO [*]\033[0m\n");
+    printf("  \033[95mPERIOD = \033[1m%d ticks\033[0m\033[95m, BUSY TASK = \033[1m%d of every %d ticks\033[0m\n",
+           TIMER_PERIOD, BUSY_TICKS, BUSY_TICKS + BUSY_PAUSE);
+
+    vTaskStartScheduler();
+    return 0;
+}
+
+#else
+
+int main_isr_timer(void) {
+    printf("\033[91mThe ISR timer demo requires configUSE_ISR_TIMERS\033[0m\n");
+    return 0;
+}
+
+#endif
@@ -0,0 +1,166 @@
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * Ready queue benchmark.
+ *
+ * Measures how long it takes to make a periodic task ready again while a
+ * growing number of other periodic tasks are already in the ready list.  The
+ * measured call is vTaskResume(), which is one critical section around the
+ * ready list insertion, so the worst value of each row is the worst time
+ * interrupts are masked by that insertion.
+ *
+ * Two tasks are resumed: one with the longest period, which goes to the tail of
+ * the list, and one with the shortest period after the benchmark task, which
+ * goes to the head.  With the default linked list the tail insertion walks the
+ * whole list; with configUSE_READY_HEAP set to 1 both stay close to flat.
+ *
+ * configREADY_HEAP_LENGTH has to be at least BENCH_MAX_TASKS + 3.  Requires
+ * configUSE_POLLING_SERVER and INCLUDE_xTaskCreatePeriodic.
+ */
+
+#define BENCH_ROUNDS        200   // Samples per measurement
+#define BENCH_MAX_TASKS     48    // Largest ready set
+#define BENCH_STEPS         5
+
+#if ( ( configUSE_POLLING_SERVER == 1 ) && ( INCLUDE_xTaskCreatePeriodic == 1 ) )
+
+static const int readySetSizes[BENCH_STEPS] = { 4, 8, 16, 32, BENCH_MAX_TASKS };
+
+#if defined( __ARM_ARCH_7M__ )
+
+/* SysTick counts core clock cycles down from its reload value. */
+#define SYSTICK_LOAD    ( * ( ( volatile uint32_t * ) 0xE000E014UL ) )
+#define SYSTICK_VAL     ( * ( ( volatile uint32_t * ) 0xE000E018UL ) )
+#define TIMER_UNIT      "cycles"
+
+static uint32_t prvTimerRead(void) {
+    return SYSTICK_VAL;
+}
+
+static uint32_t prvTimerElapsed(uint32_t start, uint32_t end) {
+    uint32_t reload = SYSTICK_LOAD + 1UL;
+    return (start >= end) ? (start - end) : (start + reload - end);
+}
+
+#else
+
+#include <time.h>
+#define TIMER_UNIT      "ns"
+
+static uint32_t prvTimerRead(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t) ((uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec);
+}
+
+static uint32_t prvTimerElapsed(uint32_t start, uint32_t end) {
+    return end - start;
+}
+
+#endif
+
+typedef struct {
+    uint32_t worst;
+    uint32_t total;
+} BenchResult_t;
+
+static TaskHandle_t xHeadTask = NULL;
+static TaskHandle_t xTailTask = NULL;
+
+/* Only ever runs if the benchmark task blocks, which it does not while the
+ * ready set is populated. */
+static void vFillerTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    for (;;) {
+        vTaskSuspend(NULL);
+    }
+}
+
+/* Suspend and resume xTask BENCH_ROUNDS times, timing the resume.  Samples
+ * that a tick interrupt landed in are taken again. */
+static void prvMeasure(TaskHandle_t xTask, BenchResult_t *result) {
+    result->worst = 0;
+    result->total = 0;
+
+    for (int i = 0; i < BENCH_ROUNDS; i++) {
+        TickType_t xTick;
+        uint32_t start, elapsed;
+
+        for (;;) {
+            vTaskSuspend(xTask);
+
+            xTick = xTaskGetTickCount();
+            start = prvTimerRead();
+            vTaskResume(xTask);
+            elapsed = prvTimerElapsed(start, prvTimerRead());
+
+            if (xTaskGetTickCount() == xTick) {
+                break;
+            }
+        }
+
+        result->total += elapsed;
+        if (elapsed > result->worst) {
+            result->worst = elapsed;
+        }
+    }
+}
+
+static void vBenchTask(void *pvParameters) {
+    ( void ) pvParameters;
+    int created = 0;
+
+    printf("  +-------------+-------------------+-------------------+\n");
+    printf("  | Ready tasks | Tail worst/avg    | Head worst/avg    |\n");
+    printf("  +-------------+-------------------+-------------------+\n");
+
+    for (int step = 0; step < BENCH_STEPS; step++) {
+        BenchResult_t tail, head;
+
+        // Grow the ready set.  The periods sit between the head and the tail task.
+        while (created < readySetSizes[step]) {
+            if (xTaskCreatePeriodic(vFillerTask, "Filler", configMINIMAL_STACK_SIZE, NULL,
+                                    tskIDLE_PRIORITY + 1, 100 + created, 0, NULL) != pdPASS) {
+                printf("\033[91mCould not create filler task %d\033[0m\n", created);
+                vTaskEndScheduler();
+            }
+            created++;
+        }
+
+        prvMeasure(xTailTask, &tail);
+        prvMeasure(xHeadTask, &head);
+
+        printf("  | %-11d | %7u / %-7u | %7u / %-7u |\n", created,
+               (unsigned) tail.worst, (unsigned) (tail.total / BENCH_ROUNDS),
+               (unsigned) head.worst, (unsigned) (head.total / BENCH_ROUNDS));
+    }
+
+    printf("  +-------------+-------------------+-------------------+\n");
+    printf("  Times in %s\n", TIMER_UNIT);
+    vTaskEndScheduler();
+}
+
+int main_ready_bench(void) {
+    // The benchmark task has the shortest period, so the ready tasks never run.
+    xTaskCreatePeriodic(vBenchTask, "Bench", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 2, 1, 0, NULL);
+    xTaskCreatePeriodic(vFillerTask, "Head", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, 2, 0, &xHeadTask);
+    xTaskCreatePeriodic(vFillerTask, "Tail", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 1, 10000, 0, &xTailTask);
+
+    printf("\t\033[1;45m[*] READY QUEUE BENCHMARK [*]\033[0m\n");
+    printf("  \033[95mREADY QUEUE = \033[1m%s\033[0m\n", (configUSE_READY_HEAP == 1) ? "binary heap" : "sorted list");
+
+    vTaskStartScheduler();
+    return 0;
+}
+
+#else
+
+int main_ready_bench(void) {
+    printf("\033[91mThe ready queue benchmark requires configUSE_POLLING_SERVER and INCLUDE_xTaskCreatePeriodic set to 1\033[0m\n");
+    return 0;
+}
+
+#endif /* configUSE_POLLING_SERVER */
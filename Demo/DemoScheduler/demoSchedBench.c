@@ -0,0 +1,484 @@
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * Scheduler benchmark suite.
+ *
+ * Measures, for a growing number of ready tasks that never run:
+ *  - switch:           a task blocks (vTaskSuspend) and the next task runs,
+ *  - preempt:          a task resumes a higher priority task, which runs,
+ *  - isr_to_task:      the tick hook gives a notification, the waiting task runs,
+ *  - release_to_run:   a task is released at its period boundary by the tick
+ *                      and runs, counted from the last instruction the
+ *                      interrupted task ran,
+ *  - tick:             the time a tick interrupt without a release takes from
+ *                      a spinning task, found as the gap in its time stamps,
+ *  - create / delete:  xTaskCreatePeriodic() and xTaskCreateAperiodic() of a
+ *                      task that does not run, and vTaskDelete() of it, and
+ *                      xTaskCreateAperiodicFromPool() with configUSE_TASK_POOL.
+ *
+ * The ready tasks are periodic tasks with longer periods than every task of
+ * the benchmark.  With configUSE_POLLING_SERVER set to 0 the same tasks are
+ * created with xTaskCreate() at fixed priorities and the aperiodic rows are
+ * left out, which gives the cost of the stock scheduler to compare with.
+ *
+ * Every result is printed twice: as tables, and as "BENCH,..." lines for
+ * tools/benchCompare.py to compare against an earlier run.  Times are in core
+ * clock cycles on the target (DWT cycle counter, or SysTick when the DWT does
+ * not run, as under QEMU) and in nanoseconds in the host build.
+ *
+ * vSchedBenchTickHook() must be called from vApplicationTickHook().  Requires
+ * configUSE_EDF_SCHEDULER set to 0, and INCLUDE_vTaskEndJob when
+ * configUSE_POLLING_SERVER is 1.
+ */
+
+void vSchedBenchTickHook(void);
+
+#if ( configUSE_EDF_SCHEDULER == 0 ) && ( ( configUSE_POLLING_SERVER == 0 ) || ( INCLUDE_vTaskEndJob == 1 ) )
+
+#define BENCH_ROUNDS        100   // Samples per measurement
+#define BENCH_STEPS         9
+#define BENCH_OWN_TASKS     8     // Benchmark tasks, probe and server, on top of the ready set
+
+static const int readySetSizes[BENCH_STEPS] = { 1, 2, 4, 8, 16, 32, 64, 128, 256 };
+
+/* Every task of the benchmark ahead of the ready set, most urgent first: the
+ * notified task, the released task, the benchmark task and its switch partner.
+ * They are ordered by period with the polling server and by priority without;
+ * the priorities also decide whether vTaskNotifyGiveFromISR() asks for a
+ * switch. */
+#define IRQ_PERIOD          1
+#define RELEASE_PERIOD      3
+#define BENCH_PERIOD        4
+#define PARTNER_PERIOD      5
+#define FILLER_PERIOD       100   // Plus the index of the filler
+#define PROBE_PERIOD        100000
+#define PROBE_DEADLINE      100000
+#define IRQ_PRIORITY        ( tskIDLE_PRIORITY + 5 )  // Above the benchmark task, as vTaskNotifyGiveFromISR() compares priorities
+#define RELEASE_PRIORITY    ( tskIDLE_PRIORITY + 4 )
+#define BENCH_PRIORITY      ( tskIDLE_PRIORITY + 3 )
+#define PARTNER_PRIORITY    ( tskIDLE_PRIORITY + 2 )
+#define FILLER_PRIORITY     ( tskIDLE_PRIORITY + 1 )
+
+#if defined( __ARM_ARCH_7M__ )
+
+#define DEMCR           ( * ( ( volatile uint32_t * ) 0xE000EDFCUL ) )
+#define DEMCR_TRCENA    ( 1UL << 24UL )
+#define DWT_CTRL        ( * ( ( volatile uint32_t * ) 0xE0001000UL ) )
+#define DWT_CYCCNTENA   ( 1UL << 0UL )
+#define DWT_CYCCNT      ( * ( ( volatile uint32_t * ) 0xE0001004UL ) )
+#define SYSTICK_LOAD    ( * ( ( volatile uint32_t * ) 0xE000E014UL ) )
+#define SYSTICK_VAL     ( * ( ( volatile uint32_t * ) 0xE000E018UL ) )
+#define TIMER_UNIT      "cycles"
+
+static BaseType_t useDwt = pdFALSE;
+
+static void prvTimerInit(void) {
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CYCCNTENA;
+
+    uint32_t first = DWT_CYCCNT;
+    for (volatile int i = 0; i < 100; i++) {
+    }
+    useDwt = (DWT_CYCCNT != first);
+}
+
+static uint32_t prvTimerRead(void) {
+    return useDwt ? DWT_CYCCNT : SYSTICK_VAL;
+}
+
+/* SysTick counts down from its reload value, at most one reload apart. */
+static uint32_t prvTimerElapsed(uint32_t start, uint32_t end) {
+    if (useDwt) {
+        return end - start;
+    }
+    uint32_t reload = SYSTICK_LOAD + 1UL;
+    return (start >= end) ? (start - end) : (start + reload - end);
+}
+
+#else
+
+#include <time.h>
+#define TIMER_UNIT      "ns"
+
+static void prvTimerInit(void) {
+}
+
+static uint32_t prvTimerRead(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t) ((uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec);
+}
+
+static uint32_t prvTimerElapsed(uint32_t start, uint32_t end) {
+    return end - start;
+}
+
+#endif
+
+typedef enum {
+    BENCH_SWITCH = 0,
+    BENCH_PREEMPT,
+    BENCH_ISR_TO_TASK,
+    BENCH_RELEASE_TO_RUN,
+    BENCH_TICK,
+    BENCH_CREATE_TASK,
+    BENCH_DELETE_TASK,
+    BENCH_CREATE_APERIODIC,
+    BENCH_DELETE_APERIODIC,
+    BENCH_CREATE_POOL,
+    BENCH_DELETE_POOL,
+    BENCH_METRICS
+} BenchMetric_t;
+
+static const char *metricNames[BENCH_METRICS] = {
+    "switch", "preempt", "isr_to_task", "release_to_run", "tick",
+    "create_task", "delete_task", "create_aperiodic", "delete_aperiodic",
+    "create_pool", "delete_pool"
+};
+
+typedef struct {
+    uint32_t worst;
+    uint32_t total;
+    uint32_t count;
+} BenchResult_t;
+
+static BenchResult_t results[BENCH_STEPS][BENCH_METRICS];
+static int completedSteps = 0;
+
+static TaskHandle_t xBenchTask = NULL;
+static TaskHandle_t xIrqTask = NULL;
+
+/* Shared with the helper tasks and the tick hook. */
+static volatile uint32_t switchStart, switchSample, resumeStart;
+static volatile uint32_t irqStart, irqSample;
+static volatile BaseType_t irqArmed = pdFALSE, irqDone = pdFALSE;
+static volatile uint32_t spinLast;
+static volatile BaseType_t releaseArmed = pdFALSE;
+static volatile UBaseType_t releaseCount = 0;
+static BenchResult_t *releaseResult;
+
+static void prvAddSample(BenchResult_t *result, uint32_t sample) {
+    result->total += sample;
+    result->count++;
+    if (sample > result->worst) {
+        result->worst = sample;
+    }
+}
+
+/* Create a task of the benchmark at the given rank: by period with the polling
+ * server, by priority without. */
+static BaseType_t prvCreate(TaskFunction_t code, const char *name, configSTACK_DEPTH_TYPE stack,
+                            TickType_t period, UBaseType_t priority, TaskHandle_t *handle) {
+#if ( configUSE_POLLING_SERVER == 1 )
+    return xTaskCreatePeriodic(code, name, stack, NULL, priority, period, 0, handle);
+#else
+    ( void ) period;
+    return xTaskCreate(code, name, stack, NULL, priority, handle);
+#endif
+}
+
+/* Only ever runs if every task of the benchmark is blocked. */
+static void vFillerTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    for (;;) {
+        vTaskSuspend(NULL);
+    }
+}
+
+/* Runs whenever the benchmark task suspends itself, and resumes it. */
+static void vPartnerTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    for (;;) {
+        switchSample = prvTimerElapsed(switchStart, prvTimerRead());
+        resumeStart = prvTimerRead();
+        vTaskResume(xBenchTask);
+    }
+}
+
+/* Woken from the tick hook. */
+static void vIrqTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        irqSample = prvTimerElapsed(irqStart, prvTimerRead());
+        irqDone = pdTRUE;
+    }
+}
+
+/* Released every RELEASE_PERIOD ticks, by the pending periodic list with the
+ * polling server, from the delayed list without. */
+static void vReleaseTask(void *pvParameters) {
+    ( void ) pvParameters;
+#if ( configUSE_POLLING_SERVER == 0 )
+    TickType_t xWakeTime = xTaskGetTickCount();
+#endif
+
+    for (;;) {
+        uint32_t now = prvTimerRead();
+
+        if (releaseArmed) {
+            prvAddSample(releaseResult, prvTimerElapsed(spinLast, now));
+            if (releaseResult->count >= BENCH_ROUNDS) {
+                releaseArmed = pdFALSE;
+            }
+        }
+        releaseCount++;
+
+#if ( configUSE_POLLING_SERVER == 1 )
+        vTaskEndJob();
+#else
+        vTaskDelayUntil(&xWakeTime, RELEASE_PERIOD);
+#endif
+    }
+}
+
+void vSchedBenchTickHook(void) {
+    if (irqArmed) {
+        irqArmed = pdFALSE;
+        irqStart = prvTimerRead();
+        // Sets xYieldPending, so the tick switches to the task on its way out.
+        vTaskNotifyGiveFromISR(xIrqTask, NULL);
+    }
+}
+
+static void prvMeasureSwitch(BenchResult_t *step) {
+    while (step[BENCH_SWITCH].count < BENCH_ROUNDS) {
+        TickType_t xTick = xTaskGetTickCount();
+
+        switchStart = prvTimerRead();
+        vTaskSuspend(NULL);
+        uint32_t back = prvTimerElapsed(resumeStart, prvTimerRead());
+
+        // Samples that a tick interrupt landed in are taken again.
+        if (xTaskGetTickCount() == xTick) {
+            prvAddSample(&step[BENCH_SWITCH], switchSample);
+            prvAddSample(&step[BENCH_PREEMPT], back);
+        }
+    }
+}
+
+static void prvMeasureIsr(BenchResult_t *step) {
+    while (step[BENCH_ISR_TO_TASK].count < BENCH_ROUNDS) {
+        irqDone = pdFALSE;
+        irqArmed = pdTRUE;
+        while (!irqDone) {
+        }
+        prvAddSample(&step[BENCH_ISR_TO_TASK], irqSample);
+    }
+}
+
+static void prvMeasureRelease(BenchResult_t *step) {
+    releaseResult = &step[BENCH_RELEASE_TO_RUN];
+    spinLast = prvTimerRead();
+    releaseArmed = pdTRUE;
+    while (releaseArmed) {
+        spinLast = prvTimerRead();
+    }
+}
+
+/* The largest gap between two time stamps around each tick is the interrupt.
+ * Ticks that released a task are skipped. */
+static void prvMeasureTick(BenchResult_t *step) {
+    TickType_t xTick = xTaskGetTickCount();
+    UBaseType_t releases = releaseCount;
+    uint32_t last = prvTimerRead(), widest = 0;
+
+    while (step[BENCH_TICK].count < BENCH_ROUNDS) {
+        TickType_t xNow = xTaskGetTickCount();
+        uint32_t now = prvTimerRead();
+        uint32_t gap = prvTimerElapsed(last, now);
+
+        if (gap > widest) {
+            widest = gap;
+        }
+        if (xNow != xTick) {
+            if (((TickType_t) (xNow - xTick) == 1) && (releases == releaseCount)) {
+                prvAddSample(&step[BENCH_TICK], widest);
+            }
+            xTick = xNow;
+            releases = releaseCount;
+            widest = 0;
+        }
+        last = prvTimerRead();
+    }
+}
+
+#if ( configUSE_POLLING_SERVER == 1 ) && ( configUSE_TASK_POOL == 1 )
+static TaskPoolHandle_t xProbePool = NULL;
+#endif
+
+/* createMetric is BENCH_CREATE_TASK, BENCH_CREATE_APERIODIC or
+ * BENCH_CREATE_POOL, and the delete metric follows it. */
+static void prvMeasureCreate(BenchResult_t *step, BenchMetric_t createMetric) {
+    BenchResult_t *create = &step[createMetric];
+    BenchResult_t *delete = &step[createMetric + 1];
+
+    while (create->count < BENCH_ROUNDS) {
+        TaskHandle_t xProbe = NULL;
+        TickType_t xTick = xTaskGetTickCount();
+        BaseType_t xCreated;
+
+        uint32_t start = prvTimerRead();
+#if ( configUSE_POLLING_SERVER == 1 )
+        if (createMetric == BENCH_CREATE_APERIODIC) {
+            xCreated = xTaskCreateAperiodic(vFillerTask, "Probe", configMINIMAL_STACK_SIZE, NULL,
+                                            FILLER_PRIORITY, 1, PROBE_DEADLINE, &xProbe);
+#if ( configUSE_TASK_POOL == 1 )
+        } else if (createMetric == BENCH_CREATE_POOL) {
+            xCreated = xTaskCreateAperiodicFromPool(xProbePool, vFillerTask, "Probe", NULL,
+                                                    FILLER_PRIORITY, 1, PROBE_DEADLINE, &xProbe);
+#endif
+        } else {
+            xCreated = xTaskCreatePeriodic(vFillerTask, "Probe", configMINIMAL_STACK_SIZE, NULL,
+                                           FILLER_PRIORITY, PROBE_PERIOD, 0, &xProbe);
+        }
+#else
+        xCreated = xTaskCreate(vFillerTask, "Probe", configMINIMAL_STACK_SIZE, NULL, FILLER_PRIORITY, &xProbe);
+#endif
+        uint32_t created = prvTimerRead();
+        if (xCreated != pdPASS) {
+            break;
+        }
+        vTaskDelete(xProbe);
+        uint32_t deleted = prvTimerRead();
+
+        if (xTaskGetTickCount() == xTick) {
+            prvAddSample(create, prvTimerElapsed(start, created));
+            prvAddSample(delete, prvTimerElapsed(created, deleted));
+        }
+    }
+}
+
+/* "avg/worst" in a column of 15, or "-" without samples. */
+static void prvPrintCell(const BenchResult_t *result) {
+    if (result->count == 0) {
+        printf(" %-15s |", "-");
+    } else {
+        printf(" %7u/%-7u |", (unsigned) (result->total / result->count), (unsigned) result->worst);
+    }
+}
+
+static void prvPrintResults(void) {
+    printf("  Times in %s, avg/worst\n", TIMER_UNIT);
+    printf("  +-------+-----------------+-----------------+-----------------+-----------------+-----------------+\n");
+    printf("  | Ready | Switch          | Preempt         | ISR to task     | Release to run  | Tick            |\n");
+    printf("  +-------+-----------------+-----------------+-----------------+-----------------+-----------------+\n");
+    for (int step = 0; step < completedSteps; step++) {
+        printf("  | %-5d |", readySetSizes[step]);
+        for (int metric = BENCH_SWITCH; metric <= BENCH_TICK; metric++) {
+            prvPrintCell(&results[step][metric]);
+        }
+        printf("\n");
+    }
+    printf("  +-------+-----------------+-----------------+-----------------+-----------------+-----------------+\n\n");
+
+    printf("  +-------+-----------------+-----------------+-----------------+-----------------+-----------------+-----------------+\n");
+    printf("  | Ready | Create task     | Delete task     | Create aperiod. | Delete aperiod. | Create pool     | Delete pool     |\n");
+    printf("  +-------+-----------------+-----------------+-----------------+-----------------+-----------------+-----------------+\n");
+    for (int step = 0; step < completedSteps; step++) {
+        printf("  | %-5d |", readySetSizes[step]);
+        for (int metric = BENCH_CREATE_TASK; metric <= BENCH_DELETE_POOL; metric++) {
+            prvPrintCell(&results[step][metric]);
+        }
+        printf("\n");
+    }
+    printf("  +-------+-----------------+-----------------+-----------------+-----------------+-----------------+-----------------+\n\n");
+
+    printf("BENCH,metric,ready_tasks,avg,worst,unit,polling_server\n");
+    for (int step = 0; step < completedSteps; step++) {
+        for (int metric = 0; metric < BENCH_METRICS; metric++) {
+            const BenchResult_t *result = &results[step][metric];
+            if (result->count > 0) {
+                printf("BENCH,%s,%d,%u,%u,%s,%d\n", metricNames[metric], readySetSizes[step],
+                       (unsigned) (result->total / result->count), (unsigned) result->worst,
+                       TIMER_UNIT, configUSE_POLLING_SERVER);
+            }
+        }
+    }
+}
+
+static void vBenchTask(void *pvParameters) {
+    ( void ) pvParameters;
+    int created = 0;
+
+    prvTimerInit();
+
+    for (int step = 0; step < BENCH_STEPS; step++) {
+        BenchResult_t *stepResults = results[step];
+
+#if ( configUSE_READY_HEAP == 1 )
+        if (readySetSizes[step] + BENCH_OWN_TASKS > configREADY_HEAP_LENGTH) {
+            printf("  \033[93mStopped at %d ready tasks, configREADY_HEAP_LENGTH is %d\033[0m\n",
+                   created, (int) configREADY_HEAP_LENGTH);
+            break;
+        }
+#endif
+
+        while (created < readySetSizes[step]) {
+            if (prvCreate(vFillerTask, "Filler", configMINIMAL_STACK_SIZE, FILLER_PERIOD + created,
+                          FILLER_PRIORITY, NULL) != pdPASS) {
+                break;
+            }
+            created++;
+        }
+        if (created < readySetSizes[step]) {
+            printf("  \033[93mStopped at %d ready tasks, out of memory\033[0m\n", created);
+            break;
+        }
+
+        prvMeasureSwitch(stepResults);
+        prvMeasureIsr(stepResults);
+        prvMeasureRelease(stepResults);
+        prvMeasureTick(stepResults);
+        prvMeasureCreate(stepResults, BENCH_CREATE_TASK);
+#if ( configUSE_POLLING_SERVER == 1 )
+        prvMeasureCreate(stepResults, BENCH_CREATE_APERIODIC);
+#if ( configUSE_TASK_POOL == 1 )
+        if (xProbePool != NULL) {
+            prvMeasureCreate(stepResults, BENCH_CREATE_POOL);
+        }
+#endif
+#endif
+        completedSteps = step + 1;
+    }
+
+    prvPrintResults();
+    vTaskEndScheduler();
+}
+
+int main_sched_bench(void) {
+#if ( configUSE_POLLING_SERVER == 1 ) && ( configUSE_TASK_POOL == 1 )
+    xProbePool = xTaskPoolCreate(1, configMINIMAL_STACK_SIZE);
+#endif
+    prvCreate(vIrqTask, "Irq", configMINIMAL_STACK_SIZE, IRQ_PERIOD, IRQ_PRIORITY, &xIrqTask);
+    prvCreate(vReleaseTask, "Release", configMINIMAL_STACK_SIZE, RELEASE_PERIOD, RELEASE_PRIORITY, NULL);
+    prvCreate(vBenchTask, "Bench", configMINIMAL_STACK_SIZE * 4, BENCH_PERIOD, BENCH_PRIORITY, &xBenchTask);
+    prvCreate(vPartnerTask, "Partner", configMINIMAL_STACK_SIZE, PARTNER_PERIOD, PARTNER_PRIORITY, NULL);
+
+    printf("\t\033[1;45m[*] SCHEDULER BENCHMARK [*]\033[0m\n");
+    printf("  \033[95mSCHEDULER   = \033[1m%s\033[0m\n", (configUSE_POLLING_SERVER == 1) ? "periodic (polling server)" : "fixed priority");
+#if ( configUSE_POLLING_SERVER == 1 )
+    printf("  \033[95mREADY QUEUE = \033[1m%s\033[0m\n", (configUSE_READY_HEAP == 1) ? "binary heap" : "sorted list");
+#endif
+
+    vTaskStartScheduler();
+    return 0;
+}
+
+#else
+
+void vSchedBenchTickHook(void) {
+}
+
+int main_sched_bench(void) {
+    printf("\033[91mThe scheduler benchmark requires configUSE_EDF_SCHEDULER set to 0\033[0m\n");
+    return 0;
+}
+
+#endif
@@ -20,7 +20,7 @@ typedef struct {
 } CustomerData_t;
 
 
-QueueHandle_t xWaitingRoomQueue;
+ZeroCopyQueueHandle_t xWaitingRoomQueue;  // Customers are seated in its slots, not copied
 SemaphoreHandle_t xBarberChair;
 TaskHandle_t xSchedulerTaskHandle;
 int servedCustomers = 0, lostCustomers = 0, preemptedCustomers = 0;
@@ -34,52 +34,54 @@ CustomerData_t customers[NUM_CUSTOMERS] = {
 };
 
 void vBarberTask(void *pvParameters) {
-    CustomerData_t currentCustomer;
+    CustomerData_t *currentCustomer = NULL;
     int barberBusy = 0; // Flag to track if the barber is cutting hair
 
     for (;;) {
         if (!barberBusy) {
-            // Pick the highest-priority customer from the queue
-            if (xQueueReceive(xWaitingRoomQueue, &currentCustomer, portMAX_DELAY) == pdTRUE) {
+            // Pick the highest-priority customer from the queue, who keeps the slot until the haircut ends
+            currentCustomer = pvQueueAcquireItem(xWaitingRoomQueue, portMAX_DELAY);
+            if (currentCustomer != NULL) {
                 TickType_t currentTime = xTaskGetTickCount();
                 
                 // **Check if the customer's deadline has already expired**
-                if (currentTime >= (currentCustomer.expirationTime * configTICK_RATE_HZ)) {
+                if (currentTime >= (currentCustomer->expirationTime * configTICK_RATE_HZ)) {
                     printf("\033[95m[ CUSTOMER %d ]\033[0m\tLeft: \033[91mEXPIRED\033[0m @ \033[1;90m[%ds] \033[0m\n",
-                           currentCustomer.id, currentTime / configTICK_RATE_HZ);
+                           currentCustomer->id, currentTime / configTICK_RATE_HZ);
                     lostCustomers++;
+                    vQueueReleaseItem(xWaitingRoomQueue, currentCustomer);
                     continue; // Skip to the next customer
                 }
 
                 // **If this customer was preempted before, resume from remaining time**
-                if (currentCustomer.remainingTime == 0) {
-                    currentCustomer.remainingTime = currentCustomer.serviceTime * configTICK_RATE_HZ;
+                if (currentCustomer->remainingTime == 0) {
+                    currentCustomer->remainingTime = currentCustomer->serviceTime * configTICK_RATE_HZ;
                 }
 
                 printf("\033[95m[ CUSTOMER %d ]\033[0m\t\033[92mCutting\033[0m hair         @ \033[1;90m[%ds] \033[0m\n", 
-                        currentCustomer.id, currentTime / configTICK_RATE_HZ);
+                        currentCustomer->id, currentTime / configTICK_RATE_HZ);
                 barberBusy = 1;
             }
         }
 
         if (barberBusy) {
             // Check if a more urgent customer has arrived
-            CustomerData_t nextCustomer;
-            if (xQueuePeek(xWaitingRoomQueue, &nextCustomer, 0) == pdTRUE) {
+            CustomerData_t *nextCustomer = pvQueuePeekItem(xWaitingRoomQueue, 0);
+            if (nextCustomer != NULL) {
                 
-                if (nextCustomer.expirationTime < currentCustomer.expirationTime) {
+                if (nextCustomer->expirationTime < currentCustomer->expirationTime) {
                     
                     // **Conditional Preemption** based on config flag
                     #if configUSE_HAIRCUT_PREEMPTION
                         printf("\033[95m[ CUSTOMER %d ]\033[0m\t\033[1;93mPreempted\033[0m customer %d @ \033[1;90m[%ds] \033[0m\n", 
-                                nextCustomer.id, currentCustomer.id, xTaskGetTickCount() / configTICK_RATE_HZ);
+                                nextCustomer->id, currentCustomer->id, xTaskGetTickCount() / configTICK_RATE_HZ);
                         preemptedCustomers++;
 
                         // Store remaining time before preempting
-                        currentCustomer.remainingTime -= (xTaskGetTickCount() - (currentCustomer.serviceTime * configTICK_RATE_HZ - currentCustomer.remainingTime));
+                        currentCustomer->remainingTime -= (xTaskGetTickCount() - (currentCustomer->serviceTime * configTICK_RATE_HZ - currentCustomer->remainingTime));
 
-                        // Put the unfinished customer back in the queue
-                        xQueueSendToBack(xWaitingRoomQueue, &currentCustomer, 0);
+                        // Put the unfinished customer back in the queue, in the slot they already hold
+                        vQueueCommitItem(xWaitingRoomQueue, currentCustomer);
 
                         // Switch to the new customer immediately
                         barberBusy = 0;
@@ -90,22 +92,24 @@ void vBarberTask(void *pvParameters) {
             }
 
             // **Check during the haircut if the deadline has expired**
-            if (xTaskGetTickCount() >= (currentCustomer.expirationTime * configTICK_RATE_HZ)) {
+            if (xTaskGetTickCount() >= (currentCustomer->expirationTime * configTICK_RATE_HZ)) {
                 printf("\033[95m [  BARBER  ]\033[0m\t\033[91mCustomer \033[1m%d\033[0m left\033[0m mid-haircut: \033[91mEXPIRED\033[0 @ \033[1;90m[%ds] \033[0m\n",
-                       currentCustomer.id, xTaskGetTickCount() / configTICK_RATE_HZ);
+                       currentCustomer->id, xTaskGetTickCount() / configTICK_RATE_HZ);
                 lostCustomers++;
+                vQueueReleaseItem(xWaitingRoomQueue, currentCustomer);
                 barberBusy = 0;
                 continue; // Move on to the next customer
             }
 
             // **Continue haircut for remaining time**
             vTaskDelay(pdMS_TO_TICKS(1000)); // Simulate 1 second of cutting
-            currentCustomer.remainingTime -= configTICK_RATE_HZ;
+            currentCustomer->remainingTime -= configTICK_RATE_HZ;
 
-            if (currentCustomer.remainingTime <= 0) {
+            if (currentCustomer->remainingTime <= 0) {
                 printf("\033[95m[ CUSTOMER %d ]\033[0m\t\033[1;42mFinished\033[0m haircut     @ \033[1;90m[%ds] \033[0m\n", 
-                        currentCustomer.id, xTaskGetTickCount() / configTICK_RATE_HZ);
+                        currentCustomer->id, xTaskGetTickCount() / configTICK_RATE_HZ);
                 servedCustomers++;
+                vQueueReleaseItem(xWaitingRoomQueue, currentCustomer);
                 barberBusy = 0;
             }
         }
@@ -129,8 +133,14 @@ void vCustomerTask(void *pvParameters) {
     printf("\033[95m[ CUSTOMER %d ]\033[0m\t\033[93mWaiting\033[0m in room      @ \033[1;90m[%ds], \033[1;90mEXPIRATION:\033[0m %d sec, \033[1;90mPRIORITY:\033[90m %d\n",
         customer->id, xTaskGetTickCount() / configTICK_RATE_HZ, customer->expirationTime, priority);
 
-    if (uxQueueMessagesWaiting(xWaitingRoomQueue) < NUM_SEATS) {
-        xQueueSendToBack(xWaitingRoomQueue, customer, 0);
+    CustomerData_t *seat = NULL;
+    if (uxQueueItemsWaiting(xWaitingRoomQueue) < NUM_SEATS) {
+        seat = pvQueueReserveItem(xWaitingRoomQueue, 0);
+    }
+
+    if (seat != NULL) {
+        *seat = *customer;
+        vQueueCommitItem(xWaitingRoomQueue, seat);
 
         // Force a reschedule to allow higher-priority tasks to take over.
         taskYIELD();
@@ -185,7 +195,8 @@ void vEndStatistics(void *pvParameters) {
 }
 
 int main_scheduler(void) {
-    xWaitingRoomQueue = xQueueCreate(NUM_SEATS, sizeof(CustomerData_t));
+    // One slot more than the seats, for the customer in the barber's chair
+    xWaitingRoomQueue = xQueueCreateZeroCopy(NUM_SEATS + 1, sizeof(CustomerData_t));
     xBarberChair = xSemaphoreCreateBinary();
     xSemaphoreGive(xBarberChair);
 
@@ -0,0 +1,228 @@
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * Aperiodic server demo.
+ *
+ * Two periodic tasks keep the CPU busy while a release task injects the same
+ * set of aperiodic jobs once per server policy (polling, deferrable, sporadic).
+ * Every job records when it completes, and the average response time of each
+ * policy is printed at the end.  The server has the same capacity and period
+ * under every policy, so all three bound the interference on the periodic
+ * tasks in the same way; only the aperiodic response times differ.
+ *
+ * Requires configUSE_POLLING_SERVER and configUSE_APERIODIC_SERVER set to 1.
+ */
+
+#if ( configUSE_APERIODIC_SERVER == 1 )
+
+#define SERVER_CAPACITY     pdMS_TO_TICKS( 40 )   // Server budget per period
+#define SERVER_PERIOD       pdMS_TO_TICKS( 200 )  // Server replenishment period
+#define RELEASE_PERIOD      pdMS_TO_TICKS( 10 )   // Granularity of the job arrivals
+#define RELEASE_WCET        pdMS_TO_TICKS( 1 )
+#define NUM_JOBS            8                     // Aperiodic jobs per policy
+#define NUM_POLICIES        3
+
+/* Periodic load: utilisation 25/100 + 50/250 = 0.45, plus 0.2 for the server. */
+#define PERIODIC1_PERIOD    pdMS_TO_TICKS( 100 )
+#define PERIODIC1_WCET      pdMS_TO_TICKS( 25 )
+#define PERIODIC2_PERIOD    pdMS_TO_TICKS( 250 )
+#define PERIODIC2_WCET      pdMS_TO_TICKS( 50 )
+
+/* Aperiodic job data structure */
+typedef struct {
+    int id;                  // Job ID
+    TickType_t arrivalTime;  // Release time, relative to the start of the run
+    TickType_t serviceTime;  // Execution time
+    TickType_t deadline;     // Relative deadline, orders the server queue
+    TickType_t releasedAt;   // Absolute release time
+    TickType_t finishedAt;   // Absolute completion time
+} JobData_t;
+
+typedef struct {
+    eServerPolicy policy;
+    const char *name;
+    TickType_t averageResponse;
+    TickType_t worstResponse;
+} PolicyResult_t;
+
+static JobData_t jobs[NUM_JOBS] = {
+    {1,  pdMS_TO_TICKS( 10 ),  pdMS_TO_TICKS( 20 ), pdMS_TO_TICKS( 400 ), 0, 0},
+    {2,  pdMS_TO_TICKS( 60 ),  pdMS_TO_TICKS( 15 ), pdMS_TO_TICKS( 300 ), 0, 0},
+    {3,  pdMS_TO_TICKS( 130 ), pdMS_TO_TICKS( 30 ), pdMS_TO_TICKS( 500 ), 0, 0},
+    {4,  pdMS_TO_TICKS( 150 ), pdMS_TO_TICKS( 10 ), pdMS_TO_TICKS( 200 ), 0, 0},
+    {5,  pdMS_TO_TICKS( 400 ), pdMS_TO_TICKS( 25 ), pdMS_TO_TICKS( 400 ), 0, 0},
+    {6,  pdMS_TO_TICKS( 430 ), pdMS_TO_TICKS( 20 ), pdMS_TO_TICKS( 300 ), 0, 0},
+    {7,  pdMS_TO_TICKS( 700 ), pdMS_TO_TICKS( 35 ), pdMS_TO_TICKS( 600 ), 0, 0},
+    {8,  pdMS_TO_TICKS( 720 ), pdMS_TO_TICKS( 10 ), pdMS_TO_TICKS( 200 ), 0, 0},
+};
+
+static PolicyResult_t results[NUM_POLICIES] = {
+    {eServerPolling,    "POLLING",    0, 0},
+    {eServerDeferrable, "DEFERRABLE", 0, 0},
+    {eServerSporadic,   "SPORADIC",   0, 0},
+};
+
+static volatile int completedJobs = 0;
+
+/* Spin until the calling task has been running for xTicks ticks.  A jump of
+ * more than one tick means the task was preempted, so only single steps count. */
+static void prvBusyWork(TickType_t xTicks) {
+    TickType_t xLast = xTaskGetTickCount();
+    TickType_t xDone = 0;
+
+    while (xDone < xTicks) {
+        TickType_t xNow = xTaskGetTickCount();
+        if (xNow != xLast) {
+            if ((TickType_t) (xNow - xLast) == 1) {
+                xDone++;
+            }
+            xLast = xNow;
+        }
+    }
+}
+
+/* Wait for the next release of the calling periodic task. */
+static void prvWaitNextPeriod(TickType_t *pxWakeTime, TickType_t xPeriod) {
+#if ( INCLUDE_vTaskEndJob == 1 )
+    ( void ) pxWakeTime;
+    ( void ) xPeriod;
+    vTaskEndJob();
+#else
+    vTaskDelayUntil(pxWakeTime, xPeriod);
+#endif
+}
+
+static void vPeriodicTask(void *pvParameters) {
+    TickType_t *params = (TickType_t *)pvParameters; // { period, wcet }
+    TickType_t xWakeTime = xTaskGetTickCount();
+
+    for (;;) {
+        prvBusyWork(params[1]);
+        prvWaitNextPeriod(&xWakeTime, params[0]);
+    }
+}
+
+static void vJobTask(void *pvParameters) {
+    JobData_t *job = (JobData_t *)pvParameters;
+
+    prvBusyWork(job->serviceTime);
+    job->finishedAt = xTaskGetTickCount();
+    completedJobs++;
+
+    vTaskDelete(NULL);
+}
+
+static void prvPrintResults(void) {
+    printf("\n\t\033[1;45m[*] APERIODIC SERVER DATA [*]\033[0m\n");
+    printf("  +------------+------------------+------------------+\n");
+    printf("  | Policy     | Avg Response(ms) | Max Response(ms) |\n");
+    printf("  +------------+------------------+------------------+\n");
+    for (int i = 0; i < NUM_POLICIES; i++) {
+        printf("  | %-10s | %-16u | %-16u |\n", results[i].name,
+               (unsigned) (results[i].averageResponse * portTICK_PERIOD_MS),
+               (unsigned) (results[i].worstResponse * portTICK_PERIOD_MS));
+    }
+    printf("  +------------+------------------+------------------+\n");
+}
+
+/* Periodic task with the shortest period, so it always runs at the arrival
+ * time of a job.  Runs the job set once for each server policy. */
+static void vReleaseTask(void *pvParameters) {
+    ( void ) pvParameters;
+    TickType_t xWakeTime = xTaskGetTickCount();
+
+    for (int p = 0; p < NUM_POLICIES; p++) {
+        TickType_t xStart, xTotal = 0, xWorst = 0;
+        int nextJob = 0, servedJobs = 0;
+
+        // The server only accepts a new configuration while it has no jobs.
+        if (xTaskServerCreate(results[p].policy, SERVER_CAPACITY, SERVER_PERIOD) != pdPASS) {
+            printf("\033[91mCould not configure the %s server\033[0m\n", results[p].name);
+            break;
+        }
+
+        printf("\033[95m[  SERVER  ]\033[0m\t\033[1m%s\033[0m server started @ \033[1;90m[%ums]\033[0m\n",
+               results[p].name, (unsigned) (xTaskGetTickCount() * portTICK_PERIOD_MS));
+
+        completedJobs = 0;
+        xStart = xTaskGetTickCount();
+
+        while (completedJobs < NUM_JOBS) {
+            while ((nextJob < NUM_JOBS) && ((TickType_t) (xTaskGetTickCount() - xStart) >= jobs[nextJob].arrivalTime)) {
+                jobs[nextJob].releasedAt = xTaskGetTickCount();
+                jobs[nextJob].finishedAt = 0;
+                if (xTaskCreateAperiodic(vJobTask, "Job", configMINIMAL_STACK_SIZE, &jobs[nextJob],
+                                         tskIDLE_PRIORITY + 1, jobs[nextJob].serviceTime, jobs[nextJob].deadline, NULL) != pdPASS) {
+                    // Turned away by the admission test (configUSE_ADMISSION_CONTROL), never runs.
+                    completedJobs++;
+                }
+                nextJob++;
+            }
+            prvWaitNextPeriod(&xWakeTime, RELEASE_PERIOD);
+        }
+
+        for (int i = 0; i < NUM_JOBS; i++) {
+            if (jobs[i].finishedAt == 0) {
+                printf("\033[95m[  JOB %d   ]\033[0m\tReleased @ \033[1;90m[%ums]\033[0m, \033[91mrejected\033[0m\n",
+                       jobs[i].id, (unsigned) (jobs[i].releasedAt * portTICK_PERIOD_MS));
+                continue;
+            }
+
+            TickType_t xResponse = jobs[i].finishedAt - jobs[i].releasedAt;
+            servedJobs++;
+            printf("\033[95m[  JOB %d   ]\033[0m\tReleased @ \033[1;90m[%ums]\033[0m, finished @ \033[1;90m[%ums]\033[0m, response \033[1m%ums\033[0m\n",
+                   jobs[i].id,
+                   (unsigned) (jobs[i].releasedAt * portTICK_PERIOD_MS),
+                   (unsigned) (jobs[i].finishedAt * portTICK_PERIOD_MS),
+                   (unsigned) (xResponse * portTICK_PERIOD_MS));
+            xTotal += xResponse;
+            if (xResponse > xWorst) {
+                xWorst = xResponse;
+            }
+        }
+
+        results[p].averageResponse = (servedJobs > 0) ? xTotal / servedJobs : 0;
+        results[p].worstResponse = xWorst;
+    }
+
+    prvPrintResults();
+    vTaskEndScheduler();
+}
+
+int main_server(void) {
+    static TickType_t periodic1[2] = { PERIODIC1_PERIOD, PERIODIC1_WCET };
+    static TickType_t periodic2[2] = { PERIODIC2_PERIOD, PERIODIC2_WCET };
+
+    xTaskCreatePeriodic(vReleaseTask, "Release", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 2, RELEASE_PERIOD, RELEASE_WCET, NULL);
+    xTaskCreatePeriodic(vPeriodicTask, "Periodic1", configMINIMAL_STACK_SIZE, periodic1, tskIDLE_PRIORITY + 2, PERIODIC1_PERIOD, PERIODIC1_WCET, NULL);
+    xTaskCreatePeriodic(vPeriodicTask, "Periodic2", configMINIMAL_STACK_SIZE, periodic2, tskIDLE_PRIORITY + 2, PERIODIC2_PERIOD, PERIODIC2_WCET, NULL);
+
+    printf("\t\033[1;45m[*] APERIODIC SERVER [*]\033[0m\n");
+    printf("  \033[95mSERVER CAPACITY = \033[1m%ums\033[0m\n", (unsigned) (SERVER_CAPACITY * portTICK_PERIOD_MS));
+    printf("  \033[95mSERVER PERIOD   = \033[1m%ums\033[0m\n", (unsigned) (SERVER_PERIOD * portTICK_PERIOD_MS));
+    printf("  \033[95mJOBS DATA:\033[0m\n");
+    printf("  +----+--------------+--------------+----------+\n");
+    printf("  | ID | Arrival (ms) | Service (ms) | Deadline |\n");
+    printf("  +----+--------------+--------------+----------+\n");
+    for (int i = 0; i < NUM_JOBS; i++) {
+        printf("  | %-2d | %-12u | %-12u | %-8u |\n", jobs[i].id,
+               (unsigned) (jobs[i].arrivalTime * portTICK_PERIOD_MS),
+               (unsigned) (jobs[i].serviceTime * portTICK_PERIOD_MS),
+               (unsigned) (jobs[i].deadline * portTICK_PERIOD_MS));
+    }
+    printf("  +----+--------------+--------------+----------+\n\n");
+
+    vTaskStartScheduler();
+    return 0;
+}
+
+#else
+
+int main_server(void) {
+    printf("\033[91mThe server demo requires configUSE_APERIODIC_SERVER set to 1\033[0m\n");
+    return 0;
+}
+
+#endif /* configUSE_APERIODIC_SERVER */
@@ -0,0 +1,196 @@
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * SMP demo.
+ *
+ * Three periodic tasks with a total utilisation of 10/20 + 15/30 + 24/40 = 1.6,
+ * more than one core can run, scheduled globally: every core takes the most
+ * urgent ready job the others are not running, so the jobs move between the
+ * cores.  Two counters run in the background on whatever the periodic tasks
+ * leave free, one of them kept on the last core with vTaskCoreAffinitySet(),
+ * so it never migrates.
+ *
+ * Build with make CORES=4 VIRTUAL_TIME=0, so each periodic task can have a
+ * core of its own, in real time as a virtual tick is shorter than the time
+ * slice of a host that has fewer processors than simulated cores.
+ *
+ * With DEFINES="-DconfigUSE_PARTITIONED_SCHEDULING=1" the periodic tasks are
+ * bin-packed onto the cores instead.  On two cores under rate monotonic P3
+ * goes to core 0, P1 to core 1, and P2 only fits split: the first 9 ticks of
+ * each job run on core 1, the rest on core 0.  Under EDF P1 and P2 fill core 1
+ * exactly, which leaves the simulation no slack.
+ *
+ * Requires configNUMBER_OF_CORES above 1, configUSE_CORE_AFFINITY and
+ * INCLUDE_vTaskEndJob.
+ */
+
+#if ( configNUMBER_OF_CORES > 1 ) && ( configUSE_CORE_AFFINITY == 1 ) && ( INCLUDE_vTaskEndJob == 1 )
+
+#define SMP_RUN_TIME        pdMS_TO_TICKS( 2400 )  // 20 hyperperiods
+#define NUM_TASKS           3
+#define NUM_COUNTERS        2
+
+typedef struct {
+    const char *name;
+    TickType_t period;
+    TickType_t wcet;
+    TaskHandle_t handle;
+} SmpTask_t;
+
+typedef struct {
+    const char *name;
+    BaseType_t pinned;
+    volatile uint64_t count;
+    TaskHandle_t handle;
+} SmpCounter_t;
+
+static SmpTask_t tasks[NUM_TASKS] = {
+    {"P1", pdMS_TO_TICKS( 20 ), pdMS_TO_TICKS( 10 ), NULL},
+    {"P2", pdMS_TO_TICKS( 30 ), pdMS_TO_TICKS( 15 ), NULL},
+    {"P3", pdMS_TO_TICKS( 40 ), pdMS_TO_TICKS( 24 ), NULL},
+};
+
+static SmpCounter_t counters[NUM_COUNTERS] = {
+    {"Free", pdFALSE, 0, NULL},
+    {"Pinned", pdTRUE, 0, NULL},
+};
+
+/* Spin for xTicks ticks.  Unlike the single core demos it counts every tick,
+ * not only those the task saw one by one: with a core per periodic task a job
+ * is never preempted, and a host with fewer processors than simulated cores
+ * would otherwise stretch the work of a job without end. */
+static void prvBusyWork(TickType_t xTicks) {
+    TickType_t xStart = xTaskGetTickCount();
+
+    while ((TickType_t) (xTaskGetTickCount() - xStart) < xTicks) {
+    }
+}
+
+static void vSmpTask(void *pvParameters) {
+    SmpTask_t *task = (SmpTask_t *)pvParameters;
+
+    for (;;) {
+        prvBusyWork(task->wcet);
+        vTaskEndJob();
+    }
+}
+
+static void vCounterTask(void *pvParameters) {
+    SmpCounter_t *counter = (SmpCounter_t *)pvParameters;
+
+    for (;;) {
+        counter->count++;
+    }
+}
+
+/* Above the counters, and not a periodic task, so it only runs on a core no
+ * job needs when it wakes up. */
+static void vMonitorTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    vTaskDelay(SMP_RUN_TIME);
+
+#if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+    printf("\n\t\033[1;45m[*] %s ON %d CORES [*]\033[0m\n",
+           (configUSE_EDF_SCHEDULER == 1) ? "PARTITIONED EDF" : "PARTITIONED RM", configNUMBER_OF_CORES);
+    printf("  +--------+-------+--------+--------+------------+\n");
+    printf("  | Task   | Core  | Jobs   | Misses | Migrations |\n");
+    printf("  +--------+-------+--------+--------+------------+\n");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        TaskJobStatus_t status;
+        TaskPartition_t partition;
+        char core[8];
+        vTaskGetJobStatus(tasks[i].handle, &status);
+        vTaskGetPartition(tasks[i].handle, &partition);
+        if (partition.xSplitCore >= 0) {
+            snprintf(core, sizeof(core), "%d>%d", (int) partition.xCore, (int) partition.xSplitCore);
+        } else {
+            snprintf(core, sizeof(core), "%d", (int) partition.xCore);
+        }
+        printf("  | %-6s | %-5s | %-6u | \033[1;%dm%-6u\033[0m | %-10u |\n", tasks[i].name, core,
+               (unsigned) status.uxJobNumber,
+               (status.uxDeadlineMisses == 0) ? 92 : 91,
+               (unsigned) status.uxDeadlineMisses,
+               (unsigned) uxTaskGetMigrationCount(tasks[i].handle));
+    }
+    printf("  +--------+-------+--------+--------+------------+\n");
+
+    printf("\n\t\033[1;45m[*] CORE UTILISATION [*]\033[0m\n");
+    printf("  +------+-------------+\n");
+    printf("  | Core | Utilisation |\n");
+    printf("  +------+-------------+\n");
+    for (BaseType_t core = 0; core < configNUMBER_OF_CORES; core++) {
+        UBaseType_t permille = uxTaskGetCoreUtilisation(core);
+        printf("  | %-4d | \033[1;%dm%u.%03u\033[0m       |\n", (int) core, (permille <= 1000) ? 92 : 91,
+               (unsigned) (permille / 1000), (unsigned) (permille % 1000));
+    }
+    printf("  +------+-------------+\n");
+#else
+    printf("\n\t\033[1;45m[*] %s ON %d CORES [*]\033[0m\n", (configUSE_EDF_SCHEDULER == 1) ? "GLOBAL EDF" : "GLOBAL RM",
+           configNUMBER_OF_CORES);
+    printf("  +--------+--------+--------+------------+\n");
+    printf("  | Task   | Jobs   | Misses | Migrations |\n");
+    printf("  +--------+--------+--------+------------+\n");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        TaskJobStatus_t status;
+        vTaskGetJobStatus(tasks[i].handle, &status);
+        printf("  | %-6s | %-6u | \033[1;%dm%-6u\033[0m | %-10u |\n", tasks[i].name,
+               (unsigned) status.uxJobNumber,
+               (status.uxDeadlineMisses == 0) ? 92 : 91,
+               (unsigned) status.uxDeadlineMisses,
+               (unsigned) uxTaskGetMigrationCount(tasks[i].handle));
+    }
+    printf("  +--------+--------+--------+------------+\n");
+#endif /* configUSE_PARTITIONED_SCHEDULING */
+
+    printf("\n\t\033[1;45m[*] BACKGROUND COUNTERS [*]\033[0m\n");
+    printf("  +--------+-------------+-----------------+------------+\n");
+    printf("  | Task   | Affinity    | Counts per tick | Migrations |\n");
+    printf("  +--------+-------------+-----------------+------------+\n");
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        UBaseType_t mask = uxTaskCoreAffinityGet(counters[i].handle);
+        printf("  | %-6s | 0x%-9lx | %-15llu | %-10u |\n", counters[i].name,
+               (unsigned long) (mask & ((1UL << configNUMBER_OF_CORES) - 1UL)),
+               (unsigned long long) (counters[i].count / SMP_RUN_TIME),
+               (unsigned) uxTaskGetMigrationCount(counters[i].handle));
+    }
+    printf("  +--------+-------------+-----------------+------------+\n");
+
+    vTaskEndScheduler();
+}
+
+int main_smp(void) {
+    for (int i = 0; i < NUM_TASKS; i++) {
+        xTaskCreatePeriodic(vSmpTask, tasks[i].name, configMINIMAL_STACK_SIZE, &tasks[i],
+                            tskIDLE_PRIORITY + 2, tasks[i].period, tasks[i].wcet, &tasks[i].handle);
+    }
+    for (int i = 0; i < NUM_COUNTERS; i++) {
+        xTaskCreate(vCounterTask, counters[i].name, configMINIMAL_STACK_SIZE, &counters[i],
+                    tskIDLE_PRIORITY + 1, &counters[i].handle);
+        if (counters[i].pinned == pdTRUE) {
+            vTaskCoreAffinitySet(counters[i].handle, (UBaseType_t) 1U << (configNUMBER_OF_CORES - 1));
+        }
+    }
+    xTaskCreate(vMonitorTask, "Monitor", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 2, NULL);
+
+    printf("\t\033[1;45m[*] SMP SCHEDULER [*]\033[0m\n");
+    for (int i = 0; i < NUM_TASKS; i++) {
+        printf("  \033[95m%s\033[0m: period \033[1m%ums\033[0m, execution \033[1m%ums\033[0m\n", tasks[i].name,
+               (unsigned) (tasks[i].period * portTICK_PERIOD_MS),
+               (unsigned) (tasks[i].wcet * portTICK_PERIOD_MS));
+    }
+
+    vTaskStartScheduler();
+    return 0;
+}
+
+#else
+
+int main_smp(void) {
+    printf("\033[91mThe SMP demo requires configNUMBER_OF_CORES above 1, configUSE_CORE_AFFINITY and INCLUDE_vTaskEndJob set to 1\033[0m\n");
+    return 0;
+}
+
+#endif /* configNUMBER_OF_CORES */
@@ -0,0 +1,242 @@
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "spsc_queue.h"
+
+/*
+ * ISR to task queue demo.
+ *
+ * The tick hook stands for a sensor interrupt: every tick it produces a burst
+ * of numbered samples, and sends each one both to an SPSC queue (spsc_queue.h)
+ * and to a regular queue, timing every send.  A consumer task on each queue
+ * checks that the samples arrive in order and without gaps, apart from the
+ * ones the interrupt found no room for.  The monitor prints, per queue, what
+ * was sent, received and dropped and the average and worst send cost in core
+ * clock cycles on the target (DWT cycle counter, or SysTick when the DWT does
+ * not run, as under QEMU) and in nanoseconds in the host build.
+ *
+ * vSpscTickHook() must be called from vApplicationTickHook().  Requires
+ * configUSE_SPSC_QUEUES.
+ */
+
+#define SPSC_RUN_TIME       pdMS_TO_TICKS( 2000 )
+#define SPSC_QUEUE_LENGTH   8
+#define SAMPLES_PER_TICK    4
+#define NUM_QUEUES          2
+
+#if ( configUSE_SPSC_QUEUES == 1 )
+
+#if defined( __ARM_ARCH_7M__ )
+
+#define DEMCR           ( * ( ( volatile uint32_t * ) 0xE000EDFCUL ) )
+#define DEMCR_TRCENA    ( 1UL << 24UL )
+#define DWT_CTRL        ( * ( ( volatile uint32_t * ) 0xE0001000UL ) )
+#define DWT_CYCCNTENA   ( 1UL << 0UL )
+#define DWT_CYCCNT      ( * ( ( volatile uint32_t * ) 0xE0001004UL ) )
+#define SYSTICK_LOAD    ( * ( ( volatile uint32_t * ) 0xE000E014UL ) )
+#define SYSTICK_VAL     ( * ( ( volatile uint32_t * ) 0xE000E018UL ) )
+#define TIMER_UNIT      "cycles"
+
+static BaseType_t useDwt = pdFALSE;
+
+static void prvTimerInit(void) {
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CYCCNTENA;
+
+    uint32_t first = DWT_CYCCNT;
+    for (volatile int i = 0; i < 100; i++) {
+    }
+    useDwt = (DWT_CYCCNT != first);
+}
+
+static uint32_t prvTimerRead(void) {
+    return useDwt ? DWT_CYCCNT : SYSTICK_VAL;
+}
+
+/* SysTick counts down from its reload value, at most one reload apart. */
+static uint32_t prvTimerElapsed(uint32_t start, uint32_t end) {
+    if (useDwt) {
+        return end - start;
+    }
+    uint32_t reload = SYSTICK_LOAD + 1UL;
+    return (start >= end) ? (start - end) : (start + reload - end);
+}
+
+#else
+
+#include <time.h>
+#define TIMER_UNIT      "ns"
+
+static void prvTimerInit(void) {
+}
+
+static uint32_t prvTimerRead(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t) ((uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec);
+}
+
+static uint32_t prvTimerElapsed(uint32_t start, uint32_t end) {
+    return end - start;
+}
+
+#endif
+
+typedef struct {
+    uint32_t sequence;
+    int32_t value;
+} Sample_t;
+
+typedef struct {
+    const char *name;
+    uint32_t sent;
+    uint32_t full;
+    uint32_t received;
+    uint32_t outOfOrder;
+    uint32_t expected;      // Sequence number of the next sample the consumer should see
+    uint32_t sendTotal;
+    uint32_t sendWorst;
+} QueueStats_t;
+
+static QueueStats_t stats[NUM_QUEUES] = {
+    {"SPSC",  0, 0, 0, 0, 0, 0, 0},
+    {"Queue", 0, 0, 0, 0, 0, 0, 0},
+};
+
+static SpscQueueHandle_t spscQueue = NULL;
+static QueueHandle_t regularQueue = NULL;
+static volatile BaseType_t producing = pdFALSE;
+static uint32_t nextSequence = 0;
+
+/* The sample the consumer got: a drop shows as a gap, which is not an error
+ * as long as the producer counted it. */
+static void prvCheckSample(QueueStats_t *queueStats, const Sample_t *sample) {
+    if (sample->sequence < queueStats->expected) {
+        queueStats->outOfOrder++;
+    }
+    queueStats->expected = sample->sequence + 1;
+    queueStats->received++;
+}
+
+static void prvRecordSend(QueueStats_t *queueStats, BaseType_t result, uint32_t elapsed) {
+    queueStats->sent++;
+    queueStats->sendTotal += elapsed;
+    if (elapsed > queueStats->sendWorst) {
+        queueStats->sendWorst = elapsed;
+    }
+    if (result != pdPASS) {
+        queueStats->full++;
+    }
+}
+
+void vSpscTickHook(void) {
+    if (producing == pdFALSE) {
+        return;
+    }
+
+    for (int i = 0; i < SAMPLES_PER_TICK; i++) {
+        Sample_t sample = { nextSequence, (int32_t) (nextSequence * 7 % 1000) - 500 };
+        nextSequence++;
+
+        // Both queues ask for a switch through xYieldPending, taken when the tick returns.
+        uint32_t start = prvTimerRead();
+        BaseType_t result = xSpscQueueSendFromISR(spscQueue, &sample, NULL);
+        prvRecordSend(&stats[0], result, prvTimerElapsed(start, prvTimerRead()));
+
+        start = prvTimerRead();
+        result = xQueueSendFromISR(regularQueue, &sample, NULL);
+        prvRecordSend(&stats[1], result, prvTimerElapsed(start, prvTimerRead()));
+    }
+}
+
+static void vSpscConsumerTask(void *pvParameters) {
+    ( void ) pvParameters;
+    Sample_t sample;
+
+    for (;;) {
+        if (xSpscQueueReceive(spscQueue, &sample, portMAX_DELAY) == pdPASS) {
+            prvCheckSample(&stats[0], &sample);
+        }
+    }
+}
+
+static void vQueueConsumerTask(void *pvParameters) {
+    ( void ) pvParameters;
+    Sample_t sample;
+
+    for (;;) {
+        if (xQueueReceive(regularQueue, &sample, portMAX_DELAY) == pdPASS) {
+            prvCheckSample(&stats[1], &sample);
+        }
+    }
+}
+
+/* Below the consumers, so both queues are empty once it runs.  It spins rather
+ * than sleeps while the samples are produced, as tickless idle would skip the
+ * ticks that produce them. */
+static void vMonitorTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    TickType_t start = xTaskGetTickCount();
+    producing = pdTRUE;
+    while ((xTaskGetTickCount() - start) < SPSC_RUN_TIME) {
+    }
+    producing = pdFALSE;
+    taskYIELD();
+
+    printf("\n\t\033[1;45m[*] ISR TO TASK QUEUES [*]\033[0m\n");
+    printf("  +-------+--------+----------+--------+--------------+----------+------------+\n");
+    printf("  | Queue | Sent   | Received | Full   | Out of order | Avg send | Worst send |\n");
+    printf("  +-------+--------+----------+--------+--------------+----------+------------+\n");
+    for (int i = 0; i < NUM_QUEUES; i++) {
+        QueueStats_t *queueStats = &stats[i];
+        BaseType_t lost = (queueStats->received + queueStats->full != queueStats->sent);
+        printf("  | %-5s | %-6u | \033[1;%dm%-8u\033[0m | %-6u | \033[1;%dm%-12u\033[0m | %-8u | %-10u |\n", queueStats->name,
+               (unsigned) queueStats->sent,
+               lost ? 91 : 92,
+               (unsigned) queueStats->received,
+               (unsigned) queueStats->full,
+               (queueStats->outOfOrder == 0) ? 92 : 91,
+               (unsigned) queueStats->outOfOrder,
+               (unsigned) ((queueStats->sent == 0) ? 0 : queueStats->sendTotal / queueStats->sent),
+               (unsigned) queueStats->sendWorst);
+    }
+    printf("  +-------+--------+----------+--------+--------------+----------+------------+\n");
+    printf("  \033[95mSEND COST IN \033[1m%s\033[0m\033[95m, measured in the interrupt\033[0m\n", TIMER_UNIT);
+
+    vTaskEndScheduler();
+}
+
+int main_spsc(void) {
+    prvTimerInit();
+
+    spscQueue = xSpscQueueCreate(SPSC_QUEUE_LENGTH, sizeof(Sample_t));
+    regularQueue = xQueueCreate(SPSC_QUEUE_LENGTH, sizeof(Sample_t));
+    configASSERT(spscQueue != NULL);
+    configASSERT(regularQueue != NULL);
+
+    xTaskCreate(vSpscConsumerTask, "SpscRx", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 2, NULL);
+    xTaskCreate(vQueueConsumerTask, "QueueRx", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 2, NULL);
+    xTaskCreate(vMonitorTask, "Monitor", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 1, NULL);
+
+    printf("\t\033[1;45m[*] SPSC QUEUE [*]\033[0m\n");
+    printf("  \033[95m%d\033[0m samples per tick into queues of \033[1m%d\033[0m items, for \033[1m%u\033[0m ticks\n",
+           SAMPLES_PER_TICK, SPSC_QUEUE_LENGTH, (unsigned) SPSC_RUN_TIME);
+
+    vTaskStartScheduler();
+    return 0;
+}
+
+#else
+
+void vSpscTickHook(void) {
+}
+
+int main_spsc(void) {
+    printf("\033[91mThe SPSC queue demo requires configUSE_SPSC_QUEUES set to 1\033[0m\n");
+    return 0;
+}
+
+#endif /* configUSE_SPSC_QUEUES */
@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+/*
+ * Stack Resource Policy demo.
+ *
+ * Three periodic tasks: High and Low share a buffer, Medium does not use it.
+ * The run has two phases.  In the first the buffer is protected by a mutex:
+ * when High blocks on the mutex held by Low, Medium has a shorter period than
+ * Low and runs first, so High waits for Low's critical section plus the whole
+ * of Medium's job and misses its deadline.  In the second phase the buffer is
+ * an SRP resource: while Low holds it neither High nor Medium can start, so
+ * High waits for at most one critical section of Low.
+ *
+ * Requires configUSE_STACK_RESOURCE_POLICY and INCLUDE_vTaskEndJob set to 1.
+ */
+
+#if ( ( configUSE_STACK_RESOURCE_POLICY == 1 ) && ( INCLUDE_vTaskEndJob == 1 ) )
+
+#define PHASE_TIME          pdMS_TO_TICKS( 2400 )  // Two hyperperiods per phase
+#define NUM_PHASES          2
+
+#define HIGH_PERIOD         pdMS_TO_TICKS( 50 )
+#define HIGH_WCET           pdMS_TO_TICKS( 5 )    // All of it inside the critical section
+#define MEDIUM_PERIOD       pdMS_TO_TICKS( 120 )
+#define MEDIUM_WCET         pdMS_TO_TICKS( 40 )
+#define LOW_PERIOD          pdMS_TO_TICKS( 400 )
+#define LOW_WCET            pdMS_TO_TICKS( 20 )   // Outside the critical section, before it
+#define LOW_CS              pdMS_TO_TICKS( 30 )   // Inside the critical section
+
+typedef struct {
+    const char *name;
+    TickType_t worstResponse;
+    UBaseType_t misses;
+} PhaseResult_t;
+
+static PhaseResult_t results[NUM_PHASES] = {
+    {"MUTEX", 0, 0},
+    {"SRP",   0, 0},
+};
+
+static volatile int phase = 0;
+static SemaphoreHandle_t xBufferMutex;
+static ResourceHandle_t xBufferResource;
+static TaskHandle_t xHighTask, xMediumTask, xLowTask;
+static volatile uint32_t sharedBuffer = 0;
+
+/* Spin until the calling task has been running for xTicks ticks.  A jump of
+ * more than one tick means the task was preempted, so only single steps count. */
+static void prvBusyWork(TickType_t xTicks) {
+    TickType_t xLast = xTaskGetTickCount();
+    TickType_t xDone = 0;
+
+    while (xDone < xTicks) {
+        TickType_t xNow = xTaskGetTickCount();
+        if (xNow != xLast) {
+            if ((TickType_t) (xNow - xLast) == 1) {
+                xDone++;
+            }
+            xLast = xNow;
+        }
+    }
+}
+
+/* Run xTicks of work on the shared buffer, protected as the current phase requires. */
+static void prvCriticalSection(int jobPhase, TickType_t xTicks) {
+    if (jobPhase == 0) {
+        xSemaphoreTake(xBufferMutex, portMAX_DELAY);
+    } else {
+        vTaskResourceTake(xBufferResource);
+    }
+
+    sharedBuffer++;
+    prvBusyWork(xTicks);
+
+    if (jobPhase == 0) {
+        xSemaphoreGive(xBufferMutex);
+    } else {
+        vTaskResourceGive(xBufferResource);
+    }
+}
+
+static void vHighTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    for (;;) {
+        int jobPhase = phase;
+        TaskJobStatus_t status;
+
+        prvCriticalSection(jobPhase, HIGH_WCET);
+
+        vTaskGetJobStatus(NULL, &status);
+        TickType_t xResponse = xTaskGetTickCount() - status.xReleaseTime;
+        if (xResponse > results[jobPhase].worstResponse) {
+            results[jobPhase].worstResponse = xResponse;
+        }
+        vTaskEndJob();
+    }
+}
+
+static void vMediumTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    for (;;) {
+        prvBusyWork(MEDIUM_WCET);
+        vTaskEndJob();
+    }
+}
+
+static void vLowTask(void *pvParameters) {
+    ( void ) pvParameters;
+
+    for (;;) {
+        int jobPhase = phase;
+
+        prvBusyWork(LOW_WCET);
+        prvCriticalSection(jobPhase, LOW_CS);
+        vTaskEndJob();
+    }
+}
+
+/* Not a periodic task, so it only runs while no job is ready. */
+static void vMonitorTask(void *pvParameters) {
+    ( void ) pvParameters;
+    UBaseType_t missesBefore = 0;
+
+    for (int p = 0; p < NUM_PHASES; p++) {
+        TaskJobStatus_t status;
+
+        vTaskDelay(PHASE_TIME);
+        vTaskGetJobStatus(xHighTask, &status);
+        results[p].misses = status.uxDeadlineMisses - missesBefore;
+        missesBefore = status.uxDeadlineMisses;
+        phase = p + 1;
+    }
+
+    printf("\n\t\033[1;45m[*] HIGH TASK DATA [*]\033[0m\n");
+    printf("  +---------+-------------------+--------+\n");
+    printf("  | Policy  | Worst response(ms)| Misses |\n");
+    printf("  +---------+-------------------+--------+\n");
+    for (int p = 0; p < NUM_PHASES; p++) {
+        printf("  | %-7s | %-17u | \033[1;%dm%-6u\033[0m |\n", results[p].name,
+               (unsigned) (results[p].worstResponse * portTICK_PERIOD_MS),
+               (results[p].misses == 0) ? 92 : 91,
+               (unsigned) results[p].misses);
+    }
+    printf("  +---------+-------------------+--------+\n");
+    printf("  \033[95mCRITICAL SECTIONS = \033[1m%u\033[0m\n", (unsigned) sharedBuffer);
+
+    vTaskEndScheduler();
+}
+
+int main_srp(void) {
+    xBufferMutex = xSemaphoreCreateMutex();
+    xBufferResource = xTaskResourceCreate();
+
+    xTaskCreatePeriodic(vHighTask, "High", configMINIMAL_STACK_SIZE * 2, NULL, tskIDLE_PRIORITY + 2,
+                        HIGH_PERIOD, HIGH_WCET, &xHighTask);
+    xTaskCreatePeriodic(vMediumTask, "Medium", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2,
+                        MEDIUM_PERIOD, MEDIUM_WCET, &xMediumTask);
+    xTaskCreatePeriodic(vLowTask, "Low", configMINIMAL_STACK_SIZE, NULL, tskIDLE_PRIORITY + 2,
+                        LOW_PERIOD, LOW_WCET + LOW_CS, &xLowTask);
+    xTaskCreate(vMonitorTask, "Monitor", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 1, NULL);
+
+    // The ceiling of the buffer is the level of High, its most urgent user.
+    vTaskResourceAddUser(xBufferResource, xHighTask);
+    vTaskResourceAddUser(xBufferResource, xLowTask);
+
+    printf("\t\033[1;45m[*] STACK RESOURCE POLICY [*]\033[0m\n");
+    printf("  \033[95mHigh\033[0m:   period \033[1m%ums\033[0m, critical section \033[1m%ums\033[0m\n",
+           (unsigned) (HIGH_PERIOD * portTICK_PERIOD_MS), (unsigned) (HIGH_WCET * portTICK_PERIOD_MS));
+    printf("  \033[95mMedium\033[0m: period \033[1m%ums\033[0m, execution \033[1m%ums\033[0m\n",
+           (unsigned) (MEDIUM_PERIOD * portTICK_PERIOD_MS), (unsigned) (MEDIUM_WCET * portTICK_PERIOD_MS));
+    printf("  \033[95mLow\033[0m:    period \033[1m%ums\033[0m, execution \033[1m%ums\033[0m + critical section \033[1m%ums\033[0m\n",
+           (unsigned) (LOW_PERIOD * portTICK_PERIOD_MS), (unsigned) (LOW_WCET * portTICK_PERIOD_MS),
+           (unsigned) (LOW_CS * portTICK_PERIOD_MS));
+
+    vTaskStartScheduler();
+    return 0;
+}
+
+#else
+
+int main_srp(void) {
+    printf("\033[91mThe SRP demo requires configUSE_STACK_RESOURCE_POLICY and INCLUDE_vTaskEndJob set to 1\033[0m\n");
+    return 0;
+}
+
+#endif /* configUSE_STACK_RESOURCE_POLICY */
@@ -0,0 +1,169 @@
+#include <stdio.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+/*
+ * Software timer benchmark.
+ *
+ * Measures how long xTimerReset() takes while a growing number of other timers
+ * are active.  The timer service task has a higher priority than the benchmark
+ * task, so the command is processed before xTimerReset() returns and the time
+ * includes queueing the command and inserting the timer.
+ *
+ * The reset timer has the longest period of all, so with the default sorted
+ * list its insertion walks every active timer; with configUSE_TIMER_WHEEL set
+ * to 1 it is linked into a slot of the wheel whatever the number of timers.
+ *
+ * A probe timer reloads every PROBE_PERIOD ticks throughout, and counts the
+ * callbacks that run on another tick than the one they were due on.
+ */
+
+#define BENCH_ROUNDS        200   // Samples per measurement
+#define BENCH_STEPS         4
+#define PROBE_PERIOD        3
+
+#if defined( __ARM_ARCH_7M__ )
+
+#define BENCH_MAX_TIMERS    256   // Largest set of active timers, bounded by configTOTAL_HEAP_SIZE
+
+/* SysTick counts core clock cycles down from its reload value. */
+#define SYSTICK_LOAD    ( * ( ( volatile uint32_t * ) 0xE000E014UL ) )
+#define SYSTICK_VAL     ( * ( ( volatile uint32_t * ) 0xE000E018UL ) )
+#define TIMER_UNIT      "cycles"
+
+static uint32_t prvTimerRead(void) {
+    return SYSTICK_VAL;
+}
+
+static uint32_t prvTimerElapsed(uint32_t start, uint32_t end) {
+    uint32_t reload = SYSTICK_LOAD + 1UL;
+    return (start >= end) ? (start - end) : (start + reload - end);
+}
+
+#else
+
+#include <time.h>
+#define BENCH_MAX_TIMERS    4096  // Largest set of active timers
+#define TIMER_UNIT      "ns"
+
+static uint32_t prvTimerRead(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t) ((uint64_t) now.tv_sec * 1000000000ULL + (uint64_t) now.tv_nsec);
+}
+
+static uint32_t prvTimerElapsed(uint32_t start, uint32_t end) {
+    return end - start;
+}
+
+#endif
+
+static const int timerSetSizes[BENCH_STEPS] = {
+    BENCH_MAX_TIMERS / 256, BENCH_MAX_TIMERS / 16, BENCH_MAX_TIMERS / 4, BENCH_MAX_TIMERS
+};
+
+typedef struct {
+    uint32_t worst;
+    uint32_t total;
+} BenchResult_t;
+
+static TimerHandle_t xTailTimer = NULL;
+static TickType_t xProbeDue = 0;
+static volatile uint32_t probeRuns = 0;
+static volatile uint32_t probeLate = 0;
+
+/* The filler timers never expire while the benchmark runs. */
+static void vFillerCallback(TimerHandle_t xTimer) {
+    ( void ) xTimer;
+}
+
+static void vProbeCallback(TimerHandle_t xTimer) {
+    TickType_t xNow = xTaskGetTickCount();
+    ( void ) xTimer;
+
+    if (probeRuns > 0 && xNow != xProbeDue) {
+        probeLate++;
+    }
+    xProbeDue = xNow + PROBE_PERIOD;
+    probeRuns++;
+}
+
+/* Reset the tail timer BENCH_ROUNDS times.  Samples that a tick interrupt
+ * landed in are taken again. */
+static void prvMeasure(BenchResult_t *result) {
+    result->worst = 0;
+    result->total = 0;
+
+    for (int i = 0; i < BENCH_ROUNDS; i++) {
+        TickType_t xTick;
+        uint32_t start, elapsed;
+
+        for (;;) {
+            xTick = xTaskGetTickCount();
+            start = prvTimerRead();
+            xTimerReset(xTailTimer, portMAX_DELAY);
+            elapsed = prvTimerElapsed(start, prvTimerRead());
+
+            if (xTaskGetTickCount() == xTick) {
+                break;
+            }
+        }
+
+        result->total += elapsed;
+        if (elapsed > result->worst) {
+            result->worst = elapsed;
+        }
+    }
+}
+
+static void vBenchTask(void *pvParameters) {
+    ( void ) pvParameters;
+    int created = 0;
+
+    printf("  +---------------+-------------------+-------------+\n");
+    printf("  | Active timers | Reset worst/avg   | Probe late  |\n");
+    printf("  +---------------+-------------------+-------------+\n");
+
+    for (int step = 0; step < BENCH_STEPS; step++) {
+        BenchResult_t reset;
+
+        // Grow the set of active timers.  The periods all end before the tail's.
+        while (created < timerSetSizes[step]) {
+            TimerHandle_t xTimer = xTimerCreate("Filler", 100000 + created * 7, pdFALSE, NULL, vFillerCallback);
+            if (xTimer == NULL || xTimerStart(xTimer, portMAX_DELAY) != pdPASS) {
+                printf("\033[91mCould not start filler timer %d\033[0m\n", created);
+                vTaskEndScheduler();
+            }
+            created++;
+        }
+
+        probeLate = 0;
+        prvMeasure(&reset);
+
+        printf("  | %-13d | %7u / %-7u | \033[1;%dm%-11u\033[0m |\n", created,
+               (unsigned) reset.worst, (unsigned) (reset.total / BENCH_ROUNDS),
+               (probeLate == 0) ? 92 : 91, (unsigned) probeLate);
+    }
+
+    printf("  +---------------+-------------------+-------------+\n");
+    printf("  Times in %s, probe timer ran %u times\n", TIMER_UNIT, (unsigned) probeRuns);
+    vTaskEndScheduler();
+}
+
+int main_timer_bench(void) {
+    TimerHandle_t xProbe = xTimerCreate("Probe", PROBE_PERIOD, pdTRUE, NULL, vProbeCallback);
+
+    xTailTimer = xTimerCreate("Tail", 200000, pdFALSE, NULL, vFillerCallback);
+    xTimerStart(xTailTimer, 0);
+    xTimerStart(xProbe, 0);
+
+    // Below the timer service task, so every command is processed on the spot.
+    xTaskCreate(vBenchTask, "Bench", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 1, NULL);
+
+    printf("\t\033[1;45m[*] SOFTWARE TIMER BENCHMARK [*]\033[0m\n");
+    printf("  \033[95mACTIVE TIMERS = \033[1m%s\033[0m\n", (configUSE_TIMER_WHEEL == 1) ? "timer wheel" : "sorted list");
+
+    vTaskStartScheduler();
+    return 0;
+}
@@ -0,0 +1,680 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+/*
+ * Workload replay demo.
+ *
+ * Runs a task set described by a list of arrivals: each entry has an arrival
+ * time, an execution time, a relative deadline and a period.  An entry with a
+ * period is a periodic task created at its arrival time, an entry without one
+ * is a single aperiodic job.  The list is either generated from a fixed seed
+ * (Poisson arrivals, or bursty arrivals that switch between a fast and a slow
+ * rate) on top of two periodic tasks, or, in the host build, read from a CSV or
+ * binary trace written by tools/workloadGen.py.  The same seed or trace always
+ * gives the same load, so builds with different schedulers (RM, EDF, with or
+ * without the aperiodic server) can be compared job by job.
+ *
+ * The entries are sorted by arrival time and released by one dispatcher, a
+ * periodic task with a period of one tick, instead of one software timer per
+ * arrival.  Every job records its release and completion time, and a table
+ * with one row per job (trace entry and job number of the entry) is printed
+ * at the end, followed by a summary.  The run
+ * ends once every job released has passed its deadline.
+ *
+ * With configUSE_TASK_POOL the aperiodic jobs are created from a pool of
+ * WORKLOAD_MAX_PENDING TCB and stack slots allocated before the run, so a
+ * release does not allocate and the heap stays flat however bursty the
+ * arrivals are.
+ *
+ * With configUSE_APERIODIC_JOBS the aperiodic entries are not tasks at all:
+ * each arrival is an AperiodicJob_t submitted to WORKLOAD_JOB_WORKERS workers
+ * created before the run, and waits in the kernel's deadline ordered job
+ * queue while they are busy.  Build with -DWORKLOAD_JOB_WORKERS=0 to go back
+ * to one task per arrival.  Each job checks the priority it runs at: with
+ * configUSE_APERIODIC_BUDGET and tskAPERIODIC_OVERRUN_DEMOTE a job that overruns
+ * ends at the idle priority, and the next job of the same worker must start at
+ * WORKLOAD_WORKER_PRIORITY again.
+ *
+ * The deadline of a periodic entry is its period.  On the MPS2 target set
+ * uartTX_FULL_POLICY to uartTX_FULL_BLOCK to keep the whole table.
+ *
+ * Requires INCLUDE_vTaskEndJob.
+ */
+
+#if ( INCLUDE_vTaskEndJob == 1 )
+
+#define WORKLOAD_MAX_ENTRIES    2048                  // Entries of a trace
+#define WORKLOAD_MAX_RESULTS    4096                  // Jobs recorded
+#define WORKLOAD_DISPATCH_PERIOD    1                 // Granularity of the arrivals, in ticks
+#define WORKLOAD_DISPATCH_WCET      1
+
+/* Aperiodic jobs released and not yet completed.  Past it the arrivals are
+ * dropped, which keeps the job stacks in the heap and the server queue below
+ * configREADY_HEAP_LENGTH. */
+#define WORKLOAD_MAX_PENDING    32
+
+/* Generated load: the arrival rate and the execution times give an aperiodic
+ * utilisation of 0.125, on top of 0.45 for the periodic tasks. */
+#ifndef WORKLOAD_SEED
+#define WORKLOAD_SEED           12345
+#endif
+#define WORKLOAD_JOBS           1000                  // Generated aperiodic arrivals
+#define WORKLOAD_MEAN_GAP       40                    // Mean ticks between two arrivals
+#define WORKLOAD_WCET_MIN       2
+#define WORKLOAD_WCET_MAX       8
+#define WORKLOAD_DEADLINE_MIN   10                    // Relative deadline, in multiples of the WCET
+#define WORKLOAD_DEADLINE_MAX   50
+
+/* Bursty arrivals: bursts and quiet spells of WORKLOAD_BURST_LENGTH arrivals on
+ * average, with a mean gap of WORKLOAD_BURST_GAP ticks inside a burst.  The
+ * quiet gap keeps the mean rate of the Poisson load. */
+#define WORKLOAD_BURST_GAP      2
+#define WORKLOAD_BURST_LENGTH   8                     // Mean arrivals in a burst
+#define WORKLOAD_QUIET_GAP      ((WORKLOAD_MEAN_GAP * 2) - WORKLOAD_BURST_GAP)
+
+/* Aperiodic server, when configUSE_APERIODIC_SERVER is 1. */
+#define SERVER_CAPACITY         pdMS_TO_TICKS( 40 )
+#define SERVER_PERIOD           pdMS_TO_TICKS( 200 )
+#ifndef WORKLOAD_SERVER_POLICY
+#define WORKLOAD_SERVER_POLICY  eServerPolling
+#endif
+
+/* One arrival of the trace, in ticks. */
+typedef struct {
+    TickType_t arrival;   // Relative to the start of the run
+    TickType_t wcet;      // Execution time of a job
+    TickType_t deadline;  // Relative deadline
+    TickType_t period;    // 0 for an aperiodic job
+} WorkloadEntry_t;
+
+typedef enum {
+    JOB_RELEASED = 0,
+    JOB_DONE,
+    JOB_REJECTED,         // Not admitted, or could not be created
+    JOB_DROPPED           // Over WORKLOAD_MAX_PENDING
+} JobState_t;
+
+typedef struct {
+    uint16_t entry;          // Index of the trace entry
+    uint16_t job;            // Job number of the entry, from 1
+    uint8_t state;           // JobState_t
+    TickType_t releasedAt;   // Absolute release time
+    TickType_t finishedAt;   // Absolute completion time, valid in JOB_DONE
+} JobResult_t;
+
+typedef struct {
+    unsigned jobs, done, missed, rejected, dropped;
+    TickType_t totalResponse, worstResponse;
+} ClassSummary_t;
+
+static WorkloadEntry_t trace[WORKLOAD_MAX_ENTRIES];
+static JobResult_t results[WORKLOAD_MAX_RESULTS];
+static int entryCount = 0;
+static int resultCount = 0;
+static unsigned lostResults = 0;
+static volatile int pendingJobs = 0;
+
+static const char *workloadSource = "poisson";
+static uint32_t workloadSeed = WORKLOAD_SEED;
+static int generatedTrace = 0;
+
+#if ( configUSE_TASK_POOL == 1 )
+static TaskPoolHandle_t jobPool = NULL;
+static unsigned poolMisses = 0;      // Jobs created from the heap as the pool was empty
+#endif
+
+#if ( configUSE_APERIODIC_JOBS == 1 )
+#ifndef WORKLOAD_JOB_WORKERS
+#define WORKLOAD_JOB_WORKERS    4
+#endif
+#define WORKLOAD_WORKER_PRIORITY    (tskIDLE_PRIORITY + 1)
+/* One job object per pending arrival.  An object is free until it is
+ * submitted, and again once the kernel has marked it done. */
+static AperiodicJob_t jobs[WORKLOAD_MAX_PENDING];
+static unsigned demotedJobs = 0;     // Jobs that ended below WORKLOAD_WORKER_PRIORITY
+static unsigned lowStarts = 0;       // Jobs that started below it
+#endif
+static int jobWorkers = 0;           // Job workers created, 0 to create a task per arrival
+
+static TickType_t startTime;
+static TickType_t lastArrival = 0;   // Jobs released after it are not recorded
+static TickType_t endTime;           // Every recorded job is past its deadline
+
+void vWorkloadSetSource(const char *source) {
+    workloadSource = source;
+}
+
+void vWorkloadSetSeed(uint32_t seed) {
+    workloadSeed = seed;
+}
+
+/* xorshift32, so the generated load is the same on every build. */
+static uint32_t prvRandom(void) {
+    workloadSeed ^= workloadSeed << 13;
+    workloadSeed ^= workloadSeed >> 17;
+    workloadSeed ^= workloadSeed << 5;
+    return workloadSeed;
+}
+
+static uint32_t prvRandomRange(uint32_t min, uint32_t max) {
+    return min + (prvRandom() % (max - min + 1));
+}
+
+/* Ticks to the next arrival of a Poisson process with a mean gap of meanGap:
+ * an arrival in each tick with probability 1 / meanGap. */
+static TickType_t prvGeometric(uint32_t meanGap) {
+    TickType_t gap = 1;
+    while ((prvRandom() % meanGap) != 0) {
+        gap++;
+    }
+    return gap;
+}
+
+static int prvAddEntry(TickType_t arrival, TickType_t wcet, TickType_t deadline, TickType_t period) {
+    if (entryCount >= WORKLOAD_MAX_ENTRIES) {
+        return 0;
+    }
+    trace[entryCount].arrival = arrival;
+    trace[entryCount].wcet = (wcet > 0) ? wcet : 1;
+    trace[entryCount].deadline = (period != 0) ? period : deadline;
+    trace[entryCount].period = period;
+    entryCount++;
+    return 1;
+}
+
+static void prvGenerate(int bursty) {
+    TickType_t arrival = 0;
+    int inBurst = 0;
+
+    // Periodic load: utilisation 25/100 + 50/250 = 0.45.
+    prvAddEntry(0, pdMS_TO_TICKS( 25 ), 0, pdMS_TO_TICKS( 100 ));
+    prvAddEntry(0, pdMS_TO_TICKS( 50 ), 0, pdMS_TO_TICKS( 250 ));
+
+    for (int i = 0; i < WORKLOAD_JOBS; i++) {
+        if (bursty) {
+            // Enter a burst once per WORKLOAD_BURST_LENGTH arrivals on average and leave it as often.
+            if ((prvRandom() % WORKLOAD_BURST_LENGTH) == 0) {
+                inBurst = !inBurst;
+            }
+            arrival += prvGeometric(inBurst ? WORKLOAD_BURST_GAP : WORKLOAD_QUIET_GAP);
+        } else {
+            arrival += prvGeometric(WORKLOAD_MEAN_GAP);
+        }
+
+        TickType_t wcet = prvRandomRange(WORKLOAD_WCET_MIN, WORKLOAD_WCET_MAX);
+        TickType_t deadline = wcet * prvRandomRange(WORKLOAD_DEADLINE_MIN, WORKLOAD_DEADLINE_MAX);
+        prvAddEntry(arrival, wcet, deadline, 0);
+    }
+}
+
+#if !defined( __ARM_ARCH_7M__ )
+
+/* Binary trace: "WKLD", a version and an entry count, then four words per
+ * entry (arrival, WCET, deadline, period in ms), all little endian. */
+#define WORKLOAD_TRACE_MAGIC    "WKLD"
+#define WORKLOAD_TRACE_VERSION  1
+
+static int prvReadWord(FILE *file, uint32_t *word) {
+    uint8_t bytes[4];
+    if (fread(bytes, 1, sizeof(bytes), file) != sizeof(bytes)) {
+        return 0;
+    }
+    *word = (uint32_t) bytes[0] | ((uint32_t) bytes[1] << 8) | ((uint32_t) bytes[2] << 16) | ((uint32_t) bytes[3] << 24);
+    return 1;
+}
+
+static int prvLoadBinary(FILE *file) {
+    uint32_t version, count, words[4];
+
+    if (!prvReadWord(file, &version) || !prvReadWord(file, &count) || version != WORKLOAD_TRACE_VERSION) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        for (int w = 0; w < 4; w++) {
+            if (!prvReadWord(file, &words[w])) {
+                return 0;
+            }
+        }
+        if (!prvAddEntry(pdMS_TO_TICKS( words[0] ), pdMS_TO_TICKS( words[1] ), pdMS_TO_TICKS( words[2] ), pdMS_TO_TICKS( words[3] ))) {
+            break;
+        }
+    }
+    return 1;
+}
+
+/* CSV trace: "arrival,wcet,deadline,period" in ms per line.  Lines that do not
+ * start with a digit (the header, comments) are skipped. */
+static int prvLoadCsv(FILE *file) {
+    char line[128];
+    unsigned long arrival, wcet, deadline, period;
+
+    while (fgets(line, sizeof(line), file) != NULL) {
+        if (line[0] < '0' || line[0] > '9') {
+            continue;
+        }
+        if (sscanf(line, "%lu,%lu,%lu,%lu", &arrival, &wcet, &deadline, &period) != 4) {
+            return 0;
+        }
+        if (!prvAddEntry(pdMS_TO_TICKS( arrival ), pdMS_TO_TICKS( wcet ), pdMS_TO_TICKS( deadline ), pdMS_TO_TICKS( period ))) {
+            break;
+        }
+    }
+    return 1;
+}
+
+static int prvLoadTrace(const char *path) {
+    char magic[4];
+    int loaded;
+    FILE *file = fopen(path, "rb");
+
+    if (file == NULL) {
+        return 0;
+    }
+    if (fread(magic, 1, sizeof(magic), file) == sizeof(magic) && memcmp(magic, WORKLOAD_TRACE_MAGIC, sizeof(magic)) == 0) {
+        loaded = prvLoadBinary(file);
+    } else {
+        rewind(file);
+        loaded = prvLoadCsv(file);
+    }
+    fclose(file);
+    return loaded;
+}
+
+#endif /* __ARM_ARCH_7M__ */
+
+static int prvBuildTrace(void) {
+    generatedTrace = 1;
+    if (strcmp(workloadSource, "poisson") == 0) {
+        prvGenerate(0);
+    } else if (strcmp(workloadSource, "bursty") == 0) {
+        prvGenerate(1);
+    } else {
+        generatedTrace = 0;
+#if !defined( __ARM_ARCH_7M__ )
+        if (!prvLoadTrace(workloadSource)) {
+            return 0;
+        }
+#else
+        return 0;
+#endif
+    }
+
+    // Stable insertion sort by arrival, the dispatcher walks the list in order.
+    for (int i = 1; i < entryCount; i++) {
+        WorkloadEntry_t entry = trace[i];
+        int j = i - 1;
+        while (j >= 0 && trace[j].arrival > entry.arrival) {
+            trace[j + 1] = trace[j];
+            j--;
+        }
+        trace[j + 1] = entry;
+    }
+    return entryCount > 0;
+}
+
+/* Spin until the calling task has run in xTicks ticks.  Unlike the other demos
+ * a jump of more than one tick still counts once: the dispatcher takes the start
+ * of every tick, and jobs sharing a priority are time sliced, so a job may
+ * never see two ticks in a row. */
+static void prvBusyWork(TickType_t xTicks) {
+    TickType_t xLast = xTaskGetTickCount();
+    TickType_t xDone = 0;
+
+    while (xDone < xTicks) {
+        TickType_t xNow = xTaskGetTickCount();
+        if (xNow != xLast) {
+            xDone++;
+            xLast = xNow;
+        }
+    }
+}
+
+/* Take the next result slot, NULL once the table is full. */
+static JobResult_t *prvNewResult(int entry, UBaseType_t job, TickType_t releasedAt, JobState_t state) {
+    JobResult_t *result = NULL;
+
+    taskENTER_CRITICAL();
+    if (resultCount < WORKLOAD_MAX_RESULTS) {
+        result = &results[resultCount++];
+    } else {
+        lostResults++;
+    }
+    taskEXIT_CRITICAL();
+
+    if (result != NULL) {
+        result->entry = (uint16_t) entry;
+        result->job = (uint16_t) job;
+        result->state = (uint8_t) state;
+        result->releasedAt = releasedAt;
+        result->finishedAt = 0;
+    }
+    return result;
+}
+
+static void vPeriodicTask(void *pvParameters) {
+    const WorkloadEntry_t *entry = (const WorkloadEntry_t *)pvParameters;
+    UBaseType_t job = 0;
+
+    for (;;) {
+        TaskJobStatus_t status;
+        JobResult_t *result = NULL;
+
+        vTaskGetJobStatus(NULL, &status);
+        job++;
+        if ((TickType_t) (status.xReleaseTime - startTime) <= lastArrival) {
+            result = prvNewResult(entry - trace, job, status.xReleaseTime, JOB_RELEASED);
+        }
+
+        prvBusyWork(entry->wcet);
+
+        if (result != NULL) {
+            result->finishedAt = xTaskGetTickCount();
+            result->state = JOB_DONE;
+        }
+        vTaskEndJob();
+    }
+}
+
+static void vJobTask(void *pvParameters) {
+    JobResult_t *result = (JobResult_t *)pvParameters;
+
+    prvBusyWork(trace[result->entry].wcet);
+    result->finishedAt = xTaskGetTickCount();
+    result->state = JOB_DONE;
+
+    taskENTER_CRITICAL();
+    pendingJobs--;
+    taskEXIT_CRITICAL();
+
+    vTaskDelete(NULL);
+}
+
+#if ( configUSE_APERIODIC_JOBS == 1 )
+static void vJobRun(void *pvParameters) {
+    JobResult_t *result = (JobResult_t *)pvParameters;
+    UBaseType_t startPriority = uxTaskPriorityGet(NULL);
+
+    prvBusyWork(trace[result->entry].wcet);
+    result->finishedAt = xTaskGetTickCount();
+    result->state = JOB_DONE;
+
+    taskENTER_CRITICAL();
+    pendingJobs--;
+    lowStarts += (startPriority < WORKLOAD_WORKER_PRIORITY);
+    demotedJobs += (uxTaskPriorityGet(NULL) < WORKLOAD_WORKER_PRIORITY);
+    taskEXIT_CRITICAL();
+}
+
+/* Fewer than WORKLOAD_MAX_PENDING jobs are pending, so there is a free object.
+ * Only the dispatcher submits, and the kernel never hands an object back to
+ * eJobIdle, so nothing can take it between the scan and the submission. */
+static BaseType_t prvSubmitJob(JobResult_t *result, const WorkloadEntry_t *entry) {
+    for (int i = 0; i < WORKLOAD_MAX_PENDING; i++) {
+        AperiodicJob_t *job = &jobs[i];
+        if (job->eState == eJobIdle || job->eState == eJobDone) {
+            job->pxJobCode = vJobRun;
+            job->pvParameters = result;
+            job->xDuration = entry->wcet;
+            job->xDeadline = entry->deadline;
+            return xTaskSubmitJob(job);
+        }
+    }
+    return errQUEUE_FULL;
+}
+#endif
+
+/* From the pool when there is one.  A job that has counted itself out of
+ * pendingJobs may not have deleted itself yet, so the pool can be empty below
+ * WORKLOAD_MAX_PENDING jobs, and the heap is used then. */
+static BaseType_t prvCreateJob(JobResult_t *result, const WorkloadEntry_t *entry) {
+#if ( configUSE_APERIODIC_JOBS == 1 )
+    if (jobWorkers > 0) {
+        return prvSubmitJob(result, entry);
+    }
+#endif
+#if ( configUSE_TASK_POOL == 1 )
+    if (jobPool != NULL) {
+        BaseType_t created = xTaskCreateAperiodicFromPool(jobPool, vJobTask, "Job", result, tskIDLE_PRIORITY + 1,
+                                                          entry->wcet, entry->deadline, NULL);
+        if (created != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY) {
+            return created;
+        }
+        poolMisses++;
+    }
+#endif
+    return xTaskCreateAperiodic(vJobTask, "Job", configMINIMAL_STACK_SIZE, result,
+                                tskIDLE_PRIORITY + 1, entry->wcet, entry->deadline, NULL);
+}
+
+static void prvRelease(int index) {
+    const WorkloadEntry_t *entry = &trace[index];
+    TickType_t releasedAt = startTime + entry->arrival;
+
+    if (entry->period != 0) {
+        if (xTaskCreatePeriodic(vPeriodicTask, "Periodic", configMINIMAL_STACK_SIZE, (void *) entry,
+                                tskIDLE_PRIORITY + 2, entry->period, entry->wcet, NULL) != pdPASS) {
+            prvNewResult(index, 1, releasedAt, JOB_REJECTED);
+        }
+        return;
+    }
+
+    if (pendingJobs >= WORKLOAD_MAX_PENDING) {
+        prvNewResult(index, 1, releasedAt, JOB_DROPPED);
+        return;
+    }
+
+    JobResult_t *result = prvNewResult(index, 1, releasedAt, JOB_RELEASED);
+    if (result == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    pendingJobs++;
+    taskEXIT_CRITICAL();
+
+    if (prvCreateJob(result, entry) != pdPASS) {
+        // Turned away by the admission test (configUSE_ADMISSION_CONTROL), out of memory or a full job queue.
+        result->state = JOB_REJECTED;
+        taskENTER_CRITICAL();
+        pendingJobs--;
+        taskEXIT_CRITICAL();
+    }
+}
+
+static void prvSummarise(ClassSummary_t *summary, const JobResult_t *result, TickType_t deadline) {
+    summary->jobs++;
+    if (result->state == JOB_REJECTED) {
+        summary->rejected++;
+    } else if (result->state == JOB_DROPPED) {
+        summary->dropped++;
+    } else if (result->state == JOB_DONE) {
+        TickType_t response = result->finishedAt - result->releasedAt;
+        summary->done++;
+        summary->totalResponse += response;
+        if (response > summary->worstResponse) {
+            summary->worstResponse = response;
+        }
+        if (response > deadline) {
+            summary->missed++;
+        }
+    } else {
+        // Still queued or running at the end, so past its deadline.
+        summary->missed++;
+    }
+}
+
+static void prvPrintSummary(const char *name, const ClassSummary_t *summary) {
+    printf("  | %-9s | %-5u | %-5u | %-6u | %-8u | %-7u | %-13u | %-13u |\n", name,
+           summary->jobs, summary->done, summary->missed, summary->rejected, summary->dropped,
+           (unsigned) (((summary->done > 0) ? summary->totalResponse / summary->done : 0) * portTICK_PERIOD_MS),
+           (unsigned) (summary->worstResponse * portTICK_PERIOD_MS));
+}
+
+static void prvPrintResults(void) {
+    static const char *states[] = { "UNFINISHED", "ok", "REJECTED", "DROPPED" };
+    ClassSummary_t periodic = { 0 }, aperiodic = { 0 };
+    int count = resultCount;
+
+    printf("\n\t\033[1;45m[*] WORKLOAD JOBS [*]\033[0m\n");
+    printf("  +-------+-------+------+-------------+-------------+---------------+---------------+------------+\n");
+    printf("  | Entry | Job   | Kind | Release(ms) | Finish (ms) | Response (ms) | Lateness (ms) | Status     |\n");
+    printf("  +-------+-------+------+-------------+-------------+---------------+---------------+------------+\n");
+    for (int i = 0; i < count; i++) {
+        const JobResult_t *result = &results[i];
+        const WorkloadEntry_t *entry = &trace[result->entry];
+        int isPeriodic = (entry->period != 0);
+        const char *state = states[result->state];
+
+        prvSummarise(isPeriodic ? &periodic : &aperiodic, result, entry->deadline);
+
+        if (result->state == JOB_DONE) {
+            TickType_t response = result->finishedAt - result->releasedAt;
+            int lateness = (int) response - (int) entry->deadline;
+            if (lateness > 0) {
+                state = "MISS";
+            }
+            printf("  | %-5u | %-5u | %-4s | %-11u | %-11u | %-13u | %-13d | %-10s |\n",
+                   (unsigned) result->entry, (unsigned) result->job, isPeriodic ? "P" : "A",
+                   (unsigned) ((result->releasedAt - startTime) * portTICK_PERIOD_MS),
+                   (unsigned) ((result->finishedAt - startTime) * portTICK_PERIOD_MS),
+                   (unsigned) (response * portTICK_PERIOD_MS),
+                   lateness * (int) portTICK_PERIOD_MS, state);
+        } else {
+            printf("  | %-5u | %-5u | %-4s | %-11u | %-11s | %-13s | %-13s | %-10s |\n",
+                   (unsigned) result->entry, (unsigned) result->job, isPeriodic ? "P" : "A",
+                   (unsigned) ((result->releasedAt - startTime) * portTICK_PERIOD_MS),
+                   "-", "-", "-", state);
+        }
+    }
+    printf("  +-------+-------+------+-------------+-------------+---------------+---------------+------------+\n");
+
+    printf("\n\t\033[1;45m[*] WORKLOAD SUMMARY [*]\033[0m\n");
+    printf("  +-----------+-------+-------+--------+----------+---------+---------------+---------------+\n");
+    printf("  | Class     | Jobs  | Done  | Missed | Rejected | Dropped | Avg Resp (ms) | Max Resp (ms) |\n");
+    printf("  +-----------+-------+-------+--------+----------+---------+---------------+---------------+\n");
+    prvPrintSummary("PERIODIC", &periodic);
+    prvPrintSummary("APERIODIC", &aperiodic);
+    printf("  +-----------+-------+-------+--------+----------+---------+---------------+---------------+\n");
+    if (lostResults > 0) {
+        printf("\033[91m%u jobs not recorded, WORKLOAD_MAX_RESULTS is too small\033[0m\n", lostResults);
+    }
+#if ( configUSE_TASK_POOL == 1 )
+    if (poolMisses > 0) {
+        printf("\033[93m%u jobs created from the heap, the job pool was empty\033[0m\n", poolMisses);
+    }
+#endif
+#if ( configUSE_APERIODIC_JOBS == 1 )
+    if (demotedJobs > 0) {
+        printf("\033[93m%u jobs demoted by an overrun\033[0m, \033[%dm%u jobs started below the worker priority\033[0m\n",
+               demotedJobs, (lowStarts == 0) ? 92 : 91, lowStarts);
+    }
+#endif
+}
+
+/* Periodic task with the shortest period, so it runs first in every tick and
+ * releases each entry at its arrival time. */
+static void vDispatchTask(void *pvParameters) {
+    ( void ) pvParameters;
+    int nextEntry = 0;
+
+    startTime = xTaskGetTickCount();
+
+    for (;;) {
+        TickType_t xNow = xTaskGetTickCount() - startTime;
+
+        while ((nextEntry < entryCount) && (trace[nextEntry].arrival <= xNow)) {
+            prvRelease(nextEntry++);
+        }
+
+        if (xNow >= endTime) {
+            printf("\033[95m[ WORKLOAD ]\033[0m\tRun ended @ \033[1;90m[%ums]\033[0m\n", (unsigned) (xNow * portTICK_PERIOD_MS));
+            prvPrintResults();
+            vTaskEndScheduler();
+        }
+
+        vTaskEndJob();
+    }
+}
+
+int main_workload(void) {
+    TickType_t maxDeadline = 0;
+    unsigned periodicEntries = 0;
+    uint32_t seed = workloadSeed;
+
+    if (!prvBuildTrace()) {
+        printf("\033[91mCould not load the workload %s\033[0m\n", workloadSource);
+        return 0;
+    }
+
+    for (int i = 0; i < entryCount; i++) {
+        if (trace[i].deadline > maxDeadline) {
+            maxDeadline = trace[i].deadline;
+        }
+        periodicEntries += (trace[i].period != 0);
+    }
+    lastArrival = trace[entryCount - 1].arrival;
+    endTime = lastArrival + maxDeadline + 1;
+
+#if ( configUSE_APERIODIC_SERVER == 1 )
+    xTaskServerCreate(WORKLOAD_SERVER_POLICY, SERVER_CAPACITY, SERVER_PERIOD);
+#endif
+#if ( configUSE_APERIODIC_JOBS == 1 )
+    if (WORKLOAD_JOB_WORKERS > 0 && xTaskCreateJobWorkers(WORKLOAD_JOB_WORKERS, configMINIMAL_STACK_SIZE, WORKLOAD_WORKER_PRIORITY) == pdPASS) {
+        jobWorkers = WORKLOAD_JOB_WORKERS;
+    }
+#endif
+#if ( configUSE_TASK_POOL == 1 )
+    if (jobWorkers == 0) {
+        jobPool = xTaskPoolCreate(WORKLOAD_MAX_PENDING, configMINIMAL_STACK_SIZE);
+    }
+#endif
+    xTaskCreatePeriodic(vDispatchTask, "Dispatch", configMINIMAL_STACK_SIZE * 4, NULL, tskIDLE_PRIORITY + 2,
+                        WORKLOAD_DISPATCH_PERIOD, WORKLOAD_DISPATCH_WCET, NULL);
+
+    printf("\t\033[1;45m[*] WORKLOAD REPLAY [*]\033[0m\n");
+    printf("  \033[95mSOURCE       = \033[1m%s\033[0m\n", workloadSource);
+    if (generatedTrace) {
+        printf("  \033[95mSEED         = \033[1m%u\033[0m\n", (unsigned) seed);
+    }
+    printf("  \033[95mENTRIES      = \033[1m%d\033[0m (%u periodic)\n", entryCount, periodicEntries);
+    printf("  \033[95mLAST ARRIVAL = \033[1m%ums\033[0m\n", (unsigned) (lastArrival * portTICK_PERIOD_MS));
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    printf("  \033[95mSCHEDULER    = \033[1mEDF\033[0m\n");
+#elif ( configUSE_APERIODIC_SERVER == 1 )
+    printf("  \033[95mSCHEDULER    = \033[1mRM, aperiodic server\033[0m\n");
+#else
+    printf("  \033[95mSCHEDULER    = \033[1mRM\033[0m\n");
+#endif
+    if (jobWorkers > 0) {
+        printf("  \033[95mJOB WORKERS  = \033[1m%d\033[0m\n", jobWorkers);
+    }
+#if ( configUSE_TASK_POOL == 1 )
+    else {
+        printf("  \033[95mJOB POOL     = \033[1m%s\033[0m\n", (jobPool != NULL) ? "preallocated" : "heap (pool allocation failed)");
+    }
+#endif
+    printf("\n");
+
+    vTaskStartScheduler();
+    return 0;
+}
+
+#else
+
+void vWorkloadSetSource(const char *source) {
+    ( void ) source;
+}
+
+void vWorkloadSetSeed(uint32_t seed) {
+    ( void ) seed;
+}
+
+int main_workload(void) {
+    printf("\033[91mThe workload demo requires INCLUDE_vTaskEndJob set to 1\033[0m\n");
+    return 0;
+}
+
+#endif /* INCLUDE_vTaskEndJob */
@@ -0,0 +1,628 @@
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Demo includes. */
+#include "hrTimer.h"
+
+#define hrTICK_US				( 1000000UL / configTICK_RATE_HZ )
+
+#if defined( __ARM_ARCH_7M__ )
+
+	/* Library includes. */
+	#include "SMM_MPS2.h"
+
+	#define hrCOUNTS_PER_US		( configCPU_CLOCK_HZ / 1000000UL )
+
+	/* Both timers count down from 32 bits at the core clock.  Timer 1 runs free
+	and wraps, timer 2 stops after one count down. */
+	#define hrFREE_RUNNING_CTRL	( CMSDK_DUALTIMER1_CTRL_EN_Msk | CMSDK_DUALTIMER1_CTRL_SIZE_Msk | CMSDK_DUALTIMER1_CTRL_INTEN_Msk )
+	#define hrONE_SHOT_CTRL		( CMSDK_DUALTIMER2_CTRL_EN_Msk | CMSDK_DUALTIMER2_CTRL_SIZE_Msk | CMSDK_DUALTIMER2_CTRL_INTEN_Msk | CMSDK_DUALTIMER2_CTRL_ONESHOOT_Msk )
+
+	/* Below the kernel's limit so the callbacks can use the FromISR API, and
+	above the UART and the interrupt queue test so releases are not delayed by
+	them. */
+	#define hrINTERRUPT_PRIORITY	( configMAX_SYSCALL_INTERRUPT_PRIORITY )
+
+#else
+
+	#include <time.h>
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+
+/* A task created by xHRTaskCreatePeriodic(). */
+typedef struct
+{
+	TaskHandle_t xTask;
+	uint32_t ulPeriodUs;
+	uint32_t ulDeadlineUs;
+	uint64_t ullFirstReleaseUs;		/* Time of the first timed release. */
+	BaseType_t xTimed;				/* pdTRUE once the timed releases have started. */
+	HRTimer_t xReleaseTimer;
+	HRTimer_t xDeadlineTimer;
+	volatile UBaseType_t uxReleased;	/* Timed jobs released, written by the interrupt. */
+	volatile UBaseType_t uxCompleted;	/* Timed jobs completed. */
+	UBaseType_t uxStarted;				/* Timed jobs started, only used by the task. */
+	HRTaskStatus_t xStatus;
+} HRPeriodicTask_t;
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Time in microseconds.  Called with interrupts masked on the target.
+ */
+static uint64_t prvGetTimeUs( void );
+
+/*
+ * Program the hardware for the expiry of the first pending timer, if any.
+ * Called with interrupts masked.
+ */
+static void prvProgramNextExpiry( void );
+
+/*
+ * Call the callbacks of the timers that have expired, then program the next
+ * expiry.  Called with interrupts masked.
+ */
+static void prvFireExpired( BaseType_t *pxHigherPriorityTaskWoken );
+
+/*
+ * Add pxTimer to, or take it out of, the pending timers.  Called with
+ * interrupts masked.
+ */
+static void prvStart( HRTimer_t *pxTimer, uint64_t ullExpiryUs, HRTimerCallback_t pxCallback, void *pvContext );
+static void prvStop( HRTimer_t *pxTimer );
+
+#if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+
+	/*
+	 * Timer callbacks of the xHRTaskCreatePeriodic() tasks.
+	 */
+	static void prvReleaseCallback( HRTimer_t *pxTimer, BaseType_t *pxHigherPriorityTaskWoken );
+	static void prvDeadlineCallback( HRTimer_t *pxTimer, BaseType_t *pxHigherPriorityTaskWoken );
+
+	/*
+	 * The entry of xTask, NULL for the calling task, in xPeriodicTasks.
+	 */
+	static HRPeriodicTask_t *prvGetPeriodicTask( TaskHandle_t xTask );
+
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Pending timers, earliest expiry first. */
+static HRTimer_t *pxPendingTimers = NULL;
+
+#if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+	static HRPeriodicTask_t xPeriodicTasks[ hrMAX_PERIODIC_TASKS ];
+#endif
+
+#if defined( __ARM_ARCH_7M__ )
+	/* Times timer 1 has wrapped, the upper half of the 64 bit count. */
+	static volatile uint32_t ulWraps = 0;
+#elif ( configUSE_VIRTUAL_TIME == 1 )
+	/* Ticks counted by vHRTimerTickHook(), which runs before the tick count is
+	incremented when the scheduler is suspended. */
+	static volatile TickType_t xHookTicks = 0;
+#else
+	static uint64_t ullStartTimeUs = 0;
+#endif
+
+/*-----------------------------------------------------------*/
+
+void vHRTimerInit( void )
+{
+	#if defined( __ARM_ARCH_7M__ )
+	{
+		CMSDK_DUALTIMER1->TimerControl = 0;
+		CMSDK_DUALTIMER1->TimerIntClr = 1;
+		CMSDK_DUALTIMER1->TimerLoad = 0xFFFFFFFFUL;
+		CMSDK_DUALTIMER1->TimerControl = hrFREE_RUNNING_CTRL;
+
+		CMSDK_DUALTIMER2->TimerControl = 0;
+		CMSDK_DUALTIMER2->TimerIntClr = 1;
+
+		NVIC_SetPriority( DUALTIMER_IRQn, hrINTERRUPT_PRIORITY );
+		NVIC_EnableIRQ( DUALTIMER_IRQn );
+	}
+	#elif ( configUSE_VIRTUAL_TIME == 0 )
+	{
+		ullStartTimeUs = prvGetTimeUs();
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullHRTimerGetTimeUs( void )
+{
+uint64_t ullTime;
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		ullTime = prvGetTimeUs();
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return ullTime;
+}
+/*-----------------------------------------------------------*/
+
+void vHRTimerStart( HRTimer_t *pxTimer, uint64_t ullExpiryUs, HRTimerCallback_t pxCallback, void *pvContext )
+{
+	taskENTER_CRITICAL();
+	{
+		prvStart( pxTimer, ullExpiryUs, pxCallback, pvContext );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vHRTimerStartFromISR( HRTimer_t *pxTimer, uint64_t ullExpiryUs, HRTimerCallback_t pxCallback, void *pvContext )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		prvStart( pxTimer, ullExpiryUs, pxCallback, pvContext );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void vHRTimerStop( HRTimer_t *pxTimer )
+{
+	taskENTER_CRITICAL();
+	{
+		prvStop( pxTimer );
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vHRTimerStopFromISR( HRTimer_t *pxTimer )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		prvStop( pxTimer );
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullHRTimerLimitIdleTicks( uint64_t ullExpectedIdleTicks )
+{
+uint64_t ullNow, ullTicks;
+
+	/* Called by the idle task. */
+	taskENTER_CRITICAL();
+	{
+		if( pxPendingTimers != NULL )
+		{
+			ullNow = prvGetTimeUs();
+
+			/* Wake up on the last tick before the expiry, so the tick count is
+			up to date when the timer fires, and in the host build so the tick
+			that fires it is not stepped over. */
+			if( pxPendingTimers->ullExpiryUs > ullNow )
+			{
+				ullTicks = ( pxPendingTimers->ullExpiryUs - ullNow - 1U ) / hrTICK_US;
+			}
+			else
+			{
+				ullTicks = 0;
+			}
+
+			if( ullTicks < ullExpectedIdleTicks )
+			{
+				ullExpectedIdleTicks = ullTicks;
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return ullExpectedIdleTicks;
+}
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+
+BaseType_t xHRTaskCreatePeriodic( TaskFunction_t pxTaskCode,
+								  const char * const pcName,
+								  const configSTACK_DEPTH_TYPE usStackDepth,
+								  void * const pvParameters,
+								  UBaseType_t uxPriority,
+								  uint32_t ulPeriodUs,
+								  uint32_t ulDeadlineUs,
+								  uint32_t ulDurationUs,
+								  TaskHandle_t * const pxCreatedTask )
+{
+HRPeriodicTask_t *pxEntry = NULL;
+UBaseType_t uxIndex;
+BaseType_t xReturn;
+
+	configASSERT( ulPeriodUs > 0 );
+	configASSERT( ( ulDeadlineUs > 0 ) && ( ulDeadlineUs <= ulPeriodUs ) );
+
+	taskENTER_CRITICAL();
+	{
+		for( uxIndex = 0; uxIndex < hrMAX_PERIODIC_TASKS; uxIndex++ )
+		{
+			if( xPeriodicTasks[ uxIndex ].ulPeriodUs == 0 )
+			{
+				pxEntry = &xPeriodicTasks[ uxIndex ];
+				pxEntry->ulPeriodUs = ulPeriodUs;
+				break;
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	if( pxEntry == NULL )
+	{
+		return errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+	}
+
+	pxEntry->ulDeadlineUs = ulDeadlineUs;
+	pxEntry->xReleaseTimer.pvContext = pxEntry;
+	pxEntry->xDeadlineTimer.pvContext = pxEntry;
+
+	/* The handle is stored in the entry before the task can run, as its first
+	job may end before xTaskCreatePeriodic() returns. */
+	xReturn = xTaskCreatePeriodic( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority,
+								   ( TickType_t ) ( ( ulPeriodUs + hrTICK_US - 1UL ) / hrTICK_US ),
+								   ( TickType_t ) ( ( ulDurationUs + hrTICK_US - 1UL ) / hrTICK_US ),
+								   &( pxEntry->xTask ) );
+
+	if( xReturn != pdPASS )
+	{
+		pxEntry->xTask = NULL;
+		pxEntry->ulPeriodUs = 0;
+	}
+	else if( pxCreatedTask != NULL )
+	{
+		*pxCreatedTask = pxEntry->xTask;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vHRTaskEndJob( void )
+{
+HRPeriodicTask_t *pxEntry = prvGetPeriodicTask( NULL );
+uint64_t ullNow = ullHRTimerGetTimeUs();
+uint64_t ullRelease;
+uint32_t ulTime;
+
+	configASSERT( pxEntry );
+
+	if( pxEntry->xTimed == pdFALSE )
+	{
+		/* The first job, released by the kernel, has ended.  Start the timed
+		releases at the next multiple of the period. */
+		pxEntry->xTimed = pdTRUE;
+		pxEntry->ullFirstReleaseUs = ( ( ullNow / pxEntry->ulPeriodUs ) + 1U ) * pxEntry->ulPeriodUs;
+		vHRTimerStart( &( pxEntry->xReleaseTimer ), pxEntry->ullFirstReleaseUs, prvReleaseCallback, pxEntry );
+	}
+	else
+	{
+		ullRelease = pxEntry->ullFirstReleaseUs + ( uint64_t ) ( pxEntry->uxStarted - 1U ) * pxEntry->ulPeriodUs;
+		ulTime = ( uint32_t ) ( ullNow - ullRelease );
+
+		taskENTER_CRITICAL();
+		{
+			( pxEntry->uxCompleted )++;
+			( pxEntry->xStatus.uxJobs )++;
+
+			if( ulTime > pxEntry->xStatus.ulWorstResponseUs )
+			{
+				pxEntry->xStatus.ulWorstResponseUs = ulTime;
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+
+	vTaskWaitForRelease();
+
+	/* The timed releases are strictly periodic, so the release time of the
+	job follows from its number. */
+	ullNow = ullHRTimerGetTimeUs();
+	ullRelease = pxEntry->ullFirstReleaseUs + ( uint64_t ) pxEntry->uxStarted * pxEntry->ulPeriodUs;
+	( pxEntry->uxStarted )++;
+	ulTime = ( uint32_t ) ( ullNow - ullRelease );
+
+	taskENTER_CRITICAL();
+	{
+		if( ulTime > pxEntry->xStatus.ulWorstJitterUs )
+		{
+			pxEntry->xStatus.ulWorstJitterUs = ulTime;
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vHRTaskGetStatus( TaskHandle_t xTask, HRTaskStatus_t *pxStatus )
+{
+HRPeriodicTask_t *pxEntry = prvGetPeriodicTask( xTask );
+
+	configASSERT( pxEntry );
+
+	taskENTER_CRITICAL();
+	{
+		*pxStatus = pxEntry->xStatus;
+	}
+	taskEXIT_CRITICAL();
+}
+
+#endif /* INCLUDE_xTaskReleaseJobFromISR */
+/*-----------------------------------------------------------*/
+
+#if defined( __ARM_ARCH_7M__ )
+
+	void DUALTIMER_Handler( void )
+	{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	UBaseType_t uxSavedInterruptStatus;
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( CMSDK_DUALTIMER1->TimerMIS != 0 )
+			{
+				CMSDK_DUALTIMER1->TimerIntClr = 1;
+				ulWraps++;
+			}
+
+			if( CMSDK_DUALTIMER2->TimerMIS != 0 )
+			{
+				CMSDK_DUALTIMER2->TimerIntClr = 1;
+			}
+
+			prvFireExpired( &xHigherPriorityTaskWoken );
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+	}
+
+#else
+
+	void vHRTimerTickHook( void )
+	{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+		#if ( configUSE_VIRTUAL_TIME == 1 )
+		{
+			/* While the scheduler is suspended the tick is only pended, and
+			counted in the tick count when the scheduler resumes. */
+			if( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED )
+			{
+				xHookTicks = ( ( xHookTicks > xTaskGetTickCountFromISR() ) ? xHookTicks : xTaskGetTickCountFromISR() ) + 1U;
+			}
+			else
+			{
+				xHookTicks = xTaskGetTickCountFromISR();
+			}
+		}
+		#endif
+
+		/* The tick interrupt is masked already, and the kernel switches task
+		at the end of the tick if a release asks for it. */
+		prvFireExpired( &xHigherPriorityTaskWoken );
+	}
+
+#endif /* __ARM_ARCH_7M__ */
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeUs( void )
+{
+	#if defined( __ARM_ARCH_7M__ )
+	{
+	uint32_t ulHigh = ulWraps;
+	uint32_t ulLow = CMSDK_DUALTIMER1->TimerValue;
+
+		if( CMSDK_DUALTIMER1->TimerRIS != 0 )
+		{
+			/* Timer 1 has wrapped and the interrupt has not counted it yet.
+			Read it again in case it wrapped after the first read. */
+			ulLow = CMSDK_DUALTIMER1->TimerValue;
+			ulHigh++;
+		}
+
+		/* The timer counts down. */
+		return ( ( ( uint64_t ) ulHigh << 32 ) | ( uint64_t ) ( 0xFFFFFFFFUL - ulLow ) ) / hrCOUNTS_PER_US;
+	}
+	#elif ( configUSE_VIRTUAL_TIME == 1 )
+	{
+	const TickType_t xTicks = xTaskGetTickCountFromISR();
+
+		/* A tick takes no fixed host time, so there is nothing finer.  The
+		tick count is ahead of xHookTicks once pended ticks are processed, or
+		after tickless idle. */
+		return ( uint64_t ) ( ( xHookTicks > xTicks ) ? xHookTicks : xTicks ) * hrTICK_US;
+	}
+	#else
+	{
+	struct timespec xNow;
+
+		clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+		return ( uint64_t ) xNow.tv_sec * 1000000ULL + ( uint64_t ) xNow.tv_nsec / 1000ULL - ullStartTimeUs;
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvProgramNextExpiry( void )
+{
+	#if defined( __ARM_ARCH_7M__ )
+	{
+	uint64_t ullNow, ullCounts = 1;
+
+		CMSDK_DUALTIMER2->TimerControl = 0;
+		CMSDK_DUALTIMER2->TimerIntClr = 1;
+
+		if( pxPendingTimers != NULL )
+		{
+			ullNow = prvGetTimeUs();
+
+			if( pxPendingTimers->ullExpiryUs > ullNow )
+			{
+				ullCounts = ( pxPendingTimers->ullExpiryUs - ullNow ) * hrCOUNTS_PER_US;
+			}
+
+			/* Further away than timer 2 can count: it fires early, finds
+			nothing expired and is programmed again. */
+			if( ullCounts > 0xFFFFFFFFULL )
+			{
+				ullCounts = 0xFFFFFFFFULL;
+			}
+
+			CMSDK_DUALTIMER2->TimerLoad = ( uint32_t ) ullCounts;
+			CMSDK_DUALTIMER2->TimerControl = hrONE_SHOT_CTRL;
+		}
+	}
+	#else
+	{
+		/* vHRTimerTickHook() looks at the pending timers on every tick. */
+	}
+	#endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvFireExpired( BaseType_t *pxHigherPriorityTaskWoken )
+{
+const uint64_t ullNow = prvGetTimeUs();
+HRTimer_t *pxTimer;
+
+	/* A timer a callback starts again at a time already passed fires again in
+	this loop, so a periodic timer catches up with the releases it is late
+	for. */
+	while( ( pxPendingTimers != NULL ) && ( pxPendingTimers->ullExpiryUs <= ullNow ) )
+	{
+		pxTimer = pxPendingTimers;
+		pxPendingTimers = pxTimer->pxNext;
+		pxTimer->xPending = pdFALSE;
+
+		pxTimer->pxCallback( pxTimer, pxHigherPriorityTaskWoken );
+	}
+
+	prvProgramNextExpiry();
+}
+/*-----------------------------------------------------------*/
+
+static void prvStart( HRTimer_t *pxTimer, uint64_t ullExpiryUs, HRTimerCallback_t pxCallback, void *pvContext )
+{
+HRTimer_t **ppxLink = &pxPendingTimers;
+
+	prvStop( pxTimer );
+
+	pxTimer->ullExpiryUs = ullExpiryUs;
+	pxTimer->pxCallback = pxCallback;
+	pxTimer->pvContext = pvContext;
+	pxTimer->xPending = pdTRUE;
+
+	/* After the timers due at the same time, so they fire in the order they
+	were started. */
+	while( ( *ppxLink != NULL ) && ( ( *ppxLink )->ullExpiryUs <= ullExpiryUs ) )
+	{
+		ppxLink = &( ( *ppxLink )->pxNext );
+	}
+
+	pxTimer->pxNext = *ppxLink;
+	*ppxLink = pxTimer;
+
+	if( pxPendingTimers == pxTimer )
+	{
+		prvProgramNextExpiry();
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvStop( HRTimer_t *pxTimer )
+{
+HRTimer_t **ppxLink = &pxPendingTimers;
+
+	if( pxTimer->xPending != pdFALSE )
+	{
+		while( *ppxLink != pxTimer )
+		{
+			ppxLink = &( ( *ppxLink )->pxNext );
+		}
+
+		*ppxLink = pxTimer->pxNext;
+		pxTimer->xPending = pdFALSE;
+
+		/* Timer 2 may be left programmed for the stopped timer, in which case
+		it fires and finds nothing expired. */
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+
+static void prvReleaseCallback( HRTimer_t *pxTimer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+HRPeriodicTask_t *pxEntry = ( HRPeriodicTask_t * ) pxTimer->pvContext;
+const uint64_t ullRelease = pxTimer->ullExpiryUs;
+
+	( pxEntry->uxReleased )++;
+
+	/* The deadline is started first so that, when it equals the period, it
+	fires before the next release. */
+	prvStart( &( pxEntry->xDeadlineTimer ), ullRelease + pxEntry->ulDeadlineUs, prvDeadlineCallback, pxEntry );
+	prvStart( pxTimer, ullRelease + pxEntry->ulPeriodUs, prvReleaseCallback, pxEntry );
+
+	if( xTaskReleaseJobFromISR( pxEntry->xTask, pxHigherPriorityTaskWoken ) == pdFALSE )
+	{
+		/* The previous job still runs, the task starts this one as soon as it
+		ends. */
+		( pxEntry->xStatus.uxLateReleases )++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeadlineCallback( HRTimer_t *pxTimer, BaseType_t *pxHigherPriorityTaskWoken )
+{
+HRPeriodicTask_t *pxEntry = ( HRPeriodicTask_t * ) pxTimer->pvContext;
+
+	( void ) pxHigherPriorityTaskWoken;
+
+	/* Jobs complete in order, so only the last one released can be due. */
+	if( pxEntry->uxCompleted < pxEntry->uxReleased )
+	{
+		( pxEntry->xStatus.uxDeadlineMisses )++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static HRPeriodicTask_t *prvGetPeriodicTask( TaskHandle_t xTask )
+{
+UBaseType_t uxIndex;
+
+	if( xTask == NULL )
+	{
+		xTask = xTaskGetCurrentTaskHandle();
+	}
+
+	for( uxIndex = 0; uxIndex < hrMAX_PERIODIC_TASKS; uxIndex++ )
+	{
+		if( xPeriodicTasks[ uxIndex ].xTask == xTask )
+		{
+			return &xPeriodicTasks[ uxIndex ];
+		}
+	}
+
+	return NULL;
+}
+
+#endif /* INCLUDE_xTaskReleaseJobFromISR */
+/*-----------------------------------------------------------*/
@@ -0,0 +1,109 @@
+#ifndef HR_TIMER_H
+#define HR_TIMER_H
+
+#include <stdint.h>
+
+/* Can be overridden in FreeRTOSConfig.h. */
+#ifndef hrMAX_PERIODIC_TASKS
+	#define hrMAX_PERIODIC_TASKS	4
+#endif
+
+/*
+ * High resolution one-shot timers, in microseconds, and periodic tasks
+ * released by them.
+ *
+ * On the MPS2 board timer 1 of the CMSDK dual timer runs free at the core
+ * clock and is extended to 64 bits by its wrap interrupt, and timer 2 is
+ * programmed as a one-shot for the earliest pending expiry, so the tick rate
+ * does not limit the resolution.  In the host build time is the tick count in
+ * virtual time, and the host clock otherwise, and expired timers are fired from
+ * the tick hook, so only the target is finer than a tick.
+ *
+ * Callbacks run in the timer interrupt and may only use the FromISR API.
+ */
+
+struct HRTimer;
+
+typedef void ( *HRTimerCallback_t )( struct HRTimer *pxTimer, BaseType_t *pxHigherPriorityTaskWoken );
+
+typedef struct HRTimer
+{
+	uint64_t ullExpiryUs;			/* Time the callback is due at. */
+	HRTimerCallback_t pxCallback;
+	void *pvContext;				/* Free for the owner of the timer. */
+	struct HRTimer *pxNext;			/* Next pending timer, in expiry order. */
+	BaseType_t xPending;
+} HRTimer_t;
+
+/* Results of xHRTaskCreatePeriodic() tasks, in microseconds. */
+typedef struct
+{
+	UBaseType_t uxJobs;				/* Jobs completed. */
+	UBaseType_t uxDeadlineMisses;	/* Jobs not completed when their deadline timer fired. */
+	UBaseType_t uxLateReleases;		/* Releases that came while the previous job still ran. */
+	uint32_t ulWorstJitterUs;		/* Longest time from a release to the start of the job. */
+	uint32_t ulWorstResponseUs;		/* Longest time from a release to the end of the job. */
+} HRTaskStatus_t;
+
+/* Start the time base.  Call once, before the scheduler starts. */
+void vHRTimerInit( void );
+
+/* Microseconds since vHRTimerInit(). */
+uint64_t ullHRTimerGetTimeUs( void );
+
+/*
+ * Call pxCallback, with pvContext in pxTimer->pvContext, at ullExpiryUs, or as
+ * soon as possible if that time has passed.  A pending timer is moved to the
+ * new expiry time.  The FromISR versions are for the interrupts and for the
+ * timer callbacks.
+ */
+void vHRTimerStart( HRTimer_t *pxTimer, uint64_t ullExpiryUs, HRTimerCallback_t pxCallback, void *pvContext );
+void vHRTimerStartFromISR( HRTimer_t *pxTimer, uint64_t ullExpiryUs, HRTimerCallback_t pxCallback, void *pvContext );
+void vHRTimerStop( HRTimer_t *pxTimer );
+void vHRTimerStopFromISR( HRTimer_t *pxTimer );
+
+#if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+
+/*
+ * Create a periodic task whose jobs are released every ulPeriodUs by a high
+ * resolution timer, with a deadline ulDeadlineUs after each release, which
+ * must not be longer than the period.  Requires INCLUDE_xTaskReleaseJobFromISR.  The kernel orders the task, and checks
+ * its deadlines, by the period rounded up to whole ticks.
+ *
+ * The task ends each job with vHRTaskEndJob() in place of vTaskEndJob().  Its
+ * first job is released by the kernel when the task is created; the timed
+ * releases start at the first multiple of the period after that job ends, so
+ * the tasks created together share their release times.
+ */
+BaseType_t xHRTaskCreatePeriodic( TaskFunction_t pxTaskCode,
+								  const char * const pcName,
+								  const configSTACK_DEPTH_TYPE usStackDepth,
+								  void * const pvParameters,
+								  UBaseType_t uxPriority,
+								  uint32_t ulPeriodUs,
+								  uint32_t ulDeadlineUs,
+								  uint32_t ulDurationUs,
+								  TaskHandle_t * const pxCreatedTask );
+
+/* Complete the job of the calling task and wait for the next release. */
+void vHRTaskEndJob( void );
+
+/* Results of an xHRTaskCreatePeriodic() task, NULL for the calling task. */
+void vHRTaskGetStatus( TaskHandle_t xTask, HRTaskStatus_t *pxStatus );
+
+#endif /* INCLUDE_xTaskReleaseJobFromISR */
+
+#if defined( __ARM_ARCH_7M__ )
+	/* Installed in the vector table as the dual timer handler. */
+	void DUALTIMER_Handler( void );
+#else
+	/* Fires the expired timers.  Call from vApplicationTickHook(). */
+	void vHRTimerTickHook( void );
+#endif
+
+/* Limits the ticks tickless idle may sleep for so that the next timer fires
+on time.  Used by configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING(), declared
+again in FreeRTOSConfig.h for tasks.c. */
+uint64_t ullHRTimerLimitIdleTicks( uint64_t ullExpectedIdleTicks );
+
+#endif /* HR_TIMER_H */
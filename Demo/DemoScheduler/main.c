@@ -54,6 +54,9 @@
 #include <stdio.h>
 #include <string.h>
 
+/* Demo includes. */
+#include "uartDriver.h"
+
 /* This project provides two demo applications.  A simple blinky style demo
 application, and a more comprehensive test and demo application.  The
 mainCREATE_SIMPLE_BLINKY_DEMO_ONLY setting is used to select between the two.
@@ -66,14 +69,53 @@ demo application will be built.  The comprehensive test and demo application is
 implemented and described in main_full.c. */
 #define mainCREATE_SIMPLE_BLINKY_DEMO_ONLY	1
 
-/* printf() output uses the UART.  These constants define the addresses of the
-required UART registers. */
-#define UART0_ADDRESS 	( 0x40004000UL )
-#define UART0_DATA		( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 0UL ) ) ) )
-#define UART0_STATE		( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 4UL ) ) ) )
-#define UART0_CTRL		( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 8UL ) ) ) )
-#define UART0_BAUDDIV	( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 16UL ) ) ) )
-#define TX_BUFFER_MASK	( 1UL )
+/* When mainCREATE_SIMPLE_BLINKY_DEMO_ONLY is 1, mainSELECTED_DEMO picks the
+scheduler demo to run.  mainDEMO_SCHEDULER is the barber shop implemented in
+demoScheduler.c, mainDEMO_SERVER compares the aperiodic server policies and is
+implemented in demoServer.c, mainDEMO_READY_BENCH times the ready queue
+insertion and is implemented in demoReadyBench.c, mainDEMO_EDF runs a task set
+that only EDF can schedule and is implemented in demoEdf.c, mainDEMO_ADMISSION
+shows which tasks the admission test accepts and is implemented in
+demoAdmission.c, mainDEMO_SRP compares a mutex with a Stack Resource Policy
+resource and is implemented in demoSrp.c, mainDEMO_WORKLOAD replays a generated
+load of a thousand aperiodic jobs and prints the outcome of each and is
+implemented in demoWorkload.c, mainDEMO_SCHED_BENCH measures context switch,
+interrupt and release latency, tick and task creation costs against the number
+of ready tasks and is implemented in demoSchedBench.c, mainDEMO_HRTIMER releases
+a sub-tick control loop from the high resolution timer of hrTimer.c and is
+implemented in demoHRTimer.c, mainDEMO_SPSC compares the cost of sending from
+an interrupt to an SPSC queue and to a regular queue and is implemented in
+demoSpsc.c, mainDEMO_TIMER_BENCH times restarting a software timer among a
+growing number of active timers and is implemented in demoTimerBench.c,
+mainDEMO_ISR_TIMER compares the release latency of a timer whose callback runs
+in the tick interrupt with that of a timer service task callback and is
+implemented in demoIsrTimer.c. */
+#define mainDEMO_SCHEDULER		0
+#define mainDEMO_SERVER			1
+#define mainDEMO_READY_BENCH	2
+#define mainDEMO_EDF			3
+#define mainDEMO_ADMISSION		4
+#define mainDEMO_SRP			5
+#define mainDEMO_WORKLOAD		6
+#define mainDEMO_SCHED_BENCH	7
+#define mainDEMO_HRTIMER		8
+#define mainDEMO_SPSC			9
+#define mainDEMO_TIMER_BENCH	10
+#define mainDEMO_ISR_TIMER		11
+#define mainSELECTED_DEMO		mainDEMO_SCHEDULER
+
+/* Registers used by the scheduler statistics time base.  The DWT cycle counter
+is used when it runs, otherwise the cycle count is rebuilt from the tick count
+and the SysTick down counter (QEMU does not model the DWT). */
+#define DEMCR			( * ( ( volatile uint32_t * ) 0xE000EDFCUL ) )
+#define DEMCR_TRCENA	( 1UL << 24UL )
+#define DWT_CTRL		( * ( ( volatile uint32_t * ) 0xE0001000UL ) )
+#define DWT_CYCCNTENA	( 1UL << 0UL )
+#define DWT_CYCCNT		( * ( ( volatile uint32_t * ) 0xE0001004UL ) )
+#define SYSTICK_LOAD	( * ( ( volatile uint32_t * ) 0xE000E014UL ) )
+#define SYSTICK_VAL		( * ( ( volatile uint32_t * ) 0xE000E018UL ) )
+#define ICSR			( * ( ( volatile uint32_t * ) 0xE000ED04UL ) )
+#define ICSR_PENDSTSET	( 1UL << 26UL )
 
 /*
  * main_blinky() is used when mainCREATE_SIMPLE_BLINKY_DEMO_ONLY is set to 1.
@@ -81,6 +123,19 @@ required UART registers. */
  */
 extern void main_blinky( void );
 extern void main_scheduler( void );
+extern void main_server( void );
+extern void main_ready_bench( void );
+extern void main_edf( void );
+extern void main_admission( void );
+extern void main_srp( void );
+extern void main_workload( void );
+extern void main_sched_bench( void );
+extern void vSchedBenchTickHook( void );
+extern void main_hrtimer( void );
+extern void main_spsc( void );
+extern void main_timer_bench( void );
+extern void main_isr_timer( void );
+extern void vSpscTickHook( void );
 extern void main_full( void );
 
 /*
@@ -90,10 +145,8 @@ extern void main_full( void );
 void vFullDemoTickHookFunction( void );
 void vFullDemoIdleFunction( void );
 
-/*
- * Printf() output is sent to the serial port.  Initialise the serial hardware.
- */
-static void prvUARTInit( void );
+/* Set when the DWT cycle counter is found not to run. */
+static BaseType_t xUseSysTickForStats = pdFALSE;
 
 /*-----------------------------------------------------------*/
 
@@ -102,14 +155,63 @@ void main( void )
 	/* See https://www.freertos.org/freertos-on-qemu-mps2-an385-model.html for
 	instructions. */
 
-	/* Hardware initialisation.  printf() output uses the UART for IO. */
-	prvUARTInit();
+	/* Hardware initialisation.  printf() output uses the UART for IO, buffered
+	and sent from the UART TX interrupt once the scheduler is running. */
+	vUARTInit();
 
 	/* The mainCREATE_SIMPLE_BLINKY_DEMO_ONLY setting is described at the top
 	of this file. */
 	#if ( mainCREATE_SIMPLE_BLINKY_DEMO_ONLY == 1 )
 	{
-		main_scheduler();
+		#if ( mainSELECTED_DEMO == mainDEMO_SERVER )
+		{
+			main_server();
+		}
+		#elif ( mainSELECTED_DEMO == mainDEMO_READY_BENCH )
+		{
+			main_ready_bench();
+		}
+		#elif ( mainSELECTED_DEMO == mainDEMO_EDF )
+		{
+			main_edf();
+		}
+		#elif ( mainSELECTED_DEMO == mainDEMO_ADMISSION )
+		{
+			main_admission();
+		}
+		#elif ( mainSELECTED_DEMO == mainDEMO_SRP )
+		{
+			main_srp();
+		}
+		#elif ( mainSELECTED_DEMO == mainDEMO_WORKLOAD )
+		{
+			main_workload();
+		}
+		#elif ( mainSELECTED_DEMO == mainDEMO_SCHED_BENCH )
+		{
+			main_sched_bench();
+		}
+		#elif ( mainSELECTED_DEMO == mainDEMO_HRTIMER )
+		{
+			main_hrtimer();
+		}
+		#elif ( mainSELECTED_DEMO == mainDEMO_SPSC )
+		{
+			main_spsc();
+		}
+		#elif ( mainSELECTED_DEMO == mainDEMO_TIMER_BENCH )
+		{
+			main_timer_bench();
+		}
+		#elif ( mainSELECTED_DEMO == mainDEMO_ISR_TIMER )
+		{
+			main_isr_timer();
+		}
+		#else
+		{
+			main_scheduler();
+		}
+		#endif
 	}
 	#else
 	{
@@ -135,6 +237,7 @@ void vApplicationMallocFailedHook( void )
 	fragmented).  See http://www.freertos.org/a00111.html for more
 	information. */
 	printf( "\r\n\r\nMalloc failed\r\n" );
+	vUARTFlush();
 	portDISABLE_INTERRUPTS();
 	for( ;; );
 }
@@ -182,6 +285,14 @@ void vApplicationTickHook( void )
 
 		vFullDemoTickHookFunction();
 	}
+	#elif ( mainSELECTED_DEMO == mainDEMO_SCHED_BENCH )
+	{
+		vSchedBenchTickHook();
+	}
+	#elif ( mainSELECTED_DEMO == mainDEMO_SPSC )
+	{
+		vSpscTickHook();
+	}
 	#endif /* mainCREATE_SIMPLE_BLINKY_DEMO_ONLY */
 }
 /*-----------------------------------------------------------*/
@@ -203,6 +314,7 @@ volatile uint32_t ulSetToNonZeroInDebuggerToContinue = 0;
 	http://www.freertos.org/a00110.html#configASSERT for more information. */
 
 	printf( "ASSERT! Line %d, file %s\r\n", ( int ) ulLine, pcFileName );
+	vUARTFlush();
 
  	taskENTER_CRITICAL();
 	{
@@ -269,27 +381,62 @@ static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
 }
 /*-----------------------------------------------------------*/
 
-static void prvUARTInit( void )
+void vConfigureSchedulerStatsTimer( void )
 {
-	UART0_BAUDDIV = 16;
-	UART0_CTRL = 1;
+uint32_t ulStart;
+volatile uint32_t ulDelay;
+
+	DEMCR |= DEMCR_TRCENA;
+	DWT_CYCCNT = 0;
+	DWT_CTRL |= DWT_CYCCNTENA;
+
+	/* Reads as zero if the DWT is not implemented. */
+	ulStart = DWT_CYCCNT;
+	for( ulDelay = 0; ulDelay < 100; ulDelay++ );
+	xUseSysTickForStats = ( DWT_CYCCNT == ulStart ) ? pdTRUE : pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
-int __write( int iFile, char *pcString, int iStringLength )
+uint32_t ulGetSchedulerStatsTime( void )
 {
-	int iNextChar;
+uint32_t ulReload, ulValue, ulReturn;
+TickType_t xTicks;
+UBaseType_t uxSavedInterruptStatus;
 
-	/* Avoid compiler warnings about unused parameters. */
-	( void ) iFile;
+	if( xUseSysTickForStats == pdFALSE )
+	{
+		return DWT_CYCCNT;
+	}
 
-	/* Output the formatted string to the UART. */
-	for( iNextChar = 0; iNextChar < iStringLength; iNextChar++ )
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		while( ( UART0_STATE & TX_BUFFER_MASK ) != 0 );
-		UART0_DATA = *pcString;
-		pcString++;
+		ulReload = SYSTICK_LOAD + 1UL;
+		xTicks = xTaskGetTickCountFromISR();
+		ulValue = SYSTICK_VAL;
+
+		/* The counter has wrapped but the tick interrupt has not run yet. */
+		if( ( ICSR & ICSR_PENDSTSET ) != 0 )
+		{
+			xTicks++;
+			ulValue = SYSTICK_VAL;
+		}
+
+		ulReturn = ( uint32_t ) xTicks * ulReload + ( ulReload - 1UL - ulValue );
 	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return ulReturn;
+}
+/*-----------------------------------------------------------*/
+
+int __write( int iFile, char *pcString, int iStringLength )
+{
+	/* Avoid compiler warnings about unused parameters. */
+	( void ) iFile;
+
+	/* Queue the formatted string for the UART, what uartTX_FULL_DROP discards
+	still counts as written so the C library does not retry it. */
+	( void ) xUARTWrite( pcString, ( size_t ) iStringLength );
 
 	return iStringLength;
 }
@@ -303,6 +450,7 @@ void *malloc( size_t size )
 	library - but something is calling the C library malloc().  See
 	https://freertos.org/a00111.html for more information. */
 	printf( "\r\n\r\nUnexpected call to malloc() - should be usine pvPortMalloc()\r\n" );
+	vUARTFlush();
 	portDISABLE_INTERRUPTS();
 	for( ;; );
 
@@ -0,0 +1,87 @@
+#!/usr/bin/env python3
+"""
+Compare two runs of the scheduler benchmark (demoSchedBench.c).
+
+The benchmark prints one "BENCH,metric,ready_tasks,avg,worst,unit,polling_server"
+line per result.  Save the output of a run, change the scheduler, run it again
+and compare the two:
+
+    build/posix/output/RTOSBench > before.txt
+    build/posix/output/RTOSBench > after.txt
+    python3 benchCompare.py before.txt after.txt --threshold 10
+
+Every result found in both runs is printed with its change in percent, and the
+ones whose average grew by more than the threshold are marked.  The exit status
+is 1 when at least one result is marked, so the script can guard a regression
+check.  --worst applies the threshold to the worst case as well, which is much
+noisier in the host build.
+"""
+
+import argparse
+import sys
+
+FIELDS = ("metric", "ready_tasks", "avg", "worst", "unit", "polling_server")
+
+
+def load(path):
+    """Return the results of a run as {(metric, ready_tasks): row}."""
+    results = {}
+    with open(path, errors="replace") as f:
+        for line in f:
+            fields = line.strip().split(",")
+            if fields[0] != "BENCH" or len(fields) != len(FIELDS) + 1 or fields[1] == "metric":
+                continue
+            row = dict(zip(FIELDS, fields[1:]))
+            row["ready_tasks"] = int(row["ready_tasks"])
+            row["avg"] = int(row["avg"])
+            row["worst"] = int(row["worst"])
+            results[(row["metric"], row["ready_tasks"])] = row
+    if not results:
+        sys.exit("%s: no BENCH lines found" % path)
+    return results
+
+
+def change(before, after):
+    if before == 0:
+        return 0.0 if after == 0 else float("inf")
+    return 100.0 * (after - before) / before
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("before", help="output of the reference run")
+    parser.add_argument("after", help="output of the run to check")
+    parser.add_argument("-t", "--threshold", type=float, default=10.0,
+                        help="largest accepted increase in percent (default 10)")
+    parser.add_argument("--worst", action="store_true", help="check the worst case as well as the average")
+    args = parser.parse_args()
+
+    before = load(args.before)
+    after = load(args.after)
+
+    units = {row["unit"] for row in list(before.values()) + list(after.values())}
+    if len(units) > 1:
+        print("warning: the runs use different units (%s)" % ", ".join(sorted(units)), file=sys.stderr)
+
+    regressions = 0
+    print("%-18s %6s %12s %12s %8s %12s %12s %8s" %
+          ("metric", "ready", "avg before", "avg after", "change", "worst before", "worst after", "change"))
+    for key in sorted(before.keys() & after.keys()):
+        old, new = before[key], after[key]
+        avg_change = change(old["avg"], new["avg"])
+        worst_change = change(old["worst"], new["worst"])
+        regressed = avg_change > args.threshold or (args.worst and worst_change > args.threshold)
+        regressions += regressed
+        print("%-18s %6d %12d %12d %+7.1f%% %12d %12d %+7.1f%%%s" %
+              (key[0], key[1], old["avg"], new["avg"], avg_change,
+               old["worst"], new["worst"], worst_change, "  <-- regression" if regressed else ""))
+
+    for key in sorted(before.keys() ^ after.keys()):
+        print("%-18s %6d only in %s" % (key[0], key[1], args.before if key in before else args.after))
+
+    print("%d of %d results above +%.1f%%" % (regressions, len(before.keys() & after.keys()), args.threshold))
+    sys.exit(1 if regressions else 0)
+
+
+if __name__ == "__main__":
+    main()
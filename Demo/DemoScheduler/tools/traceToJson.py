@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""
+Convert the kernel trace buffer (configUSE_TRACE_BUFFER) into a Chrome / Perfetto
+JSON timeline.
+
+The input is either a dump of the buffer alone:
+
+    (gdb) dump binary value trace.bin xTraceBuffer
+
+or a dump of the whole RAM, in which the buffer is found from its magic number:
+
+    (qemu) pmemsave 0x20000000 0x400000 ram.bin
+
+Usage:
+
+    python3 traceToJson.py trace.bin -o trace.json
+
+and open trace.json in https://ui.perfetto.dev or chrome://tracing.  Every task
+gets its own track with a slice for each time it ran, jobs and scheduler events
+are instant events on the track of their task, and the server budget is a
+counter track.
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = 0x46425254
+VERSION = 1
+HEADER = struct.Struct("<8I")
+
+EVENT_SWITCHED_IN = 1
+EVENT_NAMES = {
+    2: "ready",
+    3: "create",
+    4: "delete",
+    5: "suspend",
+    6: "job released",
+    7: "job completed",
+    8: "deadline missed",
+    9: "server replenished",
+    10: "server exhausted",
+    11: "resource take",
+    12: "resource give",
+    13: "ceiling blocked",
+}
+EVENT_SERVER_REPLENISHED = 9
+
+
+def find_buffer(data):
+    """Return the offset of the first plausible trace buffer header in data."""
+    magic = struct.pack("<I", MAGIC)
+    offset = data.find(magic)
+    while offset >= 0:
+        if offset % 4 == 0 and offset + HEADER.size <= len(data):
+            _, version, length, max_tasks, name_length, _, _, _ = HEADER.unpack_from(data, offset)
+            if version == VERSION and length > 0 and (length & (length - 1)) == 0 and 0 < max_tasks <= 256 and 0 < name_length <= 64:
+                return offset
+        offset = data.find(magic, offset + 1)
+    raise ValueError("no trace buffer found in the input")
+
+
+def parse(data):
+    """Return (task names, counts per second, events in order)."""
+    offset = find_buffer(data)
+    _, _, length, max_tasks, name_length, counts_per_second, head, _ = HEADER.unpack_from(data, offset)
+
+    names_offset = offset + HEADER.size
+    names = {}
+    for i in range(max_tasks):
+        raw = data[names_offset + i * name_length:names_offset + (i + 1) * name_length]
+        name = raw.split(b"\0", 1)[0].decode("ascii", "replace")
+        if name:
+            names[i] = name
+
+    # The events are 64 bit words, aligned to 8 bytes.
+    events_offset = names_offset + max_tasks * name_length
+    events_offset += (-(events_offset - offset)) % 8
+    if events_offset + length * 8 > len(data):
+        raise ValueError("the input ends inside the trace buffer")
+
+    count = min(head, length)
+    events = []
+    epoch = 0
+    last = None
+    for n in range(head - count, head):
+        (word,) = struct.unpack_from("<Q", data, events_offset + (n % length) * 8)
+        stamp = word >> 32
+        # The timestamps are 32 bits wide and wrap.
+        if last is not None and stamp < last:
+            epoch += 1 << 32
+        last = stamp
+        events.append((epoch + stamp, (word >> 24) & 0xFF, (word >> 16) & 0xFF, word & 0xFFFF))
+
+    return names, max_tasks, counts_per_second, events
+
+
+def to_chrome(names, max_tasks, counts_per_second, events):
+    """Build the Chrome trace event list."""
+    if not events:
+        return []
+
+    origin = events[0][0]
+
+    def us(stamp):
+        return (stamp - origin) * 1e6 / counts_per_second
+
+    def task_name(task):
+        if task == 0:
+            return "kernel"
+        return names.get(task % max_tasks, "task %d" % task)
+
+    trace = []
+    tasks = set()
+    running = None
+
+    for stamp, event, task, argument in events:
+        tasks.add(task)
+        if event == EVENT_SWITCHED_IN:
+            if running is not None and running[1] != task:
+                trace.append({"name": task_name(running[1]), "ph": "X", "pid": 1, "tid": running[1],
+                              "ts": us(running[0]), "dur": us(stamp) - us(running[0])})
+            if running is None or running[1] != task:
+                running = (stamp, task)
+        elif event == EVENT_SERVER_REPLENISHED:
+            trace.append({"name": "server budget", "ph": "C", "pid": 1, "ts": us(stamp),
+                          "args": {"ticks": argument}})
+        else:
+            trace.append({"name": EVENT_NAMES.get(event, "event %d" % event), "ph": "i", "s": "t", "pid": 1,
+                          "tid": task, "ts": us(stamp), "args": {"argument": argument}})
+
+    if running is not None:
+        trace.append({"name": task_name(running[1]), "ph": "X", "pid": 1, "tid": running[1],
+                      "ts": us(running[0]), "dur": us(events[-1][0]) - us(running[0])})
+
+    trace.append({"name": "process_name", "ph": "M", "pid": 1, "args": {"name": "FreeRTOS"}})
+    for task in sorted(tasks):
+        trace.append({"name": "thread_name", "ph": "M", "pid": 1, "tid": task, "args": {"name": task_name(task)}})
+        trace.append({"name": "thread_sort_index", "ph": "M", "pid": 1, "tid": task, "args": {"sort_index": task}})
+
+    return trace
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("input", help="binary dump of xTraceBuffer or of the RAM that holds it")
+    parser.add_argument("-o", "--output", help="JSON file to write, standard output by default")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    try:
+        names, max_tasks, counts_per_second, events = parse(data)
+    except ValueError as error:
+        sys.exit("%s: %s" % (args.input, error))
+
+    document = {"traceEvents": to_chrome(names, max_tasks, counts_per_second, events), "displayTimeUnit": "ms"}
+
+    if args.output:
+        with open(args.output, "w") as f:
+            json.dump(document, f)
+        print("%d events written to %s" % (len(events), args.output))
+    else:
+        json.dump(document, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+"""
+Generate a workload trace for the workload demo (demoWorkload.c).
+
+Every entry is an arrival with an execution time, a relative deadline and a
+period, all in milliseconds.  An entry with a period is a periodic task created
+at its arrival time (its deadline is its period), an entry with period 0 is a
+single aperiodic job.  The aperiodic arrivals follow a Poisson process, or a
+bursty process that switches between a fast and a slow Poisson rate, drawn from
+a fixed seed, so the same command always writes the same trace.
+
+Usage:
+
+    python3 workloadGen.py -n 2000 --model bursty --seed 7 -o trace.csv
+    python3 workloadGen.py -p 100:25 -p 250:50 -o trace.bin --binary
+
+and replay it on the host build:
+
+    build/posix/output/RTOSDemo workload -w trace.csv
+
+The CSV format has one "arrival,wcet,deadline,period" line per entry.  The
+binary format is "WKLD", a version and an entry count, then four 32 bit words
+per entry in the same order, all little endian.
+"""
+
+import argparse
+import random
+import struct
+import sys
+
+MAGIC = b"WKLD"
+VERSION = 1
+MAX_ENTRIES = 2048  # WORKLOAD_MAX_ENTRIES in demoWorkload.c
+
+
+def periodic(text):
+    """Parse a "period:wcet" or "period:wcet:arrival" argument."""
+    fields = [int(field) for field in text.split(":")]
+    if len(fields) not in (2, 3) or fields[0] <= 0 or fields[1] <= 0:
+        raise argparse.ArgumentTypeError("expected period:wcet[:arrival] in ms, got %r" % text)
+    period, wcet = fields[0], fields[1]
+    arrival = fields[2] if len(fields) == 3 else 0
+    return (arrival, wcet, period, period)
+
+
+def generate(args):
+    """Return the entries as (arrival, wcet, deadline, period) tuples, sorted by arrival."""
+    rng = random.Random(args.seed)
+    entries = list(args.periodic)
+
+    arrival = 0.0
+    in_burst = False
+    for _ in range(args.jobs):
+        if args.model == "bursty":
+            # Bursts and quiet spells of burst_length arrivals on average; the
+            # quiet gap keeps the mean rate of the Poisson model.
+            if rng.random() < 1.0 / args.burst_length:
+                in_burst = not in_burst
+            gap = args.burst_gap if in_burst else 2 * args.mean_gap - args.burst_gap
+        else:
+            gap = args.mean_gap
+        arrival += rng.expovariate(1.0 / gap)
+
+        wcet = rng.randint(args.wcet_min, args.wcet_max)
+        deadline = wcet * rng.randint(args.deadline_min, args.deadline_max)
+        entries.append((int(arrival), wcet, deadline, 0))
+
+    entries.sort(key=lambda entry: entry[0])
+    return entries
+
+
+def write_csv(entries, out):
+    out.write("arrival,wcet,deadline,period\n")
+    for entry in entries:
+        out.write("%d,%d,%d,%d\n" % entry)
+
+
+def write_binary(entries, out):
+    out.write(MAGIC)
+    out.write(struct.pack("<II", VERSION, len(entries)))
+    for entry in entries:
+        out.write(struct.pack("<4I", *entry))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-n", "--jobs", type=int, default=1000, help="aperiodic arrivals (default 1000)")
+    parser.add_argument("--model", choices=("poisson", "bursty"), default="poisson")
+    parser.add_argument("--seed", type=int, default=12345)
+    parser.add_argument("--mean-gap", type=float, default=40.0, help="mean ms between two arrivals (default 40)")
+    parser.add_argument("--burst-gap", type=float, default=2.0, help="mean ms between two arrivals of a burst (default 2)")
+    parser.add_argument("--burst-length", type=float, default=8.0, help="mean arrivals in a burst (default 8)")
+    parser.add_argument("--wcet-min", type=int, default=2)
+    parser.add_argument("--wcet-max", type=int, default=8)
+    parser.add_argument("--deadline-min", type=int, default=10, help="smallest deadline, in multiples of the WCET")
+    parser.add_argument("--deadline-max", type=int, default=50, help="largest deadline, in multiples of the WCET")
+    parser.add_argument("-p", "--periodic", type=periodic, action="append", default=[],
+                        help="periodic task as period:wcet[:arrival] in ms, may be repeated")
+    parser.add_argument("-o", "--output", help="file to write, standard output by default")
+    parser.add_argument("--binary", action="store_true", help="write the binary format instead of CSV")
+    args = parser.parse_args()
+
+    if args.burst_gap >= 2 * args.mean_gap:
+        parser.error("--burst-gap must be below twice --mean-gap")
+
+    entries = generate(args)
+    if len(entries) > MAX_ENTRIES:
+        print("warning: %d entries, the demo only reads the first %d" % (len(entries), MAX_ENTRIES), file=sys.stderr)
+
+    if args.binary:
+        if not args.output:
+            parser.error("--binary needs --output")
+        with open(args.output, "wb") as f:
+            write_binary(entries, f)
+    elif args.output:
+        with open(args.output, "w") as f:
+            write_csv(entries, f)
+    else:
+        write_csv(entries, sys.stdout)
+
+    if args.output:
+        print("%d entries written to %s" % (len(entries), args.output))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,212 @@
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stream_buffer.h"
+
+/* Demo includes. */
+#include "uartDriver.h"
+
+/* Library includes. */
+#include "SMM_MPS2.h"
+
+#define uartBAUD_DIVIDER		( 16UL )
+
+/* Below the kernel's limit so the handler can use the FromISR API. */
+#define uartTX_INTERRUPT_PRIORITY	( configMAX_SYSCALL_INTERRUPT_PRIORITY + 2 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Send one byte by polling the transmitter.
+ */
+static void prvPollByte( uint8_t ucByte );
+
+/*
+ * Send everything still in the stream buffer by polling.  Called with
+ * interrupts masked.
+ */
+static void prvDrainPolled( void );
+
+/*
+ * Hand the next buffered byte to the transmitter if it is not already busy.
+ * Called with interrupts masked.
+ */
+static void prvStartTransmission( void );
+
+/*-----------------------------------------------------------*/
+
+static StreamBufferHandle_t xTxStream = NULL;
+static StaticStreamBuffer_t xTxStreamStruct;
+
+/* A stream buffer holds one byte less than its storage. */
+static uint8_t ucTxStorage[ uartTX_BUFFER_SIZE + 1 ];
+
+/* pdTRUE while a byte is in the transmitter and a TX interrupt will follow. */
+static volatile BaseType_t xTxBusy = pdFALSE;
+
+static volatile size_t xDroppedBytes = 0;
+
+/*-----------------------------------------------------------*/
+
+void vUARTInit( void )
+{
+	xTxStream = xStreamBufferCreateStatic( sizeof( ucTxStorage ), 1, ucTxStorage, &xTxStreamStruct );
+	configASSERT( xTxStream );
+
+	CMSDK_UART0->BAUDDIV = uartBAUD_DIVIDER;
+	CMSDK_UART0->CTRL = CMSDK_UART_CTRL_TXEN_Msk | CMSDK_UART_CTRL_TXIRQEN_Msk;
+
+	NVIC_SetPriority( UARTTX0_IRQn, uartTX_INTERRUPT_PRIORITY );
+	NVIC_EnableIRQ( UARTTX0_IRQn );
+}
+/*-----------------------------------------------------------*/
+
+size_t xUARTWrite( const char *pcData, size_t xLength )
+{
+	const uint8_t *pucData = ( const uint8_t * ) pcData;
+	size_t xSent = 0, xIndex;
+	UBaseType_t uxSavedInterruptStatus;
+	BaseType_t xState;
+
+	xState = xTaskGetSchedulerState();
+
+	if( ( xTxStream == NULL ) || ( xState == taskSCHEDULER_NOT_STARTED ) || ( __get_IPSR() != 0 ) )
+	{
+		/* No task to return to, or the caller is an interrupt that must not
+		wait for the transmitter: write straight to the UART, after whatever
+		the tasks have already queued so the output stays in order. */
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			if( xTxStream != NULL )
+			{
+				prvDrainPolled();
+			}
+
+			for( xIndex = 0; xIndex < xLength; xIndex++ )
+			{
+				prvPollByte( pucData[ xIndex ] );
+			}
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+		return xLength;
+	}
+
+	for( ;; )
+	{
+		/* Copying and starting the transmitter in one critical section keeps
+		bytes from different tasks apart and cannot race the TX interrupt.  No
+		task ever blocks on the stream buffer, so the FromISR variants are
+		enough and do not touch the scheduler from inside the critical
+		section. */
+		taskENTER_CRITICAL();
+		{
+			xSent += xStreamBufferSendFromISR( xTxStream, &pucData[ xSent ], xLength - xSent, NULL );
+			prvStartTransmission();
+		}
+		taskEXIT_CRITICAL();
+
+		if( xSent == xLength )
+		{
+			break;
+		}
+
+		#if ( uartTX_FULL_POLICY == uartTX_FULL_BLOCK )
+		{
+			/* The scheduler must be running to wait, otherwise drop the rest. */
+			if( xState == taskSCHEDULER_RUNNING )
+			{
+				vTaskDelay( 1 );
+				continue;
+			}
+		}
+		#endif
+
+		xDroppedBytes += xLength - xSent;
+		break;
+	}
+
+	return xSent;
+}
+/*-----------------------------------------------------------*/
+
+void vUARTFlush( void )
+{
+UBaseType_t uxSavedInterruptStatus;
+
+	if( xTxStream != NULL )
+	{
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			prvDrainPolled();
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vUARTPutChar( char cChar )
+{
+	( void ) xUARTWrite( &cChar, 1 );
+}
+/*-----------------------------------------------------------*/
+
+size_t xUARTGetDroppedBytes( void )
+{
+	return xDroppedBytes;
+}
+/*-----------------------------------------------------------*/
+
+void UARTTX0_Handler( void )
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	uint8_t ucByte;
+
+	/* Clear interrupt. */
+	CMSDK_UART0->INTCLEAR = CMSDK_UART_CTRL_TXIRQ_Msk;
+
+	if( xStreamBufferReceiveFromISR( xTxStream, &ucByte, 1, &xHigherPriorityTaskWoken ) == 1 )
+	{
+		CMSDK_UART0->DATA = ucByte;
+	}
+	else
+	{
+		xTxBusy = pdFALSE;
+	}
+
+	portEND_SWITCHING_ISR( xHigherPriorityTaskWoken );
+}
+/*-----------------------------------------------------------*/
+
+static void prvPollByte( uint8_t ucByte )
+{
+	while( ( CMSDK_UART0->STATE & CMSDK_UART_STATE_TXBF_Msk ) != 0 );
+	CMSDK_UART0->DATA = ucByte;
+}
+/*-----------------------------------------------------------*/
+
+static void prvDrainPolled( void )
+{
+	uint8_t ucByte;
+
+	while( xStreamBufferReceiveFromISR( xTxStream, &ucByte, 1, NULL ) == 1 )
+	{
+		prvPollByte( ucByte );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvStartTransmission( void )
+{
+	uint8_t ucByte;
+
+	if( xTxBusy == pdFALSE )
+	{
+		if( xStreamBufferReceiveFromISR( xTxStream, &ucByte, 1, NULL ) == 1 )
+		{
+			xTxBusy = pdTRUE;
+			CMSDK_UART0->DATA = ucByte;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
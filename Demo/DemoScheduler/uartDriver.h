@@ -0,0 +1,43 @@
+#ifndef UART_DRIVER_H
+#define UART_DRIVER_H
+
+#include <stddef.h>
+
+/* What a writer does when the transmit buffer is full. */
+#define uartTX_FULL_DROP		0	/* Discard what does not fit, the caller never waits. */
+#define uartTX_FULL_BLOCK		1	/* Wait a tick at a time until the interrupt makes room. */
+
+/* Both can be overridden in FreeRTOSConfig.h. */
+#ifndef uartTX_BUFFER_SIZE
+	#define uartTX_BUFFER_SIZE		2048
+#endif
+
+#ifndef uartTX_FULL_POLICY
+	#define uartTX_FULL_POLICY		uartTX_FULL_DROP
+#endif
+
+/*
+ * Buffered, interrupt driven output on the CMSDK UART0 of the MPS2 board.
+ *
+ * Writers copy their bytes into a stream buffer and return; the UART transmit
+ * interrupt sends them one at a time.  Before the scheduler starts, after it
+ * has stopped, and from an interrupt the bytes are sent by polling instead,
+ * after anything still buffered, so start up messages and assertion messages
+ * are not lost.  Do not write from inside a critical section when
+ * uartTX_FULL_POLICY is uartTX_FULL_BLOCK.
+ */
+void vUARTInit( void );
+size_t xUARTWrite( const char *pcData, size_t xLength );
+void vUARTPutChar( char cChar );
+
+/* Send everything still buffered by polling.  Call before masking interrupts
+for good, as the assertion and error hooks do. */
+void vUARTFlush( void );
+
+/* Bytes discarded by uartTX_FULL_DROP so far. */
+size_t xUARTGetDroppedBytes( void );
+
+/* Installed in the vector table as the UART0 TX handler. */
+void UARTTX0_Handler( void );
+
+#endif /* UART_DRIVER_H */
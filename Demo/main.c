@@ -57,6 +57,9 @@
 #include <stdio.h>
 #include <string.h>
 
+/* Demo includes. */
+#include "uartDriver.h"
+
 #define DEMO_MAIN_FULL   0
 #define DEMO_MAIN_BLINKY 1
 #define DEMO_SMOKERS	 2
@@ -66,15 +69,6 @@
 /* mainSELECT_DEMO is used to select each demo, based on the value indicated above. */
 #define mainSELECT_DEMO DEMO_BARBER
 
-/* printf() output uses the UART.  These constants define the addresses of the
-required UART registers. */
-#define UART0_ADDRESS 	( 0x40004000UL )
-#define UART0_DATA		( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 0UL ) ) ) )
-#define UART0_STATE		( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 4UL ) ) ) )
-#define UART0_CTRL		( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 8UL ) ) ) )
-#define UART0_BAUDDIV	( * ( ( ( volatile uint32_t * )( UART0_ADDRESS + 16UL ) ) ) )
-#define TX_BUFFER_MASK	( 1UL )
-
 /*
  * main_blinky() is used when mainSELECT_DEMO is set to DEMO_MAIN_BLINKY.
  * main_full() is used when mainSELECT_DEMO is set to DEMO_MAIN_FULL.
@@ -94,11 +88,6 @@ extern void demoBarber( void );
 void vFullDemoTickHookFunction( void );
 void vFullDemoIdleFunction( void );
 
-/*
- * Printf() output is sent to the serial port.  Initialise the serial hardware.
- */
-static void prvUARTInit( void );
-
 /*-----------------------------------------------------------*/
 
 void main( void )
@@ -106,8 +95,9 @@ void main( void )
 	/* See https://www.freertos.org/freertos-on-qemu-mps2-an385-model.html for
 	instructions. */
 
-	/* Hardware initialisation.  printf() output uses the UART for IO. */
-	prvUARTInit();
+	/* Hardware initialisation.  printf() output uses the UART for IO, buffered
+	and sent from the UART TX interrupt once the scheduler is running. */
+	vUARTInit();
 
 	/* The mainCREATE_SIMPLE_BLINKY_DEMO_ONLY setting is described at the top
 	of this file. */
@@ -155,6 +145,7 @@ void vApplicationMallocFailedHook( void )
 	fragmented).  See http://www.freertos.org/a00111.html for more
 	information. */
 	printf( "\r\n\r\nMalloc failed\r\n" );
+	vUARTFlush();
 	portDISABLE_INTERRUPTS();
 	for( ;; );
 }
@@ -223,6 +214,7 @@ volatile uint32_t ulSetToNonZeroInDebuggerToContinue = 0;
 	http://www.freertos.org/a00110.html#configASSERT for more information. */
 
 	printf( "ASSERT! Line %d, file %s\r\n", ( int ) ulLine, pcFileName );
+	vUARTFlush();
 
  	taskENTER_CRITICAL();
 	{
@@ -289,27 +281,14 @@ static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
 }
 /*-----------------------------------------------------------*/
 
-static void prvUARTInit( void )
-{
-	UART0_BAUDDIV = 16;
-	UART0_CTRL = 1;
-}
-/*-----------------------------------------------------------*/
-
 int __write( int iFile, char *pcString, int iStringLength )
 {
-	int iNextChar;
-
 	/* Avoid compiler warnings about unused parameters. */
 	( void ) iFile;
 
-	/* Output the formatted string to the UART. */
-	for( iNextChar = 0; iNextChar < iStringLength; iNextChar++ )
-	{
-		while( ( UART0_STATE & TX_BUFFER_MASK ) != 0 );
-		UART0_DATA = *pcString;
-		pcString++;
-	}
+	/* Queue the formatted string for the UART, what uartTX_FULL_DROP discards
+	still counts as written so the C library does not retry it. */
+	( void ) xUARTWrite( pcString, ( size_t ) iStringLength );
 
 	return iStringLength;
 }
@@ -323,6 +302,7 @@ void *malloc( size_t size )
 	library - but something is calling the C library malloc().  See
 	https://freertos.org/a00111.html for more information. */
 	printf( "\r\n\r\nUnexpected call to malloc() - should be usine pvPortMalloc()\r\n" );
+	vUARTFlush();
 	portDISABLE_INTERRUPTS();
 	for( ;; );
 
@@ -58,6 +58,11 @@
 /* Application specific configuration options. */
 #include "FreeRTOSConfig.h"
 
+/* Defaulted before portable.h is included, as the port macros depend on it. */
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES    1
+#endif
+
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
@@ -257,6 +262,14 @@
     #define INCLUDE_xTaskGetCurrentTaskHandle    1
 #endif
 
+#ifndef INCLUDE_vTaskEndJob
+    #define INCLUDE_vTaskEndJob    0
+#endif
+
+#ifndef INCLUDE_xTaskReleaseJobFromISR
+    #define INCLUDE_xTaskReleaseJobFromISR    0
+#endif
+
 #if configUSE_CO_ROUTINES != 0
     #ifndef configMAX_CO_ROUTINE_PRIORITIES
         #error configMAX_CO_ROUTINE_PRIORITIES must be greater than or equal to 1.
@@ -393,6 +406,96 @@
     #define portPOINTER_SIZE_TYPE    uint32_t
 #endif
 
+#ifndef configUSE_TRACE_BUFFER
+    #define configUSE_TRACE_BUFFER    0
+#endif
+
+#if ( configUSE_TRACE_BUFFER == 1 )
+
+/* Record the scheduler events in the binary trace buffer kept by tasks.c.
+ * These hooks only expand in tasks.c, and are called with interrupts masked,
+ * so an event is written without a lock of its own.  The one exception is the
+ * ready event of xTaskAbortDelay(), which runs with the scheduler suspended
+ * and can lose the race with an event recorded by an interrupt.  A hook
+ * already defined in FreeRTOSConfig.h takes precedence. */
+    #if ( configUSE_TRACE_FACILITY != 1 )
+        #error configUSE_TRACE_BUFFER requires configUSE_TRACE_FACILITY to be set to 1 in FreeRTOSConfig.h
+    #endif
+
+    #ifndef configTRACE_BUFFER_LENGTH
+        #define configTRACE_BUFFER_LENGTH    1024
+    #endif
+
+    #ifndef configTRACE_BUFFER_MAX_TASKS
+        #define configTRACE_BUFFER_MAX_TASKS    32
+    #endif
+
+/* Event timestamps use the scheduler statistics counter when there is one,
+ * the tick count otherwise. */
+    #ifndef portGET_TRACE_BUFFER_TIME
+        #ifdef portGET_SCHEDULER_STATS_TIME
+            #define portGET_TRACE_BUFFER_TIME()          portGET_SCHEDULER_STATS_TIME()
+            #define configTRACE_BUFFER_COUNTS_PER_TICK    configSCHEDULER_STATS_COUNTS_PER_TICK
+        #else
+            #define portGET_TRACE_BUFFER_TIME()          xTickCount
+            #define configTRACE_BUFFER_COUNTS_PER_TICK    1
+        #endif
+    #endif
+
+    #ifndef traceTASK_SWITCHED_IN
+        #define traceTASK_SWITCHED_IN()    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_SWITCHED_IN, pxCurrentTCB, 0U )
+    #endif
+
+    #ifndef traceMOVED_TASK_TO_READY_STATE
+        #define traceMOVED_TASK_TO_READY_STATE( pxTCB )    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_READY, pxTCB, 0U )
+    #endif
+
+    #ifndef traceTASK_CREATE
+        #define traceTASK_CREATE( pxNewTCB )    taskTRACE_BUFFER_CREATE( pxNewTCB )
+    #endif
+
+    #ifndef traceTASK_DELETE
+        #define traceTASK_DELETE( pxTaskToDelete )    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_DELETE, pxTaskToDelete, 0U )
+    #endif
+
+    #ifndef traceTASK_SUSPEND
+        #define traceTASK_SUSPEND( pxTaskToSuspend )    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_SUSPEND, pxTaskToSuspend, 0U )
+    #endif
+
+    #ifndef traceTASK_JOB_RELEASED
+        #define traceTASK_JOB_RELEASED( pxTCB )    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_JOB_RELEASED, pxTCB, ( pxTCB )->uxJobNumber )
+    #endif
+
+    #ifndef traceTASK_JOB_COMPLETED
+        #define traceTASK_JOB_COMPLETED( pxTCB )    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_JOB_COMPLETED, pxTCB, ( pxTCB )->uxJobNumber )
+    #endif
+
+    #ifndef traceTASK_DEADLINE_MISSED
+        #define traceTASK_DEADLINE_MISSED( pxTCB )    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_DEADLINE_MISSED, pxTCB, ( pxTCB )->uxJobNumber )
+    #endif
+
+    #ifndef traceSERVER_REPLENISHED
+        #define traceSERVER_REPLENISHED( xBudget )    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_SERVER_REPLENISHED, NULL, xBudget )
+    #endif
+
+    #ifndef traceSERVER_BUDGET_EXHAUSTED
+        #define traceSERVER_BUDGET_EXHAUSTED()    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_SERVER_EXHAUSTED, pxCurrentTCB, 0U )
+    #endif
+
+    #ifndef traceRESOURCE_TAKE
+        #define traceRESOURCE_TAKE( xResource )    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_RESOURCE_TAKE, pxCurrentTCB, ( xResource )->xCeiling )
+    #endif
+
+    #ifndef traceRESOURCE_GIVE
+        #define traceRESOURCE_GIVE( xResource )    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_RESOURCE_GIVE, pxCurrentTCB, ( xResource )->xCeiling )
+    #endif
+
+    #ifndef traceRESOURCE_CEILING_BLOCKED
+        #define traceRESOURCE_CEILING_BLOCKED( pxTCB )    taskTRACE_BUFFER_RECORD( taskTRACE_EVENT_CEILING_BLOCKED, pxTCB, 0U )
+    #endif
+
+#endif /* configUSE_TRACE_BUFFER */
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 
@@ -615,6 +718,42 @@
     #define traceTASK_DELETE( pxTaskToDelete )
 #endif
 
+#ifndef traceTASK_APERIODIC_OVERRUN
+    #define traceTASK_APERIODIC_OVERRUN( pxTCB )
+#endif
+
+#ifndef traceTASK_JOB_RELEASED
+    #define traceTASK_JOB_RELEASED( pxTCB )
+#endif
+
+#ifndef traceTASK_JOB_COMPLETED
+    #define traceTASK_JOB_COMPLETED( pxTCB )
+#endif
+
+#ifndef traceTASK_DEADLINE_MISSED
+    #define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
+#ifndef traceSERVER_REPLENISHED
+    #define traceSERVER_REPLENISHED( xBudget )
+#endif
+
+#ifndef traceSERVER_BUDGET_EXHAUSTED
+    #define traceSERVER_BUDGET_EXHAUSTED()
+#endif
+
+#ifndef traceRESOURCE_TAKE
+    #define traceRESOURCE_TAKE( xResource )
+#endif
+
+#ifndef traceRESOURCE_GIVE
+    #define traceRESOURCE_GIVE( xResource )
+#endif
+
+#ifndef traceRESOURCE_CEILING_BLOCKED
+    #define traceRESOURCE_CEILING_BLOCKED( pxTCB )
+#endif
+
 #ifndef traceTASK_DELAY_UNTIL
     #define traceTASK_DELAY_UNTIL( x )
 #endif
@@ -1141,6 +1280,248 @@
     #define configRUN_ADDITIONAL_TESTS    0
 #endif
 
+#ifndef configUSE_POLLING_SERVER
+    #define configUSE_POLLING_SERVER    0
+#endif
+
+#ifndef configUSE_APERIODIC_BUDGET
+    #define configUSE_APERIODIC_BUDGET    0
+#endif
+
+#ifndef configAPERIODIC_OVERRUN_POLICY
+    #define configAPERIODIC_OVERRUN_POLICY    tskAPERIODIC_OVERRUN_THROTTLE
+#endif
+
+#ifndef configAPERIODIC_THROTTLE_TICKS
+    #define configAPERIODIC_THROTTLE_TICKS    ( ( TickType_t ) 1U )
+#endif
+
+#ifndef configUSE_APERIODIC_OVERRUN_HOOK
+    #define configUSE_APERIODIC_OVERRUN_HOOK    0
+#endif
+
+#if ( ( configUSE_APERIODIC_BUDGET == 1 ) && ( configUSE_POLLING_SERVER != 1 ) )
+    #error configUSE_APERIODIC_BUDGET requires configUSE_POLLING_SERVER to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_APERIODIC_SERVER
+    #define configUSE_APERIODIC_SERVER    0
+#endif
+
+#ifndef configSERVER_MAX_REPLENISHMENTS
+    #define configSERVER_MAX_REPLENISHMENTS    8
+#endif
+
+#if ( ( configUSE_APERIODIC_SERVER == 1 ) && ( configUSE_POLLING_SERVER != 1 ) )
+    #error configUSE_APERIODIC_SERVER requires configUSE_POLLING_SERVER to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#if ( ( INCLUDE_vTaskEndJob == 1 ) && ( configUSE_POLLING_SERVER != 1 ) )
+    #error INCLUDE_vTaskEndJob requires configUSE_POLLING_SERVER to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_READY_HEAP
+    #define configUSE_READY_HEAP    0
+#endif
+
+#ifndef configREADY_HEAP_LENGTH
+    #define configREADY_HEAP_LENGTH    16
+#endif
+
+#if ( ( configUSE_READY_HEAP == 1 ) && ( configUSE_POLLING_SERVER != 1 ) )
+    #error configUSE_READY_HEAP requires configUSE_POLLING_SERVER to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_EDF_SCHEDULER
+    #define configUSE_EDF_SCHEDULER    0
+#endif
+
+#ifndef configUSE_DEADLINE_MISS_HOOK
+    #define configUSE_DEADLINE_MISS_HOOK    0
+#endif
+
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( INCLUDE_vTaskEndJob != 1 ) )
+    #error configUSE_EDF_SCHEDULER requires INCLUDE_vTaskEndJob to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#if ( ( configUSE_DEADLINE_MISS_HOOK == 1 ) && ( INCLUDE_vTaskEndJob != 1 ) )
+    #error configUSE_DEADLINE_MISS_HOOK requires INCLUDE_vTaskEndJob to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#if ( ( INCLUDE_xTaskReleaseJobFromISR == 1 ) && ( INCLUDE_vTaskEndJob != 1 ) )
+    #error INCLUDE_xTaskReleaseJobFromISR requires INCLUDE_vTaskEndJob to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_TASK_POOL
+    #define configUSE_TASK_POOL    0
+#endif
+
+#if ( ( configUSE_TASK_POOL == 1 ) && ( ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) || ( INCLUDE_vTaskDelete != 1 ) ) )
+    #error configUSE_TASK_POOL requires configSUPPORT_DYNAMIC_ALLOCATION and INCLUDE_vTaskDelete to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_ZERO_COPY_QUEUES
+    #define configUSE_ZERO_COPY_QUEUES    0
+#endif
+
+#if ( ( configUSE_ZERO_COPY_QUEUES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+    #error configUSE_ZERO_COPY_QUEUES requires configSUPPORT_DYNAMIC_ALLOCATION to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+    #define configTIMER_WHEEL_SLOT_BITS    5
+#endif
+
+#if ( ( configUSE_TIMER_WHEEL == 1 ) && ( ( configTIMER_WHEEL_SLOT_BITS < 1 ) || ( configTIMER_WHEEL_SLOT_BITS > 5 ) ) )
+    #error configTIMER_WHEEL_SLOT_BITS must be between 1 and 5, the slots of a level of the timer wheel are tracked in a 32 bit mask
+#endif
+
+#ifndef configUSE_ISR_TIMERS
+    #define configUSE_ISR_TIMERS    0
+#endif
+
+#if ( ( configUSE_ISR_TIMERS == 1 ) && ( configUSE_TIMERS == 0 ) )
+    #error configUSE_TIMERS must be set to 1 to make vTimerSetISRContext() available
+#endif
+
+#ifndef configUSE_SPSC_QUEUES
+    #define configUSE_SPSC_QUEUES    0
+#endif
+
+/* Index 0 is the one xTaskNotifyGive() and ulTaskNotifyTake() use, so SPSC
+ * queues default to the last index.  With a single index spsc_queue.c does not
+ * build unless configSPSC_QUEUE_NOTIFICATION_INDEX is set explicitly. */
+#ifndef configSPSC_QUEUE_NOTIFICATION_INDEX
+    #if ( configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 )
+        #define configSPSC_QUEUE_NOTIFICATION_INDEX    ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+    #endif
+#elif ( configSPSC_QUEUE_NOTIFICATION_INDEX >= configTASK_NOTIFICATION_ARRAY_ENTRIES )
+    #error configSPSC_QUEUE_NOTIFICATION_INDEX must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES
+#endif
+
+#ifndef configUSE_APERIODIC_JOBS
+    #define configUSE_APERIODIC_JOBS    0
+#endif
+
+#ifndef configAPERIODIC_JOB_QUEUE_LENGTH
+    #define configAPERIODIC_JOB_QUEUE_LENGTH    16
+#endif
+
+#if ( ( configUSE_APERIODIC_JOBS == 1 ) && ( ( configUSE_POLLING_SERVER != 1 ) || ( INCLUDE_xTaskCreateAperiodic != 1 ) || ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) ) )
+    #error configUSE_APERIODIC_JOBS requires configUSE_POLLING_SERVER, INCLUDE_xTaskCreateAperiodic and configSUPPORT_DYNAMIC_ALLOCATION to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_ADMISSION_CONTROL
+    #define configUSE_ADMISSION_CONTROL    0
+#endif
+
+#ifndef configADMISSION_RM_TEST
+    #define configADMISSION_RM_TEST    tskADMISSION_HYPERBOLIC
+#endif
+
+#if ( ( configUSE_ADMISSION_CONTROL == 1 ) && ( configUSE_POLLING_SERVER != 1 ) )
+    #error configUSE_ADMISSION_CONTROL requires configUSE_POLLING_SERVER to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_STACK_RESOURCE_POLICY
+    #define configUSE_STACK_RESOURCE_POLICY    0
+#endif
+
+#if ( ( configUSE_STACK_RESOURCE_POLICY == 1 ) && ( configUSE_POLLING_SERVER != 1 ) )
+    #error configUSE_STACK_RESOURCE_POLICY requires configUSE_POLLING_SERVER to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_CORE_AFFINITY
+    #define configUSE_CORE_AFFINITY    0
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* The scheduler features that keep one running entity for the whole system -
+ * the aperiodic server and its budget, the system ceiling of the Stack Resource
+ * Policy, the single idle time of tickless idle and the port optimised
+ * selection of one task - are not available on more than one core. */
+    #if ( ( configUSE_APERIODIC_SERVER == 1 ) || ( configUSE_APERIODIC_BUDGET == 1 ) || ( configUSE_STACK_RESOURCE_POLICY == 1 ) )
+        #error configNUMBER_OF_CORES above 1 requires configUSE_APERIODIC_SERVER, configUSE_APERIODIC_BUDGET and configUSE_STACK_RESOURCE_POLICY to be set to 0 in FreeRTOSConfig.h
+    #endif
+
+    #if ( ( configUSE_TICKLESS_IDLE != 0 ) || ( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 ) )
+        #error configNUMBER_OF_CORES above 1 requires configUSE_TICKLESS_IDLE and configUSE_PORT_OPTIMISED_TASK_SELECTION to be set to 0 in FreeRTOSConfig.h
+    #endif
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configNUMBER_OF_CORES above 1 requires configSUPPORT_DYNAMIC_ALLOCATION to be set to 1 in FreeRTOSConfig.h, the idle tasks of the other cores are allocated from the heap
+    #endif
+
+    #if ( configUSE_CORE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES > 32 )
+        #error configUSE_CORE_AFFINITY supports up to 32 cores
+    #endif
+
+    #ifndef portGET_CORE_ID
+        #error configNUMBER_OF_CORES above 1 requires the port to define portGET_CORE_ID(), portYIELD_CORE(), portGET_KERNEL_LOCK(), portRELEASE_KERNEL_LOCK() and portGET_CRITICAL_NESTING_COUNT()
+    #endif
+#else
+    #define portGET_CORE_ID()    ( ( BaseType_t ) 0 )
+#endif /* configNUMBER_OF_CORES */
+
+#ifndef configUSE_PARTITIONED_SCHEDULING
+    #define configUSE_PARTITIONED_SCHEDULING    0
+#endif
+
+#ifndef configPARTITION_HEURISTIC
+    #define configPARTITION_HEURISTIC    tskPARTITION_FIRST_FIT
+#endif
+
+#ifndef configUSE_TASK_SPLITTING
+    #define configUSE_TASK_SPLITTING    0
+#endif
+
+#if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+    #if ( ( configNUMBER_OF_CORES < 2 ) || ( configUSE_POLLING_SERVER != 1 ) || ( INCLUDE_xTaskCreatePeriodic != 1 ) )
+        #error configUSE_PARTITIONED_SCHEDULING requires configNUMBER_OF_CORES above 1, and configUSE_POLLING_SERVER and INCLUDE_xTaskCreatePeriodic to be set to 1 in FreeRTOSConfig.h
+    #endif
+
+/* The admission test keeps one total for the whole system, the partitions
+ * keep one per core instead. */
+    #if ( configUSE_ADMISSION_CONTROL == 1 )
+        #error configUSE_PARTITIONED_SCHEDULING requires configUSE_ADMISSION_CONTROL to be set to 0 in FreeRTOSConfig.h
+    #endif
+#endif /* configUSE_PARTITIONED_SCHEDULING */
+
+#if ( ( configUSE_TASK_SPLITTING == 1 ) && ( ( configUSE_PARTITIONED_SCHEDULING != 1 ) || ( INCLUDE_vTaskEndJob != 1 ) ) )
+    #error configUSE_TASK_SPLITTING requires configUSE_PARTITIONED_SCHEDULING and INCLUDE_vTaskEndJob to be set to 1 in FreeRTOSConfig.h
+#endif
+
+#ifndef configUSE_SCHEDULER_STATS
+    #define configUSE_SCHEDULER_STATS    0
+#endif
+
+#ifndef configSCHEDULER_STATS_COUNTER_TYPE
+    #define configSCHEDULER_STATS_COUNTER_TYPE    uint32_t
+#endif
+
+#ifndef portCONFIGURE_TIMER_FOR_SCHEDULER_STATS
+    #define portCONFIGURE_TIMER_FOR_SCHEDULER_STATS()
+#endif
+
+#if ( configUSE_SCHEDULER_STATS == 1 )
+    #if ( INCLUDE_vTaskEndJob != 1 )
+        #error configUSE_SCHEDULER_STATS requires INCLUDE_vTaskEndJob to be set to 1 in FreeRTOSConfig.h
+    #endif
+
+    #ifndef portGET_SCHEDULER_STATS_TIME
+        #error If configUSE_SCHEDULER_STATS is set to 1 then portGET_SCHEDULER_STATS_TIME() must also be defined.  It should return the value of a free running counter that is faster than the tick.
+    #endif
+
+    #ifndef configSCHEDULER_STATS_COUNTS_PER_TICK
+        #error If configUSE_SCHEDULER_STATS is set to 1 then configSCHEDULER_STATS_COUNTS_PER_TICK must also be defined as the number of portGET_SCHEDULER_STATS_TIME() counts in one tick.
+    #endif
+#endif
+
 
 /* Sometimes the FreeRTOSConfig.h settings only allow a task to be created using
  * dynamically allocated RAM, in which case when any task is deleted it is known
@@ -1307,6 +1688,61 @@ typedef struct xSTATIC_TCB
         TickType_t uxDummy24;
         TickType_t uxDummy25;
     #endif
+
+    #if ( configUSE_APERIODIC_BUDGET == 1 )
+        TickType_t xDummy26;
+        BaseType_t xDummy26a;
+    #endif
+
+    #if ( INCLUDE_vTaskEndJob == 1 )
+        TickType_t xDummy27[ 4 ];
+        UBaseType_t uxDummy28[ 3 ];
+    #endif
+
+    #if ( configUSE_READY_HEAP == 1 )
+        UBaseType_t uxDummy29;
+    #endif
+
+    #if ( configUSE_ADMISSION_CONTROL == 1 )
+        uint32_t ulDummy30;
+    #endif
+
+    #if ( configUSE_SCHEDULER_STATS == 1 )
+        UBaseType_t uxDummy31;
+        configSCHEDULER_STATS_COUNTER_TYPE ulDummy32[ 2 ];
+        uint64_t ullDummy33;
+        int64_t llDummy34[ 2 ];
+    #endif
+
+    #if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+        UBaseType_t uxDummy35;
+    #endif
+
+    #if ( configUSE_TASK_POOL == 1 )
+        void * pvDummy36;
+    #endif
+
+    #if ( configUSE_APERIODIC_JOBS == 1 )
+        void * pvDummy37;
+        UBaseType_t uxDummy37a;
+    #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xDummy38[ 2 ];
+        UBaseType_t uxDummy39;
+        #if ( configUSE_CORE_AFFINITY == 1 )
+            UBaseType_t uxDummy40;
+        #endif
+        #if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+            BaseType_t xDummy41;
+            uint32_t ulDummy42;
+            #if ( configUSE_TASK_SPLITTING == 1 )
+                BaseType_t xDummy43[ 2 ];
+                TickType_t xDummy44[ 2 ];
+                uint32_t ulDummy45;
+            #endif
+        #endif
+    #endif
 } StaticTask_t;
 
 /*
@@ -1437,6 +1873,18 @@ typedef struct xSTATIC_STREAM_BUFFER
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with software engineering best practice, the SPSC queue structure is
+ * only visible in spsc_queue.c.  StaticSpscQueue_t has the same size and
+ * alignment, see xSpscQueueCreateStatic().
+ */
+typedef struct xSTATIC_SPSC_QUEUE
+{
+    size_t uxDummy1[ 4 ];
+    void * pvDummy2[ 2 ];
+    uint8_t ucDummy3;
+} StaticSpscQueue_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
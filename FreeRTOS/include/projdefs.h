@@ -54,6 +54,7 @@ typedef void (* TaskFunction_t)( void * );
 #define errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY    ( -1 )
 #define errQUEUE_BLOCKED                         ( -4 )
 #define errQUEUE_YIELD                           ( -5 )
+#define errSCHEDULE_NOT_ADMITTED                 ( -6 )
 
 /* Macros used for basic data corruption checks. */
 #ifndef configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES
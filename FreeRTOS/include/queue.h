@@ -64,6 +64,14 @@ typedef struct QueueDefinition   * QueueSetHandle_t;
  */
 typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 
+/**
+ * Type by which zero copy queues are referenced.  For example, a call to
+ * xQueueCreateZeroCopy() returns a ZeroCopyQueueHandle_t variable that can then
+ * be used as a parameter to pvQueueReserveItem(), pvQueueAcquireItem(), etc.
+ */
+struct ZeroCopyQueueDefinition;
+typedef struct ZeroCopyQueueDefinition * ZeroCopyQueueHandle_t;
+
 /* For internal use only. */
 #define queueSEND_TO_BACK                     ( ( BaseType_t ) 0 )
 #define queueSEND_TO_FRONT                    ( ( BaseType_t ) 1 )
@@ -1701,6 +1709,122 @@ QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
  */
 QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 
+/*
+ * Zero copy queues hold items of a fixed size, like queues created with
+ * xQueueCreate(), but hand out pointers to their slots instead of copying the
+ * items in and out.  A writer reserves a free slot with pvQueueReserveItem(),
+ * fills it in place and commits it with vQueueCommitItem(); a reader acquires
+ * the oldest committed item with pvQueueAcquireItem(), uses it in place and
+ * gives the slot back with vQueueReleaseItem().  Between the two calls the
+ * task owns the slot and nothing else reads or writes it.  A task that owns
+ * an acquired item may also commit it again instead of releasing it, which
+ * puts it back at the end of the queue.
+ *
+ * Reserving waits for a free slot and acquiring waits for a committed item,
+ * with the same blocking and timeout behaviour as xQueueSend() and
+ * xQueueReceive().  Committing and releasing never block, as there is always
+ * room for a slot the caller owns.  Only the pointer to the slot is copied, so
+ * large items cost no more to pass than small ones.
+ *
+ * configUSE_ZERO_COPY_QUEUES must be set to 1 in FreeRTOSConfig.h for the zero
+ * copy queue API functions to be available.
+ */
+
+/*
+ * Creates a zero copy queue of uxQueueLength slots of uxItemSize bytes, each
+ * aligned to portBYTE_ALIGNMENT, in a single call to pvPortMalloc().
+ *
+ * @return The handle of the queue, or NULL if there was not enough heap
+ * memory to create it.
+ */
+ZeroCopyQueueHandle_t xQueueCreateZeroCopy( const UBaseType_t uxQueueLength,
+                                            const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Frees a zero copy queue.  No task may be waiting on it and no task may own
+ * one of its slots.
+ */
+void vQueueDeleteZeroCopy( ZeroCopyQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes a free slot of the queue, waiting up to xTicksToWait ticks for one.
+ * The slot belongs to the caller until it is given to vQueueCommitItem() or
+ * vQueueReleaseItem().
+ *
+ * @return A pointer to the slot, or NULL if no slot became free in time.
+ */
+void * pvQueueReserveItem( ZeroCopyQueueHandle_t xQueue,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of pvQueueReserveItem() that can be used from an ISR.  Returns
+ * NULL straight away if no slot is free.
+ */
+void * pvQueueReserveItemFromISR( ZeroCopyQueueHandle_t xQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Appends the item in the slot pvItem, obtained from pvQueueReserveItem() or
+ * pvQueueAcquireItem(), to the queue, and wakes a task waiting to acquire an
+ * item.  The caller must not touch the slot afterwards.
+ */
+void vQueueCommitItem( ZeroCopyQueueHandle_t xQueue,
+                       void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of vQueueCommitItem() that can be used from an ISR.
+ */
+void vQueueCommitItemFromISR( ZeroCopyQueueHandle_t xQueue,
+                              void * pvItem,
+                              BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes the oldest committed item off the queue, waiting up to xTicksToWait
+ * ticks for one.  The slot belongs to the caller until it is given to
+ * vQueueReleaseItem() or vQueueCommitItem().
+ *
+ * @return A pointer to the item, or NULL if no item was committed in time.
+ */
+void * pvQueueAcquireItem( ZeroCopyQueueHandle_t xQueue,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of pvQueueAcquireItem() that can be used from an ISR.  Returns
+ * NULL straight away if the queue is empty.
+ */
+void * pvQueueAcquireItemFromISR( ZeroCopyQueueHandle_t xQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns a pointer to the oldest committed item without taking it off the
+ * queue, waiting up to xTicksToWait ticks for one, or NULL.  The item is only
+ * valid until a task acquires it, so with more than one reader the result
+ * must not be used without some other form of mutual exclusion.
+ */
+void * pvQueuePeekItem( ZeroCopyQueueHandle_t xQueue,
+                        TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Gives the slot pvItem, obtained from pvQueueAcquireItem() or
+ * pvQueueReserveItem(), back to the queue, and wakes a task waiting to
+ * reserve a slot.  The caller must not touch the slot afterwards.
+ */
+void vQueueReleaseItem( ZeroCopyQueueHandle_t xQueue,
+                        void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * A version of vQueueReleaseItem() that can be used from an ISR.
+ */
+void vQueueReleaseItemFromISR( ZeroCopyQueueHandle_t xQueue,
+                               void * pvItem,
+                               BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of committed items in the queue, not counting the slots
+ * that tasks own.
+ */
+UBaseType_t uxQueueItemsWaiting( const ZeroCopyQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
                                      TickType_t xTicksToWait,
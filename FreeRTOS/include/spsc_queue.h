@@ -0,0 +1,253 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * SPSC queues pass fixed size items from exactly one writer to exactly one
+ * reader, typically from an interrupt to a task.  Unlike a queue created with
+ * xQueueCreate() neither side enters a critical section or masks interrupts:
+ * the writer only ever moves the head index and the reader only ever moves the
+ * tail index, so each index has a single writer and a plain atomic store
+ * publishes it.  The kernel is only called when the reader is blocked waiting
+ * for an item, in which case the writer gives it a task notification.
+ *
+ * ***NOTE***:  As with stream buffers it is not safe to have more than one
+ * writer or more than one reader.  The writer never blocks: xSpscQueueSend()
+ * and xSpscQueueSendFromISR() return errQUEUE_FULL when there is no room.
+ *
+ * The reader waits on the task notification at index
+ * configSPSC_QUEUE_NOTIFICATION_INDEX, which must not be used for anything
+ * else by a task that reads from an SPSC queue.  It defaults to the last index,
+ * configTASK_NOTIFICATION_ARRAY_ENTRIES - 1, away from the index 0 that
+ * xTaskNotifyGive() and ulTaskNotifyTake() use.
+ *
+ * configUSE_SPSC_QUEUES must be set to 1 in FreeRTOSConfig.h for spsc_queue.c
+ * to be built.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include spsc_queue.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which SPSC queues are referenced.  xSpscQueueCreate() returns an
+ * SpscQueueHandle_t that is then passed to xSpscQueueSend(),
+ * xSpscQueueReceive(), etc.
+ */
+struct SpscQueueDef_t;
+typedef struct SpscQueueDef_t * SpscQueueHandle_t;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * SpscQueueHandle_t xSpscQueueCreate( size_t uxQueueLength, size_t uxItemSize );
+ * @endcode
+ *
+ * Creates an SPSC queue using dynamically allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xSpscQueueCreate() to be available.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold.
+ *
+ * @param uxItemSize The size, in bytes, of each item.  Items are copied in and
+ * out of the queue.
+ *
+ * @return The handle of the queue, or NULL if there was not enough heap.
+ *
+ * \defgroup xSpscQueueCreate xSpscQueueCreate
+ * \ingroup SpscQueueManagement
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    SpscQueueHandle_t xSpscQueueCreate( size_t uxQueueLength,
+                                        size_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * SpscQueueHandle_t xSpscQueueCreateStatic( size_t uxQueueLength,
+ *                                           size_t uxItemSize,
+ *                                           uint8_t * pucQueueStorage,
+ *                                           StaticSpscQueue_t * pxStaticQueue );
+ * @endcode
+ *
+ * Creates an SPSC queue using statically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xSpscQueueCreateStatic() to be available.
+ *
+ * @param pucQueueStorage At least ( uxQueueLength + 1 ) * uxItemSize bytes.
+ * One slot is always left empty, which tells a full queue from an empty one
+ * without a count that both sides would have to update.
+ *
+ * @param pxStaticQueue Holds the queue's data structure.
+ *
+ * @return The handle of the queue, or NULL if pucQueueStorage or
+ * pxStaticQueue is NULL.
+ *
+ * \defgroup xSpscQueueCreateStatic xSpscQueueCreateStatic
+ * \ingroup SpscQueueManagement
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    SpscQueueHandle_t xSpscQueueCreateStatic( size_t uxQueueLength,
+                                              size_t uxItemSize,
+                                              uint8_t * pucQueueStorage,
+                                              StaticSpscQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * void vSpscQueueDelete( SpscQueueHandle_t xSpscQueue );
+ * @endcode
+ *
+ * Deletes a queue.  No task may be waiting to read from it.
+ *
+ * \defgroup vSpscQueueDelete vSpscQueueDelete
+ * \ingroup SpscQueueManagement
+ */
+void vSpscQueueDelete( SpscQueueHandle_t xSpscQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueSend( SpscQueueHandle_t xSpscQueue, const void * pvItemToQueue );
+ * @endcode
+ *
+ * Copies an item to the back of the queue, from the writer task.
+ *
+ * @return pdPASS, or errQUEUE_FULL if the queue has no room.  The writer
+ * never blocks.
+ *
+ * \defgroup xSpscQueueSend xSpscQueueSend
+ * \ingroup SpscQueueManagement
+ */
+BaseType_t xSpscQueueSend( SpscQueueHandle_t xSpscQueue,
+                           const void * pvItemToQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueSendFromISR( SpscQueueHandle_t xSpscQueue,
+ *                                   const void * pvItemToQueue,
+ *                                   BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xSpscQueueSend() that can be called from an interrupt.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the send unblocked the
+ * reader and the reader should run before the task that was interrupted, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.  Left unchanged otherwise.
+ *
+ * \defgroup xSpscQueueSendFromISR xSpscQueueSendFromISR
+ * \ingroup SpscQueueManagement
+ */
+BaseType_t xSpscQueueSendFromISR( SpscQueueHandle_t xSpscQueue,
+                                  const void * pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueReceive( SpscQueueHandle_t xSpscQueue,
+ *                               void * pvBuffer,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the item at the front of the queue into pvBuffer and removes it,
+ * from the reader task.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state for an
+ * item if the queue is empty.
+ *
+ * @return pdPASS, or errQUEUE_EMPTY if no item arrived in time.
+ *
+ * \defgroup xSpscQueueReceive xSpscQueueReceive
+ * \ingroup SpscQueueManagement
+ */
+BaseType_t xSpscQueueReceive( SpscQueueHandle_t xSpscQueue,
+                              void * pvBuffer,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSpscQueueReceiveFromISR( SpscQueueHandle_t xSpscQueue, void * pvBuffer );
+ * @endcode
+ *
+ * A version of xSpscQueueReceive() that can be called from an interrupt, when
+ * an interrupt is the reader.  It does not block.
+ *
+ * @return pdPASS, or errQUEUE_EMPTY if the queue is empty.
+ *
+ * \defgroup xSpscQueueReceiveFromISR xSpscQueueReceiveFromISR
+ * \ingroup SpscQueueManagement
+ */
+BaseType_t xSpscQueueReceiveFromISR( SpscQueueHandle_t xSpscQueue,
+                                     void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * size_t uxSpscQueueMessagesWaiting( SpscQueueHandle_t xSpscQueue );
+ * @endcode
+ *
+ * @return The number of items in the queue.  Either side can call it, from a
+ * task or an interrupt; the result is only a snapshot if the other side is
+ * active.
+ *
+ * \defgroup uxSpscQueueMessagesWaiting uxSpscQueueMessagesWaiting
+ * \ingroup SpscQueueManagement
+ */
+size_t uxSpscQueueMessagesWaiting( SpscQueueHandle_t xSpscQueue ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( SPSC_QUEUE_H ) */
@@ -86,6 +86,29 @@
 struct tskTaskControlBlock; /* The old naming convention is used to prevent breaking kernel aware debuggers. */
 typedef struct tskTaskControlBlock * TaskHandle_t;
 
+/**
+ * task. h
+ *
+ * Type by which resources shared under the Stack Resource Policy are
+ * referenced.  See xTaskResourceCreate().
+ *
+ * \defgroup ResourceHandle_t ResourceHandle_t
+ * \ingroup Tasks
+ */
+struct tskResource;
+typedef struct tskResource * ResourceHandle_t;
+
+/**
+ * task. h
+ *
+ * Type by which task pools are referenced.  See xTaskPoolCreate().
+ *
+ * \defgroup TaskPoolHandle_t TaskPoolHandle_t
+ * \ingroup Tasks
+ */
+struct tskTaskPool;
+typedef struct tskTaskPool * TaskPoolHandle_t;
+
 /*
  * Defines the prototype to which the application task hook function must
  * conform.
@@ -168,6 +191,84 @@ typedef struct xTASK_STATUS
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
 
+/* Used with vTaskGetJobStatus() to obtain the timing of the jobs of a periodic
+ * task. */
+typedef struct xTASK_JOB_STATUS
+{
+    UBaseType_t uxJobNumber;      /* Number of jobs released so far, including the current one. */
+    TickType_t xReleaseTime;      /* Tick at which the current job was released. */
+    TickType_t xAbsoluteDeadline; /* Tick by which the current job should complete (its release time plus the period). */
+    TickType_t xCompletionTime;   /* Tick at which the last job called vTaskEndJob(). */
+    TickType_t xResponseTime;     /* Completion time minus release time of the last completed job. */
+    UBaseType_t uxDeadlineMisses; /* Number of jobs that were still running, or completed, after their absolute deadline. */
+} TaskJobStatus_t;
+
+/* Used with vTaskGetPartition() to obtain the cores the packing of
+ * configUSE_PARTITIONED_SCHEDULING gave a task. */
+typedef struct xTASK_PARTITION
+{
+    BaseType_t xCore;         /* The core the jobs of the task start on. */
+    BaseType_t xSplitCore;    /* The core a split task finishes its jobs on, -1 if the task is not split. */
+    TickType_t xSplitBudget;  /* Ticks of each job run on xCore before the job moves to xSplitCore, 0 if the task is not split. */
+    UBaseType_t uxPermille;   /* Utilisation the task holds on xCore, in thousandths. */
+} TaskPartition_t;
+
+/* The function an aperiodic job runs, see xTaskSubmitJob(). */
+typedef void (* JobFunction_t)( void * pvParameters );
+
+/* Progress of an aperiodic job, see AperiodicJob_t. */
+typedef enum
+{
+    eJobIdle = 0, /* Never submitted. */
+    eJobQueued,   /* Waiting for a worker. */
+    eJobRunning,  /* Being run by a worker. */
+    eJobDone      /* Completed.  The job can be submitted again. */
+} eJobState;
+
+/* An aperiodic job run by one of the workers of xTaskCreateJobWorkers().  The
+ * application owns the structure and fills in the first four members, it must
+ * not be changed from the time it is submitted until eState is eJobDone. */
+typedef struct xAPERIODIC_JOB
+{
+    JobFunction_t pxJobCode;    /* The function to run. */
+    void * pvParameters;        /* Passed to pxJobCode. */
+    TickType_t xDuration;       /* Worst case execution time, the budget of the worker while it runs the job.  0 if not known. */
+    TickType_t xDeadline;       /* Deadline relative to the submission. */
+    TickType_t xReleaseTime;    /* Set by the kernel: tick at which the job was submitted. */
+    TickType_t xCompletionTime; /* Set by the kernel: tick at which the job returned. */
+    UBaseType_t uxOrder;        /* Set by the kernel: submission order, breaks deadline ties. */
+    volatile eJobState eState;  /* Set by the kernel. */
+} AperiodicJob_t;
+
+#if ( configUSE_SCHEDULER_STATS == 1 )
+
+/* Used with uxTaskGetSchedulerStats() to return the job statistics of each
+ * periodic task.  Times are in portGET_SCHEDULER_STATS_TIME() counts, measured
+ * from the tick at which the job was released. */
+    typedef struct xTASK_SCHEDULER_STATS
+    {
+        TaskHandle_t xHandle;                                /* The handle of the task to which the rest of the information in the structure relates. */
+        const char * pcTaskName;                             /* A pointer to the task's name. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        UBaseType_t uxReleasedJobs;                          /* Number of jobs released so far, including the current one. */
+        UBaseType_t uxCompletedJobs;                         /* Number of jobs that called vTaskEndJob(). */
+        UBaseType_t uxDeadlineMisses;                        /* Number of jobs that were still running, or completed, after their absolute deadline. */
+        configSCHEDULER_STATS_COUNTER_TYPE ulBestResponse;    /* Shortest response time of a completed job. */
+        configSCHEDULER_STATS_COUNTER_TYPE ulWorstResponse;   /* Longest response time of a completed job. */
+        configSCHEDULER_STATS_COUNTER_TYPE ulAverageResponse; /* Average response time of the completed jobs. */
+        int64_t llWorstLateness;                             /* Largest completion time minus absolute deadline.  Negative if every job completed early. */
+        int64_t llAverageLateness;                           /* Average completion time minus absolute deadline. */
+    } TaskSchedulerStats_t;
+
+#endif /* configUSE_SCHEDULER_STATS */
+
+/* Replenishment rules of the aperiodic server created by xTaskServerCreate(). */
+typedef enum
+{
+    eServerPolling = 0, /* Capacity is lost as soon as the server has no pending job, and restored at the next period boundary. */
+    eServerDeferrable,  /* Capacity is kept for jobs that arrive later in the period, and restored at the next period boundary. */
+    eServerSporadic     /* Capacity consumed in a busy interval is returned one period after that interval started. */
+} eServerPolicy;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -185,6 +286,74 @@ typedef enum
  */
 #define tskIDLE_PRIORITY    ( ( UBaseType_t ) 0U )
 
+/**
+ * The core affinity mask of a task that may run on any core, see
+ * vTaskCoreAffinitySet().
+ *
+ * \ingroup TaskUtils
+ */
+#define tskNO_AFFINITY    ( ( UBaseType_t ) -1 )
+
+/**
+ * Actions that can be taken when an aperiodic task consumes its whole
+ * execution-time budget (uxDuration) with configUSE_APERIODIC_BUDGET set to 1.
+ * Select one with configAPERIODIC_OVERRUN_POLICY in FreeRTOSConfig.h.
+ *
+ * tskAPERIODIC_OVERRUN_THROTTLE: block the task for
+ * configAPERIODIC_THROTTLE_TICKS, then give it a fresh budget.
+ *
+ * tskAPERIODIC_OVERRUN_DEMOTE: drop the task to tskIDLE_PRIORITY so it only
+ * completes in background time.
+ *
+ * tskAPERIODIC_OVERRUN_ABORT: delete the task as if it had called
+ * vTaskDelete( NULL ).  Requires INCLUDE_vTaskDelete.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskAPERIODIC_OVERRUN_THROTTLE    0
+#define tskAPERIODIC_OVERRUN_DEMOTE      1
+#define tskAPERIODIC_OVERRUN_ABORT       2
+
+/**
+ * Schedulability tests applied to periodic tasks under rate monotonic
+ * scheduling with configUSE_ADMISSION_CONTROL set to 1.  Select one with
+ * configADMISSION_RM_TEST in FreeRTOSConfig.h.  Under configUSE_EDF_SCHEDULER
+ * the total utilisation is simply kept at or below 1.
+ *
+ * tskADMISSION_LIU_LAYLAND: the total utilisation of n tasks must not exceed
+ * n( 2^(1/n) - 1 ).
+ *
+ * tskADMISSION_HYPERBOLIC: the product of ( Ui + 1 ) over all tasks must not
+ * exceed 2.  Accepts every set the Liu and Layland bound accepts, and more.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskADMISSION_LIU_LAYLAND         0
+#define tskADMISSION_HYPERBOLIC          1
+
+/**
+ * Bin-packing heuristics that assign the periodic tasks to cores with
+ * configUSE_PARTITIONED_SCHEDULING set to 1.  Select one with
+ * configPARTITION_HEURISTIC in FreeRTOSConfig.h.  The tasks created before
+ * the scheduler starts are packed again when it starts, in order of
+ * decreasing utilisation, which makes them first-fit decreasing and worst-fit
+ * decreasing.  A task created later is placed on its own.
+ *
+ * A task fits on a core if the utilisation of the core stays at or below 1
+ * under configUSE_EDF_SCHEDULER, and if the product of ( Ui + 1 ) over its
+ * tasks stays at or below 2 under rate monotonic scheduling.
+ *
+ * tskPARTITION_FIRST_FIT: the lowest numbered core the task fits on.  Fills
+ * the first cores and leaves the last ones free for the other tasks.
+ *
+ * tskPARTITION_WORST_FIT: the core with the most utilisation left, if the
+ * task fits on it.  Spreads the load so every core keeps some slack.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskPARTITION_FIRST_FIT           0
+#define tskPARTITION_WORST_FIT           1
+
 /**
  * task. h
  *
@@ -222,7 +391,11 @@ typedef enum
  * \defgroup taskEXIT_CRITICAL taskEXIT_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskEXIT_CRITICAL()                portEXIT_CRITICAL()
+#if ( configNUMBER_OF_CORES == 1 )
+    #define taskEXIT_CRITICAL()            portEXIT_CRITICAL()
+#else
+    #define taskEXIT_CRITICAL()            vTaskExitCritical()
+#endif
 #define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
 
 /**
@@ -358,6 +531,26 @@ typedef enum
                             void * const pvParameters,
                             UBaseType_t uxPriority,
                             TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * uxDuration is the worst case execution time of the aperiodic job, or of one
+ * job of the periodic task, in ticks.  With configUSE_ADMISSION_CONTROL set to
+ * 1 it is used to test, before the task is created, that the task set stays
+ * schedulable:
+ *
+ * - a periodic task adds uxDuration / uxPeriod to the utilisation, which is
+ *   checked against configADMISSION_RM_TEST, or against 1 under
+ *   configUSE_EDF_SCHEDULER;
+ * - under configUSE_EDF_SCHEDULER an aperiodic task adds uxDuration /
+ *   uxDeadline to the same total;
+ * - once the aperiodic server exists, an aperiodic task is only accepted if the
+ *   work already queued on the server plus uxDuration fits in the capacity the
+ *   server is granted within uxDeadline.
+ *
+ * A task that fails the test is not created and errSCHEDULE_NOT_ADMITTED is
+ * returned (NULL for the static versions).  Its share is given back when the
+ * task is deleted.  A uxDuration of zero is always accepted.
+ */
 #if ( INCLUDE_xTaskCreateAperiodic == 1 )
     BaseType_t xTaskCreateAperiodic( TaskFunction_t pxTaskCode,
                             const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
@@ -375,6 +568,7 @@ typedef enum
                             void * const pvParameters,
                             UBaseType_t uxPriority,
                             TickType_t uxPeriod,
+                            TickType_t uxDuration,
                             TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 #endif
@@ -514,11 +708,530 @@ typedef enum
                                     void * const pvParameters,
                                     UBaseType_t uxPriority,
                                     TickType_t uxPeriod,
+                                    TickType_t uxDuration,
                                     StackType_t * const puxStackBuffer,
                                     StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
 #endif
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * task. h
+ * @code{c}
+ * TaskPoolHandle_t xTaskPoolCreate( UBaseType_t uxSlots, configSTACK_DEPTH_TYPE usStackDepth );
+ * @endcode
+ *
+ * configUSE_TASK_POOL must be defined as 1 for this function to be available.
+ *
+ * Allocate, in two blocks of the FreeRTOS heap, uxSlots task control blocks
+ * and uxSlots stacks of usStackDepth words each, for short lived tasks that
+ * all need the same stack.  Tasks created with xTaskCreateFromPool() or
+ * xTaskCreateAperiodicFromPool() take a free slot in constant time and do not
+ * use the heap, so memory use stays flat however often they are created.
+ *
+ * A task deleted by another task gives its slot back at once.  A task that
+ * deletes itself is still running on its stack, so its slot is given back by
+ * the next task created from the same pool rather than by the idle task.
+ *
+ * Call it before the scheduler starts, or at least before the load it is
+ * sized for.  A pool is never deleted.
+ *
+ * @param uxSlots The number of tasks of the pool that can exist at once.
+ *
+ * @param usStackDepth The size of the stack of each slot, in words.
+ *
+ * @return The handle of the pool, or NULL if there was not enough heap.
+ *
+ * \defgroup xTaskPoolCreate xTaskPoolCreate
+ * \ingroup Tasks
+ */
+#if ( configUSE_TASK_POOL == 1 )
+    TaskPoolHandle_t xTaskPoolCreate( UBaseType_t uxSlots,
+                                      configSTACK_DEPTH_TYPE usStackDepth ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateFromPool( TaskPoolHandle_t xTaskPool,
+ *                                 TaskFunction_t pxTaskCode,
+ *                                 const char * const pcName,
+ *                                 void * const pvParameters,
+ *                                 UBaseType_t uxPriority,
+ *                                 TaskHandle_t * const pxCreatedTask );
+ * @endcode
+ *
+ * configUSE_TASK_POOL must be defined as 1 for this function to be available.
+ *
+ * Same as xTaskCreate(), except that the TCB and the stack are a free slot of
+ * xTaskPool, and the stack depth is that of the pool.  The task is deleted
+ * with vTaskDelete() as usual.
+ *
+ * @return pdPASS, or errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY if every slot of
+ * the pool is in use.
+ *
+ * \defgroup xTaskCreateFromPool xTaskCreateFromPool
+ * \ingroup Tasks
+ */
+#if ( configUSE_TASK_POOL == 1 )
+    BaseType_t xTaskCreateFromPool( TaskPoolHandle_t xTaskPool,
+                                    TaskFunction_t pxTaskCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateAperiodicFromPool( TaskPoolHandle_t xTaskPool,
+ *                                          TaskFunction_t pxTaskCode,
+ *                                          const char * const pcName,
+ *                                          void * const pvParameters,
+ *                                          UBaseType_t uxPriority,
+ *                                          TickType_t uxDuration,
+ *                                          TickType_t uxDeadline,
+ *                                          TaskHandle_t * const pxCreatedTask );
+ * @endcode
+ *
+ * configUSE_TASK_POOL and INCLUDE_xTaskCreateAperiodic must be defined as 1
+ * for this function to be available.
+ *
+ * Same as xTaskCreateAperiodic(), except that the TCB and the stack are a
+ * free slot of xTaskPool, and the stack depth is that of the pool.
+ *
+ * @return pdPASS, errSCHEDULE_NOT_ADMITTED if the task failed the admission
+ * test, or errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY if every slot of the pool is
+ * in use.
+ *
+ * \defgroup xTaskCreateAperiodicFromPool xTaskCreateAperiodicFromPool
+ * \ingroup Tasks
+ */
+#if ( ( configUSE_TASK_POOL == 1 ) && ( INCLUDE_xTaskCreateAperiodic == 1 ) )
+    BaseType_t xTaskCreateAperiodicFromPool( TaskPoolHandle_t xTaskPool,
+                                             TaskFunction_t pxTaskCode,
+                                             const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                             void * const pvParameters,
+                                             UBaseType_t uxPriority,
+                                             TickType_t uxDuration,
+                                             TickType_t uxDeadline,
+                                             TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateJobWorkers( UBaseType_t uxWorkers, configSTACK_DEPTH_TYPE usStackDepth, UBaseType_t uxPriority );
+ * @endcode
+ *
+ * configUSE_APERIODIC_JOBS must be defined as 1 for this function to be
+ * available.
+ *
+ * Create uxWorkers aperiodic tasks that run the jobs given to
+ * xTaskSubmitJob().  A worker is scheduled as the aperiodic task it is, by the
+ * server once it exists, and takes the deadline and the budget of the job it
+ * runs.  Workers with no job wait without being scheduled.  They are never
+ * deleted.
+ *
+ * Handling a request as a job rather than as a task of its own saves the
+ * creation and the deletion of a task each time: a job only needs the
+ * structure that describes it, and is queued in O(log n).
+ *
+ * @param uxWorkers The number of jobs that can run at once.
+ *
+ * @param usStackDepth The stack size of each worker, in words.  Every job runs
+ * on the stack of a worker, so it must be enough for any of them.
+ *
+ * @param uxPriority The priority the workers run at while there is no server.
+ *
+ * @return pdPASS, or errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY if not all the
+ * workers could be created.
+ *
+ * \defgroup xTaskCreateJobWorkers xTaskCreateJobWorkers
+ * \ingroup Tasks
+ */
+#if ( configUSE_APERIODIC_JOBS == 1 )
+    BaseType_t xTaskCreateJobWorkers( UBaseType_t uxWorkers,
+                                      configSTACK_DEPTH_TYPE usStackDepth,
+                                      UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskSubmitJob( AperiodicJob_t * pxJob );
+ * @endcode
+ *
+ * configUSE_APERIODIC_JOBS must be defined as 1 for this function to be
+ * available.
+ *
+ * Release pxJob now.  It is given to a worker straight away if one is waiting,
+ * and otherwise queued by absolute deadline, ties in submission order, until a
+ * worker finishes its job.  pxJob->eState becomes eJobDone once
+ * pxJob->pxJobCode has returned.
+ *
+ * Jobs are not run through the admission test: the workers, and the server
+ * that schedules them, bound the time they take.
+ *
+ * @param pxJob The job.  It must stay valid until it is done.
+ *
+ * @return pdPASS, or errQUEUE_FULL if configAPERIODIC_JOB_QUEUE_LENGTH jobs are
+ * already waiting for a worker.
+ *
+ * \defgroup xTaskSubmitJob xTaskSubmitJob
+ * \ingroup Tasks
+ */
+#if ( configUSE_APERIODIC_JOBS == 1 )
+    BaseType_t xTaskSubmitJob( AperiodicJob_t * pxJob ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskSubmitJobFromISR( AperiodicJob_t * pxJob, BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xTaskSubmitJob() that can be called from an interrupt.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the worker given the job
+ * should run before the task that was interrupted, in which case a context
+ * switch should be requested before the interrupt is exited.
+ *
+ * \defgroup xTaskSubmitJobFromISR xTaskSubmitJobFromISR
+ * \ingroup Tasks
+ */
+#if ( configUSE_APERIODIC_JOBS == 1 )
+    BaseType_t xTaskSubmitJobFromISR( AperiodicJob_t * pxJob,
+                                      BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskServerCreate( eServerPolicy ePolicy, TickType_t xCapacity, TickType_t xPeriod );
+ * @endcode
+ *
+ * Only available when configUSE_APERIODIC_SERVER is set to 1.
+ *
+ * Configure the aperiodic server.  Once the server exists, tasks created with
+ * xTaskCreateAperiodic() are no longer scheduled by priority.  They are queued
+ * on the server in deadline order, and the server runs them for at most
+ * xCapacity ticks in every xPeriod ticks.  The server is scheduled alongside
+ * the periodic tasks as if it were a periodic task with period xPeriod, so
+ * the interference it causes on the periodic tasks is bounded by that of a
+ * periodic task with execution time xCapacity.
+ *
+ * The function can be called again to change the policy or parameters, but
+ * only while no aperiodic task is queued on the server.
+ *
+ * @param ePolicy The replenishment rule - eServerPolling, eServerDeferrable or
+ * eServerSporadic.
+ *
+ * @param xCapacity The execution time, in ticks, granted to the server each
+ * period.  Must be greater than zero and not greater than xPeriod.
+ *
+ * @param xPeriod The replenishment period of the server, in ticks.
+ *
+ * With configUSE_ADMISSION_CONTROL set to 1 the server counts as a periodic
+ * task with utilisation xCapacity / xPeriod, and is only configured if the
+ * periodic task set stays schedulable.
+ *
+ * @return pdPASS if the server was configured, errSCHEDULE_NOT_ADMITTED if it
+ * failed the admission test, otherwise pdFAIL.
+ *
+ * \defgroup xTaskServerCreate xTaskServerCreate
+ * \ingroup Tasks
+ */
+#if ( configUSE_APERIODIC_SERVER == 1 )
+    BaseType_t xTaskServerCreate( eServerPolicy ePolicy,
+                                  TickType_t xCapacity,
+                                  TickType_t xPeriod ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskEndJob( void );
+ * @endcode
+ *
+ * INCLUDE_vTaskEndJob must be defined as 1 for this function to be available.
+ *
+ * Called by a periodic task, created with xTaskCreatePeriodic(), when its
+ * current job has completed.  The task is moved to the pending periodic list
+ * and the tick interrupt makes it ready again at the start of its next period,
+ * that is at the release time of the current job plus the task period.  The
+ * release times are therefore fixed by the period alone and do not drift with
+ * the execution time of the jobs, without the task having to keep its own
+ * wake time as it would with vTaskDelayUntil().
+ *
+ * If the job completes after its next release time has passed, the next job is
+ * released immediately.
+ *
+ * Each job has an absolute deadline, its release time plus the period.  A job
+ * that is still running when the deadline passes, or that calls vTaskEndJob()
+ * after it, is counted as a deadline miss (see vTaskGetJobStatus() and
+ * configUSE_DEADLINE_MISS_HOOK).  Misses are only meaningful for tasks that
+ * end every job with vTaskEndJob().
+ *
+ * The first job is released when the task is created.
+ *
+ * Example usage:
+ * @code{c}
+ * void vPeriodicTask( void * pvParameters )
+ * {
+ *   for( ;; )
+ *   {
+ *       // Perform the work of one job.
+ *       vDoWork();
+ *
+ *       // Wait for the next period.
+ *       vTaskEndJob();
+ *   }
+ * }
+ * @endcode
+ * \defgroup vTaskEndJob vTaskEndJob
+ * \ingroup TaskCtrl
+ */
+#if ( INCLUDE_vTaskEndJob == 1 )
+    void vTaskEndJob( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetJobStatus( TaskHandle_t xTask, TaskJobStatus_t *pxJobStatus );
+ * @endcode
+ *
+ * INCLUDE_vTaskEndJob must be defined as 1 for this function to be available.
+ *
+ * Populates a TaskJobStatus_t structure with the release time, absolute
+ * deadline and job number of the current job of a periodic task, and with the
+ * completion and response time of its last completed job.
+ *
+ * @param xTask The handle of the periodic task being queried.  Passing NULL
+ * queries the calling task.
+ *
+ * @param pxJobStatus The TaskJobStatus_t structure to fill.
+ *
+ * \defgroup vTaskGetJobStatus vTaskGetJobStatus
+ * \ingroup TaskCtrl
+ */
+#if ( INCLUDE_vTaskEndJob == 1 )
+    void vTaskGetJobStatus( TaskHandle_t xTask,
+                            TaskJobStatus_t * pxJobStatus ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskWaitForRelease( void );
+ * @endcode
+ *
+ * INCLUDE_xTaskReleaseJobFromISR must be defined as 1 for this function to be
+ * available.
+ *
+ * Called by a periodic task, in place of vTaskEndJob(), when its next job is
+ * released by an interrupt rather than by the tick, for example by a timer
+ * that is finer than the tick.  The current job is completed as by
+ * vTaskEndJob(), then the task waits until xTaskReleaseJobFromISR() releases
+ * the next job.  If that release came while the job was still running, the
+ * next job is released immediately.
+ *
+ * The period given to xTaskCreatePeriodic() still orders the task against the
+ * other periodic tasks, and its job deadlines are still the release tick plus
+ * the period, so it should be the release interval rounded up to whole
+ * ticks.
+ *
+ * \defgroup vTaskWaitForRelease vTaskWaitForRelease
+ * \ingroup TaskCtrl
+ */
+#if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+    void vTaskWaitForRelease( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskReleaseJobFromISR( TaskHandle_t xTaskToRelease, BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * INCLUDE_xTaskReleaseJobFromISR must be defined as 1 for this function to be
+ * available.
+ *
+ * Release the next job of a periodic task that waits in vTaskWaitForRelease().
+ * The release time of the job is the current tick.  If the task is still
+ * running its previous job the release is remembered, and
+ * vTaskWaitForRelease() returns at once for each remembered release.
+ *
+ * @param xTaskToRelease The handle of the periodic task.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the released job should
+ * preempt the running task, in which case a context switch should be requested
+ * before the interrupt is exited.  Can be NULL.
+ *
+ * @return pdTRUE if a job was released, pdFALSE if the release was remembered
+ * because the previous job has not completed yet.
+ *
+ * \defgroup xTaskReleaseJobFromISR xTaskReleaseJobFromISR
+ * \ingroup TaskCtrl
+ */
+#if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+    BaseType_t xTaskReleaseJobFromISR( TaskHandle_t xTaskToRelease,
+                                       BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetSchedulerStats( TaskSchedulerStats_t * const pxStatsArray, const UBaseType_t uxArraySize );
+ * @endcode
+ *
+ * configUSE_SCHEDULER_STATS must be defined as 1 for this function to be
+ * available.  portGET_SCHEDULER_STATS_TIME() and
+ * configSCHEDULER_STATS_COUNTS_PER_TICK must then also be defined, see
+ * FreeRTOS.h.
+ *
+ * Populates a TaskSchedulerStats_t structure for each periodic task in the
+ * system with the number of jobs released, completed and late, and the best,
+ * worst and average response time and lateness of the completed jobs.  The
+ * response time of a job is measured from its release tick to the call to
+ * vTaskEndJob() with the resolution of portGET_SCHEDULER_STATS_TIME().
+ *
+ * The scheduler is suspended while the tasks are found, but interrupts are
+ * only disabled while the counters of one task are copied, so the snapshot
+ * does not add to the interrupt latency in proportion to the number of tasks.
+ *
+ * @param pxStatsArray An array of TaskSchedulerStats_t structures.
+ *
+ * @param uxArraySize The number of structures in pxStatsArray.  Tasks beyond
+ * that number are not reported.
+ *
+ * @return The number of TaskSchedulerStats_t structures populated.
+ *
+ * Example usage:
+ * @code{c}
+ * void vPrintWorstResponses( void )
+ * {
+ * TaskSchedulerStats_t xStats[ 8 ];
+ * UBaseType_t uxCount, x;
+ *
+ *   uxCount = uxTaskGetSchedulerStats( xStats, 8 );
+ *
+ *   for( x = 0; x < uxCount; x++ )
+ *   {
+ *       printf( "%s %u\n", xStats[ x ].pcTaskName, ( unsigned ) xStats[ x ].ulWorstResponse );
+ *   }
+ * }
+ * @endcode
+ * \defgroup uxTaskGetSchedulerStats uxTaskGetSchedulerStats
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_SCHEDULER_STATS == 1 )
+    UBaseType_t uxTaskGetSchedulerStats( TaskSchedulerStats_t * const pxStatsArray,
+                                         const UBaseType_t uxArraySize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * ResourceHandle_t xTaskResourceCreate( void );
+ * @endcode
+ *
+ * configUSE_STACK_RESOURCE_POLICY and configSUPPORT_DYNAMIC_ALLOCATION must be
+ * set to 1 for this function to be available.
+ *
+ * Create a resource shared under the Stack Resource Policy (SRP).  Unlike a
+ * mutex, the resource works with the period and deadline ordered ready lists:
+ *
+ * - every periodic and aperiodic task has a preemption level, its relative
+ *   deadline (the period of a periodic task, uxDeadline of an aperiodic task,
+ *   or the server period for a job run by the aperiodic server).  The shorter
+ *   the relative deadline, the higher the level;
+ * - the ceiling of a resource is the highest preemption level of the tasks
+ *   that use it, as declared with vTaskResourceAddUser();
+ * - the system ceiling is the highest ceiling among the resources that are
+ *   currently held;
+ * - a task is only allowed to run if its preemption level is higher than the
+ *   system ceiling.  Otherwise the task holding the resource on top of the
+ *   stack keeps running until it gives the resource back.
+ *
+ * A task is therefore never blocked once it starts running, the resource is
+ * always free when vTaskResourceTake() is called, deadlock is not possible and
+ * a job is blocked for at most the length of one critical section of a task
+ * with a lower preemption level.  This holds under both rate monotonic and EDF
+ * scheduling.
+ *
+ * Tasks must not block or end their job while they hold a resource, and
+ * resources must be given back in the reverse order they were taken.  An
+ * aperiodic job holding a resource keeps running past the capacity of the
+ * server until it gives the resource back.
+ *
+ * @return The handle of the resource, or NULL if it could not be allocated.
+ *
+ * \defgroup xTaskResourceCreate xTaskResourceCreate
+ * \ingroup Tasks
+ */
+#if ( ( configUSE_STACK_RESOURCE_POLICY == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+    ResourceHandle_t xTaskResourceCreate( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskResourceAddUser( ResourceHandle_t xResource, TaskHandle_t xTask );
+ * @endcode
+ *
+ * Declare that xTask uses xResource, raising the ceiling of the resource to
+ * the preemption level of the task if it is higher.  Every task that takes the
+ * resource must be declared, before the resource is first taken.
+ *
+ * @param xResource The resource.
+ *
+ * @param xTask The handle of a periodic or aperiodic task.  Passing NULL
+ * declares the calling task.
+ *
+ * \defgroup vTaskResourceAddUser vTaskResourceAddUser
+ * \ingroup Tasks
+ */
+#if ( configUSE_STACK_RESOURCE_POLICY == 1 )
+    void vTaskResourceAddUser( ResourceHandle_t xResource,
+                               TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskResourceTake( ResourceHandle_t xResource );
+ * void vTaskResourceGive( ResourceHandle_t xResource );
+ * @endcode
+ *
+ * Enter and leave a critical section protected by xResource.  Neither function
+ * blocks: vTaskResourceTake() raises the system ceiling to the ceiling of the
+ * resource, and vTaskResourceGive() restores it, letting any task that was
+ * kept from running by the ceiling preempt the caller.
+ *
+ * Example usage:
+ * @code{c}
+ * void vPeriodicTask( void * pvParameters )
+ * {
+ *   for( ;; )
+ *   {
+ *       vTaskResourceTake( xSharedBuffer );
+ *       vUpdateBuffer();
+ *       vTaskResourceGive( xSharedBuffer );
+ *
+ *       vTaskEndJob();
+ *   }
+ * }
+ * @endcode
+ * \defgroup vTaskResourceTake vTaskResourceTake
+ * \ingroup Tasks
+ */
+#if ( configUSE_STACK_RESOURCE_POLICY == 1 )
+    void vTaskResourceTake( ResourceHandle_t xResource ) PRIVILEGED_FUNCTION;
+    void vTaskResourceGive( ResourceHandle_t xResource ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1704,6 +2417,45 @@ configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVIL
 
 #endif
 
+#if ( configUSE_APERIODIC_OVERRUN_HOOK == 1 )
+
+/**
+ *  task.h
+ * @code{c}
+ * void vApplicationAperiodicOverrunHook( TaskHandle_t xTask );
+ * @endcode
+ *
+ * This hook function is called from the tick interrupt when the aperiodic task
+ * xTask has used up its execution-time budget, before the action selected by
+ * configAPERIODIC_OVERRUN_POLICY is applied.  Only interrupt safe API
+ * functions may be called from it.
+ *
+ * @param xTask The aperiodic task that overran its budget.
+ */
+    void vApplicationAperiodicOverrunHook( TaskHandle_t xTask ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
+#if ( configUSE_DEADLINE_MISS_HOOK == 1 )
+
+/**
+ *  task.h
+ * @code{c}
+ * void vApplicationDeadlineMissHook( TaskHandle_t xTask );
+ * @endcode
+ *
+ * This hook function is called once for each job that misses its absolute
+ * deadline: from the tick interrupt when the job is still running after its
+ * deadline, or from vTaskEndJob() when it completes late.  In both cases it
+ * runs with interrupts masked, so it must not block and only interrupt safe
+ * API functions may be called from it.
+ *
+ * @param xTask The task whose current job missed its deadline.
+ */
+    void vApplicationDeadlineMissHook( TaskHandle_t xTask ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 /**
@@ -1749,6 +2501,102 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/**
+ * Multi core version of xTaskGetIdleTaskHandle(): every core has an idle task,
+ * and xTaskGetIdleTaskHandle() returns the one of core 0.
+ */
+    TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );
+ * @endcode
+ *
+ * configUSE_CORE_AFFINITY must be defined as 1 for this function to be
+ * available.
+ *
+ * Restrict the cores xTask may run on to those set in uxCoreAffinityMask, bit
+ * n standing for core n.  Tasks are created with tskNO_AFFINITY.  A task that
+ * runs on a core it is no longer allowed on is moved at once.  Passing xTask as
+ * NULL sets the affinity of the calling task.
+ *
+ * Example usage:
+ * @code{c}
+ * // Keep the logger on core 0, clear of the cores the periodic tasks use.
+ * vTaskCoreAffinitySet( xLoggerTask, ( 1U << 0 ) );
+ * @endcode
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup TaskCtrl
+ */
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                                   UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+
+/**
+ * Return the core affinity mask of xTask, or of the calling task if xTask is
+ * NULL.
+ */
+        UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+    #endif
+
+/**
+ * Return how many times xTask has been switched in on a different core from
+ * the one it last ran on, or the calling task if xTask is NULL.  Only the
+ * first time a task runs does not count.
+ */
+    UBaseType_t uxTaskGetMigrationCount( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetCoreUtilisation( BaseType_t xCoreID );
+ * @endcode
+ *
+ * configUSE_PARTITIONED_SCHEDULING must be defined as 1 for this function to
+ * be available.
+ *
+ * Return the utilisation of the periodic tasks, and shares of split tasks,
+ * assigned to core xCoreID, in thousandths.  A value above 1000 means a task
+ * fitted on no core and was placed on the one with the most utilisation left
+ * anyway.
+ *
+ * Example usage:
+ * @code{c}
+ * for( BaseType_t xCore = 0; xCore < configNUMBER_OF_CORES; xCore++ )
+ * {
+ *     printf( "core %d: %u/1000\n", ( int ) xCore, ( unsigned ) uxTaskGetCoreUtilisation( xCore ) );
+ * }
+ * @endcode
+ * \defgroup uxTaskGetCoreUtilisation uxTaskGetCoreUtilisation
+ * \ingroup TaskUtils
+ */
+    #if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+        UBaseType_t uxTaskGetCoreUtilisation( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskGetPartition( TaskHandle_t xTask, TaskPartition_t *pxPartition );
+ * @endcode
+ *
+ * configUSE_PARTITIONED_SCHEDULING must be defined as 1 for this function to
+ * be available.
+ *
+ * Populates a TaskPartition_t structure with the cores the periodic task
+ * xTask was assigned to, or the calling task if xTask is NULL.  A task that
+ * is not periodic has no share of its core, and is never split.
+ *
+ * \defgroup vTaskGetPartition vTaskGetPartition
+ * \ingroup TaskUtils
+ */
+        void vTaskGetPartition( TaskHandle_t xTask,
+                                TaskPartition_t * pxPartition ) PRIVILEGED_FUNCTION;
+    #endif
+#endif /* configNUMBER_OF_CORES */
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -3065,6 +3913,21 @@ TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
  */
 TaskHandle_t xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * Return the handle of the task core xCoreID is running.
+ */
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Leave a critical section, and switch to another task if one was made ready
+ * for this core while it was held.  Used by taskEXIT_CRITICAL() on more than
+ * one core, where that task can be made ready by another core.
+ */
+    void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Shortcut used by the queue implementation to prevent unnecessary call to
  * taskYIELD();
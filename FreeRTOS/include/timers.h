@@ -1269,6 +1269,40 @@ const char * pcTimerGetName( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION; /*lint
 void vTimerSetReloadMode( TimerHandle_t xTimer,
                           const BaseType_t xAutoReload ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetISRContext( TimerHandle_t xTimer, const BaseType_t xISRContext );
+ *
+ * configUSE_ISR_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * vTimerSetISRContext() to be available.
+ *
+ * Makes a timer an ISR timer, or a normal timer again.  The callback of an ISR
+ * timer is called from the tick interrupt, on the tick the timer expires,
+ * instead of from the timer service task.  A task it releases therefore runs
+ * as soon as the tick interrupt returns, whatever the priority of the timer
+ * service task and whatever it is busy with.
+ *
+ * The callback runs in interrupt context: it must not block, and must only
+ * call API functions that end in "FromISR".  It should pass NULL as their
+ * pxHigherPriorityTaskWoken parameter, the tick interrupt then switches to a
+ * task the callback unblocked when it returns.
+ *
+ * The other timer API functions are used on an ISR timer as on any timer, but
+ * act on it directly, within a critical section, rather than through the timer
+ * command queue, so they never block and always return pdPASS.  The period of
+ * an ISR timer must be less than half the range of TickType_t.
+ *
+ * @param xTimer The handle of the timer being updated.  The timer must be
+ * dormant, and if it was started before as a normal timer, the timer service
+ * task must have processed the command that stopped it.
+ *
+ * @param xISRContext pdTRUE to call the callback from the tick interrupt,
+ * pdFALSE to call it from the timer service task.
+ */
+#if ( configUSE_ISR_TIMERS == 1 )
+    void vTimerSetISRContext( TimerHandle_t xTimer,
+                              const BaseType_t xISRContext ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * BaseType_t xTimerGetReloadMode( TimerHandle_t xTimer );
  *
@@ -1340,6 +1374,24 @@ BaseType_t xTimerGenericCommand( TimerHandle_t xTimer,
     UBaseType_t uxTimerGetTimerNumber( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_ISR_TIMERS == 1 )
+
+/*
+ * Called by xTaskIncrementTick() on every tick interrupt, with the tick count
+ * that interrupt stands for, to call the callbacks of the ISR timers that are
+ * due.
+ */
+    void vTimerProcessISRTimers( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of ticks from xTimeNow to the next ISR timer expiry, 0 if
+ * one is due and portMAX_DELAY if no ISR timer is active.  Used to bound the
+ * time the tick can be suppressed for.
+ */
+    TickType_t xTimerGetTicksToNextISRTimer( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_ISR_TIMERS */
+
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 /**
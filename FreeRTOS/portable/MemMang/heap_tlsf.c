@@ -0,0 +1,771 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() based on the Two Level
+ * Segregated Fit allocator (Masmano et al., "TLSF: a new dynamic memory
+ * allocator for real-time systems").  Like heap_4.c it combines adjacent
+ * blocks as they are freed, but both functions take a bounded time that does
+ * not depend on the number of free blocks:
+ *
+ * - the free blocks are kept in one list per size class.  The first level
+ *   splits the sizes into powers of two, the second level splits each power of
+ *   two into heapSL_INDEX_COUNT equal ranges, and a bitmap per level records
+ *   which lists are not empty, so a list that holds a large enough block is
+ *   found with two find-first-set operations;
+ * - every block records the block just below it in memory, so a freed block is
+ *   merged with both of its neighbours without walking a list.
+ *
+ * A request is rounded up to the next size class before the search, so any
+ * block of the class found fits and no list is searched.  The rounding wastes
+ * less than 1 / heapSL_INDEX_COUNT of the request.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c and heap_4.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE    ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX         ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+#if ( portBYTE_ALIGNMENT == 4 )
+    #define heapALIGNMENT_LOG2    2
+#elif ( portBYTE_ALIGNMENT == 8 )
+    #define heapALIGNMENT_LOG2    3
+#elif ( portBYTE_ALIGNMENT == 16 )
+    #define heapALIGNMENT_LOG2    4
+#elif ( portBYTE_ALIGNMENT == 32 )
+    #define heapALIGNMENT_LOG2    5
+#else
+    #error heap_tlsf.c does not support this portBYTE_ALIGNMENT
+#endif
+
+/* Each power of two is split into 1 << heapSL_INDEX_LOG2 size classes. */
+#define heapSL_INDEX_LOG2      4
+#define heapSL_INDEX_COUNT     ( 1U << heapSL_INDEX_LOG2 )
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE all go in first level 0, split into
+ * classes one alignment unit apart. */
+#define heapFL_INDEX_SHIFT     ( heapSL_INDEX_LOG2 + heapALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE   ( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* Index of the most significant bit set in a constant of up to 32 bits, for
+ * the size of the tables below. */
+#define heapFLS_CONST_4( x )     ( ( ( x ) >= 0x8U ) ? 3 : ( ( x ) >= 0x4U ) ? 2 : ( ( x ) >= 0x2U ) ? 1 : 0 )
+#define heapFLS_CONST_8( x )     ( ( ( x ) >= 0x10U ) ? ( 4 + heapFLS_CONST_4( ( x ) >> 4 ) ) : heapFLS_CONST_4( x ) )
+#define heapFLS_CONST_16( x )    ( ( ( x ) >= 0x100U ) ? ( 8 + heapFLS_CONST_8( ( x ) >> 8 ) ) : heapFLS_CONST_8( x ) )
+#define heapFLS_CONST_32( x )    ( ( ( x ) >= 0x10000U ) ? ( 16 + heapFLS_CONST_16( ( x ) >> 16 ) ) : heapFLS_CONST_16( x ) )
+
+/* First level 0 for the small blocks, then one per power of two up to the size
+ * of the heap. */
+#define heapFL_INDEX_COUNT     ( heapFLS_CONST_32( ( size_t ) configTOTAL_HEAP_SIZE ) - heapFL_INDEX_SHIFT + 2 )
+
+/* The lowest bit of the xBlockSize member of a BlockLink_t structure is set
+ * while the block is free.  Block sizes are multiples of portBYTE_ALIGNMENT so
+ * the bit is otherwise unused. */
+#define heapBLOCK_FREE_BIT                ( ( size_t ) 1 )
+#define heapBLOCK_SIZE( pxBlock )         ( ( pxBlock )->xBlockSize & ~heapBLOCK_FREE_BIT )
+#define heapBLOCK_IS_FREE( pxBlock )      ( ( ( pxBlock )->xBlockSize & heapBLOCK_FREE_BIT ) != 0 )
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )    ( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/*-----------------------------------------------------------*/
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* The header at the start of every block.  Only the first two members are kept
+ * in an allocated block, the free list links use the start of its payload. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPrevPhysicalBlock; /*<< The block just below this one in memory, NULL for the first block. */
+    size_t xBlockSize;                         /*<< The size of the block, header included, and heapBLOCK_FREE_BIT. */
+    struct A_BLOCK_LINK * pxNextFreeBlock;     /*<< The next free block of the same size class. */
+    struct A_BLOCK_LINK * pxPrevFreeBlock;     /*<< The previous free block of the same size class. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The first and second level indexes of the size class that holds blocks of
+ * xSize bytes.
+ */
+static void prvMappingInsert( size_t xSize,
+                              UBaseType_t * puxFirstLevel,
+                              UBaseType_t * puxSecondLevel ) PRIVILEGED_FUNCTION;
+
+/*
+ * The first and second level indexes of the smallest size class whose blocks
+ * all hold at least xSize bytes.
+ */
+static void prvMappingSearch( size_t xSize,
+                              UBaseType_t * puxFirstLevel,
+                              UBaseType_t * puxSecondLevel ) PRIVILEGED_FUNCTION;
+
+/*
+ * The first free block of the smallest non empty size class at or above the
+ * one given, NULL if there is none.  The indexes are updated to that class.
+ */
+static BlockLink_t * prvFindSuitableBlock( UBaseType_t * puxFirstLevel,
+                                           UBaseType_t * puxSecondLevel ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add a free block to, or take it out of, the list of its size class.
+ */
+static void prvInsertFreeBlock( BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Index of the most and of the least significant bit set in a non zero value.
+ */
+static UBaseType_t prvFindLastSet( size_t xValue ) PRIVILEGED_FUNCTION;
+static UBaseType_t prvFindFirstSet( uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The size of the header kept in an allocated block, which must be correctly
+ * byte aligned. */
+static const size_t xHeapStructSize = ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* A free block must hold the whole structure, free list links included. */
+static const size_t xMinimumBlockSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* One bit per first level index, set while one of its lists is not empty, and
+ * one bit per second level list of each first level index. */
+PRIVILEGED_DATA static uint32_t ulFirstLevelBitmap = 0;
+PRIVILEGED_DATA static uint32_t ulSecondLevelBitmaps[ heapFL_INDEX_COUNT ];
+
+/* The free lists, one per size class. */
+PRIVILEGED_DATA static BlockLink_t * pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+
+/* A block of size zero, never free, that ends the heap. */
+PRIVILEGED_DATA static BlockLink_t * pxEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining and of free blocks. */
+PRIVILEGED_DATA static size_t xFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
+PRIVILEGED_DATA static size_t xNumberOfFreeBlocks = 0;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    vTaskSuspendAll();
+    {
+        /* If this is the first call to malloc then the heap will require
+         * initialisation to setup the free lists. */
+        if( pxEnd == NULL )
+        {
+            prvHeapInit();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xWantedSize > 0 )
+        {
+            /* The wanted size must be increased so it can contain the block
+             * header in addition to the requested amount of bytes, and rounded
+             * up to the alignment. */
+            xAdditionalRequiredSize = xHeapStructSize + ( ( portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK ) ) & portBYTE_ALIGNMENT_MASK );
+
+            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            {
+                xWantedSize += xAdditionalRequiredSize;
+
+                if( xWantedSize < xMinimumBlockSize )
+                {
+                    xWantedSize = xMinimumBlockSize;
+                }
+            }
+            else
+            {
+                xWantedSize = 0;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+        {
+            prvMappingSearch( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+            /* A request rounded up past the largest size class cannot be met. */
+            if( uxFirstLevel < ( UBaseType_t ) heapFL_INDEX_COUNT )
+            {
+                pxBlock = prvFindSuitableBlock( &uxFirstLevel, &uxSecondLevel );
+            }
+            else
+            {
+                pxBlock = NULL;
+            }
+
+            if( pxBlock != NULL )
+            {
+                prvRemoveFreeBlock( pxBlock );
+
+                /* If the block is larger than required it can be split into
+                 * two. */
+                if( ( heapBLOCK_SIZE( pxBlock ) - xWantedSize ) >= xMinimumBlockSize )
+                {
+                    /* This block is to be split into two.  Create a new block
+                     * following the number of bytes requested. The void cast is
+                     * used to prevent byte alignment warnings from the
+                     * compiler. */
+                    pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                    configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                    pxNewBlockLink->xBlockSize = ( heapBLOCK_SIZE( pxBlock ) - xWantedSize ) | heapBLOCK_FREE_BIT;
+                    pxNewBlockLink->pxPrevPhysicalBlock = pxBlock;
+                    heapNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPrevPhysicalBlock = pxNewBlockLink;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    /* The block that followed is not free, or it would have
+                     * been merged with this one, so the remainder goes straight
+                     * into its free list. */
+                    prvInsertFreeBlock( pxNewBlockLink );
+                }
+                else
+                {
+                    /* The block is being returned - it is allocated and owned
+                     * by the application. */
+                    pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+                }
+
+                xFreeBytesRemaining -= heapBLOCK_SIZE( pxBlock );
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Return the memory space pointed to - jumping over the block
+                 * header at its start. */
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                xNumberOfSuccessfulAllocations++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    BlockLink_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have a block header immediately before
+         * it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_FREE( pxLink ) == pdFALSE );
+
+        if( heapBLOCK_IS_FREE( pxLink ) == pdFALSE )
+        {
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( puc + xHeapStructSize, 0, heapBLOCK_SIZE( pxLink ) - xHeapStructSize );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += heapBLOCK_SIZE( pxLink );
+                traceFREE( pv, heapBLOCK_SIZE( pxLink ) );
+
+                /* Merge with the block below if it is free. */
+                pxNeighbour = pxLink->pxPrevPhysicalBlock;
+
+                if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE ) )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxNeighbour->xBlockSize += heapBLOCK_SIZE( pxLink );
+                    pxLink = pxNeighbour;
+                }
+                else
+                {
+                    pxLink->xBlockSize |= heapBLOCK_FREE_BIT;
+                }
+
+                /* Merge with the block above if it is free.  pxEnd never is. */
+                pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxLink );
+
+                if( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxLink->xBlockSize += heapBLOCK_SIZE( pxNeighbour );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                heapNEXT_PHYSICAL_BLOCK( pxLink )->pxPrevPhysicalBlock = pxLink;
+                prvInsertFreeBlock( pxLink );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxFirstFreeBlock;
+    uint8_t * pucAlignedHeap;
+    portPOINTER_SIZE_TYPE uxAddress;
+    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    uxAddress = ( portPOINTER_SIZE_TYPE ) ucHeap;
+
+    if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+    {
+        uxAddress += ( portBYTE_ALIGNMENT - 1 );
+        uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        xTotalHeapSize -= uxAddress - ( portPOINTER_SIZE_TYPE ) ucHeap;
+    }
+
+    pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+    /* pxEnd is used to mark the end of the heap, it is only a header.  Being
+     * allocated, it is never merged with the block below it. */
+    uxAddress = ( ( portPOINTER_SIZE_TYPE ) pucAlignedHeap ) + xTotalHeapSize;
+    uxAddress -= xHeapStructSize;
+    uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+    pxEnd = ( BlockLink_t * ) uxAddress;
+
+    /* To start with there is a single free block that is sized to take up the
+     * entire heap space, minus the space taken by pxEnd. */
+    pxFirstFreeBlock = ( BlockLink_t * ) pucAlignedHeap;
+    pxFirstFreeBlock->pxPrevPhysicalBlock = NULL;
+    pxFirstFreeBlock->xBlockSize = ( size_t ) ( uxAddress - ( portPOINTER_SIZE_TYPE ) pxFirstFreeBlock ) | heapBLOCK_FREE_BIT;
+
+    pxEnd->pxPrevPhysicalBlock = pxFirstFreeBlock;
+    pxEnd->xBlockSize = 0;
+
+    prvInsertFreeBlock( pxFirstFreeBlock );
+
+    /* Only one block exists - and it covers the entire usable heap space. */
+    xMinimumEverFreeBytesRemaining = heapBLOCK_SIZE( pxFirstFreeBlock );
+    xFreeBytesRemaining = heapBLOCK_SIZE( pxFirstFreeBlock );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( size_t xValue ) /* PRIVILEGED_FUNCTION */
+{
+    #if defined( __GNUC__ )
+    {
+        return ( UBaseType_t ) ( ( sizeof( unsigned long ) * heapBITS_PER_BYTE ) - 1U - ( size_t ) __builtin_clzl( ( unsigned long ) xValue ) );
+    }
+    #else
+    {
+        UBaseType_t uxBit = 0;
+
+        /* At most one step per bit of a size_t. */
+        while( ( xValue >>= 1 ) != 0 )
+        {
+            uxBit++;
+        }
+
+        return uxBit;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindFirstSet( uint32_t ulValue ) /* PRIVILEGED_FUNCTION */
+{
+    #if defined( __GNUC__ )
+    {
+        return ( UBaseType_t ) __builtin_ctz( ulValue );
+    }
+    #else
+    {
+        UBaseType_t uxBit = 0;
+
+        while( ( ulValue & 1U ) == 0 )
+        {
+            ulValue >>= 1;
+            uxBit++;
+        }
+
+        return uxBit;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize,
+                              UBaseType_t * puxFirstLevel,
+                              UBaseType_t * puxSecondLevel ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxLastSet;
+
+    if( xSize < heapSMALL_BLOCK_SIZE )
+    {
+        /* The small blocks are split into classes one alignment unit apart. */
+        *puxFirstLevel = 0;
+        *puxSecondLevel = ( UBaseType_t ) ( xSize >> heapALIGNMENT_LOG2 );
+    }
+    else
+    {
+        /* The bits below the most significant one pick the second level. */
+        uxLastSet = prvFindLastSet( xSize );
+        *puxSecondLevel = ( UBaseType_t ) ( ( xSize >> ( uxLastSet - heapSL_INDEX_LOG2 ) ) ^ heapSL_INDEX_COUNT );
+        *puxFirstLevel = uxLastSet - ( heapFL_INDEX_SHIFT - 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingSearch( size_t xSize,
+                              UBaseType_t * puxFirstLevel,
+                              UBaseType_t * puxSecondLevel ) /* PRIVILEGED_FUNCTION */
+{
+    size_t xRound;
+
+    if( xSize >= heapSMALL_BLOCK_SIZE )
+    {
+        /* Round up to the start of the next size class, unless xSize is the
+         * start of one already. */
+        xRound = ( ( size_t ) 1 << ( prvFindLastSet( xSize ) - heapSL_INDEX_LOG2 ) ) - 1U;
+
+        if( heapADD_WILL_OVERFLOW( xSize, xRound ) == 0 )
+        {
+            xSize += xRound;
+        }
+        else
+        {
+            xSize = heapSIZE_MAX;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    prvMappingInsert( xSize, puxFirstLevel, puxSecondLevel );
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvFindSuitableBlock( UBaseType_t * puxFirstLevel,
+                                           UBaseType_t * puxSecondLevel ) /* PRIVILEGED_FUNCTION */
+{
+    uint32_t ulMap;
+    UBaseType_t uxFirstLevel = *puxFirstLevel;
+
+    /* A list of the same first level, at or above the second level. */
+    ulMap = ulSecondLevelBitmaps[ uxFirstLevel ] & ( ~( ( uint32_t ) 0 ) << *puxSecondLevel );
+
+    if( ulMap == 0 )
+    {
+        /* None, take the smallest list of the next first level that has one. */
+        ulMap = ulFirstLevelBitmap & ( ~( ( uint32_t ) 0 ) << ( uxFirstLevel + 1U ) );
+
+        if( ulMap == 0 )
+        {
+            return NULL;
+        }
+
+        uxFirstLevel = prvFindFirstSet( ulMap );
+        ulMap = ulSecondLevelBitmaps[ uxFirstLevel ];
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    *puxFirstLevel = uxFirstLevel;
+    *puxSecondLevel = prvFindFirstSet( ulMap );
+
+    return pxFreeLists[ uxFirstLevel ][ *puxSecondLevel ];
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    BlockLink_t * pxHead;
+
+    prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+    configASSERT( uxFirstLevel < ( UBaseType_t ) heapFL_INDEX_COUNT );
+
+    pxHead = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+    pxBlock->pxNextFreeBlock = pxHead;
+    pxBlock->pxPrevFreeBlock = NULL;
+
+    if( pxHead != NULL )
+    {
+        pxHead->pxPrevFreeBlock = pxBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+    ulFirstLevelBitmap |= ( uint32_t ) 1 << uxFirstLevel;
+    ulSecondLevelBitmaps[ uxFirstLevel ] |= ( uint32_t ) 1 << uxSecondLevel;
+    xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFirstLevel, &uxSecondLevel );
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock->pxPrevFreeBlock != NULL )
+    {
+        pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was the head of its list. */
+        pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+        if( pxBlock->pxNextFreeBlock == NULL )
+        {
+            ulSecondLevelBitmaps[ uxFirstLevel ] &= ~( ( uint32_t ) 1 << uxSecondLevel );
+
+            if( ulSecondLevelBitmaps[ uxFirstLevel ] == 0 )
+            {
+                ulFirstLevelBitmap &= ~( ( uint32_t ) 1 << uxFirstLevel );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        /* The bitmaps are empty if the heap has not been initialised.  The heap
+         * is initialised automatically when the first allocation is made. */
+        if( ulFirstLevelBitmap != 0 )
+        {
+            xBlocks = xNumberOfFreeBlocks;
+
+            /* The largest block is in the highest non empty size class and the
+             * smallest in the lowest one, so only those two lists are walked. */
+            uxFirstLevel = prvFindLastSet( ulFirstLevelBitmap );
+            uxSecondLevel = prvFindLastSet( ulSecondLevelBitmaps[ uxFirstLevel ] );
+
+            for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( heapBLOCK_SIZE( pxBlock ) > xMaxSize )
+                {
+                    xMaxSize = heapBLOCK_SIZE( pxBlock );
+                }
+            }
+
+            uxFirstLevel = prvFindFirstSet( ulFirstLevelBitmap );
+            uxSecondLevel = prvFindFirstSet( ulSecondLevelBitmaps[ uxFirstLevel ] );
+
+            for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+            {
+                if( heapBLOCK_SIZE( pxBlock ) < xMinSize )
+                {
+                    xMinSize = heapBLOCK_SIZE( pxBlock );
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
@@ -48,9 +48,13 @@
 * stdio (printf() and friends) should be called from a single task
 * only or serialized with a FreeRTOS primitive such as a binary
 * semaphore or mutex.
+*
+* With configNUMBER_OF_CORES above 1 the threads of configNUMBER_OF_CORES
+* tasks run at once, one per simulated core.  The kernel data is guarded by
+* a single kernel lock, held by a core for as long as it is in a critical
+* section, an interrupt or has the scheduler suspended.  A core makes
+* another one select its task again with the SIG_YIELD_CORE signal.
 *----------------------------------------------------------*/
-#include "portmacro.h"
-
 #include <errno.h>
 #include <pthread.h>
 #include <signal.h>
@@ -70,6 +74,29 @@
 
 #define SIG_RESUME    SIGUSR1
 
+#if ( configNUMBER_OF_CORES > 1 )
+    #define SIG_YIELD_CORE    SIGUSR2
+#endif
+
+#ifndef configUSE_VIRTUAL_TIME
+    #define configUSE_VIRTUAL_TIME    0
+#endif
+
+#ifndef configVIRTUAL_TICK_MICROSECONDS
+    #define configVIRTUAL_TICK_MICROSECONDS    100
+#endif
+
+/* Host time between two tick interrupts. */
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    #define prvTIMER_INTERVAL_MICROSECONDS    ( configVIRTUAL_TICK_MICROSECONDS )
+#else
+    #define prvTIMER_INTERVAL_MICROSECONDS    ( portTICK_RATE_MICROSECONDS )
+#endif
+
+/* Most ticks vPortAdvanceVirtualTime() takes in one call, so the idle task
+ * still runs now and then when nothing wakes up. */
+#define portVIRTUAL_IDLE_TICKS_MAX    ( ( UBaseType_t ) 1000 )
+
 typedef struct THREAD
 {
     pthread_t pthread;
@@ -77,6 +104,9 @@ typedef struct THREAD
     void * pvParams;
     BaseType_t xDying;
     struct event * ev;
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xCoreID; /* The core the thread runs as, set by the thread that resumes it. */
+    #endif
 } Thread_t;
 
 /*
@@ -96,12 +126,41 @@ static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
 static sigset_t xAllSignals;
 static sigset_t xSchedulerOriginalSignalMask;
 static pthread_t hMainThread = ( pthread_t ) NULL;
-static volatile portBASE_TYPE uxCriticalNesting;
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* Several threads run at once, so the critical nesting and the interrupt
+ * mask are kept per thread, as is the core the thread runs as. */
+    static __thread volatile portBASE_TYPE uxCriticalNesting;
+    static __thread BaseType_t xInterruptsMasked = pdFALSE;
+    static __thread BaseType_t xThreadCoreID = 0;
+
+/* The core that holds the kernel lock, -1 when it is free, and how many
+ * times that core has taken it.  The lock belongs to a core rather than to a
+ * thread, as it is handed over with the core on a task switch, so it is not a
+ * pthread mutex itself: the mutex only guards the owner while a core waits
+ * for it on the condition variable. */
+    static volatile BaseType_t xKernelLockOwner = -1;
+    static volatile UBaseType_t uxKernelLockCount = 0;
+    static pthread_mutex_t xKernelLockMutex = PTHREAD_MUTEX_INITIALIZER;
+    static pthread_cond_t xKernelLockFree = PTHREAD_COND_INITIALIZER;
+
+/* The cores stopped by vPortEndScheduler(), see prvParkCore(). */
+    static volatile UBaseType_t uxParkedCores = 0;
+#else
+    static volatile portBASE_TYPE uxCriticalNesting;
+#endif
 /*-----------------------------------------------------------*/
 
 static portBASE_TYPE xSchedulerEnd = pdFALSE;
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    static unsigned long ulSuppressedTicks = 0;
+#endif
+/*-----------------------------------------------------------*/
+
 static void prvSetupSignalsAndSchedulerPolicy( void );
 static void prvSetupTimerInterrupt( void );
 static void * prvWaitForStart( void * pvParams );
@@ -110,6 +169,11 @@ static void prvSwitchThread( Thread_t * xThreadToResume,
 static void prvSuspendSelf( Thread_t * thread );
 static void prvResumeThread( Thread_t * xThreadId );
 static void vPortSystemTickHandler( int sig );
+#if ( configNUMBER_OF_CORES > 1 )
+    static void vPortYieldCoreHandler( int sig );
+    static void prvFreeKernelLock( void );
+    static void prvParkCore( Thread_t * pxThread );
+#endif
 static void vPortStartFirstTask( void );
 static void prvPortYieldFromISR( void );
 /*-----------------------------------------------------------*/
@@ -146,6 +210,9 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
     thread->pxCode = pxCode;
     thread->pvParams = pvParameters;
     thread->xDying = pdFALSE;
+    #if ( configNUMBER_OF_CORES > 1 )
+        thread->xCoreID = 0;
+    #endif
 
     pthread_attr_init( &xThreadAttributes );
     iRet = pthread_attr_setstack( &xThreadAttributes, pxEndOfStack, ulStackSize );
@@ -175,10 +242,32 @@ portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
 
 void vPortStartFirstTask( void )
 {
-    Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        Thread_t * pxFirstThreads[ configNUMBER_OF_CORES ];
+        BaseType_t xCoreID;
 
-    /* Start the first task. */
-    prvResumeThread( pxFirstThread );
+        /* The kernel has selected a task for each core.  The first one starts
+         * as soon as it is resumed, so all are looked up beforehand. */
+        for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
+        {
+            pxFirstThreads[ xCoreID ] = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+            pxFirstThreads[ xCoreID ]->xCoreID = xCoreID;
+        }
+
+        for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
+        {
+            prvResumeThread( pxFirstThreads[ xCoreID ] );
+        }
+    }
+    #else
+    {
+        Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        /* Start the first task. */
+        prvResumeThread( pxFirstThread );
+    }
+    #endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -215,7 +304,24 @@ portBASE_TYPE xPortStartScheduler( void )
     }
 
     /* Cancel the Idle task and free its resources */
-    #if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        BaseType_t xCoreID;
+        const struct timespec xTick = { 0, prvTIMER_INTERVAL_MICROSECONDS * 1000L };
+
+        /* Not before every core has stopped, or one could still switch to an
+         * idle task whose thread is gone. */
+        while( __atomic_load_n( &uxParkedCores, __ATOMIC_ACQUIRE ) < ( UBaseType_t ) configNUMBER_OF_CORES )
+        {
+            ( void ) nanosleep( &xTick, NULL );
+        }
+
+        for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
+        {
+            vPortCancelThread( xTaskGetIdleTaskHandleForCore( xCoreID ) );
+        }
+    }
+    #elif ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
         vPortCancelThread( xTaskGetIdleTaskHandle() );
     #endif
 
@@ -253,10 +359,31 @@ void vPortEndScheduler( void )
 
     /* Signal the scheduler to exit its loop. */
     xSchedulerEnd = pdTRUE;
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        BaseType_t xCoreID;
+
+        /* The other cores stop in vPortYieldCoreHandler(). */
+        for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
+        {
+            if( xCoreID != xThreadCoreID )
+            {
+                vPortYieldCore( xCoreID );
+            }
+        }
+    }
+    #endif
+
     ( void ) pthread_kill( hMainThread, SIG_RESUME );
 
     xCurrentThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
-    prvSuspendSelf( xCurrentThread );
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        prvParkCore( xCurrentThread );
+    #else
+        prvSuspendSelf( xCurrentThread );
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -267,6 +394,10 @@ void vPortEnterCritical( void )
         vPortDisableInterrupts();
     }
 
+    #if ( configNUMBER_OF_CORES > 1 )
+        vPortGetKernelLock();
+    #endif
+
     uxCriticalNesting++;
 }
 /*-----------------------------------------------------------*/
@@ -275,6 +406,10 @@ void vPortExitCritical( void )
 {
     uxCriticalNesting--;
 
+    #if ( configNUMBER_OF_CORES > 1 )
+        vPortReleaseKernelLock();
+    #endif
+
     /* If we have reached 0 then re-enable the interrupts. */
     if( uxCriticalNesting == 0 )
     {
@@ -283,6 +418,102 @@ void vPortExitCritical( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+    BaseType_t xPortGetCoreID( void )
+    {
+        return xThreadCoreID;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetKernelLock( void )
+    {
+        /* Taken with the interrupts masked only, so the calling thread cannot
+         * be switched out while its core owns the lock.  A waiting core sleeps
+         * rather than spins: the host may have fewer processors than there are
+         * cores, and a thread that keeps yielding the processor is the last
+         * one the host scheduler runs again. */
+        if( xKernelLockOwner != xThreadCoreID )
+        {
+            pthread_mutex_lock( &xKernelLockMutex );
+
+            while( xKernelLockOwner != -1 )
+            {
+                pthread_cond_wait( &xKernelLockFree, &xKernelLockMutex );
+            }
+
+            xKernelLockOwner = xThreadCoreID;
+            pthread_mutex_unlock( &xKernelLockMutex );
+        }
+
+        uxKernelLockCount++;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFreeKernelLock( void )
+    {
+        pthread_mutex_lock( &xKernelLockMutex );
+        uxKernelLockCount = 0;
+        xKernelLockOwner = -1;
+        pthread_cond_signal( &xKernelLockFree );
+        pthread_mutex_unlock( &xKernelLockMutex );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvParkCore( Thread_t * pxThread )
+    {
+        /* The scheduler has ended: the thread of the core stops where it is,
+         * until it is cancelled, without the kernel lock so the other cores
+         * can get to their own stop. */
+        if( xKernelLockOwner == xThreadCoreID )
+        {
+            prvFreeKernelLock();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) __atomic_add_fetch( &uxParkedCores, 1, __ATOMIC_RELEASE );
+
+        for( ; ; )
+        {
+            prvSuspendSelf( pxThread );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortReleaseKernelLock( void )
+    {
+        if( uxKernelLockCount == ( UBaseType_t ) 1 )
+        {
+            prvFreeKernelLock();
+        }
+        else
+        {
+            uxKernelLockCount--;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetCriticalNesting( void )
+    {
+        return ( UBaseType_t ) uxCriticalNesting;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortYieldCore( BaseType_t xCoreID )
+    {
+        Thread_t * pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandleForCore( xCoreID ) );
+
+        /* Called with the kernel lock held, so the task stays the one of
+         * xCoreID until the signal handler runs. */
+        ( void ) pthread_kill( pxThread->pthread, SIG_YIELD_CORE );
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configNUMBER_OF_CORES */
+
 static void prvPortYieldFromISR( void )
 {
     Thread_t * xThreadToSuspend;
@@ -311,26 +542,69 @@ void vPortYield( void )
 void vPortDisableInterrupts( void )
 {
     pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        xInterruptsMasked = pdTRUE;
+    #endif
 }
 /*-----------------------------------------------------------*/
 
 void vPortEnableInterrupts( void )
 {
+    #if ( configNUMBER_OF_CORES > 1 )
+        xInterruptsMasked = pdFALSE;
+    #endif
+
     pthread_sigmask( SIG_UNBLOCK, &xAllSignals, NULL );
 }
 /*-----------------------------------------------------------*/
 
 portBASE_TYPE xPortSetInterruptMask( void )
 {
-    /* Interrupts are always disabled inside ISRs (signals
-     * handlers). */
-    return pdTRUE;
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* The FromISR functions can also be called from a task on one core
+         * while another core is in the kernel, so they take the kernel lock.
+         * The return value tells whether the interrupts were masked already. */
+        portBASE_TYPE xWasMasked = xInterruptsMasked;
+
+        if( xWasMasked == pdFALSE )
+        {
+            vPortDisableInterrupts();
+        }
+
+        vPortGetKernelLock();
+        uxCriticalNesting++;
+
+        return xWasMasked;
+    }
+    #else
+    {
+        /* Interrupts are always disabled inside ISRs (signals
+         * handlers). */
+        return pdTRUE;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
 void vPortClearInterruptMask( portBASE_TYPE xMask )
 {
-    ( void ) xMask;
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        uxCriticalNesting--;
+        vPortReleaseKernelLock();
+
+        if( xMask == pdFALSE )
+        {
+            vPortEnableInterrupts();
+        }
+    }
+    #else
+    {
+        ( void ) xMask;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -368,11 +642,11 @@ void prvSetupTimerInterrupt( void )
 
     /* Set the interval between timer events. */
     itimer.it_interval.tv_sec = 0;
-    itimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+    itimer.it_interval.tv_usec = prvTIMER_INTERVAL_MICROSECONDS;
 
     /* Set the current count-down. */
     itimer.it_value.tv_sec = 0;
-    itimer.it_value.tv_usec = portTICK_RATE_MICROSECONDS;
+    itimer.it_value.tv_usec = prvTIMER_INTERVAL_MICROSECONDS;
 
     /* Set-up the timer interrupt. */
     iRet = setitimer( ITIMER_REAL, &itimer, NULL );
@@ -391,12 +665,21 @@ static void vPortSystemTickHandler( int sig )
     Thread_t * pxThreadToSuspend;
     Thread_t * pxThreadToResume;
 
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xWasMasked = xInterruptsMasked;
+    #endif
+
     ( void ) sig;
 
 /* uint64_t xExpectedTicks; */
 
     uxCriticalNesting++; /* Signals are blocked in this signal handler. */
 
+    #if ( configNUMBER_OF_CORES > 1 )
+        xInterruptsMasked = pdTRUE;
+        vPortGetKernelLock();
+    #endif
+
     #if ( configUSE_PREEMPTION == 1 )
         pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
     #endif
@@ -424,10 +707,132 @@ static void vPortSystemTickHandler( int sig )
         prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
     #endif
 
+    #if ( configNUMBER_OF_CORES > 1 )
+        vPortReleaseKernelLock();
+        xInterruptsMasked = xWasMasked;
+    #endif
+
     uxCriticalNesting--;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static void vPortYieldCoreHandler( int sig )
+    {
+        Thread_t * pxThreadToSuspend;
+        BaseType_t xWasMasked = xInterruptsMasked;
+
+        ( void ) sig;
+
+        if( xSchedulerEnd == pdTRUE )
+        {
+            /* vPortEndScheduler() was called on another core. */
+            prvParkCore( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ) );
+        }
+
+        /* As the tick handler, without the tick.  The task that made the
+         * request may have changed its mind, or the thread may have moved to
+         * another core in the meantime, either way the core selects again. */
+        uxCriticalNesting++;
+        xInterruptsMasked = pdTRUE;
+        vPortGetKernelLock();
+
+        pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        vTaskSwitchContext();
+
+        prvSwitchThread( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ), pxThreadToSuspend );
+
+        vPortReleaseKernelLock();
+        xInterruptsMasked = xWasMasked;
+        uxCriticalNesting--;
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+void vPortAdvanceVirtualTime( void )
+{
+    /* With tickless idle the kernel knows which tick the idle time ends at,
+     * and vPortSuppressTicksAndSleep() steps to it in one go. */
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* An idle core says nothing about the others, which may still have
+         * work before the next tick.  Leave the host processor to them until
+         * the next signal, a tick or a request to select again.  Sleeping is
+         * also a cancellation point, for the idle tasks still running when
+         * the scheduler ends: the other cores stop only when they next
+         * switch. */
+        const struct timespec xTick = { 0, prvTIMER_INTERVAL_MICROSECONDS * 1000L };
+
+        ( void ) nanosleep( &xTick, NULL );
+    }
+    #elif ( configUSE_VIRTUAL_TIME == 1 ) && ( configUSE_TICKLESS_IDLE == 0 )
+    {
+        TaskHandle_t xIdleTask = xTaskGetCurrentTaskHandle();
+        UBaseType_t uxTicks = 0;
+
+        /* Called from the idle task: nothing else is ready, so nothing can
+         * happen before the next tick.  Do what the tick handler would do, one
+         * tick after the other, until a tick makes another task run.  Taking
+         * the ticks here rather than raising the timer signal for each saves
+         * the signal round trip, which is most of the cost of an idle tick. */
+        vPortEnterCritical();
+
+        do
+        {
+            ( void ) xTaskIncrementTick();
+            vTaskSwitchContext();
+            uxTicks++;
+        } while( ( xTaskGetCurrentTaskHandle() == xIdleTask ) && ( uxTicks < portVIRTUAL_IDLE_TICKS_MAX ) );
+
+        prvSwitchThread( prvGetThreadFromTask( xTaskGetCurrentTaskHandle() ), prvGetThreadFromTask( xIdleTask ) );
+
+        vPortExitCritical();
+    }
+    #endif /* configUSE_VIRTUAL_TIME */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+        #if ( configUSE_VIRTUAL_TIME == 1 )
+        {
+            /* Nothing but the timer signal can happen before the tick the
+             * kernel expects the idle time to end at, so there is nothing to
+             * wait for: step over the ticks in between at once.  The last tick
+             * is left pending by vTaskStepTick() and processed by
+             * xTaskResumeAll() when the idle task resumes the scheduler. */
+            vPortEnterCritical();
+
+            if( eTaskConfirmSleepModeStatus() == eStandardSleep )
+            {
+                vTaskStepTick( xExpectedIdleTime );
+                ulSuppressedTicks += ( unsigned long ) ( xExpectedIdleTime - 1 );
+            }
+
+            vPortExitCritical();
+        }
+        #else
+        {
+            /* In real time the idle task keeps taking every tick. */
+            ( void ) xExpectedIdleTime;
+        }
+        #endif /* configUSE_VIRTUAL_TIME */
+    }
+/*-----------------------------------------------------------*/
+
+    unsigned long ulPortGetSuppressedTicks( void )
+    {
+        return ulSuppressedTicks;
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
 void vPortThreadDying( void * pxTaskToDelete,
                        volatile BaseType_t * pxPendYield )
 {
@@ -457,6 +862,20 @@ static void * prvWaitForStart( void * pvParams )
 
     prvSuspendSelf( pxThread );
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        xThreadCoreID = pxThread->xCoreID;
+
+        /* Resumed by a switch on this core, which holds the kernel lock for
+         * the thread it suspended.  This thread has no critical section to
+         * leave, so it lets the lock go. */
+        if( xKernelLockOwner == xThreadCoreID )
+        {
+            prvFreeKernelLock();
+        }
+    }
+    #endif
+
     /* Resumed for the first time, unblocks all signals. */
     uxCriticalNesting = 0;
     vPortEnableInterrupts();
@@ -491,6 +910,19 @@ static void prvSwitchThread( Thread_t * pxThreadToResume,
          */
         uxSavedCriticalNesting = uxCriticalNesting;
 
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            /* A core that missed the SIG_YIELD_CORE of vPortEndScheduler(),
+             * sent to the thread it was running then. */
+            if( xSchedulerEnd == pdTRUE )
+            {
+                prvParkCore( pxThreadToSuspend );
+            }
+
+            pxThreadToResume->xCoreID = xThreadCoreID;
+        }
+        #endif
+
         prvResumeThread( pxThreadToResume );
 
         if( pxThreadToSuspend->xDying == pdTRUE )
@@ -501,6 +933,16 @@ static void prvSwitchThread( Thread_t * pxThreadToResume,
         prvSuspendSelf( pxThreadToSuspend );
 
         uxCriticalNesting = uxSavedCriticalNesting;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            /* Possibly on another core than before.  The lock of that core
+             * is handed over with it, held as often as this thread holds it:
+             * always from within a critical section or a signal handler. */
+            xThreadCoreID = pxThreadToSuspend->xCoreID;
+            uxKernelLockCount = ( UBaseType_t ) uxCriticalNesting;
+        }
+        #endif
     }
 }
 /*-----------------------------------------------------------*/
@@ -569,6 +1011,18 @@ static void prvSetupSignalsAndSchedulerPolicy( void )
     {
         prvFatalError( "sigaction", errno );
     }
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        sigtick.sa_handler = vPortYieldCoreHandler;
+        iRet = sigaction( SIG_YIELD_CORE, &sigtick, NULL );
+
+        if( iRet == -1 )
+        {
+            prvFatalError( "sigaction", errno );
+        }
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -104,6 +104,29 @@ extern void vPortExitCritical( void );
 
 /*-----------------------------------------------------------*/
 
+/*
+ * Simulated multi core.  With configNUMBER_OF_CORES above 1 the threads of as
+ * many tasks run at the same time, each as one core, and the host schedules
+ * them on whatever processors it has.  All the kernel data is guarded by one
+ * kernel lock, recursive for the core that holds it, which the critical
+ * sections and the signal handlers take.  portYIELD_CORE() makes another core
+ * select its task again, as an inter-processor interrupt would.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+	extern BaseType_t xPortGetCoreID( void );
+	extern void vPortYieldCore( BaseType_t xCoreID );
+	extern void vPortGetKernelLock( void );
+	extern void vPortReleaseKernelLock( void );
+	extern UBaseType_t uxPortGetCriticalNesting( void );
+
+	#define portGET_CORE_ID()						xPortGetCoreID()
+	#define portYIELD_CORE( xCoreID )				vPortYieldCore( xCoreID )
+	#define portGET_KERNEL_LOCK()					vPortGetKernelLock()
+	#define portRELEASE_KERNEL_LOCK()				vPortReleaseKernelLock()
+	#define portGET_CRITICAL_NESTING_COUNT()		uxPortGetCriticalNesting()
+#endif
+/*-----------------------------------------------------------*/
+
 extern void vPortThreadDying( void *pxTaskToDelete, volatile BaseType_t *pxPendYield );
 extern void vPortCancelThread( void *pxTaskToDelete );
 #define portPRE_TASK_DELETE_HOOK( pvTaskToDelete, pxPendYield ) vPortThreadDying( ( pvTaskToDelete ), ( pxPendYield ) )
@@ -124,6 +147,30 @@ extern void vPortCancelThread( void *pxTaskToDelete );
  */
 #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
 
+/*
+ * Virtual time.  With configUSE_VIRTUAL_TIME set to 1 the tick interrupt is
+ * raised every configVIRTUAL_TICK_MICROSECONDS of host time instead of every
+ * tick period, and vPortAdvanceVirtualTime(), called from the idle hook, takes
+ * the following ticks at once until one of them wakes a task, so the time the
+ * system would spend idle costs next to nothing.  Work that is measured in
+ * ticks, as in the busy loops of the scheduler demos, gives the same schedule
+ * as in real time; work measured in host time takes more ticks.
+ */
+extern void vPortAdvanceVirtualTime( void );
+
+/*
+ * Tickless idle.  In virtual time the ticks up to the next one the kernel has
+ * work for are stepped over in one go, in place of vPortAdvanceVirtualTime(),
+ * and ulPortGetSuppressedTicks() returns how many ticks were not processed one
+ * by one.  In real time the idle task still takes every tick.
+ */
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+    extern unsigned long ulPortGetSuppressedTicks( void );
+    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )    vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+/*-----------------------------------------------------------*/
+
 extern unsigned long ulPortGetRunTime( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() /* no-op */
 #define portGET_RUN_TIME_COUNTER_VALUE()         ulPortGetRunTime()
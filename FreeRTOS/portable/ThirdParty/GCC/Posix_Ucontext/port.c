@@ -0,0 +1,624 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2020 Cambridge Consultants Ltd.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*-----------------------------------------------------------
+* Implementation of functions defined in portable.h for the Posix port,
+* with every task on the one host thread.
+*
+* The Posix port in ../Posix runs each task as a pthread and hands the
+* processor over through a condition variable, so each context switch costs
+* two trips through the host kernel and a host scheduling decision.  Here the
+* tasks are coroutines of a single thread: a context switch saves the callee
+* saved registers on the stack of the task that stops and loads the stack
+* pointer of the task that runs, with a few instructions of assembly on
+* x86-64 and swapcontext() elsewhere.
+*
+* The tick is still a SIGALRM from setitimer(), so a task that never blocks is
+* preempted as on the target, and the virtual time of the Posix port works
+* unchanged.  Interrupts are masked in software: a critical section only sets
+* a flag, and a tick that arrives while the flag is set is counted and taken
+* when the critical section ends, without a system call on either side.  The
+* handler switches tasks from inside the signal, which is installed with
+* SA_NODEFER, so the signal mask of the thread never changes and the task
+* switched to carries on as if it had never stopped.
+*
+* As with the Posix port, the C library is not reentrant across a task
+* switch: stdio must be called from a single task or from a critical section,
+* and the heap from heap_3.c (which suspends the scheduler) or another
+* FreeRTOS heap.
+*----------------------------------------------------------*/
+#include "portmacro.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sys/times.h>
+
+#if !defined( __x86_64__ )
+    #include <ucontext.h>
+#endif
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+/*-----------------------------------------------------------*/
+
+#ifndef configUSE_VIRTUAL_TIME
+    #define configUSE_VIRTUAL_TIME    0
+#endif
+
+#ifndef configVIRTUAL_TICK_MICROSECONDS
+    #define configVIRTUAL_TICK_MICROSECONDS    100
+#endif
+
+/* Host time between two tick interrupts. */
+#if ( configUSE_VIRTUAL_TIME == 1 )
+    #define prvTIMER_INTERVAL_MICROSECONDS    ( configVIRTUAL_TICK_MICROSECONDS )
+#else
+    #define prvTIMER_INTERVAL_MICROSECONDS    ( portTICK_RATE_MICROSECONDS )
+#endif
+
+/* Most ticks vPortAdvanceVirtualTime() takes in one call, so the idle task
+ * still runs now and then when nothing wakes up. */
+#define portVIRTUAL_IDLE_TICKS_MAX    ( ( UBaseType_t ) 1000 )
+
+/* Alignment of the stack pointer the System V ABIs require at a call. */
+#define portSTACK_ALIGNMENT_MASK      ( ( uintptr_t ) 15 )
+
+#if defined( __x86_64__ )
+    /* MXCSR and x87 control word a task starts with, the defaults of the ABI. */
+    #define portINITIAL_MXCSR         ( ( uint64_t ) 0x1F80 )
+    #define portINITIAL_FPU_CW        ( ( uint64_t ) 0x037F )
+#endif
+
+typedef struct CONTEXT
+{
+    #if defined( __x86_64__ )
+        void * pvStackPointer; /* Where prvSwapStacks() left the registers of the task. */
+    #else
+        ucontext_t xContext;
+    #endif
+    pdTASK_CODE pxCode;
+    void * pvParams;
+} Context_t;
+
+/*
+ * The context is stored at the beginning of the task's stack, as the Posix
+ * port stores its thread data.
+ */
+static inline Context_t * prvGetContextFromTask( TaskHandle_t xTask )
+{
+    StackType_t * pxTopOfStack = *( StackType_t ** ) xTask;
+
+    return ( Context_t * ) ( pxTopOfStack + 1 );
+}
+
+/*-----------------------------------------------------------*/
+
+/* The context of the caller of xPortStartScheduler(), resumed by
+ * vPortEndScheduler(). */
+static Context_t xSchedulerContext;
+static volatile portBASE_TYPE uxCriticalNesting;
+
+/* The interrupt mask, and the ticks that arrived while it was set.  Masked
+ * until the first task starts. */
+static volatile sig_atomic_t xInterruptsMasked = 1;
+static volatile sig_atomic_t xPendingTicks = 0;
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    static unsigned long ulSuppressedTicks = 0;
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvSetupTimerInterrupt( void );
+static void prvTaskEntry( void );
+static void prvSwitchContext( Context_t * pxContextToResume,
+                              Context_t * pxContextToSuspend );
+static void prvTickInterrupt( void );
+static void prvTakePendingTicks( void );
+static void prvTimerSignalHandler( int iSignal );
+static void vPortStartFirstTask( void );
+/*-----------------------------------------------------------*/
+
+#if defined( __x86_64__ )
+
+/*
+ * Saves the callee saved registers, MXCSR and the x87 control word of the
+ * caller on its stack, stores its stack pointer in *ppvSaveStackPointer, and
+ * returns on the stack pvNewStackPointer, saved by an earlier call or built by
+ * pxPortInitialiseStack().
+ */
+    void prvSwapStacks( void ** ppvSaveStackPointer,
+                        void * pvNewStackPointer );
+
+    __asm__ (
+        "    .text                          \n"
+        "    .p2align 4                     \n"
+        "    .type prvSwapStacks, @function \n"
+        "prvSwapStacks:                     \n"
+        "    pushq %rbp                     \n"
+        "    pushq %rbx                     \n"
+        "    pushq %r12                     \n"
+        "    pushq %r13                     \n"
+        "    pushq %r14                     \n"
+        "    pushq %r15                     \n"
+        "    subq $8, %rsp                  \n"
+        "    stmxcsr (%rsp)                 \n"
+        "    fnstcw 4(%rsp)                 \n"
+        "    movq %rsp, (%rdi)              \n"
+        "    movq %rsi, %rsp                \n"
+        "    ldmxcsr (%rsp)                 \n"
+        "    fldcw 4(%rsp)                  \n"
+        "    addq $8, %rsp                  \n"
+        "    popq %r15                      \n"
+        "    popq %r14                      \n"
+        "    popq %r13                      \n"
+        "    popq %r12                      \n"
+        "    popq %rbx                      \n"
+        "    popq %rbp                      \n"
+        "    ret                            \n"
+        "    .size prvSwapStacks, .-prvSwapStacks \n"
+        );
+
+#endif /* __x86_64__ */
+/*-----------------------------------------------------------*/
+
+static void prvFatalError( const char * pcCall,
+                           int iErrno )
+{
+    fprintf( stderr, "%s: %s\n", pcCall, strerror( iErrno ) );
+    abort();
+}
+
+/*
+ * See header file for description.
+ */
+portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
+                                        portSTACK_TYPE * pxEndOfStack,
+                                        pdTASK_CODE pxCode,
+                                        void * pvParameters )
+{
+    Context_t * pxContext;
+    uintptr_t uxStackTop;
+
+    /*
+     * Store the context at the start of the stack, the task runs below it.
+     */
+    pxContext = ( Context_t * ) ( pxTopOfStack + 1 ) - 1;
+    pxTopOfStack = ( portSTACK_TYPE * ) pxContext - 1;
+    uxStackTop = ( uintptr_t ) pxContext & ~portSTACK_ALIGNMENT_MASK;
+
+    pxContext->pxCode = pxCode;
+    pxContext->pvParams = pvParameters;
+
+    #if defined( __x86_64__ )
+    {
+        uint64_t * pullFrame = ( uint64_t * ) uxStackTop;
+
+        ( void ) pxEndOfStack;
+
+        /* The frame prvSwapStacks() returns through: the return address of
+         * prvTaskEntry(), which it never uses, prvTaskEntry() itself, the six
+         * callee saved registers and the floating point control words.  The
+         * stack pointer is 8 bytes past a 16 byte boundary once prvTaskEntry()
+         * is entered, as after a call. */
+        *( --pullFrame ) = 0;
+        *( --pullFrame ) = ( uint64_t ) ( uintptr_t ) prvTaskEntry;
+        pullFrame -= 6;
+        memset( pullFrame, 0, 6 * sizeof( uint64_t ) );
+        *( --pullFrame ) = portINITIAL_MXCSR | ( portINITIAL_FPU_CW << 32 );
+
+        pxContext->pvStackPointer = pullFrame;
+    }
+    #else
+    {
+        if( getcontext( &( pxContext->xContext ) ) != 0 )
+        {
+            prvFatalError( "getcontext", errno );
+        }
+
+        pxContext->xContext.uc_stack.ss_sp = pxEndOfStack;
+        pxContext->xContext.uc_stack.ss_size = ( size_t ) ( uxStackTop - ( uintptr_t ) pxEndOfStack );
+        pxContext->xContext.uc_link = NULL;
+        makecontext( &( pxContext->xContext ), prvTaskEntry, 0 );
+    }
+    #endif /* __x86_64__ */
+
+    return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+void vPortStartFirstTask( void )
+{
+    Context_t * pxFirstContext = prvGetContextFromTask( xTaskGetCurrentTaskHandle() );
+
+    /* Start the first task, and come back here from vPortEndScheduler(). */
+    prvSwitchContext( pxFirstContext, &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+portBASE_TYPE xPortStartScheduler( void )
+{
+    struct sigaction sigtick;
+
+    /* The tick interrupt.  SA_NODEFER leaves the signal unblocked while the
+     * handler runs, as the handler switches to other tasks that must keep
+     * taking ticks, and the software mask keeps it from nesting.  SA_RESTART
+     * restarts a system call the tick interrupts, such as the write() of a
+     * printf() inside a critical section. */
+    sigtick.sa_flags = SA_NODEFER | SA_RESTART;
+    sigtick.sa_handler = prvTimerSignalHandler;
+    sigemptyset( &sigtick.sa_mask );
+
+    if( sigaction( SIGALRM, &sigtick, NULL ) == -1 )
+    {
+        prvFatalError( "sigaction", errno );
+    }
+
+    /* Start the timer that generates the tick ISR(SIGALRM).
+     * Interrupts are disabled here already. */
+    prvSetupTimerInterrupt();
+
+    /* Start the first task.  Returns once vPortEndScheduler() is called. */
+    vPortStartFirstTask();
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+    struct itimerval itimer;
+    struct sigaction sigtick;
+
+    /* Stop the timer and ignore any SIGALRM still on its way. */
+    itimer.it_value.tv_sec = 0;
+    itimer.it_value.tv_usec = 0;
+
+    itimer.it_interval.tv_sec = 0;
+    itimer.it_interval.tv_usec = 0;
+    ( void ) setitimer( ITIMER_REAL, &itimer, NULL );
+
+    sigtick.sa_flags = 0;
+    sigtick.sa_handler = SIG_IGN;
+    sigemptyset( &sigtick.sa_mask );
+    sigaction( SIGALRM, &sigtick, NULL );
+
+    /* Return from xPortStartScheduler().  The stacks of the tasks are left as
+     * they are, the task that ended the scheduler is never resumed. */
+    xInterruptsMasked = 1;
+    xPendingTicks = 0;
+    prvSwitchContext( &xSchedulerContext, prvGetContextFromTask( xTaskGetCurrentTaskHandle() ) );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+    if( uxCriticalNesting == 0 )
+    {
+        vPortDisableInterrupts();
+    }
+
+    uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+    uxCriticalNesting--;
+
+    /* If we have reached 0 then re-enable the interrupts. */
+    if( uxCriticalNesting == 0 )
+    {
+        vPortEnableInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+    Context_t * pxContextToSuspend;
+    Context_t * pxContextToResume;
+
+    vPortEnterCritical();
+
+    pxContextToSuspend = prvGetContextFromTask( xTaskGetCurrentTaskHandle() );
+
+    vTaskSwitchContext();
+
+    pxContextToResume = prvGetContextFromTask( xTaskGetCurrentTaskHandle() );
+
+    prvSwitchContext( pxContextToResume, pxContextToSuspend );
+
+    vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+    xInterruptsMasked = 1;
+    portMEMORY_BARRIER();
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+    portMEMORY_BARRIER();
+    xInterruptsMasked = 1;
+    prvTakePendingTicks();
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortSetInterruptMask( void )
+{
+    /* Interrupts are always disabled inside ISRs (signals
+     * handlers). */
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( portBASE_TYPE xMask )
+{
+    ( void ) xMask;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Setup the systick timer to generate the tick interrupts at the required
+ * frequency.
+ */
+void prvSetupTimerInterrupt( void )
+{
+    struct itimerval itimer;
+
+    /* Set the interval between timer events. */
+    itimer.it_interval.tv_sec = 0;
+    itimer.it_interval.tv_usec = prvTIMER_INTERVAL_MICROSECONDS;
+
+    /* Set the current count-down. */
+    itimer.it_value.tv_sec = 0;
+    itimer.it_value.tv_usec = prvTIMER_INTERVAL_MICROSECONDS;
+
+    /* Set-up the timer interrupt. */
+    if( setitimer( ITIMER_REAL, &itimer, NULL ) == -1 )
+    {
+        prvFatalError( "setitimer", errno );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTimerSignalHandler( int iSignal )
+{
+    ( void ) iSignal;
+
+    /* Count the tick, and take it now unless interrupts are masked, in which
+     * case vPortEnableInterrupts() takes it. */
+    __atomic_add_fetch( &xPendingTicks, 1, __ATOMIC_RELAXED );
+
+    if( xInterruptsMasked == 0 )
+    {
+        xInterruptsMasked = 1;
+        prvTakePendingTicks();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTakePendingTicks( void )
+{
+    /* Called with interrupts masked, returns with them enabled.  A tick that
+     * arrives after the last look at xPendingTicks but before the mask is
+     * cleared is only counted, so look again once it is. */
+    for( ; ; )
+    {
+        while( __atomic_load_n( &xPendingTicks, __ATOMIC_RELAXED ) != 0 )
+        {
+            __atomic_sub_fetch( &xPendingTicks, 1, __ATOMIC_RELAXED );
+            prvTickInterrupt();
+        }
+
+        xInterruptsMasked = 0;
+        portMEMORY_BARRIER();
+
+        if( __atomic_load_n( &xPendingTicks, __ATOMIC_RELAXED ) == 0 )
+        {
+            break;
+        }
+
+        xInterruptsMasked = 1;
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickInterrupt( void )
+{
+    Context_t * pxContextToSuspend;
+    Context_t * pxContextToResume;
+
+    uxCriticalNesting++; /* Interrupts are masked in the tick handler. */
+
+    #if ( configUSE_PREEMPTION == 1 )
+        pxContextToSuspend = prvGetContextFromTask( xTaskGetCurrentTaskHandle() );
+    #endif
+
+    xTaskIncrementTick();
+
+    #if ( configUSE_PREEMPTION == 1 )
+        /* Select Next Task. */
+        vTaskSwitchContext();
+
+        pxContextToResume = prvGetContextFromTask( xTaskGetCurrentTaskHandle() );
+
+        prvSwitchContext( pxContextToResume, pxContextToSuspend );
+    #endif
+
+    uxCriticalNesting--;
+}
+/*-----------------------------------------------------------*/
+
+void vPortAdvanceVirtualTime( void )
+{
+    /* With tickless idle the kernel knows which tick the idle time ends at,
+     * and vPortSuppressTicksAndSleep() steps to it in one go. */
+    #if ( configUSE_VIRTUAL_TIME == 1 ) && ( configUSE_TICKLESS_IDLE == 0 )
+    {
+        TaskHandle_t xIdleTask = xTaskGetCurrentTaskHandle();
+        UBaseType_t uxTicks = 0;
+
+        /* Called from the idle task: nothing else is ready, so nothing can
+         * happen before the next tick.  Do what the tick handler would do, one
+         * tick after the other, until a tick makes another task run. */
+        vPortEnterCritical();
+
+        do
+        {
+            ( void ) xTaskIncrementTick();
+            vTaskSwitchContext();
+            uxTicks++;
+        } while( ( xTaskGetCurrentTaskHandle() == xIdleTask ) && ( uxTicks < portVIRTUAL_IDLE_TICKS_MAX ) );
+
+        prvSwitchContext( prvGetContextFromTask( xTaskGetCurrentTaskHandle() ), prvGetContextFromTask( xIdleTask ) );
+
+        vPortExitCritical();
+    }
+    #endif /* configUSE_VIRTUAL_TIME */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+        #if ( configUSE_VIRTUAL_TIME == 1 )
+        {
+            /* Nothing but the timer signal can happen before the tick the
+             * kernel expects the idle time to end at, so there is nothing to
+             * wait for: step over the ticks in between at once.  The last tick
+             * is left pending by vTaskStepTick() and processed by
+             * xTaskResumeAll() when the idle task resumes the scheduler. */
+            vPortEnterCritical();
+
+            if( eTaskConfirmSleepModeStatus() == eStandardSleep )
+            {
+                vTaskStepTick( xExpectedIdleTime );
+                ulSuppressedTicks += ( unsigned long ) ( xExpectedIdleTime - 1 );
+            }
+
+            vPortExitCritical();
+        }
+        #else
+        {
+            /* In real time the idle task keeps taking every tick. */
+            ( void ) xExpectedIdleTime;
+        }
+        #endif /* configUSE_VIRTUAL_TIME */
+    }
+/*-----------------------------------------------------------*/
+
+    unsigned long ulPortGetSuppressedTicks( void )
+    {
+        return ulSuppressedTicks;
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry( void )
+{
+    Context_t * pxContext = prvGetContextFromTask( xTaskGetCurrentTaskHandle() );
+
+    /* Started for the first time, from a task switch, so interrupts are
+     * masked. */
+    uxCriticalNesting = 0;
+    vPortEnableInterrupts();
+
+    /* Call the task's entry point. */
+    pxContext->pxCode( pxContext->pvParams );
+
+    /* A function that implements a task must not exit or attempt to return to
+     * its caller as there is nothing to return to. If a task wants to exit it
+     * should instead call vTaskDelete( NULL ). Artificially force an assert()
+     * to be triggered if configASSERT() is defined, so application writers can
+     * catch the error. */
+    configASSERT( pdFALSE );
+
+    for( ; ; )
+    {
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( Context_t * pxContextToResume,
+                              Context_t * pxContextToSuspend )
+{
+    BaseType_t uxSavedCriticalNesting;
+
+    if( pxContextToSuspend != pxContextToResume )
+    {
+        /*
+         * Switch tasks.  Always called with interrupts masked, so every task
+         * stops and resumes with them masked.
+         *
+         * The critical section nesting is per-task, so save it on the
+         * stack of the current (suspending) task, restoring it when
+         * we switch back to this task.  A task that deleted itself is never
+         * switched back to, its stack is freed by the idle task.
+         */
+        uxSavedCriticalNesting = uxCriticalNesting;
+
+        #if defined( __x86_64__ )
+            prvSwapStacks( &( pxContextToSuspend->pvStackPointer ), pxContextToResume->pvStackPointer );
+        #else
+            if( swapcontext( &( pxContextToSuspend->xContext ), &( pxContextToResume->xContext ) ) != 0 )
+            {
+                prvFatalError( "swapcontext", errno );
+            }
+        #endif
+
+        uxCriticalNesting = uxSavedCriticalNesting;
+    }
+}
+/*-----------------------------------------------------------*/
+
+unsigned long ulPortGetRunTime( void )
+{
+    struct tms xTimes;
+
+    times( &xTimes );
+
+    return ( unsigned long ) xTimes.tms_utime;
+}
+/*-----------------------------------------------------------*/
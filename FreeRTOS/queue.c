@@ -136,6 +136,26 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
  * name below to enable the use of older kernel aware debuggers. */
 typedef xQUEUE Queue_t;
 
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+/*
+ * A zero copy queue hands out its slots instead of copying items in and out.
+ * Every slot is either free, its pointer held by xFreeSlots, owned by the task
+ * that reserved or acquired it, or holds a committed item, its pointer held by
+ * xItems.  Both are ordinary queues of pointers, which gives the zero copy
+ * queue the blocking and timeout behaviour of a queue.
+ */
+    typedef struct ZeroCopyQueueDefinition
+    {
+        Queue_t xItems;       /*< Pointers to the slots that hold committed items, oldest first. */
+        Queue_t xFreeSlots;   /*< Pointers to the slots that no task owns. */
+        uint8_t * pucSlots;   /*< The first slot, the others follow every xSlotSize bytes. */
+        size_t xSlotSize;     /*< The item size rounded up to portBYTE_ALIGNMENT. */
+        UBaseType_t uxLength; /*< The number of slots. */
+    } ZeroCopyQueue_t;
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -3084,4 +3104,306 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         return xReturn;
     }
 
-#endif /* configUSE_QUEUE_SETS */
\ No newline at end of file
+#endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    ZeroCopyQueueHandle_t xQueueCreateZeroCopy( const UBaseType_t uxQueueLength,
+                                                const UBaseType_t uxItemSize )
+    {
+        ZeroCopyQueue_t * pxNewQueue = NULL;
+        size_t xSlotSize;
+        size_t xSlotsOffset;
+        uint8_t * pucSlot;
+        UBaseType_t uxSlot;
+
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        /* Every slot starts on a portBYTE_ALIGNMENT boundary, so the task that
+         * owns it can use it as the structure it holds. */
+        xSlotSize = ( ( size_t ) uxItemSize + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+        xSlotsOffset = ( sizeof( ZeroCopyQueue_t ) + ( 2U * ( size_t ) uxQueueLength * sizeof( void * ) ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+            ( uxItemSize > ( UBaseType_t ) 0 ) &&
+            /* Check for multiplication overflow. */
+            ( ( SIZE_MAX / ( 2U * sizeof( void * ) + xSlotSize ) ) >= uxQueueLength ) &&
+            /* Check for addition overflow. */
+            ( ( SIZE_MAX - ( sizeof( ZeroCopyQueue_t ) + ( size_t ) portBYTE_ALIGNMENT ) ) >= ( ( size_t ) uxQueueLength * ( 2U * sizeof( void * ) + xSlotSize ) ) ) )
+        {
+            /* The structure, the storage of the two queues of pointers, then
+             * the slots, in a single allocation. */
+            pxNewQueue = ( ZeroCopyQueue_t * ) pvPortMalloc( xSlotsOffset + ( ( size_t ) uxQueueLength * xSlotSize ) ); /*lint !e9087 !e9079 pvPortMalloc() returns memory aligned to portBYTE_ALIGNMENT. */
+
+            if( pxNewQueue != NULL )
+            {
+                pucSlot = ( uint8_t * ) pxNewQueue;
+                pucSlot += sizeof( ZeroCopyQueue_t ); /*lint !e9016 Pointer arithmetic allowed on char types. */
+
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    /* Neither queue is ever deleted on its own, the flags only
+                     * keep the structures consistent for a debugger. */
+                    pxNewQueue->xItems.ucStaticallyAllocated = pdTRUE;
+                    pxNewQueue->xFreeSlots.ucStaticallyAllocated = pdTRUE;
+                }
+                #endif /* configSUPPORT_STATIC_ALLOCATION */
+
+                prvInitialiseNewQueue( uxQueueLength, ( UBaseType_t ) sizeof( void * ), pucSlot, queueQUEUE_TYPE_BASE, &( pxNewQueue->xItems ) );
+                pucSlot += ( size_t ) uxQueueLength * sizeof( void * ); /*lint !e9016 Pointer arithmetic allowed on char types. */
+                prvInitialiseNewQueue( uxQueueLength, ( UBaseType_t ) sizeof( void * ), pucSlot, queueQUEUE_TYPE_BASE, &( pxNewQueue->xFreeSlots ) );
+
+                pxNewQueue->pucSlots = ( ( uint8_t * ) pxNewQueue ) + xSlotsOffset; /*lint !e9016 Pointer arithmetic allowed on char types. */
+                pxNewQueue->xSlotSize = xSlotSize;
+                pxNewQueue->uxLength = uxQueueLength;
+
+                /* Every slot starts free.  Nothing can wait on the queue yet,
+                 * so the pointers are copied in directly. */
+                pucSlot = pxNewQueue->pucSlots;
+
+                for( uxSlot = ( UBaseType_t ) 0; uxSlot < uxQueueLength; uxSlot++ )
+                {
+                    ( void ) prvCopyDataToQueue( &( pxNewQueue->xFreeSlots ), ( const void * ) &pucSlot, queueSEND_TO_BACK );
+                    pucSlot += xSlotSize; /*lint !e9016 Pointer arithmetic allowed on char types. */
+                }
+            }
+            else
+            {
+                traceQUEUE_CREATE_FAILED( queueQUEUE_TYPE_BASE );
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            configASSERT( pxNewQueue );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxNewQueue;
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    void vQueueDeleteZeroCopy( ZeroCopyQueueHandle_t xQueue )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        /* No task may be waiting on either queue, and no task may still own
+         * a slot. */
+        configASSERT( listLIST_IS_EMPTY( &( pxQueue->xItems.xTasksWaitingToReceive ) ) != pdFALSE );
+        configASSERT( listLIST_IS_EMPTY( &( pxQueue->xFreeSlots.xTasksWaitingToReceive ) ) != pdFALSE );
+        configASSERT( ( pxQueue->xItems.uxMessagesWaiting + pxQueue->xFreeSlots.uxMessagesWaiting ) == pxQueue->uxLength );
+
+        vPortFree( pxQueue );
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    static void prvAssertZeroCopySlot( const ZeroCopyQueue_t * pxQueue,
+                                       const void * pvItem )
+    {
+        const uint8_t * const pucItem = ( const uint8_t * ) pvItem;
+
+        /* Remove compiler warnings when configASSERT() is not defined. */
+        ( void ) pxQueue;
+        ( void ) pucItem;
+
+        configASSERT( pucItem >= pxQueue->pucSlots );
+        configASSERT( pucItem < ( pxQueue->pucSlots + ( ( size_t ) pxQueue->uxLength * pxQueue->xSlotSize ) ) );
+        configASSERT( ( ( size_t ) ( pucItem - pxQueue->pucSlots ) % pxQueue->xSlotSize ) == ( size_t ) 0 );
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    void * pvQueueReserveItem( ZeroCopyQueueHandle_t xQueue,
+                               TickType_t xTicksToWait )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        void * pvItem = NULL;
+
+        configASSERT( pxQueue );
+
+        /* A slot is free while its pointer is in xFreeSlots, so waiting for a
+         * free slot is waiting to receive from xFreeSlots. */
+        ( void ) xQueueReceive( &( pxQueue->xFreeSlots ), &pvItem, xTicksToWait );
+
+        return pvItem;
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    void * pvQueueReserveItemFromISR( ZeroCopyQueueHandle_t xQueue,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        void * pvItem = NULL;
+
+        configASSERT( pxQueue );
+
+        ( void ) xQueueReceiveFromISR( &( pxQueue->xFreeSlots ), &pvItem, pxHigherPriorityTaskWoken );
+
+        return pvItem;
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    void vQueueCommitItem( ZeroCopyQueueHandle_t xQueue,
+                           void * pvItem )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        configASSERT( pxQueue );
+        prvAssertZeroCopySlot( pxQueue, pvItem );
+
+        /* There are as many places for pointers in xItems as there are slots,
+         * and the caller owns this one, so there is always room. */
+        xReturn = xQueueSendToBack( &( pxQueue->xItems ), &pvItem, 0 );
+        configASSERT( xReturn == pdPASS );
+        ( void ) xReturn;
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    void vQueueCommitItemFromISR( ZeroCopyQueueHandle_t xQueue,
+                                  void * pvItem,
+                                  BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        configASSERT( pxQueue );
+        prvAssertZeroCopySlot( pxQueue, pvItem );
+
+        xReturn = xQueueSendToBackFromISR( &( pxQueue->xItems ), &pvItem, pxHigherPriorityTaskWoken );
+        configASSERT( xReturn == pdPASS );
+        ( void ) xReturn;
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    void * pvQueueAcquireItem( ZeroCopyQueueHandle_t xQueue,
+                               TickType_t xTicksToWait )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        void * pvItem = NULL;
+
+        configASSERT( pxQueue );
+
+        ( void ) xQueueReceive( &( pxQueue->xItems ), &pvItem, xTicksToWait );
+
+        return pvItem;
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    void * pvQueueAcquireItemFromISR( ZeroCopyQueueHandle_t xQueue,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        void * pvItem = NULL;
+
+        configASSERT( pxQueue );
+
+        ( void ) xQueueReceiveFromISR( &( pxQueue->xItems ), &pvItem, pxHigherPriorityTaskWoken );
+
+        return pvItem;
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    void * pvQueuePeekItem( ZeroCopyQueueHandle_t xQueue,
+                            TickType_t xTicksToWait )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        void * pvItem = NULL;
+
+        configASSERT( pxQueue );
+
+        ( void ) xQueuePeek( &( pxQueue->xItems ), &pvItem, xTicksToWait );
+
+        return pvItem;
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    void vQueueReleaseItem( ZeroCopyQueueHandle_t xQueue,
+                            void * pvItem )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        configASSERT( pxQueue );
+        prvAssertZeroCopySlot( pxQueue, pvItem );
+
+        xReturn = xQueueSendToBack( &( pxQueue->xFreeSlots ), &pvItem, 0 );
+        configASSERT( xReturn == pdPASS );
+        ( void ) xReturn;
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    void vQueueReleaseItemFromISR( ZeroCopyQueueHandle_t xQueue,
+                                   void * pvItem,
+                                   BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        ZeroCopyQueue_t * const pxQueue = xQueue;
+        BaseType_t xReturn;
+
+        configASSERT( pxQueue );
+        prvAssertZeroCopySlot( pxQueue, pvItem );
+
+        xReturn = xQueueSendToBackFromISR( &( pxQueue->xFreeSlots ), &pvItem, pxHigherPriorityTaskWoken );
+        configASSERT( xReturn == pdPASS );
+        ( void ) xReturn;
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ZERO_COPY_QUEUES == 1 )
+
+    UBaseType_t uxQueueItemsWaiting( const ZeroCopyQueueHandle_t xQueue )
+    {
+        configASSERT( xQueue );
+
+        return uxQueueMessagesWaiting( &( xQueue->xItems ) );
+    }
+
+#endif /* configUSE_ZERO_COPY_QUEUES */
\ No newline at end of file
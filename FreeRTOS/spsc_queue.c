@@ -0,0 +1,533 @@
+/*
+ * FreeRTOS Kernel V10.5.1
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * SPSC queues, see spsc_queue.h.
+ *
+ * The queue is a ring of uxLength slots, one more than the number of items it
+ * holds, with a head index moved only by the writer and a tail index moved
+ * only by the reader.  The writer copies the item into the slot at the head
+ * and then publishes the new head with a release store; the reader reads the
+ * head with an acquire load, so it never sees the index move before the item.
+ * The same holds the other way round for the tail.  The only read-modify-write
+ * is taking the announcement of a waiting reader, which only happens when the
+ * reader has blocked or is about to.
+ */
+
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_queue.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include SPSC queue functionality.  This #if is closed at the very bottom
+ * of this file.  If you want to include SPSC queues then ensure
+ * configUSE_SPSC_QUEUES is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_SPSC_QUEUES == 1 )
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build spsc_queue.c
+#endif
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+    #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build spsc_queue.c
+#endif
+
+#ifndef configSPSC_QUEUE_NOTIFICATION_INDEX
+    #error configTASK_NOTIFICATION_ARRAY_ENTRIES must be above 1, or configSPSC_QUEUE_NOTIFICATION_INDEX set, so SPSC queues do not share the notification index of xTaskNotifyGive()
+#endif
+
+/*
+ * The index accesses.  GCC's atomic built-ins compile to plain loads and
+ * stores with the barriers the memory model needs (none on a single core
+ * Cortex-M3 beyond the compiler barrier, a DMB where the core requires one),
+ * and the exchange to an LDREX/STREX loop.  Other compilers fall back on
+ * portMEMORY_BARRIER() and atomic.h, whose exchange masks interrupts for a few
+ * instructions.
+ */
+#if defined( __GNUC__ )
+    #define spscLOAD_ACQUIRE( xIndex )              __atomic_load_n( &( xIndex ), __ATOMIC_ACQUIRE )
+    #define spscSTORE_RELEASE( xIndex, xValue )     __atomic_store_n( &( xIndex ), ( xValue ), __ATOMIC_RELEASE )
+    #define spscFULL_BARRIER()                      __atomic_thread_fence( __ATOMIC_SEQ_CST )
+    #define spscTAKE_WAITING_TASK( pxSpscQueue )    __atomic_exchange_n( &( ( pxSpscQueue )->xTaskWaitingToReceive ), NULL, __ATOMIC_ACQ_REL )
+#else
+    #include "atomic.h"
+
+    #define spscLOAD_ACQUIRE( xIndex )              prvLoadAcquire( &( xIndex ) )
+    #define spscSTORE_RELEASE( xIndex, xValue )     prvStoreRelease( &( xIndex ), ( xValue ) )
+    #define spscFULL_BARRIER()                      portMEMORY_BARRIER()
+    #define spscTAKE_WAITING_TASK( pxSpscQueue )    ( TaskHandle_t ) Atomic_SwapPointers_p32( ( void * volatile * ) &( ( pxSpscQueue )->xTaskWaitingToReceive ), NULL )
+#endif
+
+/* Bits stored in the ucFlags field of the SPSC queue. */
+#define spscFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 1 ) /* Set if the queue structure was statically allocated. */
+
+/*lint -save -e9058 Structure is used with the dummy in FreeRTOS.h. */
+typedef struct SpscQueueDef_t
+{
+    volatile size_t uxHead;                      /* Next slot the writer fills, only moved by the writer. */
+    volatile size_t uxTail;                      /* Next slot the reader empties, only moved by the reader. */
+    size_t uxLength;                             /* Number of slots, one more than the number of items the queue holds. */
+    size_t uxItemSize;                           /* Size of an item, in bytes. */
+    TaskHandle_t volatile xTaskWaitingToReceive; /* The reader while it waits for an item, set by the reader and taken by whichever side sees it first. */
+    uint8_t * pucStorage;                        /* The slots. */
+    uint8_t ucFlags;
+} SpscQueue_t;
+/*lint -restore */
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both API functions that create a queue.
+ */
+static void prvInitialiseNewSpscQueue( SpscQueue_t * const pxSpscQueue,
+                                       size_t uxQueueLength,
+                                       size_t uxItemSize,
+                                       uint8_t * const pucStorage,
+                                       uint8_t ucFlags ) PRIVILEGED_FUNCTION;
+
+/*
+ * The body of xSpscQueueSend() and xSpscQueueSendFromISR().  Returns pdPASS or
+ * errQUEUE_FULL, and the reader that waited for the item, if any, in
+ * *pxTaskToNotify.
+ */
+static BaseType_t prvWriteItem( SpscQueue_t * const pxSpscQueue,
+                                const void * pvItemToQueue,
+                                TaskHandle_t * pxTaskToNotify ) PRIVILEGED_FUNCTION;
+
+/*
+ * The body of xSpscQueueReceive() and xSpscQueueReceiveFromISR().  Returns
+ * pdTRUE if an item was copied to pvBuffer, pdFALSE if the queue is empty.
+ */
+static BaseType_t prvReadItem( SpscQueue_t * const pxSpscQueue,
+                               void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if !defined( __GNUC__ )
+
+    static size_t prvLoadAcquire( const volatile size_t * puxIndex )
+    {
+        size_t uxValue = *puxIndex;
+
+        portMEMORY_BARRIER();
+
+        return uxValue;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStoreRelease( volatile size_t * puxIndex,
+                                 size_t uxValue )
+    {
+        portMEMORY_BARRIER();
+        *puxIndex = uxValue;
+    }
+
+#endif /* __GNUC__ */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    SpscQueueHandle_t xSpscQueueCreate( size_t uxQueueLength,
+                                        size_t uxItemSize )
+    {
+        SpscQueue_t * pxSpscQueue;
+        size_t xStorageSize;
+
+        configASSERT( uxQueueLength > ( size_t ) 0 );
+        configASSERT( uxItemSize > ( size_t ) 0 );
+
+        /* One slot more than the length, see xSpscQueueCreateStatic().  Check
+         * for multiplication overflow, then addition overflow. */
+        if( ( uxQueueLength < ( SIZE_MAX / uxItemSize ) ) &&
+            ( ( ( uxQueueLength + ( size_t ) 1 ) * uxItemSize ) < ( SIZE_MAX - sizeof( SpscQueue_t ) ) ) )
+        {
+            xStorageSize = ( uxQueueLength + ( size_t ) 1 ) * uxItemSize;
+
+            /* The structure and the slots in one allocation, the slots after
+             * the structure. */
+            pxSpscQueue = ( SpscQueue_t * ) pvPortMalloc( sizeof( SpscQueue_t ) + xStorageSize ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            pxSpscQueue = NULL;
+        }
+
+        if( pxSpscQueue != NULL )
+        {
+            prvInitialiseNewSpscQueue( pxSpscQueue,
+                                       uxQueueLength,
+                                       uxItemSize,
+                                       ( ( uint8_t * ) pxSpscQueue ) + sizeof( SpscQueue_t ), /*lint !e9016 Pointer arithmetic allowed on char types. */
+                                       ( uint8_t ) 0 );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxSpscQueue;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    SpscQueueHandle_t xSpscQueueCreateStatic( size_t uxQueueLength,
+                                              size_t uxItemSize,
+                                              uint8_t * pucQueueStorage,
+                                              StaticSpscQueue_t * pxStaticQueue )
+    {
+        SpscQueue_t * const pxSpscQueue = ( SpscQueue_t * ) pxStaticQueue; /*lint !e740 !e9087 Safe cast as StaticSpscQueue_t is opaque SpscQueue_t. */
+        SpscQueueHandle_t xReturn;
+
+        configASSERT( uxQueueLength > ( size_t ) 0 );
+        configASSERT( uxItemSize > ( size_t ) 0 );
+        configASSERT( pucQueueStorage );
+        configASSERT( pxStaticQueue );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticSpscQueue_t equals the size of the real
+             * SPSC queue structure. */
+            volatile size_t xSize = sizeof( StaticSpscQueue_t );
+            configASSERT( xSize == sizeof( SpscQueue_t ) );
+        } /*lint !e529 xSize is referenced is configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucQueueStorage != NULL ) && ( pxStaticQueue != NULL ) )
+        {
+            prvInitialiseNewSpscQueue( pxSpscQueue,
+                                       uxQueueLength,
+                                       uxItemSize,
+                                       pucQueueStorage,
+                                       spscFLAGS_IS_STATICALLY_ALLOCATED );
+            xReturn = ( SpscQueueHandle_t ) pxStaticQueue; /*lint !e9087 Data hiding requires cast to opaque type. */
+        }
+        else
+        {
+            xReturn = NULL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewSpscQueue( SpscQueue_t * const pxSpscQueue,
+                                       size_t uxQueueLength,
+                                       size_t uxItemSize,
+                                       uint8_t * const pucStorage,
+                                       uint8_t ucFlags )
+{
+    ( void ) memset( ( void * ) pxSpscQueue, 0x00, sizeof( SpscQueue_t ) ); /*lint !e9087 memset() requires void *. */
+    pxSpscQueue->uxLength = uxQueueLength + ( size_t ) 1;
+    pxSpscQueue->uxItemSize = uxItemSize;
+    pxSpscQueue->pucStorage = pucStorage;
+    pxSpscQueue->ucFlags = ucFlags;
+}
+/*-----------------------------------------------------------*/
+
+void vSpscQueueDelete( SpscQueueHandle_t xSpscQueue )
+{
+    SpscQueue_t * pxSpscQueue = xSpscQueue;
+
+    configASSERT( pxSpscQueue );
+    configASSERT( pxSpscQueue->xTaskWaitingToReceive == NULL );
+
+    if( ( pxSpscQueue->ucFlags & spscFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            /* Both the structure and the slots were allocated in a single
+             * call to pvPortMalloc(), hence only one call to vPortFree() is
+             * required. */
+            vPortFree( ( void * ) pxSpscQueue ); /*lint !e9087 Standard free() semantics require void *, plus pxSpscQueue was allocated by pvPortMalloc(). */
+        }
+        #else
+        {
+            /* Should not be possible to get here, ucFlags must be corrupt.
+             * Force an assert. */
+            configASSERT( xSpscQueue == ( SpscQueueHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* The structure was statically allocated, just clear it. */
+        ( void ) memset( pxSpscQueue, 0x00, sizeof( SpscQueue_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWriteItem( SpscQueue_t * const pxSpscQueue,
+                                const void * pvItemToQueue,
+                                TaskHandle_t * pxTaskToNotify )
+{
+    const size_t uxHead = pxSpscQueue->uxHead;
+    size_t uxNextHead = uxHead + ( size_t ) 1;
+    BaseType_t xReturn;
+
+    *pxTaskToNotify = NULL;
+
+    if( uxNextHead == pxSpscQueue->uxLength )
+    {
+        uxNextHead = ( size_t ) 0;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( uxNextHead == spscLOAD_ACQUIRE( pxSpscQueue->uxTail ) )
+    {
+        /* Filling the slot would make the head catch up with the tail, which
+         * would read as empty. */
+        xReturn = errQUEUE_FULL;
+    }
+    else
+    {
+        ( void ) memcpy( ( void * ) &( pxSpscQueue->pucStorage[ uxHead * pxSpscQueue->uxItemSize ] ), pvItemToQueue, pxSpscQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+        spscSTORE_RELEASE( pxSpscQueue->uxHead, uxNextHead );
+
+        /* The reader announces itself before it looks at the head for the
+         * last time, and the head is published before the announcement is
+         * looked at here, so either the reader sees the item or this sees the
+         * reader. */
+        spscFULL_BARRIER();
+
+        if( pxSpscQueue->xTaskWaitingToReceive != NULL )
+        {
+            *pxTaskToNotify = spscTAKE_WAITING_TASK( pxSpscQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscQueueSend( SpscQueueHandle_t xSpscQueue,
+                           const void * pvItemToQueue )
+{
+    SpscQueue_t * const pxSpscQueue = xSpscQueue;
+    TaskHandle_t xTaskToNotify;
+    BaseType_t xReturn;
+
+    configASSERT( pxSpscQueue );
+    configASSERT( pvItemToQueue );
+
+    xReturn = prvWriteItem( pxSpscQueue, pvItemToQueue, &xTaskToNotify );
+
+    if( xTaskToNotify != NULL )
+    {
+        ( void ) xTaskNotifyGiveIndexed( xTaskToNotify, configSPSC_QUEUE_NOTIFICATION_INDEX );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscQueueSendFromISR( SpscQueueHandle_t xSpscQueue,
+                                  const void * pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    SpscQueue_t * const pxSpscQueue = xSpscQueue;
+    TaskHandle_t xTaskToNotify;
+    BaseType_t xReturn;
+
+    configASSERT( pxSpscQueue );
+    configASSERT( pvItemToQueue );
+
+    xReturn = prvWriteItem( pxSpscQueue, pvItemToQueue, &xTaskToNotify );
+
+    if( xTaskToNotify != NULL )
+    {
+        vTaskNotifyGiveIndexedFromISR( xTaskToNotify, configSPSC_QUEUE_NOTIFICATION_INDEX, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReadItem( SpscQueue_t * const pxSpscQueue,
+                               void * pvBuffer )
+{
+    size_t uxTail = pxSpscQueue->uxTail;
+    BaseType_t xReturn;
+
+    if( uxTail == spscLOAD_ACQUIRE( pxSpscQueue->uxHead ) )
+    {
+        xReturn = pdFALSE;
+    }
+    else
+    {
+        ( void ) memcpy( pvBuffer, ( void * ) &( pxSpscQueue->pucStorage[ uxTail * pxSpscQueue->uxItemSize ] ), pxSpscQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        uxTail++;
+
+        if( uxTail == pxSpscQueue->uxLength )
+        {
+            uxTail = ( size_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The slot is only handed back to the writer once it has been
+         * copied out. */
+        spscSTORE_RELEASE( pxSpscQueue->uxTail, uxTail );
+        xReturn = pdTRUE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscQueueReceive( SpscQueueHandle_t xSpscQueue,
+                              void * pvBuffer,
+                              TickType_t xTicksToWait )
+{
+    SpscQueue_t * const pxSpscQueue = xSpscQueue;
+    TimeOut_t xTimeOut;
+    BaseType_t xReturn;
+
+    configASSERT( pxSpscQueue );
+    configASSERT( pvBuffer );
+
+    vTaskSetTimeOutState( &xTimeOut );
+
+    for( ; ; )
+    {
+        if( prvReadItem( pxSpscQueue, pvBuffer ) != pdFALSE )
+        {
+            xReturn = pdPASS;
+            break;
+        }
+
+        if( xTicksToWait == ( TickType_t ) 0 )
+        {
+            xReturn = errQUEUE_EMPTY;
+            break;
+        }
+
+        /* Announce that the reader waits, then look once more: an item
+         * written before the announcement is found now, and the writer of
+         * any later item sees the announcement (see prvWriteItem()). */
+        pxSpscQueue->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+        spscFULL_BARRIER();
+
+        if( pxSpscQueue->uxTail == spscLOAD_ACQUIRE( pxSpscQueue->uxHead ) )
+        {
+            ( void ) ulTaskNotifyTakeIndexed( configSPSC_QUEUE_NOTIFICATION_INDEX, pdTRUE, xTicksToWait );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Withdraw the announcement if the writer has not taken it.  If it
+         * has, a notification may be left pending, which only makes a later
+         * wait return early and look at the queue again. */
+        ( void ) spscTAKE_WAITING_TASK( pxSpscQueue );
+
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+        {
+            /* xTicksToWait is now 0, so the next pass looks at the queue a
+             * last time without waiting. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSpscQueueReceiveFromISR( SpscQueueHandle_t xSpscQueue,
+                                     void * pvBuffer )
+{
+    SpscQueue_t * const pxSpscQueue = xSpscQueue;
+
+    configASSERT( pxSpscQueue );
+    configASSERT( pvBuffer );
+
+    return ( prvReadItem( pxSpscQueue, pvBuffer ) != pdFALSE ) ? pdPASS : errQUEUE_EMPTY;
+}
+/*-----------------------------------------------------------*/
+
+size_t uxSpscQueueMessagesWaiting( SpscQueueHandle_t xSpscQueue )
+{
+    const SpscQueue_t * const pxSpscQueue = xSpscQueue;
+    size_t uxHead, uxTail;
+
+    configASSERT( pxSpscQueue );
+
+    uxTail = spscLOAD_ACQUIRE( pxSpscQueue->uxTail );
+    uxHead = spscLOAD_ACQUIRE( pxSpscQueue->uxHead );
+
+    return ( uxHead >= uxTail ) ? ( uxHead - uxTail ) : ( ( pxSpscQueue->uxLength - uxTail ) + uxHead );
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include SPSC queue functionality.  If you want to include SPSC queues then
+ * ensure configUSE_SPSC_QUEUES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_SPSC_QUEUES == 1 */
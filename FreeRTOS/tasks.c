@@ -67,6 +67,23 @@
     #define taskYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
 #endif
 
+/* EDF orders aperiodic tasks by their own deadlines, not through a server. */
+#if ( ( configUSE_EDF_SCHEDULER == 1 ) && ( configUSE_APERIODIC_SERVER == 1 ) )
+    #error configUSE_EDF_SCHEDULER schedules aperiodic tasks by their own deadlines, so configUSE_APERIODIC_SERVER must be 0
+#endif
+
+/* An aborted aperiodic task is cleaned up through the same termination list as
+ * a task that deletes itself. */
+#if ( ( configUSE_APERIODIC_BUDGET == 1 ) && ( configAPERIODIC_OVERRUN_POLICY == tskAPERIODIC_OVERRUN_ABORT ) && ( INCLUDE_vTaskDelete != 1 ) )
+    #error tskAPERIODIC_OVERRUN_ABORT requires INCLUDE_vTaskDelete to be set to 1 in FreeRTOSConfig.h
+#endif
+
+/* A job that overruns its budget cannot be aborted without ending the worker
+ * that runs it. */
+#if ( ( configUSE_APERIODIC_JOBS == 1 ) && ( configUSE_APERIODIC_BUDGET == 1 ) && ( configAPERIODIC_OVERRUN_POLICY == tskAPERIODIC_OVERRUN_ABORT ) )
+    #error tskAPERIODIC_OVERRUN_ABORT cannot be used with configUSE_APERIODIC_JOBS
+#endif
+
 /* Values that can be assigned to the ucNotifyState member of the TCB. */
 #define taskNOT_WAITING_NOTIFICATION              ( ( uint8_t ) 0 ) /* Must be zero as it is the initialised value. */
 #define taskWAITING_NOTIFICATION                  ( ( uint8_t ) 1 )
@@ -245,32 +262,339 @@
 
 /*-----------------------------------------------------------*/
 
+#if ( INCLUDE_vTaskEndJob == 1 )
+
+/* pxPendingPeriodicList and pxOverflowPendingPeriodicList are switched when the
+ * tick count overflows, in the same way as the delayed lists. */
+    #define taskSWITCH_PENDING_PERIODIC_LISTS()                                       \
+    {                                                                                 \
+        List_t * pxTemp;                                                              \
+                                                                                      \
+        /* The pending list should be empty when the lists are switched. */          \
+        configASSERT( ( listLIST_IS_EMPTY( pxPendingPeriodicList ) ) );               \
+                                                                                      \
+        pxTemp = pxPendingPeriodicList;                                               \
+        pxPendingPeriodicList = pxOverflowPendingPeriodicList;                        \
+        pxOverflowPendingPeriodicList = pxTemp;                                       \
+        prvResetNextPeriodicReleaseTime();                                            \
+    }
+
+#endif /* INCLUDE_vTaskEndJob */
+
+/*-----------------------------------------------------------*/
+
 /*
- * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * The periodic ready list and the server job list are kept in item value
+ * order.  By default each insertion walks the list, so its cost grows with the
+ * number of ready tasks.  With configUSE_READY_HEAP set to 1 the items are
+ * appended to the list, which only tracks membership, and the order is kept by
+ * a binary heap instead: insertion is O(log n) and the head is read in O(1).
+ *
+ * With configUSE_PARTITIONED_SCHEDULING every core has a periodic ready list,
+ * and a heap, of its own, selected by uxIndex.  There is a single one
+ * otherwise, and uxIndex is ignored.
+ */
+#if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+    #define taskPERIODIC_READY_LIST( uxIndex )    ( &( xReadyPeriodicTasksLists[ ( uxIndex ) ] ) )
+    #define taskPERIODIC_READY_HEAP( uxIndex )    ( &( xPeriodicReadyHeaps[ ( uxIndex ) ] ) )
+    #define taskPERIODIC_READY_LISTS    configNUMBER_OF_CORES
+#else
+    #define taskPERIODIC_READY_LIST( uxIndex )    ( &xReadyPeriodicTasksLists )
+    #define taskPERIODIC_READY_HEAP( uxIndex )    ( &xPeriodicReadyHeap )
+    #define taskPERIODIC_READY_LISTS    1
+#endif
+
+#if ( configUSE_READY_HEAP == 1 )
+    #define taskPERIODIC_READY_INSERT( uxIndex, pxItem )                           \
+    {                                                                              \
+        listINSERT_END( taskPERIODIC_READY_LIST( uxIndex ), ( pxItem ) );          \
+        prvReadyHeapInsert( taskPERIODIC_READY_HEAP( uxIndex ), ( pxItem ) );      \
+    }
+    #define taskPERIODIC_READY_HEAD( uxIndex )    prvReadyHeapPeek( taskPERIODIC_READY_HEAP( uxIndex ) )
+#else
+    #define taskPERIODIC_READY_INSERT( uxIndex, pxItem )    listINSERT( taskPERIODIC_READY_LIST( uxIndex ), ( pxItem ) )
+    #define taskPERIODIC_READY_HEAD( uxIndex )              listGET_HEAD_ENTRY( taskPERIODIC_READY_LIST( uxIndex ) )
+#endif
+
+/*
+ * The index of the periodic ready list pxTCB is placed in: the list of the
+ * core the task is assigned to with configUSE_PARTITIONED_SCHEDULING.
+ */
+#if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+    #define taskPARTITION_OF( pxTCB )    ( ( UBaseType_t ) ( pxTCB )->xPartitionCore )
+#else
+    #define taskPARTITION_OF( pxTCB )    ( ( UBaseType_t ) 0U )
+#endif
+
+#if ( configUSE_APERIODIC_SERVER == 1 )
+    #if ( configUSE_READY_HEAP == 1 )
+        #define taskSERVER_JOB_INSERT( pxItem )                                 \
+    {                                                                           \
+        listINSERT_END( &( xAperiodicServer.xJobList ), ( pxItem ) );           \
+        prvReadyHeapInsert( &xServerJobHeap, ( pxItem ) );                      \
+    }
+        #define taskSERVER_JOB_HEAD()    prvReadyHeapPeek( &xServerJobHeap )
+    #else
+        #define taskSERVER_JOB_INSERT( pxItem )    listINSERT( &( xAperiodicServer.xJobList ), ( pxItem ) )
+        #define taskSERVER_JOB_HEAD()              listGET_HEAD_ENTRY( &( xAperiodicServer.xJobList ) )
+    #endif
+#endif /* configUSE_APERIODIC_SERVER */
+
+/*
+ * Drop the heap entry of a task that is being deleted, so the heap never
+ * references a freed TCB.
+ */
+#if ( configUSE_READY_HEAP == 1 )
+    #define taskREADY_HEAP_FORGET( pxTCB )                                                                       \
+    {                                                                                                            \
+        prvReadyHeapRemove( taskPERIODIC_READY_HEAP( taskPARTITION_OF( pxTCB ) ), &( ( pxTCB )->xStateListItem ) ); \
+        taskSERVER_JOB_HEAP_FORGET( pxTCB );                                                                     \
+    }
+    #if ( configUSE_APERIODIC_SERVER == 1 )
+        #define taskSERVER_JOB_HEAP_FORGET( pxTCB )    prvReadyHeapRemove( &xServerJobHeap, &( ( pxTCB )->xStateListItem ) )
+    #else
+        #define taskSERVER_JOB_HEAP_FORGET( pxTCB )
+    #endif
+#else
+    #define taskREADY_HEAP_FORGET( pxTCB )
+#endif
+
+/*
+ * Give back the share the admission test reserved for a task that is being
+ * deleted.
+ */
+#if ( configUSE_ADMISSION_CONTROL == 1 )
+    #define taskADMISSION_RELEASE( pxTCB )    prvAdmissionRelease( taskIS_PERIODIC( pxTCB ), ( pxTCB )->ulAdmittedLoad )
+#else
+    #define taskADMISSION_RELEASE( pxTCB )
+#endif
+
+/*
+ * Likewise for the share of its cores the packing gave the task.
+ */
+#if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+    #define taskPARTITION_RELEASE( pxTCB )    prvPartitionRelease( pxTCB )
+#else
+    #define taskPARTITION_RELEASE( pxTCB )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/*
+ * On a single core the code that makes a task ready compares it with
+ * pxCurrentTCB to decide whether to yield.  With several cores the task may
+ * instead have to preempt the task running on another core, which
+ * prvYieldForTask() looks for each time a task is added to a ready list.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+    #define taskYIELD_FOR_TASK( pxTCB )    prvYieldForTask( pxTCB )
+#else
+    #define taskYIELD_FOR_TASK( pxTCB )
+#endif
+
+/*
+ * Place the task represented by pxTCB into the ready list for its priority.
+ * It is inserted at the end of the list.
  */
-#define prvAddTaskToReadyList( pxTCB )                                                                 \
+#define prvAddTaskToPriorityReadyList( pxTCB )                                                         \
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
     taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
     listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
+    taskYIELD_FOR_TASK( pxTCB )
+
+/*
+ * Place the task represented by pxTCB into the appropriate ready list for
+ * the task.  Periodic tasks go to the periodic ready list, aperiodic tasks are
+ * queued by deadline and all other tasks by priority.
+ */
+#if ( configUSE_POLLING_SERVER == 1 )
+    #define prvAddTaskToReadyList( pxTCB )                 \
+    if( taskIS_PERIODIC( pxTCB ) )                         \
+    {                                                      \
+        prvAddTaskToPeriodicReadyList( pxTCB );            \
+    }                                                      \
+    else if( taskIS_APERIODIC( pxTCB ) )                   \
+    {                                                      \
+        prvAddTaskByDeadlineToReadyList( pxTCB );          \
+    }                                                      \
+    else                                                   \
+    {                                                      \
+        prvAddTaskToPriorityReadyList( pxTCB );            \
+    }
+#else
+    #define prvAddTaskToReadyList( pxTCB )    prvAddTaskToPriorityReadyList( pxTCB )
+#endif
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted sorted by the uxDeadline
+ * the task.  It is inserted sorted by the uxDeadline.  The item value is
+ * restored first as it holds the wake time while the task is delayed.
  */
-#define prvAddTaskByDeadlineToReadyList( pxTCB )                                                                 \
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+/* Under EDF periodic and aperiodic tasks share xReadyPeriodicTasksLists, keyed
+ * on the absolute deadline of their current job. */
+    #define prvAddTaskByDeadlineToReadyList( pxTCB )                                                   \
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
-    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
-    listINSERT( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+    listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), taskEDF_KEY( pxTCB ) );                   \
+    taskPERIODIC_READY_INSERT( taskPARTITION_OF( pxTCB ), &( ( pxTCB )->xStateListItem ) );            \
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
+    taskYIELD_FOR_TASK( pxTCB )
+#elif ( configUSE_APERIODIC_SERVER == 1 )
+
+/* Once xTaskServerCreate() has been called the task is queued on the server
+ * instead, and only runs when the server is scheduled. */
+    #define prvAddTaskByDeadlineToReadyList( pxTCB )                                                           \
+    traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                                   \
+    listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( pxTCB )->uxDeadline );                          \
+    if( xAperiodicServer.xPeriod != ( TickType_t ) 0U )                                                        \
+    {                                                                                                          \
+        taskSERVER_JOB_INSERT( &( ( pxTCB )->xStateListItem ) );                                               \
+        prvServerUpdateReadyState();                                                                           \
+    }                                                                                                          \
+    else                                                                                                       \
+    {                                                                                                          \
+        taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                    \
+        listINSERT( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) );         \
+    }                                                                                                          \
     tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#else
+    #define prvAddTaskByDeadlineToReadyList( pxTCB )                                                   \
+    traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
+    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
+    listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( pxTCB )->uxDeadline );                  \
+    listINSERT( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) );     \
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
+    taskYIELD_FOR_TASK( pxTCB )
+#endif /* configUSE_APERIODIC_SERVER */
 /*
- * Place the task represented by pxTCB into the periodic ready list.  It is inserted sorted by the uxDeadline
+ * Place the task represented by pxTCB into the periodic ready list.  It is
+ * inserted sorted by uxPeriod, or by the absolute deadline of its job under
+ * EDF.  The ready priority is not recorded as the task is not in
+ * pxReadyTasksLists, and a recorded priority with an empty list would trip the
+ * port optimised task selection.
  */
-#define prvAddTaskToPeriodicReadyList( pxTCB )                                                                 \
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    #define prvAddTaskToPeriodicReadyList( pxTCB )    prvAddTaskByDeadlineToReadyList( pxTCB )
+#else
+    #define prvAddTaskToPeriodicReadyList( pxTCB )                                                     \
     traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
-    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
-    listINSERT( &( xReadyPeriodicTasksLists ), &( ( pxTCB )->xStateListItem ) ); \
-    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+    listSET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ), ( pxTCB )->uxPeriod );                    \
+    taskPERIODIC_READY_INSERT( taskPARTITION_OF( pxTCB ), &( ( pxTCB )->xStateListItem ) );            \
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );                                                      \
+    taskYIELD_FOR_TASK( pxTCB )
+#endif
+
+/*
+ * Periodic tasks are created with an infinite deadline, aperiodic tasks with an
+ * infinite period.  Tasks created with xTaskCreate() have neither.
+ */
+#define taskIS_PERIODIC( pxTCB )     ( ( pxTCB )->uxDeadline == portMAX_DELAY )
+#define taskIS_APERIODIC( pxTCB )    ( ( pxTCB )->uxPeriod == portMAX_DELAY )
+
+/*
+ * The deadline of a job relative to its release.  Periodic tasks have implicit
+ * deadlines, equal to their period.
+ */
+#define taskRELATIVE_DEADLINE( pxTCB )    ( taskIS_PERIODIC( pxTCB ) ? ( pxTCB )->uxPeriod : ( TickType_t ) ( pxTCB )->uxDeadline )
+
+/*
+ * True if pxTCB has an absolute deadline for its current job, which is what
+ * deadline misses are checked against.  Aperiodic jobs only get one under EDF.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    #define taskHAS_ABSOLUTE_DEADLINE( pxTCB )    ( taskIS_PERIODIC( pxTCB ) || taskIS_APERIODIC( pxTCB ) )
+#else
+    #define taskHAS_ABSOLUTE_DEADLINE( pxTCB )    taskIS_PERIODIC( pxTCB )
+#endif
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+/*
+ * The EDF ready list is keyed on absolute deadlines measured from xEDFTimeBase,
+ * so that keys compare correctly across a tick count overflow.  The base is
+ * moved forward by taskEDF_REBASE_INTERVAL whenever the tick count gets that far
+ * ahead of it, which keeps every key below half the tick range as long as no
+ * relative deadline is longer than the interval.  A deadline from before the
+ * base has been missed and gets key 0.
+ */
+    #define taskEDF_REBASE_INTERVAL    ( ( TickType_t ) ( portMAX_DELAY >> 2 ) )
+
+    #define taskEDF_KEY( pxTCB )                                                                  \
+    ( ( ( TickType_t ) ( ( pxTCB )->xAbsoluteDeadline - xEDFTimeBase ) > ( portMAX_DELAY >> 1 ) ) ? \
+      ( TickType_t ) 0U : ( TickType_t ) ( ( pxTCB )->xAbsoluteDeadline - xEDFTimeBase ) )
+
+/*
+ * True if pxTCB, which has just been made ready, has an earlier deadline than
+ * the running task.  Tasks that have a deadline outrank those that do not.
+ */
+    #define taskEDF_PREEMPTS( pxTCB )                                                            \
+    ( taskHAS_ABSOLUTE_DEADLINE( pxTCB ) &&                                                      \
+      ( ( taskHAS_ABSOLUTE_DEADLINE( pxCurrentTCB ) == pdFALSE ) ||                              \
+        ( taskEDF_KEY( pxTCB ) < taskEDF_KEY( pxCurrentTCB ) ) ) )
+
+#endif /* configUSE_EDF_SCHEDULER */
+
+/*
+ * The period the running task is scheduled at.  A job run by the aperiodic
+ * server inherits the server's period.
+ */
+#if ( configUSE_APERIODIC_SERVER == 1 )
+    #define taskCURRENT_PERIOD()                                                   \
+    ( ( xAperiodicServer.xRunning != pdFALSE ) ? xAperiodicServer.xPeriod :        \
+      ( taskIS_PERIODIC( pxCurrentTCB ) ? pxCurrentTCB->uxPeriod : portMAX_DELAY ) )
+
+/* True if the server has become the highest priority periodic entity but is
+ * not the one running. */
+    #define taskSERVER_PREEMPTS()                                                                           \
+    ( ( xAperiodicServer.xRunning == pdFALSE ) &&                                                           \
+      ( taskPERIODIC_READY_HEAD( 0 ) == &( xAperiodicServer.xServerListItem ) ) )
+#else
+    #define taskCURRENT_PERIOD()    ( taskIS_PERIODIC( pxCurrentTCB ) ? pxCurrentTCB->uxPeriod : portMAX_DELAY )
+#endif
+
+/*
+ * True if the periodic task pxTCB, which has just been made ready, should
+ * preempt the running task.  Periodic tasks are ordered by period (rate
+ * monotonic), or by deadline under EDF, and all of them outrank the tasks
+ * scheduled by priority.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    #define taskPERIODIC_PREEMPTS( pxTCB )    taskEDF_PREEMPTS( pxTCB )
+#else
+    #define taskPERIODIC_PREEMPTS( pxTCB )    ( ( pxTCB )->uxPeriod < taskCURRENT_PERIOD() )
+#endif
+
+/*
+ * True if pxTCB, which has just been moved out of a blocked state, should
+ * preempt the running task ahead of the priority comparison.
+ */
+#if ( configUSE_EDF_SCHEDULER == 1 )
+    #define taskUNBLOCKED_PREEMPTS( pxTCB )    taskEDF_PREEMPTS( pxTCB )
+#else
+    #define taskUNBLOCKED_PREEMPTS( pxTCB )    ( ( taskIS_PERIODIC( pxTCB ) != pdFALSE ) && taskPERIODIC_PREEMPTS( pxTCB ) )
+#endif
+
+/*
+ * True if the aperiodic task pxTCB, which has just been made ready, should
+ * preempt the running task.  Once the server exists it decides, as in
+ * prvAddNewTaskByDeadlineToReadyList().
+ */
+#if ( configUSE_APERIODIC_JOBS == 1 )
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        #define taskAPERIODIC_PREEMPTS( pxTCB )    taskEDF_PREEMPTS( pxTCB )
+    #elif ( configUSE_APERIODIC_SERVER == 1 )
+        #define taskAPERIODIC_PREEMPTS( pxTCB )                                    \
+    ( ( xAperiodicServer.xPeriod != ( TickType_t ) 0U ) ? taskSERVER_PREEMPTS() : \
+      ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) )
+    #else
+        #define taskAPERIODIC_PREEMPTS( pxTCB )    ( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority )
+    #endif
+
+/* The deadline of a worker that has yet to be given its first job, far enough
+ * not to get ahead of the jobs. */
+    #define taskJOB_WORKER_DEADLINE    ( ( TickType_t ) ( portMAX_DELAY >> 2 ) )
+#endif /* configUSE_APERIODIC_JOBS */
 /*-----------------------------------------------------------*/
 
 /*
@@ -279,7 +603,66 @@
  * task should be used in place of the parameter.  This macro simply checks to
  * see if the parameter is NULL and returns a pointer to the appropriate TCB.
  */
-#define prvGetTCBFromHandle( pxHandle )    ( ( ( pxHandle ) == NULL ) ? pxCurrentTCB : ( pxHandle ) )
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* pxCurrentTCB reads the entry of the core the caller runs on, which is only
+ * stable while the caller cannot be switched out, see
+ * xTaskGetCurrentTaskHandle(). */
+    #define prvGetTCBFromHandle( pxHandle )    ( ( ( pxHandle ) == NULL ) ? ( TCB_t * ) xTaskGetCurrentTaskHandle() : ( pxHandle ) )
+#else
+    #define prvGetTCBFromHandle( pxHandle )    ( ( ( pxHandle ) == NULL ) ? pxCurrentTCB : ( pxHandle ) )
+#endif
+
+/*
+ * True if pxTCB is running, on any core.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+    #define taskTASK_NOT_RUNNING    ( ( BaseType_t ) -1 )
+    #define taskTASK_IS_RUNNING( pxTCB )    ( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING )
+
+/* True if pxTCB is placed in a periodic ready list, so belongs to the core of
+ * its partition with configUSE_PARTITIONED_SCHEDULING: the periodic tasks, and
+ * the aperiodic tasks that are queued by deadline with them under EDF. */
+    #define taskIN_PARTITION( pxTCB )    taskHAS_ABSOLUTE_DEADLINE( pxTCB )
+
+/* True if xCoreID is one of the cores pxTCB may ever run on: the core of its
+ * partition with configUSE_PARTITIONED_SCHEDULING, which takes precedence over
+ * the affinity mask, and otherwise the cores the mask allows with
+ * configUSE_CORE_AFFINITY. */
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        #define taskAFFINITY_ALLOWS( pxTCB, xCoreID ) \
+    ( ( ( pxTCB )->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) ( xCoreID ) ) ) != 0U )
+    #else
+        #define taskAFFINITY_ALLOWS( pxTCB, xCoreID )    ( pdTRUE )
+    #endif
+
+    #if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+        #define taskMAY_RUN_ON_CORE( pxTCB, xCoreID ) \
+    ( taskIN_PARTITION( pxTCB ) ? ( ( pxTCB )->xPartitionCore == ( xCoreID ) ) : taskAFFINITY_ALLOWS( pxTCB, xCoreID ) )
+    #else
+        #define taskMAY_RUN_ON_CORE( pxTCB, xCoreID )    taskAFFINITY_ALLOWS( pxTCB, xCoreID )
+    #endif
+
+/* True if pxTCB may be selected to run on xCoreID: it is not running on
+ * another core, and may run on xCoreID at all. */
+    #define taskCAN_RUN_ON_CORE( pxTCB, xCoreID )                                                                 \
+    ( ( ( ( pxTCB )->xTaskRunState == taskTASK_NOT_RUNNING ) || ( ( pxTCB )->xTaskRunState == ( xCoreID ) ) ) && \
+      taskMAY_RUN_ON_CORE( pxTCB, xCoreID ) )
+#else
+    #define taskTASK_IS_RUNNING( pxTCB )    ( ( pxTCB ) == pxCurrentTCB )
+#endif
+
+/*
+ * True if the scheduler is suspended by the caller.  With several cores the
+ * core that suspends the scheduler holds the kernel lock until it resumes it,
+ * so the other cores only see it suspended when they read it unlocked.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+    #define taskSCHEDULER_SUSPENDED_BY_CALLER() \
+    ( ( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE ) && ( pxSchedulerSuspender == xTaskGetCurrentTaskHandle() ) )
+#else
+    #define taskSCHEDULER_SUSPENDED_BY_CALLER()    ( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+#endif
 
 /* The item value of the event list item is normally used to hold the priority
  * of the task to which it belongs (coded to allow it to be held in reverse
@@ -372,6 +755,71 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         TickType_t uxPeriod;
         TickType_t uxDeadline;
     #endif
+
+    #if ( configUSE_APERIODIC_BUDGET == 1 )
+        TickType_t xBudgetRemaining; /*< Ticks the aperiodic job may still run for before configAPERIODIC_OVERRUN_POLICY is applied. */
+        BaseType_t xThrottlePending; /*< Set if the budget ran out while the task was blocking, so the tskAPERIODIC_OVERRUN_THROTTLE throttle is left until it is ready again. */
+    #endif
+
+    #if ( INCLUDE_vTaskEndJob == 1 )
+        TickType_t xReleaseTime;      /*< Release time of the current job of a periodic task. */
+        TickType_t xAbsoluteDeadline; /*< Absolute deadline of the current job. */
+        TickType_t xCompletionTime;   /*< Completion time of the last completed job. */
+        TickType_t xResponseTime;     /*< Response time of the last completed job. */
+        UBaseType_t uxJobNumber;      /*< Number of jobs released so far. */
+        UBaseType_t uxDeadlineMisses; /*< Number of jobs that missed their absolute deadline. */
+        UBaseType_t uxLastMissedJob;  /*< Job number of the last reported miss, so a job is only counted once. */
+    #endif
+
+    #if ( configUSE_SCHEDULER_STATS == 1 )
+        UBaseType_t uxCompletedJobs;                       /*< Number of jobs that called vTaskEndJob(). */
+        configSCHEDULER_STATS_COUNTER_TYPE ulBestResponse;  /*< Shortest response time, in portGET_SCHEDULER_STATS_TIME() counts. */
+        configSCHEDULER_STATS_COUNTER_TYPE ulWorstResponse; /*< Longest response time, in portGET_SCHEDULER_STATS_TIME() counts. */
+        uint64_t ullTotalResponse;                         /*< Sum of the response times, for the average. */
+        int64_t llWorstLateness;                           /*< Largest completion time minus absolute deadline. */
+        int64_t llTotalLateness;                           /*< Sum of the lateness values, for the average. */
+    #endif
+
+    #if ( configUSE_READY_HEAP == 1 )
+        UBaseType_t uxReadyHeapIndex; /*< Position of the task's entry in the ready heap it was last inserted in. */
+    #endif
+
+    #if ( configUSE_ADMISSION_CONTROL == 1 )
+        uint32_t ulAdmittedLoad; /*< Share reserved for the task by the admission test, given back when it is deleted. */
+    #endif
+
+    #if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+        UBaseType_t uxPendingReleases; /*< Releases by xTaskReleaseJobFromISR() that came while the previous job was still running. */
+    #endif
+
+    #if ( configUSE_TASK_POOL == 1 )
+        struct tskTaskPool * pxTaskPool; /*< The pool the TCB and stack are a slot of, NULL for a task that is not. */
+    #endif
+
+    #if ( configUSE_APERIODIC_JOBS == 1 )
+        AperiodicJob_t * pxAperiodicJob; /*< The job a worker of xTaskCreateJobWorkers() runs, NULL while it waits for one. */
+        UBaseType_t uxWorkerPriority;    /*< The priority passed to xTaskCreateJobWorkers(), given back to the worker with each job. */
+    #endif
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xTaskRunState; /*< The core the task is running on, taskTASK_NOT_RUNNING if none. */
+        BaseType_t xLastRunCore;  /*< The core the task last ran on, taskTASK_NOT_RUNNING if it has not run yet. */
+        UBaseType_t uxMigrations; /*< Times the task was switched in on another core than the last time, see uxTaskGetMigrationCount(). */
+        #if ( configUSE_CORE_AFFINITY == 1 )
+            UBaseType_t uxCoreAffinityMask; /*< Bit n set if the task may run on core n. */
+        #endif
+        #if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+            BaseType_t xPartitionCore; /*< The core whose periodic ready list the task is placed in, see taskIN_PARTITION(). */
+            uint32_t ulPartitionLoad;  /*< Utilisation the task holds on the core its jobs start on. */
+            #if ( configUSE_TASK_SPLITTING == 1 )
+                BaseType_t xHomeCore;    /*< The core the jobs start on.  xPartitionCore differs from it while a split job runs its second share. */
+                BaseType_t xSplitCore;   /*< The core the jobs finish on, taskTASK_NOT_RUNNING if the task is not split. */
+                TickType_t xSplitBudget; /*< Ticks of each job run on xHomeCore before the job moves to xSplitCore. */
+                TickType_t xJobTicks;    /*< Ticks the current job has run on xHomeCore. */
+                uint32_t ulSplitLoad;    /*< Utilisation the task holds on xSplitCore. */
+            #endif
+        #endif
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -380,7 +828,15 @@ typedef tskTCB TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
-portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* The task running on each core.  pxCurrentTCB is the one of the core the
+ * caller runs on, so the code shared with the single core build is unchanged. */
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ] = { NULL };
+    #define pxCurrentTCB    pxCurrentTCBs[ portGET_CORE_ID() ]
+#else
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#endif
 
 /* Lists for ready and blocked tasks. --------------------
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
@@ -395,11 +851,242 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 
 #if ( configUSE_POLLING_SERVER == 1)
 
-    PRIVILEGED_DATA static List_t xReadyPeriodicTasksLists;              /* Ready periodic tasks. */
+    #if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+        PRIVILEGED_DATA static List_t xReadyPeriodicTasksLists[ configNUMBER_OF_CORES ]; /* Ready periodic tasks, one list per core. */
+    #else
+        PRIVILEGED_DATA static List_t xReadyPeriodicTasksLists;          /* Ready periodic tasks. */
+    #endif
     PRIVILEGED_DATA static List_t xPendingPeriodicReadyList;             /* Periodic tasks that have finished their execution and are waiting for the next cicle. */
 
+    #if ( INCLUDE_vTaskEndJob == 1 )
+        PRIVILEGED_DATA static List_t xPendingPeriodicReadyList2;                         /*< Pending periodic tasks (two lists are used - one for releases that have overflowed the current tick count. */
+        PRIVILEGED_DATA static List_t * volatile pxPendingPeriodicList;                   /*< Points to the pending periodic list currently being used. */
+        PRIVILEGED_DATA static List_t * volatile pxOverflowPendingPeriodicList;           /*< Points to the pending periodic list holding releases that have overflowed the current tick count. */
+        PRIVILEGED_DATA static volatile TickType_t xNextPeriodicReleaseTime = portMAX_DELAY; /*< Release time of the task at the head of pxPendingPeriodicList. */
+    #endif
+
+    #if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+        PRIVILEGED_DATA static List_t xWaitingReleaseList;                                /*< Periodic tasks waiting in vTaskWaitForRelease() for xTaskReleaseJobFromISR(). */
+    #endif
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        PRIVILEGED_DATA static TickType_t xEDFTimeBase = ( TickType_t ) configINITIAL_TICK_COUNT; /*< Origin of the keys in the EDF ready list, see taskEDF_KEY(). */
+    #endif
+
+#endif
+
+#if ( configUSE_APERIODIC_SERVER == 1 )
+
+/*
+ * The aperiodic server.  Its list item sits in xReadyPeriodicTasksLists, ordered
+ * by xPeriod like the state list item of a periodic task, whenever the server
+ * has both capacity left and a job in xJobList.  The item has no owner, which is
+ * how vTaskSwitchContext() recognises it.
+ */
+    typedef struct xAPERIODIC_SERVER
+    {
+        ListItem_t xServerListItem;                                   /*< Places the server in xReadyPeriodicTasksLists. */
+        List_t xJobList;                                              /*< Ready aperiodic tasks, ordered by deadline (see taskSERVER_JOB_HEAD()). */
+        eServerPolicy ePolicy;                                        /*< Replenishment rule. */
+        TickType_t xCapacity;                                         /*< Capacity granted per period. */
+        TickType_t xPeriod;                                           /*< Replenishment period.  Zero until xTaskServerCreate() is called. */
+        TickType_t xBudget;                                           /*< Capacity left. */
+        TickType_t xNextReplenishTime;                                /*< Next period boundary (polling and deferrable). */
+        TickType_t xActivationTime;                                   /*< Start of the current busy interval (sporadic). */
+        TickType_t xConsumed;                                         /*< Capacity used in the current busy interval (sporadic). */
+        TickType_t xReplenishTime[ configSERVER_MAX_REPLENISHMENTS ]; /*< Pending replenishments, oldest first (sporadic). */
+        TickType_t xReplenishAmount[ configSERVER_MAX_REPLENISHMENTS ];
+        UBaseType_t uxReplenishHead;
+        UBaseType_t uxReplenishCount;
+        BaseType_t xRunning;                                          /*< pdTRUE while pxCurrentTCB was selected through the server. */
+        #if ( configUSE_READY_HEAP == 1 )
+            UBaseType_t uxReadyHeapIndex;                             /*< Position of xServerListItem in xPeriodicReadyHeap. */
+        #endif
+    } AperiodicServer_t;
+
+    PRIVILEGED_DATA static AperiodicServer_t xAperiodicServer;
+
+#endif
+
+#if ( configUSE_READY_HEAP == 1 )
+
+/*
+ * A binary min-heap of list items, ordered by the item value they had when
+ * they were inserted.  Items that were inserted with the same value keep their
+ * insertion order, as they would with listINSERT().
+ *
+ * The list the items are inserted in remains the authority on whether a task
+ * is ready, so the many places that remove a task from a ready list do not
+ * need to know about the heap.  An entry whose item has since left the list is
+ * stale.  Stale entries are dropped when they reach the top of the heap, or
+ * reused when the same item is inserted again, so there is never more than one
+ * entry per item.
+ */
+    typedef struct xREADY_HEAP_ENTRY
+    {
+        ListItem_t * pxItem;  /*< The list item the entry orders. */
+        TickType_t xKey;      /*< Item value at the time of insertion. */
+        UBaseType_t uxOrder;  /*< Insertion sequence number, breaks ties between equal keys. */
+    } ReadyHeapEntry_t;
+
+    typedef struct xREADY_HEAP
+    {
+        List_t * pxList;                                       /*< The list the heap orders. */
+        UBaseType_t uxCount;                                   /*< Number of entries, including stale ones. */
+        UBaseType_t uxNextOrder;                               /*< Sequence number of the next insertion. */
+        ReadyHeapEntry_t xEntries[ configREADY_HEAP_LENGTH ];  /*< The heap, with the smallest key at index 0. */
+    } ReadyHeap_t;
+
+    #if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+        PRIVILEGED_DATA static ReadyHeap_t xPeriodicReadyHeaps[ configNUMBER_OF_CORES ]; /*< Order the lists of xReadyPeriodicTasksLists. */
+    #else
+        PRIVILEGED_DATA static ReadyHeap_t xPeriodicReadyHeap; /*< Orders xReadyPeriodicTasksLists. */
+    #endif
+
+    #if ( configUSE_APERIODIC_SERVER == 1 )
+        PRIVILEGED_DATA static ReadyHeap_t xServerJobHeap; /*< Orders xAperiodicServer.xJobList. */
+    #endif
+
+#endif /* configUSE_READY_HEAP */
+
+#if ( configUSE_ADMISSION_CONTROL == 1 ) || ( configUSE_PARTITIONED_SCHEDULING == 1 )
+
+/*
+ * Utilisations are fixed point, with taskUTILISATION_ONE standing for 1.
+ */
+    #define taskUTILISATION_ONE    ( ( uint32_t ) 0x10000UL )
+
+/* xDuration / xInterval, rounded up so the totals never understate the load.
+ * xDuration must not be greater than xInterval. */
+    #define taskUTILISATION( xDuration, xInterval ) \
+    ( ( uint32_t ) ( ( ( ( uint64_t ) ( xDuration ) << 16 ) + ( uint64_t ) ( xInterval ) - 1U ) / ( uint64_t ) ( xInterval ) ) )
+
 #endif
 
+#if ( configUSE_ADMISSION_CONTROL == 1 )
+
+/*
+ * Running totals of the admission test, so admitting or deleting a task costs
+ * O(1).
+ */
+    typedef struct xADMISSION_CONTROL
+    {
+        uint32_t ulUtilisation;       /*< Total utilisation of the admitted periodic tasks and of the server, plus the density of the admitted aperiodic tasks under EDF. */
+        uint32_t ulHyperbolicProduct; /*< Product of ( Ui + 1 ) over the same tasks. */
+        UBaseType_t uxAdmittedTasks;  /*< Number of tasks that make up ulUtilisation. */
+        #if ( configUSE_APERIODIC_SERVER == 1 )
+            uint32_t ulServerUtilisation; /*< Utilisation of the server, zero until xTaskServerCreate() is called. */
+            TickType_t xServerBacklog;    /*< Execution time of the admitted aperiodic tasks that have not been deleted yet. */
+        #endif
+    } AdmissionControl_t;
+
+    PRIVILEGED_DATA static AdmissionControl_t xAdmissionControl = { .ulHyperbolicProduct = taskUTILISATION_ONE };
+
+    #if ( ( configUSE_EDF_SCHEDULER == 0 ) && ( configADMISSION_RM_TEST == tskADMISSION_LIU_LAYLAND ) )
+
+/*
+ * n( 2^(1/n) - 1 ) for n = 1 to 16, rounded down.  Larger sets use the limit
+ * of the bound, ln 2.
+ */
+        static const uint32_t ulLiuLaylandBound[] =
+        {
+            65536UL, 54291UL, 51102UL, 49599UL, 48725UL, 48154UL, 47751UL, 47452UL,
+            47221UL, 47037UL, 46887UL, 46763UL, 46658UL, 46569UL, 46492UL, 46424UL
+        };
+        #define taskLIU_LAYLAND_LIMIT    ( ( uint32_t ) 45426UL )
+
+    #endif
+
+#endif /* configUSE_ADMISSION_CONTROL */
+
+#if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+
+/*
+ * The share of each core held by the periodic tasks assigned to it, kept like
+ * the totals of the admission test so that placing or deleting a task costs
+ * O(1) per core.  A split task holds a share on each of its two cores.
+ */
+    typedef struct xCORE_PARTITION
+    {
+        uint32_t ulUtilisation;       /*< Total utilisation of the shares on the core. */
+        uint32_t ulHyperbolicProduct; /*< Product of ( Ui + 1 ) over the same shares, for the rate monotonic test. */
+        UBaseType_t uxShares;         /*< Number of shares that make up ulUtilisation. */
+    } CorePartition_t;
+
+    PRIVILEGED_DATA static CorePartition_t xCorePartitions[ configNUMBER_OF_CORES ];
+
+/* The utilisation of a periodic task.  A job as long as its period takes a
+ * whole core. */
+    #define taskPERIODIC_UTILISATION( pxTCB )                                                            \
+    ( ( ( pxTCB )->uxDuration < ( pxTCB )->uxPeriod ) ? taskUTILISATION( ( pxTCB )->uxDuration, ( pxTCB )->uxPeriod ) : \
+      taskUTILISATION_ONE )
+
+/* A utilisation in thousandths, rounded up like the utilisation itself. */
+    #define taskUTILISATION_PERMILLE( ulUtilisation ) \
+    ( ( UBaseType_t ) ( ( ( uint64_t ) ( ulUtilisation ) * 1000U + ( uint64_t ) ( taskUTILISATION_ONE - 1U ) ) >> 16 ) )
+
+#endif /* configUSE_PARTITIONED_SCHEDULING */
+
+#if ( configUSE_STACK_RESOURCE_POLICY == 1 )
+
+/*
+ * A resource shared under the Stack Resource Policy.  Ceilings and preemption
+ * levels are relative deadlines, so a smaller value is a higher level.  The
+ * resources that are held form a stack, linked through pxPrevious, as the
+ * protocol guarantees they are given back in the reverse order they were
+ * taken.
+ */
+    typedef struct tskResource
+    {
+        TickType_t xCeiling;               /*< Shortest relative deadline of the tasks that use the resource. */
+        TickType_t xPreviousSystemCeiling; /*< xSystemCeiling before the resource was taken, restored when it is given. */
+        TCB_t * pxHolder;                  /*< The task holding the resource, NULL while it is free. */
+        struct tskResource * pxPrevious;   /*< The resource below this one on the stack. */
+    } Resource_t;
+
+    PRIVILEGED_DATA static Resource_t * pxResourceStackTop = NULL;              /*< The resource taken last, NULL when none is held. */
+    PRIVILEGED_DATA static TickType_t xSystemCeiling = portMAX_DELAY;           /*< Highest ceiling among the resources held. */
+    PRIVILEGED_DATA static volatile BaseType_t xCeilingBlockedTask = pdFALSE;   /*< Set when the ceiling kept the selected task from running. */
+
+#endif /* configUSE_STACK_RESOURCE_POLICY */
+
+#if ( configUSE_TASK_POOL == 1 )
+
+/*
+ * A pool of TCBs and stacks, see xTaskPoolCreate().  The slots that are not in
+ * use are linked through the state list items of their TCBs.
+ */
+    typedef struct tskTaskPool
+    {
+        List_t xFreeSlots;             /*< Slots ready to be taken. */
+        List_t xSlotsWaitingRelease;   /*< Tasks of the pool that deleted themselves, released by the next creation. */
+        TCB_t * pxTCBs;                /*< The TCB of every slot. */
+        StackType_t * pxStacks;        /*< The stack of every slot, usStackDepth words each. */
+        configSTACK_DEPTH_TYPE usStackDepth;
+    } TaskPool_t;
+
+#endif /* configUSE_TASK_POOL */
+
+#if ( configUSE_APERIODIC_JOBS == 1 )
+
+/*
+ * The jobs submitted with xTaskSubmitJob() that wait for a worker, kept as a
+ * binary heap on the absolute deadline, and the workers that wait for a job.
+ * Jobs only wait while no worker does, so at most one of the two is not empty.
+ */
+    typedef struct tskJobQueue
+    {
+        AperiodicJob_t * pxJobs[ configAPERIODIC_JOB_QUEUE_LENGTH ]; /*< pxJobs[ 0 ] is the job with the earliest deadline. */
+        UBaseType_t uxCount;                                         /*< Number of jobs in pxJobs. */
+        UBaseType_t uxNextOrder;                                     /*< Submission order of the next job. */
+        List_t xIdleWorkers;                                         /*< Workers waiting for a job. */
+        List_t xWakingWorkers;                                       /*< Workers given a job while the scheduler was suspended, on their way to the ready list through xPendingReadyList. */
+    } JobQueue_t;
+
+    PRIVILEGED_DATA static JobQueue_t xJobQueue;
+
+#endif /* configUSE_APERIODIC_JOBS */
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     PRIVILEGED_DATA static List_t xTasksWaitingTermination; /*< Tasks that have been deleted - but their memory not yet freed. */
@@ -425,11 +1112,21 @@ PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINI
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#if ( configNUMBER_OF_CORES > 1 )
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE };
+    #define xYieldPending    xYieldPendings[ portGET_CORE_ID() ]
+#else
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows = ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#if ( configNUMBER_OF_CORES > 1 )
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ] = { NULL }; /*< One idle task per core, so every core always has a task to run. */
+    #define xIdleTaskHandle    xIdleTaskHandles[ 0 ]
+#else
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#endif
 
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
@@ -446,6 +1143,10 @@ const volatile UBaseType_t uxTopUsedPriority = configMAX_PRIORITIES - 1U;
  * accessed from a critical section. */
 PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t ) pdFALSE;
 
+#if ( configNUMBER_OF_CORES > 1 )
+    PRIVILEGED_DATA static TaskHandle_t volatile pxSchedulerSuspender = NULL; /*< The task that suspended the scheduler, while uxSchedulerSuspended is not zero. */
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 /* Do not move these variables to function scope as doing so prevents the
@@ -455,20 +1156,89 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 #endif
 
-/*lint -restore */
+#if ( configUSE_SCHEDULER_STATS == 1 )
 
-/*-----------------------------------------------------------*/
+    PRIVILEGED_DATA static volatile configSCHEDULER_STATS_COUNTER_TYPE ulTickStatsTime = 0UL; /*< portGET_SCHEDULER_STATS_TIME() when xTickCount was last incremented. */
 
-/* File private functions. --------------------------------*/
+#endif
 
-/**
- * Utility task that simply returns pdTRUE if the task referenced by xTask is
- * currently in the Suspended state, or pdFALSE if the task referenced by xTask
- * is in any other state.
- */
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( configUSE_TRACE_BUFFER == 1 )
 
-    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+    #if ( ( configTRACE_BUFFER_LENGTH & ( configTRACE_BUFFER_LENGTH - 1 ) ) != 0 )
+        #error configTRACE_BUFFER_LENGTH must be a power of 2
+    #endif
+
+/* Event identifiers stored in the trace buffer. */
+    #define taskTRACE_EVENT_SWITCHED_IN          ( 1U )  /* The task was selected to run. */
+    #define taskTRACE_EVENT_READY                ( 2U )  /* The task was moved to a ready list. */
+    #define taskTRACE_EVENT_CREATE               ( 3U )  /* The task was created, argument is its priority. */
+    #define taskTRACE_EVENT_DELETE               ( 4U )
+    #define taskTRACE_EVENT_SUSPEND              ( 5U )
+    #define taskTRACE_EVENT_JOB_RELEASED         ( 6U )  /* Argument is the job number. */
+    #define taskTRACE_EVENT_JOB_COMPLETED        ( 7U )  /* Argument is the job number. */
+    #define taskTRACE_EVENT_DEADLINE_MISSED      ( 8U )  /* Argument is the job number. */
+    #define taskTRACE_EVENT_SERVER_REPLENISHED   ( 9U )  /* No task, argument is the server budget. */
+    #define taskTRACE_EVENT_SERVER_EXHAUSTED     ( 10U ) /* The server job that used up the budget. */
+    #define taskTRACE_EVENT_RESOURCE_TAKE        ( 11U ) /* Argument is the ceiling of the resource. */
+    #define taskTRACE_EVENT_RESOURCE_GIVE        ( 12U ) /* Argument is the ceiling of the resource. */
+    #define taskTRACE_EVENT_CEILING_BLOCKED      ( 13U ) /* The task the system ceiling kept from running. */
+
+    #define taskTRACE_BUFFER_MAGIC               ( 0x46425254UL ) /* "TRBF" in little endian memory. */
+    #define taskTRACE_BUFFER_VERSION             ( 1UL )
+
+/*
+ * The trace buffer is a single object so a debugger can dump it in one go
+ * (gdb: dump binary value trace.bin xTraceBuffer), or a decoder can find it in
+ * a dump of the whole RAM from its magic number.  Each event is one 64 bit
+ * word: the timestamp in the upper 32 bits, then 8 bits of event identifier,
+ * 8 bits of task number (uxTCBNumber, 0 for none) and 16 bits of argument.
+ * ulHead counts the events written, the last configTRACE_BUFFER_LENGTH of
+ * which are kept.  Task names are stored when the task is created, at index
+ * uxTCBNumber modulo configTRACE_BUFFER_MAX_TASKS.
+ */
+    typedef struct TraceBuffer
+    {
+        uint32_t ulMagic;
+        uint32_t ulVersion;
+        uint32_t ulLength;          /*< configTRACE_BUFFER_LENGTH. */
+        uint32_t ulMaxTasks;        /*< configTRACE_BUFFER_MAX_TASKS. */
+        uint32_t ulNameLength;      /*< configMAX_TASK_NAME_LEN. */
+        uint32_t ulCountsPerSecond; /*< Frequency of the timestamps. */
+        volatile uint32_t ulHead;
+        uint32_t ulReserved;
+        char cTaskNames[ configTRACE_BUFFER_MAX_TASKS ][ configMAX_TASK_NAME_LEN ];
+        uint64_t ullEvents[ configTRACE_BUFFER_LENGTH ];
+    } TraceBuffer_t;
+
+    PRIVILEGED_DATA static TraceBuffer_t xTraceBuffer =
+    {
+        .ulMagic           = taskTRACE_BUFFER_MAGIC,
+        .ulVersion         = taskTRACE_BUFFER_VERSION,
+        .ulLength          = configTRACE_BUFFER_LENGTH,
+        .ulMaxTasks        = configTRACE_BUFFER_MAX_TASKS,
+        .ulNameLength      = configMAX_TASK_NAME_LEN,
+        .ulCountsPerSecond = ( uint32_t ) ( configTRACE_BUFFER_COUNTS_PER_TICK ) * ( uint32_t ) configTICK_RATE_HZ
+    };
+
+    #define taskTRACE_BUFFER_RECORD( ulEvent, pxTCB, xArgument )    prvTraceBufferRecord( ( ulEvent ), ( pxTCB ), ( uint32_t ) ( xArgument ) )
+    #define taskTRACE_BUFFER_CREATE( pxNewTCB )                    prvTraceBufferCreate( pxNewTCB )
+
+#endif /* configUSE_TRACE_BUFFER */
+
+/*lint -restore */
+
+/*-----------------------------------------------------------*/
+
+/* File private functions. --------------------------------*/
+
+/**
+ * Utility task that simply returns pdTRUE if the task referenced by xTask is
+ * currently in the Suspended state, or pdFALSE if the task referenced by xTask
+ * is in any other state.
+ */
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
 
 #endif /* INCLUDE_vTaskSuspend */
 
@@ -502,6 +1272,64 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 
     static void prvDeleteTCB( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Place a task that deleted itself, or that the tick deleted, where its memory
+ * is released once it no longer runs: the termination list that the idle task
+ * checks, or the pool the task was created from.
+ */
+    static void prvAddTaskToTerminationList( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_POOL == 1 )
+
+/*
+ * Take a free slot of a pool, after releasing the slot of a task of the pool
+ * that deleted itself, if any.  Returns the TCB of the slot, cleared and with
+ * its stack set, or NULL if every slot is in use.
+ */
+    static TCB_t * prvTaskPoolTakeSlot( TaskPool_t * pxTaskPool ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_APERIODIC_JOBS == 1 )
+
+/*
+ * The task function of the workers.  Runs one job after the other.
+ */
+    static portTASK_FUNCTION_PROTO( prvJobWorkerTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by a worker when it has finished its job, or has yet to get one.
+ * Marks the job done, then takes the most urgent queued job, or waits for
+ * xTaskSubmitJob() to give it one.  Returns the new job.
+ */
+    static AperiodicJob_t * prvJobWorkerNextJob( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Make pxJob the job of the worker pxTCB.  The worker takes the timing of the
+ * job and gets back the priority it was created with.  The caller moves the
+ * worker to the ready list.
+ */
+    static void prvJobWorkerAssign( TCB_t * pxTCB,
+                                    AperiodicJob_t * pxJob ) PRIVILEGED_FUNCTION;
+
+/*
+ * Shared by xTaskSubmitJob() and xTaskSubmitJobFromISR(), which call it with
+ * interrupts masked.  *pxYieldRequired is set to pdTRUE if the worker that was
+ * given the job should preempt the running task.
+ */
+    static BaseType_t prvSubmitJob( AperiodicJob_t * pxJob,
+                                    BaseType_t * pxYieldRequired ) PRIVILEGED_FUNCTION;
+
+/*
+ * The binary heap of xJobQueue.
+ */
+    static BaseType_t prvJobQueueLess( const AperiodicJob_t * pxA,
+                                       const AperiodicJob_t * pxB ) PRIVILEGED_FUNCTION;
+    static void prvJobQueuePush( AperiodicJob_t * pxJob ) PRIVILEGED_FUNCTION;
+    static AperiodicJob_t * prvJobQueuePop( void ) PRIVILEGED_FUNCTION;
+
 #endif
 
 /*
@@ -571,12 +1399,60 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Return the number of ticks until the next tick that has work to do: a
+ * Blocked task to wake, a periodic job to release, a replenishment that makes
+ * the aperiodic server ready or a rebase of the EDF keys.  The ticks before it
+ * change nothing, so they can be skipped with vTaskStepTick().
+ */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    static TickType_t prvGetTicksToNextEvent( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Set xNextTaskUnblockTime to the time at which the next Blocked state task
  * will exit the Blocked state.
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * Select the task xCoreID runs next, the most urgent ready task that is not
+ * running on another core and may run on xCoreID, see taskMAY_RUN_ON_CORE().
+ */
+    static void prvSelectHighestPriorityTaskForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * The first task of pxList, after the last one selected from it, that can run
+ * on xCoreID.  NULL if there is none.
+ */
+    static TCB_t * prvSelectFromReadyList( List_t * const pxList,
+                                           BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * True if pxTCB is more urgent than pxOther, in the order the scheduler
+ * selects tasks in.
+ */
+    static BaseType_t prvTaskPrecedes( const TCB_t * const pxTCB,
+                                       const TCB_t * const pxOther ) PRIVILEGED_FUNCTION;
+
+/*
+ * Make xCoreID select its task again, at once if it is the calling core's
+ * turn to leave the kernel, through portYIELD_CORE() otherwise.
+ */
+    static void prvYieldCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when pxTCB has been added to a ready list: yield the core running
+ * the least urgent task, if pxTCB is more urgent and may run there.
+ */
+    static void prvYieldForTask( const TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -607,17 +1483,330 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_POLLING_SERVER == 1 )
+
 /*
  * Called after a new task has been created and initialised to place the task
  * under the control of the scheduler.
  */
-static void prvAddNewTaskByDeadlineToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
+    static void prvAddNewTaskByDeadlineToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
 /*
  * Called after a new task has been created and initialised to place the task
  * under the control of the scheduler.
  */
-static void prvAddNewTaskToPeriodicReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
+    static void prvAddNewTaskToPeriodicReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_POLLING_SERVER */
+
+#if ( INCLUDE_vTaskEndJob == 1 )
+
+/*
+ * Set xNextPeriodicReleaseTime to the release time of the task at the head of
+ * pxPendingPeriodicList.
+ */
+    static void prvResetNextPeriodicReleaseTime( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from xTaskIncrementTick() to release the periodic tasks whose next
+ * job is due.  Returns pdTRUE if a context switch is required.
+ */
+    static BaseType_t prvReleasePeriodicJobs( TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Start a new job of pxTCB at xReleaseTime, and set the absolute deadline of the
+ * job from the relative deadline of the task.
+ */
+    static void prvReleaseJob( TCB_t * pxTCB,
+                               TickType_t xReleaseTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Report a deadline miss if the current job of pxTCB is still running, or has
+ * just completed, after its absolute deadline.  Each job is reported once.
+ */
+    static void prvCheckDeadlineMiss( TCB_t * pxTCB,
+                                      TickType_t xTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Record the completion of the current job of pxTCB, the running task, and
+ * take it out of the ready list.  Called from a critical section by
+ * vTaskEndJob() and vTaskWaitForRelease().
+ */
+    static void prvCompleteJob( TCB_t * pxTCB,
+                                TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_SCHEDULER_STATS == 1 )
+
+/*
+ * Add the response time and lateness of the job of pxTCB that is completing
+ * now to the statistics of the task.  Called from a critical section.
+ */
+    static void prvRecordJobStats( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fills a TaskSchedulerStats_t structure for each periodic task referenced
+ * from pxList, up to uxArraySize structures.
+ */
+    static UBaseType_t prvListSchedulerStatsWithinSingleList( TaskSchedulerStats_t * pxStatsArray,
+                                                              UBaseType_t uxArraySize,
+                                                              List_t * pxList ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TRACE_BUFFER == 1 )
+
+/*
+ * Append an event to xTraceBuffer.  Called with interrupts masked.
+ */
+    static void prvTraceBufferRecord( uint32_t ulEvent,
+                                      const TCB_t * pxTCB,
+                                      uint32_t ulArgument ) PRIVILEGED_FUNCTION;
+
+/*
+ * Store the name of a new task in xTraceBuffer and record its creation.
+ */
+    static void prvTraceBufferCreate( const TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_EDF_SCHEDULER == 1 )
+
+/*
+ * Move xEDFTimeBase forward by taskEDF_REBASE_INTERVAL and adjust the keys of
+ * the ready tasks to match.
+ */
+    static void prvEDFRebase( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_READY_HEAP == 1 )
+
+/*
+ * Add pxItem, which has just been appended to pxHeap->pxList, to the heap.
+ */
+    static void prvReadyHeapInsert( ReadyHeap_t * pxHeap,
+                                    ListItem_t * pxItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the item with the smallest value in pxHeap->pxList, or the end marker
+ * of the list if it is empty.  Stale entries found at the top are dropped.
+ */
+    static ListItem_t * prvReadyHeapPeek( ReadyHeap_t * pxHeap ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the entry of pxItem from pxHeap, if it has one.
+ */
+    static void prvReadyHeapRemove( ReadyHeap_t * pxHeap,
+                                    const ListItem_t * pxItem ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_ADMISSION_CONTROL == 1 )
+
+/*
+ * Admission test for a new periodic task (xPeriodic set to pdTRUE, xInterval
+ * its period) or aperiodic task (xInterval its relative deadline) that runs
+ * for at most xDuration ticks.  If the task is accepted its share is added to
+ * the running totals and stored in pulLoad, and pdPASS is returned.  Otherwise
+ * errSCHEDULE_NOT_ADMITTED is returned.
+ */
+    static BaseType_t prvAdmitTask( BaseType_t xPeriodic,
+                                    TickType_t xDuration,
+                                    TickType_t xInterval,
+                                    uint32_t * pulLoad ) PRIVILEGED_FUNCTION;
+
+/*
+ * Give back a share returned by prvAdmitTask().  Must be called from a
+ * critical section or from the tick interrupt.
+ */
+    static void prvAdmissionRelease( BaseType_t xPeriodic,
+                                     uint32_t ulLoad ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return pdTRUE if the periodic task set still passes the schedulability test
+ * once a task with utilisation ulUtilisation is added to it.
+ */
+    static BaseType_t prvUtilisationFits( uint32_t ulUtilisation ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add a utilisation to, or remove it from, the running totals.
+ */
+    static void prvAddUtilisation( uint32_t ulUtilisation ) PRIVILEGED_FUNCTION;
+    static void prvRemoveUtilisation( uint32_t ulUtilisation ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+
+/*
+ * Assign the periodic task pxTCB to a core with configPARTITION_HEURISTIC, and
+ * add its share to the totals of the core.  With configUSE_TASK_SPLITTING a
+ * task that fits on no core is split over two.  A task that still does not
+ * fit is placed on the core with the most utilisation left, which it
+ * overloads.  pxTCB must not be in a ready list.
+ */
+    static void prvPartitionTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Give back the shares prvPartitionTask() added for pxTCB.  Must be called
+ * from a critical section.
+ */
+    static void prvPartitionRelease( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when the scheduler starts to pack the ready periodic tasks again, in
+ * order of decreasing utilisation, now that the whole set is known.
+ */
+    static void prvPartitionTaskSet( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The largest utilisation that xCoreID can still take and pass its test.
+ */
+    static uint32_t prvPartitionSpare( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * The core with the most utilisation left, other than xExcludedCore.
+ */
+    static BaseType_t prvPartitionMostSpareCore( BaseType_t xExcludedCore ) PRIVILEGED_FUNCTION;
+
+/*
+ * The core configPARTITION_HEURISTIC picks for a share of ulUtilisation, other
+ * than xExcludedCore.  taskTASK_NOT_RUNNING if the share fits on none.
+ */
+    static BaseType_t prvPartitionSelectCore( uint32_t ulUtilisation,
+                                              BaseType_t xExcludedCore ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add a share to, or remove it from, the totals of xCoreID.
+ */
+    static void prvPartitionAdd( BaseType_t xCoreID,
+                                 uint32_t ulUtilisation ) PRIVILEGED_FUNCTION;
+    static void prvPartitionRemove( BaseType_t xCoreID,
+                                    uint32_t ulUtilisation ) PRIVILEGED_FUNCTION;
+
+/*
+ * Place pxTCB in the periodic ready list of xCoreID from now on.  pxTCB must
+ * not be in a ready list.
+ */
+    static void prvSetPartitionCore( TCB_t * pxTCB,
+                                     BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TASK_SPLITTING == 1 )
+
+/*
+ * Called from xTaskIncrementTick() to charge the tick to the split jobs that
+ * run their first share, and to move those that have spent it to the core of
+ * their second share.
+ */
+        static void prvChargeSplitJobs( void ) PRIVILEGED_FUNCTION;
+
+    #endif
+
+#endif /* configUSE_PARTITIONED_SCHEDULING */
+
+#if ( configUSE_STACK_RESOURCE_POLICY == 1 )
+
+/*
+ * Return the preemption level of a task as a relative deadline.  Tasks that
+ * are neither periodic nor aperiodic get the lowest level.
+ */
+    static TickType_t prvPreemptionLevel( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from vTaskSwitchContext() once pxCurrentTCB has been selected.  If
+ * its preemption level is not above the system ceiling, pxCurrentTCB is
+ * replaced by the task holding the resource on top of the stack.  xViaServer
+ * tells whether the selected task was picked through the aperiodic server; the
+ * same is returned for the task finally selected.
+ */
+    static BaseType_t prvResourceCeilingSelect( BaseType_t xViaServer ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called from the tick interrupt when the running aperiodic task has used up
+ * its execution-time budget.  Applies configAPERIODIC_OVERRUN_POLICY to the
+ * task.  Returns pdTRUE if a context switch is required.
+ */
+#if ( configUSE_APERIODIC_BUDGET == 1 )
+
+    static BaseType_t prvAperiodicBudgetExhausted( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Returns pdTRUE if pxTCB is in a ready list or the job list of the server.
+ * The tick can run after the running task has been moved to a delayed or event
+ * list but before it has yielded, in which case this returns pdFALSE.
+ */
+#if ( ( configUSE_APERIODIC_BUDGET == 1 ) && ( configAPERIODIC_OVERRUN_POLICY != tskAPERIODIC_OVERRUN_ABORT ) )
+
+    static BaseType_t prvAperiodicIsReady( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Block the running aperiodic task for configAPERIODIC_THROTTLE_TICKS and give
+ * it a full budget to resume with.  Called from the tick interrupt.
+ */
+#if ( ( configUSE_APERIODIC_BUDGET == 1 ) && ( configAPERIODIC_OVERRUN_POLICY == tskAPERIODIC_OVERRUN_THROTTLE ) )
+
+    static void prvAperiodicThrottle( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_APERIODIC_SERVER == 1 )
+
+/*
+ * Insert the server into, or remove it from, xReadyPeriodicTasksLists depending
+ * on whether it has both capacity and work.
+ */
+    static void prvServerUpdateReadyState( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from vTaskSwitchContext() with the outcome of the task selection, to
+ * open and close the busy intervals the sporadic policy is based on.
+ */
+    static void prvServerSetRunning( BaseType_t xRunning ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called from xTaskIncrementTick() to charge the elapsed tick to the server and
+ * apply any replenishment that is due.  Returns pdTRUE if a context switch is
+ * required.
+ */
+    static BaseType_t prvServerTick( TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sporadic policy: return the capacity consumed in the busy interval that has
+ * just ended one server period after the interval started.
+ */
+    static void prvServerScheduleReplenishment( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sporadic policy: add the oldest pending replenishment to the budget.
+ */
+    static void prvServerApplyReplenishment( void ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+
+/*
+ * Return the number of ticks until the next replenishment that can make the
+ * server ready, or portMAX_DELAY if the server has no job to run.
+ */
+        static TickType_t prvServerTicksToNextEvent( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Apply the replenishments that fall in the ticks skipped by vTaskStepTick().
+ * These can only be replenishments of a server without jobs, which do not
+ * have to happen at their own tick.
+ */
+        static void prvServerStepTick( TickType_t xTicksToJump ) PRIVILEGED_FUNCTION;
+
+    #endif
+
+#endif
 
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
@@ -1002,6 +2191,38 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
     }
     #endif /* configUSE_MUTEXES */
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+        pxNewTCB->xLastRunCore = taskTASK_NOT_RUNNING;
+
+        #if ( configUSE_CORE_AFFINITY == 1 )
+        {
+            pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+        }
+        #endif
+
+        #if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+        {
+            /* Set for the tasks placed in a periodic ready list when they are
+             * added to it the first time. */
+            pxNewTCB->xPartitionCore = 0;
+            pxNewTCB->ulPartitionLoad = 0U;
+
+            #if ( configUSE_TASK_SPLITTING == 1 )
+            {
+                pxNewTCB->xHomeCore = 0;
+                pxNewTCB->xSplitCore = taskTASK_NOT_RUNNING;
+                pxNewTCB->xSplitBudget = ( TickType_t ) 0U;
+                pxNewTCB->xJobTicks = ( TickType_t ) 0U;
+                pxNewTCB->ulSplitLoad = 0U;
+            }
+            #endif
+        }
+        #endif
+    }
+    #endif /* configNUMBER_OF_CORES */
+
     vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
     vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
@@ -1214,7 +2435,11 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * so far. */
                 if( xSchedulerRunning == pdFALSE )
                 {
-                    if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        if( taskEDF_PREEMPTS( pxNewTCB ) )
+                    #else
+                        if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                    #endif
                     {
                         pxCurrentTCB = pxNewTCB;
                     }
@@ -1239,24 +2464,88 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             #endif /* configUSE_TRACE_FACILITY */
             traceTASK_CREATE( pxNewTCB );
 
-            prvAddTaskByDeadlineToReadyList( pxNewTCB );
-
-            portSETUP_TCB( pxNewTCB );
-        }
-        taskEXIT_CRITICAL();
+            #if ( ( configUSE_PARTITIONED_SCHEDULING == 1 ) && ( configUSE_EDF_SCHEDULER == 1 ) )
+            {
+                /* The aperiodic tasks queued with the periodic ones are not
+                 * packed, nothing being known of their rate.  Each goes to
+                 * the core with the most utilisation left. */
+                pxNewTCB->xPartitionCore = prvPartitionMostSpareCore( taskTASK_NOT_RUNNING );
+
+                #if ( configUSE_TASK_SPLITTING == 1 )
+                {
+                    pxNewTCB->xHomeCore = pxNewTCB->xPartitionCore;
+                }
+                #endif
+            }
+            #endif
+
+            prvAddTaskByDeadlineToReadyList( pxNewTCB );
+
+            portSETUP_TCB( pxNewTCB );
+        }
+        taskEXIT_CRITICAL();
 
         if( xSchedulerRunning != pdFALSE )
         {
-            /* If the created task is of a higher priority than the current task
-             * then it should run now. */
-            if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+            #if ( configUSE_APERIODIC_SERVER == 1 )
             {
-                taskYIELD_IF_USING_PREEMPTION();
+                /* When the task was queued on the server, the server decides
+                 * whether it should run now. */
+                if( xAperiodicServer.xPeriod != ( TickType_t ) 0U )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        if( taskSERVER_PREEMPTS() )
+                        {
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                else if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            else
+            #elif ( configUSE_EDF_SCHEDULER == 1 )
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* The created job should run now if its deadline is earlier
+                 * than that of the current task. */
+                taskENTER_CRITICAL();
+                {
+                    if( taskEDF_PREEMPTS( pxNewTCB ) )
+                    {
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            #else
+            {
+                /* If the created task is of a higher priority than the current task
+                 * then it should run now. */
+                if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
+            #endif /* configUSE_APERIODIC_SERVER */
         }
         else
         {
@@ -1298,7 +2587,11 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * so far. */
                 if( xSchedulerRunning == pdFALSE )
                 {
-                    if( pxCurrentTCB->uxPeriod == 0 || pxCurrentTCB->uxPeriod >= pxNewTCB->uxPeriod )
+                    #if ( configUSE_EDF_SCHEDULER == 1 )
+                        if( taskEDF_PREEMPTS( pxNewTCB ) )
+                    #else
+                        if( pxCurrentTCB->uxPeriod == 0 || pxCurrentTCB->uxPeriod >= pxNewTCB->uxPeriod )
+                    #endif
                     {
                         pxCurrentTCB = pxNewTCB;
                     }
@@ -1323,6 +2616,14 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             #endif /* configUSE_TRACE_FACILITY */
             traceTASK_CREATE( pxNewTCB );
 
+            #if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+            {
+                /* Placed on its own as it comes.  The tasks created before the
+                 * scheduler starts are packed again when it starts. */
+                prvPartitionTask( pxNewTCB );
+            }
+            #endif
+
             prvAddTaskToPeriodicReadyList( pxNewTCB );
 
             portSETUP_TCB( pxNewTCB );
@@ -1333,14 +2634,18 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         {
             /* If the created task is of a higher priority than the current task
              * then it should run now. */
-            if( pxCurrentTCB->uxPeriod > pxNewTCB->uxPeriod )
-            {
-                taskYIELD_IF_USING_PREEMPTION();
-            }
-            else
+            taskENTER_CRITICAL();
             {
-                mtCOVERAGE_TEST_MARKER();
+                if( taskPERIODIC_PREEMPTS( pxNewTCB ) )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
+            taskEXIT_CRITICAL();
         }
         else
         {
@@ -1356,6 +2661,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
     void vTaskDelete( TaskHandle_t xTaskToDelete )
     {
         TCB_t * pxTCB;
+        BaseType_t xTaskIsRunning;
 
         taskENTER_CRITICAL();
         {
@@ -1373,6 +2679,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
 
+            taskREADY_HEAP_FORGET( pxTCB );
+            taskADMISSION_RELEASE( pxTCB );
+            taskPARTITION_RELEASE( pxTCB );
+
             /* Is the task waiting on an event also? */
             if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
             {
@@ -1389,19 +2699,16 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
              * not return. */
             uxTaskNumber++;
 
-            if( pxTCB == pxCurrentTCB )
+            xTaskIsRunning = taskTASK_IS_RUNNING( pxTCB ) ? pdTRUE : pdFALSE;
+
+            if( xTaskIsRunning != pdFALSE )
             {
                 /* A task is deleting itself.  This cannot complete within the
                  * task itself, as a context switch to another task is required.
                  * Place the task in the termination list.  The idle task will
                  * check the termination list and free up any memory allocated by
                  * the scheduler for the TCB and stack of the deleted task. */
-                vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
-
-                /* Increment the ucTasksDeleted variable so the idle task knows
-                 * there is a task that has been deleted and that it should therefore
-                 * check the xTasksWaitingTermination list. */
-                ++uxDeletedTasksWaitingCleanUp;
+                prvAddTaskToTerminationList( pxTCB );
 
                 /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
                  * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
@@ -1413,6 +2720,15 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                  * hence xYieldPending is used to latch that a context switch is
                  * required. */
                 portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+
+                #if ( configNUMBER_OF_CORES > 1 )
+                {
+                    /* The task may be running on another core, which has to
+                     * leave it before the idle task can free it.  The calling
+                     * core leaves it in taskEXIT_CRITICAL(). */
+                    prvYieldCore( pxTCB->xTaskRunState );
+                }
+                #endif
             }
             else
             {
@@ -1429,25 +2745,29 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         /* If the task is not deleting itself, call prvDeleteTCB from outside of
          * critical section. If a task deletes itself, prvDeleteTCB is called
          * from prvCheckTasksWaitingTermination which is called from Idle task. */
-        if( pxTCB != pxCurrentTCB )
+        if( xTaskIsRunning == pdFALSE )
         {
             prvDeleteTCB( pxTCB );
         }
 
         /* Force a reschedule if it is the currently running task that has just
          * been deleted. */
-        if( xSchedulerRunning != pdFALSE )
+        #if ( configNUMBER_OF_CORES == 1 )
         {
-            if( pxTCB == pxCurrentTCB )
-            {
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
-            }
-            else
+            if( xSchedulerRunning != pdFALSE )
             {
-                mtCOVERAGE_TEST_MARKER();
+                if( xTaskIsRunning != pdFALSE )
+                {
+                    configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
+        #endif /* configNUMBER_OF_CORES */
     }
 
 #endif /* INCLUDE_vTaskDelete */
@@ -1463,7 +2783,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
         configASSERT( pxPreviousWakeTime );
         configASSERT( ( xTimeIncrement > 0U ) );
-        configASSERT( uxSchedulerSuspended == 0 );
+        configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
 
         vTaskSuspendAll();
         {
@@ -1549,7 +2869,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
         /* A delay time of zero just forces a reschedule. */
         if( xTicksToDelay > ( TickType_t ) 0U )
         {
-            configASSERT( uxSchedulerSuspended == 0 );
+            configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
             vTaskSuspendAll();
             {
                 traceTASK_DELAY();
@@ -1597,9 +2917,10 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
 
         configASSERT( pxTCB );
 
-        if( pxTCB == pxCurrentTCB )
+        if( taskTASK_IS_RUNNING( pxTCB ) )
         {
-            /* The task calling this function is querying its own state. */
+            /* The task calling this function is querying its own state, or
+             * that of a task running on another core. */
             eReturn = eRunning;
         }
         else
@@ -1619,6 +2940,30 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 eReturn = eBlocked;
             }
 
+            #if ( INCLUDE_vTaskEndJob == 1 )
+                else if( ( pxStateList == &xPendingPeriodicReadyList ) || ( pxStateList == &xPendingPeriodicReadyList2 ) )
+                {
+                    /* The periodic task is waiting for the release of its next
+                     * job. */
+                    eReturn = eBlocked;
+                }
+            #endif
+
+            #if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+                else if( pxStateList == &xWaitingReleaseList )
+                {
+                    eReturn = eBlocked;
+                }
+            #endif
+
+            #if ( configUSE_APERIODIC_JOBS == 1 )
+                else if( pxStateList == &( xJobQueue.xIdleWorkers ) )
+                {
+                    /* A worker waiting for a job. */
+                    eReturn = eBlocked;
+                }
+            #endif
+
             #if ( INCLUDE_vTaskSuspend == 1 )
                 else if( pxStateList == &xSuspendedTaskList )
                 {
@@ -1670,6 +3015,13 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 }
             #endif
 
+            #if ( configUSE_TASK_POOL == 1 )
+                else if( ( pxTCB->pxTaskPool != NULL ) && ( pxStateList == &( pxTCB->pxTaskPool->xSlotsWaitingRelease ) ) )
+                {
+                    eReturn = eDeleted;
+                }
+            #endif
+
             else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
             {
                 /* If the task is not in any other state, it must be in the
@@ -1964,6 +3316,21 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 }
             }
             #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* A task running on another core is suspended when that core
+                 * leaves it.  The calling task yields below. */
+                if( taskTASK_IS_RUNNING( pxTCB ) && ( pxTCB->xTaskRunState != portGET_CORE_ID() ) )
+                {
+                    prvYieldCore( pxTCB->xTaskRunState );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
         }
         taskEXIT_CRITICAL();
 
@@ -1987,7 +3354,7 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             if( xSchedulerRunning != pdFALSE )
             {
                 /* The current task has just been suspended. */
-                configASSERT( uxSchedulerSuspended == 0 );
+                configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
                 portYIELD_WITHIN_API();
             }
             else
@@ -2238,6 +3605,39 @@ void vTaskStartScheduler( void )
     }
     #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        BaseType_t xCoreID;
+        char cIdleName[ configMAX_TASK_NAME_LEN ];
+        size_t x;
+
+        /* The idle tasks of the other cores, named after the core they are
+         * created for, although any core may run any of them. */
+        for( xCoreID = 1; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+        {
+            for( x = 0; ( configIDLE_TASK_NAME[ x ] != '\0' ) && ( x < ( size_t ) ( configMAX_TASK_NAME_LEN - 3 ) ); x++ )
+            {
+                cIdleName[ x ] = configIDLE_TASK_NAME[ x ];
+            }
+
+            if( xCoreID >= 10 )
+            {
+                cIdleName[ x++ ] = ( char ) ( '0' + ( xCoreID / 10 ) );
+            }
+
+            cIdleName[ x++ ] = ( char ) ( '0' + ( xCoreID % 10 ) );
+            cIdleName[ x ] = '\0';
+
+            xReturn = xTaskCreate( prvIdleTask,
+                                   cIdleName,
+                                   configMINIMAL_STACK_SIZE,
+                                   ( void * ) NULL,
+                                   portPRIVILEGE_BIT,
+                                   &( xIdleTaskHandles[ xCoreID ] ) );
+        }
+    }
+    #endif /* configNUMBER_OF_CORES */
+
     #if ( configUSE_TIMERS == 1 )
     {
         if( xReturn == pdPASS )
@@ -2269,6 +3669,30 @@ void vTaskStartScheduler( void )
          * starts to run. */
         portDISABLE_INTERRUPTS();
 
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            BaseType_t xCoreID;
+
+            #if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+            {
+                prvPartitionTaskSet();
+            }
+            #endif
+
+            /* The task creation left the last task that preempted in
+             * pxCurrentTCB, of core 0.  Start each core with its own task. */
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                pxCurrentTCBs[ xCoreID ] = NULL;
+            }
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                prvSelectHighestPriorityTaskForCore( xCoreID );
+            }
+        }
+        #endif /* configNUMBER_OF_CORES */
+
         #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
         {
             /* Switch C-Runtime's TLS Block to point to the TLS
@@ -2289,6 +3713,16 @@ void vTaskStartScheduler( void )
          * FreeRTOSConfig.h file. */
         portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
 
+        /* Likewise for configUSE_SCHEDULER_STATS.  The response times of the
+         * first jobs are measured from the tick count set above. */
+        portCONFIGURE_TIMER_FOR_SCHEDULER_STATS();
+
+        #if ( configUSE_SCHEDULER_STATS == 1 )
+        {
+            ulTickStatsTime = portGET_SCHEDULER_STATS_TIME();
+        }
+        #endif
+
         traceTASK_SWITCHED_IN();
 
         /* Setting up the timer tick is hardware specific and thus in the
@@ -2344,7 +3778,22 @@ void vTaskSuspendAll( void )
 
     /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
      * is used to allow calls to vTaskSuspendAll() to nest. */
-    ++uxSchedulerSuspended;
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* The other cores could change the lists the caller reads, so the
+         * kernel lock is held until the scheduler is resumed.  The critical
+         * section keeps the caller on its core while it takes it. */
+        portENTER_CRITICAL();
+        portGET_KERNEL_LOCK();
+        ++uxSchedulerSuspended;
+        pxSchedulerSuspender = pxCurrentTCB;
+        portEXIT_CRITICAL();
+    }
+    #else
+    {
+        ++uxSchedulerSuspended;
+    }
+    #endif
 
     /* Enforces ordering for ports and optimised compilers that may otherwise place
      * the above increment elsewhere. */
@@ -2406,8 +3855,82 @@ void vTaskSuspendAll( void )
         }
         else
         {
-            xReturn = xNextTaskUnblockTime - xTickCount;
+            xReturn = prvGetTicksToNextEvent();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvGetTicksToNextEvent( void )
+    {
+        TickType_t xReturn = xNextTaskUnblockTime - xTickCount;
+
+        #if ( INCLUDE_vTaskEndJob == 1 )
+        {
+            /* Like xNextTaskUnblockTime, xNextPeriodicReleaseTime is
+             * portMAX_DELAY when no release is pending before the tick count
+             * overflows.  A release time that is not after the tick count is
+             * one a pended tick has still to process. */
+            if( xNextPeriodicReleaseTime <= xTickCount )
+            {
+                xReturn = 0;
+            }
+            else if( ( TickType_t ) ( xNextPeriodicReleaseTime - xTickCount ) < xReturn )
+            {
+                xReturn = xNextPeriodicReleaseTime - xTickCount;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* INCLUDE_vTaskEndJob */
+
+        #if ( configUSE_APERIODIC_SERVER == 1 )
+        {
+            const TickType_t xServerTicks = prvServerTicksToNextEvent();
+
+            if( xServerTicks < xReturn )
+            {
+                xReturn = xServerTicks;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_APERIODIC_SERVER */
+
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            const TickType_t xRebaseTicks = taskEDF_REBASE_INTERVAL - ( TickType_t ) ( xTickCount - xEDFTimeBase );
+
+            if( xRebaseTicks < xReturn )
+            {
+                xReturn = xRebaseTicks;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_EDF_SCHEDULER */
+
+        #if ( configUSE_ISR_TIMERS == 1 )
+        {
+            const TickType_t xISRTimerTicks = xTimerGetTicksToNextISRTimer( xTickCount );
+
+            if( xISRTimerTicks < xReturn )
+            {
+                xReturn = xISRTimerTicks;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
+        #endif /* configUSE_ISR_TIMERS */
 
         return xReturn;
     }
@@ -2433,6 +3956,18 @@ BaseType_t xTaskResumeAll( void )
     {
         --uxSchedulerSuspended;
 
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+            {
+                pxSchedulerSuspender = NULL;
+            }
+
+            /* Taken by vTaskSuspendAll(). */
+            portRELEASE_KERNEL_LOCK();
+        }
+        #endif
+
         if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
         {
             if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
@@ -2445,24 +3980,7 @@ BaseType_t xTaskResumeAll( void )
                     listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
                     portMEMORY_BARRIER();
                     listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    #if ( configUSE_POLLING_SERVER == 1 )
-                    {
-                        if( pxTCB->uxDeadline == portMAX_DELAY && pxTCB->uxPeriod != portMAX_DELAY )
-                        {
-                            prvAddTaskToPeriodicReadyList( pxTCB );
-                        }
-                        else if( pxTCB->uxPeriod == portMAX_DELAY && pxTCB->uxDeadline != portMAX_DELAY )
-                        {
-                            prvAddTaskByDeadlineToReadyList( pxTCB );
-                        }
-                        else
-                        {
-                            prvAddTaskToReadyList( pxTCB );
-                        }
-                    }
-                    #else // ( configUSE_POLLING_SERVER == 1 )
-                        prvAddTaskToReadyList( pxTCB );
-                    #endif // ( configUSE_POLLING_SERVER == 1 )
+                    prvAddTaskToReadyList( pxTCB );
 
                     /* If the moved task has a priority higher than or equal to
                      * the current task then a yield must be performed. */
@@ -2833,1713 +4351,5260 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
 /*----------------------------------------------------------*/
 
-/* This conditional compilation should use inequality to 0, not equality to 1.
- * This is to ensure vTaskStepTick() is available when user defined low power mode
- * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
- * 1. */
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    void vTaskStepTick( TickType_t xTicksToJump )
+    TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID )
     {
-        /* Correct the tick count value after a period during which the tick
-         * was suppressed.  Note this does *not* call the tick hook function for
-         * each stepped tick. */
-        configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+        configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+        configASSERT( ( xIdleTaskHandles[ xCoreID ] != NULL ) );
+        return xIdleTaskHandles[ xCoreID ];
+    }
+/*----------------------------------------------------------*/
+
+    UBaseType_t uxTaskGetMigrationCount( TaskHandle_t xTask )
+    {
+        const TCB_t * const pxTCB = prvGetTCBFromHandle( xTask );
+
+        return pxTCB->uxMigrations;
+    }
+/*----------------------------------------------------------*/
 
-        if( ( xTickCount + xTicksToJump ) == xNextTaskUnblockTime )
+    #if ( configUSE_CORE_AFFINITY == 1 )
+
+        void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                                   UBaseType_t uxCoreAffinityMask )
         {
-            /* Arrange for xTickCount to reach xNextTaskUnblockTime in
-             * xTaskIncrementTick() when the scheduler resumes.  This ensures
-             * that any delayed tasks are resumed at the correct time. */
-            configASSERT( uxSchedulerSuspended );
-            configASSERT( xTicksToJump != ( TickType_t ) 0 );
+            TCB_t * pxTCB;
 
-            /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
             taskENTER_CRITICAL();
             {
-                xPendedTicks++;
-            }
-            taskEXIT_CRITICAL();
-            xTicksToJump--;
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+                pxTCB = prvGetTCBFromHandle( xTask );
+                pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
 
-        xTickCount += xTicksToJump;
-        traceINCREASE_TICK_COUNT( xTicksToJump );
-    }
+                if( xSchedulerRunning != pdFALSE )
+                {
+                    if( taskTASK_IS_RUNNING( pxTCB ) )
+                    {
+                        if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) pxTCB->xTaskRunState ) ) == 0U )
+                        {
+                            /* Moved off the core it runs on. */
+                            prvYieldCore( pxTCB->xTaskRunState );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        const List_t * const pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+                        BaseType_t xIsReady = ( pxStateList == &( pxReadyTasksLists[ pxTCB->uxPriority ] ) ) ? pdTRUE : pdFALSE;
 
-#endif /* configUSE_TICKLESS_IDLE */
+                        #if ( configUSE_POLLING_SERVER == 1 )
+                        {
+                            if( pxStateList == taskPERIODIC_READY_LIST( taskPARTITION_OF( pxTCB ) ) )
+                            {
+                                xIsReady = pdTRUE;
+                            }
+                        }
+                        #endif
+
+                        /* A ready task may now preempt one of the cores it
+                         * has been allowed on. */
+                        if( xIsReady != pdFALSE )
+                        {
+                            prvYieldForTask( pxTCB );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
 /*----------------------------------------------------------*/
 
-BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
-{
-    BaseType_t xYieldOccurred;
+        UBaseType_t uxTaskCoreAffinityGet( TaskHandle_t xTask )
+        {
+            const TCB_t * pxTCB;
+            UBaseType_t uxCoreAffinityMask;
 
-    /* Must not be called with the scheduler suspended as the implementation
-     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-    configASSERT( uxSchedulerSuspended == 0 );
+            taskENTER_CRITICAL();
+            {
+                pxTCB = prvGetTCBFromHandle( xTask );
+                uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+            }
+            taskEXIT_CRITICAL();
 
-    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
-     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
-    vTaskSuspendAll();
+            return uxCoreAffinityMask;
+        }
 
-    /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
-    taskENTER_CRITICAL();
-    {
-        xPendedTicks += xTicksToCatchUp;
-    }
-    taskEXIT_CRITICAL();
-    xYieldOccurred = xTaskResumeAll();
+    #endif /* configUSE_CORE_AFFINITY */
 
-    return xYieldOccurred;
-}
+#endif /* configNUMBER_OF_CORES */
 /*----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskAbortDelay == 1 )
+#if ( configUSE_PARTITIONED_SCHEDULING == 1 )
 
-    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+    static uint32_t prvPartitionSpare( BaseType_t xCoreID )
     {
-        TCB_t * pxTCB = xTask;
-        BaseType_t xReturn;
+        const CorePartition_t * const pxPartition = &( xCorePartitions[ xCoreID ] );
+        uint32_t ulSpare = 0U;
 
-        configASSERT( pxTCB );
-
-        vTaskSuspendAll();
+        #if ( configUSE_EDF_SCHEDULER == 1 )
         {
-            /* A task can only be prematurely removed from the Blocked state if
-             * it is actually in the Blocked state. */
-            if( eTaskGetState( xTask ) == eBlocked )
+            if( pxPartition->ulUtilisation < taskUTILISATION_ONE )
             {
-                xReturn = pdPASS;
+                ulSpare = taskUTILISATION_ONE - pxPartition->ulUtilisation;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else
+        {
+            /* The largest U with ( U + 1 ) * ulHyperbolicProduct <= 2, the
+             * test of prvUtilisationFits(). */
+            const uint64_t ullLimit = ( ( uint64_t ) 2U * taskUTILISATION_ONE * taskUTILISATION_ONE ) / ( uint64_t ) pxPartition->ulHyperbolicProduct;
 
-                /* Remove the reference to the task from the blocked list.  An
-                 * interrupt won't touch the xStateListItem because the
-                 * scheduler is suspended. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+            if( ullLimit > ( uint64_t ) taskUTILISATION_ONE )
+            {
+                ulSpare = ( uint32_t ) ( ullLimit - ( uint64_t ) taskUTILISATION_ONE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_EDF_SCHEDULER */
 
-                /* Is the task waiting on an event also?  If so remove it from
-                 * the event list too.  Interrupts can touch the event list item,
-                 * even though the scheduler is suspended, so a critical section
-                 * is used. */
-                taskENTER_CRITICAL();
-                {
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+        return ulSpare;
+    }
+/*-----------------------------------------------------------*/
 
-                        /* This lets the task know it was forcibly removed from the
-                         * blocked state so it should not re-evaluate its block time and
-                         * then block again. */
-                        pxTCB->ucDelayAborted = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                taskEXIT_CRITICAL();
+    static BaseType_t prvPartitionMostSpareCore( BaseType_t xExcludedCore )
+    {
+        BaseType_t xCoreID;
+        BaseType_t xReturn = taskTASK_NOT_RUNNING;
+        uint32_t ulMostSpare = 0U;
 
-                /* Place the unblocked task into the appropriate ready list. */
-                prvAddTaskToReadyList( pxTCB );
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            if( xCoreID != xExcludedCore )
+            {
+                const uint32_t ulSpare = prvPartitionSpare( xCoreID );
 
-                /* A task being unblocked cannot cause an immediate context
-                 * switch if preemption is turned off. */
-                #if ( configUSE_PREEMPTION == 1 )
+                /* The lowest numbered core wins a tie, so that the overloaded
+                 * cores are picked in order too. */
+                if( ( xReturn == taskTASK_NOT_RUNNING ) || ( ulSpare > ulMostSpare ) )
                 {
-                    /* Preemption is on, but a context switch should only be
-                     * performed if the unblocked task has a priority that is
-                     * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                    {
-                        /* Pend the yield to be performed when the scheduler
-                         * is unsuspended. */
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    xReturn = xCoreID;
+                    ulMostSpare = ulSpare;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
-                #endif /* configUSE_PREEMPTION */
             }
             else
             {
-                xReturn = pdFAIL;
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        ( void ) xTaskResumeAll();
 
         return xReturn;
     }
+/*-----------------------------------------------------------*/
 
-#endif /* INCLUDE_xTaskAbortDelay */
-/*----------------------------------------------------------*/
+    static BaseType_t prvPartitionSelectCore( uint32_t ulUtilisation,
+                                              BaseType_t xExcludedCore )
+    {
+        BaseType_t xReturn = taskTASK_NOT_RUNNING;
 
-BaseType_t xTaskIncrementTick( void )
-{
-    TCB_t * pxTCB;
-    TickType_t xItemValue;
-    BaseType_t xSwitchRequired = pdFALSE;
+        #if ( configPARTITION_HEURISTIC == tskPARTITION_WORST_FIT )
+        {
+            const BaseType_t xCoreID = prvPartitionMostSpareCore( xExcludedCore );
 
-    /* Called by the portable layer each time a tick interrupt occurs.
-     * Increments the tick then checks to see if the new tick value will cause any
-     * tasks to be unblocked. */
-    traceTASK_INCREMENT_TICK( xTickCount );
+            if( ( xCoreID != taskTASK_NOT_RUNNING ) && ( ulUtilisation <= prvPartitionSpare( xCoreID ) ) )
+            {
+                xReturn = xCoreID;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* tskPARTITION_FIRST_FIT */
+        {
+            BaseType_t xCoreID;
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+            for( xCoreID = 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == taskTASK_NOT_RUNNING ); xCoreID++ )
+            {
+                if( ( xCoreID != xExcludedCore ) && ( ulUtilisation <= prvPartitionSpare( xCoreID ) ) )
+                {
+                    xReturn = xCoreID;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        #endif /* configPARTITION_HEURISTIC */
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPartitionAdd( BaseType_t xCoreID,
+                                 uint32_t ulUtilisation )
     {
-        /* Minor optimisation.  The tick count cannot change in this
-         * block. */
-        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+        CorePartition_t * const pxPartition = &( xCorePartitions[ xCoreID ] );
 
-        /* Increment the RTOS tick, switching the delayed and overflowed
-         * delayed lists if it wraps to 0. */
-        xTickCount = xConstTickCount;
+        if( ulUtilisation != 0U )
+        {
+            pxPartition->ulUtilisation += ulUtilisation;
+            pxPartition->uxShares++;
 
-        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+            /* Rounded up like the utilisations themselves, as in
+             * prvAddUtilisation(). */
+            pxPartition->ulHyperbolicProduct = ( uint32_t ) ( ( ( uint64_t ) pxPartition->ulHyperbolicProduct * ( uint64_t ) ( taskUTILISATION_ONE + ulUtilisation ) + ( uint64_t ) ( taskUTILISATION_ONE - 1U ) ) >> 16 );
+        }
+        else
         {
-            taskSWITCH_DELAYED_LISTS();
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPartitionRemove( BaseType_t xCoreID,
+                                    uint32_t ulUtilisation )
+    {
+        CorePartition_t * const pxPartition = &( xCorePartitions[ xCoreID ] );
+
+        if( ulUtilisation != 0U )
+        {
+            pxPartition->ulUtilisation -= ulUtilisation;
+            pxPartition->uxShares--;
+
+            if( pxPartition->uxShares == ( UBaseType_t ) 0U )
+            {
+                /* Drop the rounding error the divisions have accumulated. */
+                pxPartition->ulHyperbolicProduct = taskUTILISATION_ONE;
+            }
+            else
+            {
+                pxPartition->ulHyperbolicProduct = ( uint32_t ) ( ( ( uint64_t ) pxPartition->ulHyperbolicProduct << 16 ) / ( uint64_t ) ( taskUTILISATION_ONE + ulUtilisation ) );
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+    }
+/*-----------------------------------------------------------*/
 
-        /* See if this tick has made a timeout expire.  Tasks are stored in
-         * the  queue in the order of their wake time - meaning once one task
-         * has been found whose block time has not expired there is no need to
-         * look any further down the list. */
-        if( xConstTickCount >= xNextTaskUnblockTime )
+    static void prvSetPartitionCore( TCB_t * pxTCB,
+                                     BaseType_t xCoreID )
+    {
+        #if ( configUSE_READY_HEAP == 1 )
         {
-            for( ; ; )
+            /* Only the heap of the core the task is placed in is cleaned when
+             * the task is deleted, see taskREADY_HEAP_FORGET(), so the entry
+             * left in the heap of the previous core goes now. */
+            prvReadyHeapRemove( taskPERIODIC_READY_HEAP( taskPARTITION_OF( pxTCB ) ), &( pxTCB->xStateListItem ) );
+        }
+        #endif
+
+        pxTCB->xPartitionCore = xCoreID;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPartitionTask( TCB_t * pxTCB )
+    {
+        uint32_t ulUtilisation = taskPERIODIC_UTILISATION( pxTCB );
+        BaseType_t xCoreID = prvPartitionSelectCore( ulUtilisation, taskTASK_NOT_RUNNING );
+
+        #if ( configUSE_TASK_SPLITTING == 1 )
+        {
+            pxTCB->xSplitCore = taskTASK_NOT_RUNNING;
+            pxTCB->xSplitBudget = ( TickType_t ) 0U;
+            pxTCB->ulSplitLoad = 0U;
+
+            if( xCoreID == taskTASK_NOT_RUNNING )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-                {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    break;
-                }
-                else
+                /* The first share is what the core with the most utilisation
+                 * left can still take, rounded down to whole ticks, and the
+                 * rest of each job goes wherever it fits.  Both shares have the
+                 * period of the task, so each passes the test of its core, but
+                 * the second only starts once the first is spent. */
+                const BaseType_t xFirstCore = prvPartitionMostSpareCore( taskTASK_NOT_RUNNING );
+                const TickType_t xBudget = ( TickType_t ) ( ( ( uint64_t ) prvPartitionSpare( xFirstCore ) * ( uint64_t ) pxTCB->uxPeriod ) >> 16 );
+
+                if( ( xBudget > ( TickType_t ) 0U ) && ( xBudget < pxTCB->uxDuration ) )
                 {
-                    /* The delayed list is not empty, get the value of the
-                     * item at the head of the delayed list.  This is the time
-                     * at which the task at the head of the delayed list must
-                     * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+                    const uint32_t ulRest = taskUTILISATION( pxTCB->uxDuration - xBudget, pxTCB->uxPeriod );
+                    const BaseType_t xSecondCore = prvPartitionSelectCore( ulRest, xFirstCore );
 
-                    if( xConstTickCount < xItemValue )
+                    if( xSecondCore != taskTASK_NOT_RUNNING )
                     {
-                        /* It is not time to unblock this item yet, but the
-                         * item value is the time at which the task at the head
-                         * of the blocked list must be removed from the Blocked
-                         * state -  so record the item value in
-                         * xNextTaskUnblockTime. */
-                        xNextTaskUnblockTime = xItemValue;
-                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+                        xCoreID = xFirstCore;
+                        ulUtilisation = taskUTILISATION( xBudget, pxTCB->uxPeriod );
+                        pxTCB->xSplitCore = xSecondCore;
+                        pxTCB->xSplitBudget = xBudget;
+                        pxTCB->ulSplitLoad = ulRest;
+                        prvPartitionAdd( xSecondCore, ulRest );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-
-                    /* It is time to remove the item from the Blocked state. */
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-
-                    /* Is the task waiting on an event also?  If so remove
-                     * it from the event list. */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    #if ( configUSE_POLLING_SERVER == 1 )
-                    {
-                        /* Place the unblocked task into the appropriate ready
-                         * list. */
-                        if( pxTCB->uxDeadline == portMAX_DELAY )
-                        {
-                            prvAddTaskToPeriodicReadyList( pxTCB );
-                        }
-                        else if( pxTCB->uxPeriod == portMAX_DELAY )
-                        {
-                            prvAddTaskByDeadlineToReadyList( pxTCB );
-                        }
-                        else
-                        {
-                            prvAddTaskToReadyList( pxTCB );
-                        }
-                    }
-                    #else // ( configUSE_POLLING_SERVER == 1 )
-                    {
-                        /* Place the unblocked task into the appropriate ready
-                         * list. */
-                        prvAddTaskToReadyList( pxTCB );
-                    }
-                    #endif // (configUSE_POLLING_SERVER == 1)
-
-                    /* A task being unblocked cannot cause an immediate
-                     * context switch if preemption is turned off. */
-                    #if ( configUSE_PREEMPTION == 1 )
-                    {
-                        /* Preemption is on, but a context switch should
-                         * only be performed if the unblocked task's
-                         * priority is higher than the currently executing
-                         * task.
-                         * The case of equal priority tasks sharing
-                         * processing time (which happens when both
-                         * preemption and time slicing are on) is
-                         * handled below.*/
-                        #if ( configUSE_POLLING_SERVER == 1 )
-                        {
-                            if( pxTCB->uxDeadline == portMAX_DELAY && pxTCB->uxPeriod < pxCurrentTCB->uxPeriod )
-                            {
-                                xSwitchRequired = pdTRUE;
-                            }
-                            else if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                            {
-                                xSwitchRequired = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        #else
-                        {
-                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                            {
-                                xSwitchRequired = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        #endif // (configUSE_POLLING_SERVER == 1)
-                    }
-                    #endif /* configUSE_PREEMPTION */
                 }
-            }
-        }
-
-        /* Tasks of equal priority to the currently running task will share
-         * processing time (time slice) if preemption is on, and the application
-         * writer has not explicitly turned time slicing off. */
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
-        {
-            #if ( configUSE_POLLING_SERVER != 1 )
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
-            {
-                xSwitchRequired = pdTRUE;
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-            #else
-                mtCOVERAGE_TEST_MARKER();
-            #endif
         }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+        #endif /* configUSE_TASK_SPLITTING */
 
-        #if ( configUSE_TICK_HOOK == 1 )
+        if( xCoreID == taskTASK_NOT_RUNNING )
         {
-            /* Guard against the tick hook being called when the pended tick
-             * count is being unwound (when the scheduler is being unlocked). */
-            if( xPendedTicks == ( TickType_t ) 0 )
-            {
-                vApplicationTickHook();
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            /* The set does not fit.  The task overloads the core that has the
+             * most room left, as uxTaskGetCoreUtilisation() then shows. */
+            xCoreID = prvPartitionMostSpareCore( taskTASK_NOT_RUNNING );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif /* configUSE_TICK_HOOK */
 
-        #if ( configUSE_PREEMPTION == 1 )
+        pxTCB->ulPartitionLoad = ulUtilisation;
+        prvPartitionAdd( xCoreID, ulUtilisation );
+        prvSetPartitionCore( pxTCB, xCoreID );
+
+        #if ( configUSE_TASK_SPLITTING == 1 )
         {
-            if( xYieldPending != pdFALSE )
+            pxTCB->xHomeCore = xCoreID;
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPartitionRelease( TCB_t * pxTCB )
+    {
+        #if ( configUSE_TASK_SPLITTING == 1 )
+        {
+            prvPartitionRemove( pxTCB->xHomeCore, pxTCB->ulPartitionLoad );
+
+            if( pxTCB->xSplitCore != taskTASK_NOT_RUNNING )
             {
-                xSwitchRequired = pdTRUE;
+                prvPartitionRemove( pxTCB->xSplitCore, pxTCB->ulSplitLoad );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configUSE_PREEMPTION */
-    }
-    else
-    {
-        ++xPendedTicks;
-
-        /* The tick hook gets called at regular intervals, even if the
-         * scheduler is locked. */
-        #if ( configUSE_TICK_HOOK == 1 )
+        #else
         {
-            vApplicationTickHook();
+            prvPartitionRemove( pxTCB->xPartitionCore, pxTCB->ulPartitionLoad );
         }
         #endif
-    }
 
-    return xSwitchRequired;
-}
+        pxTCB->ulPartitionLoad = 0U;
+    }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
-
-    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
-                                     TaskHookFunction_t pxHookFunction )
+    static void prvPartitionTaskSet( void )
     {
-        TCB_t * xTCB;
+        List_t xTasksByUtilisation;
+        ListItem_t * pxItem;
+        ListItem_t * pxNext;
+        TCB_t * pxTCB;
+        UBaseType_t uxList;
 
-        /* If xTask is NULL then it is the task hook of the calling task that is
-         * getting set. */
-        if( xTask == NULL )
-        {
-            xTCB = ( TCB_t * ) pxCurrentTCB;
-        }
-        else
+        vListInitialise( &xTasksByUtilisation );
+
+        /* Take the ready periodic tasks out of the lists they were placed in
+         * as they were created, the highest utilisation first.  The key is
+         * halved so it fits a 16 bit TickType_t.  A task suspended before the
+         * scheduler started keeps the core it was given. */
+        for( uxList = ( UBaseType_t ) 0U; uxList < ( UBaseType_t ) configNUMBER_OF_CORES; uxList++ )
         {
-            xTCB = xTask;
+            pxItem = listGET_HEAD_ENTRY( taskPERIODIC_READY_LIST( uxList ) );
+
+            while( pxItem != listGET_END_MARKER( taskPERIODIC_READY_LIST( uxList ) ) )
+            {
+                pxNext = listGET_NEXT( pxItem );
+                pxTCB = listGET_LIST_ITEM_OWNER( pxItem );
+
+                if( taskIS_PERIODIC( pxTCB ) )
+                {
+                    ( void ) uxListRemove( pxItem );
+                    prvPartitionRelease( pxTCB );
+                    listSET_LIST_ITEM_VALUE( pxItem, ( TickType_t ) ( ( taskUTILISATION_ONE - taskPERIODIC_UTILISATION( pxTCB ) ) >> 1 ) );
+                    vListInsert( &xTasksByUtilisation, pxItem );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxItem = pxNext;
+            }
         }
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        taskENTER_CRITICAL();
+        /* Then pack them again, first-fit or worst-fit decreasing. */
+        while( listLIST_IS_EMPTY( &xTasksByUtilisation ) == pdFALSE )
         {
-            xTCB->pxTaskTag = pxHookFunction;
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( &xTasksByUtilisation ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+            prvPartitionTask( pxTCB );
+            prvAddTaskToReadyList( pxTCB );
         }
-        taskEXIT_CRITICAL();
     }
+/*-----------------------------------------------------------*/
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+    #if ( configUSE_TASK_SPLITTING == 1 )
+
+        static void prvChargeSplitJobs( void )
+        {
+            BaseType_t xCoreID;
+            TCB_t * pxTCB;
+
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                pxTCB = pxCurrentTCBs[ xCoreID ];
+
+                if( ( pxTCB != NULL ) && ( pxTCB->xSplitCore != taskTASK_NOT_RUNNING ) && ( pxTCB->xPartitionCore == pxTCB->xHomeCore ) )
+                {
+                    ( pxTCB->xJobTicks )++;
+
+                    if( ( pxTCB->xJobTicks >= pxTCB->xSplitBudget ) &&
+                        ( listIS_CONTAINED_WITHIN( taskPERIODIC_READY_LIST( taskPARTITION_OF( pxTCB ) ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+                    {
+                        /* The first share is spent.  The task is running, so
+                         * adding it to the ready list of the second core
+                         * yields this one, and the second core takes the job
+                         * once this one has switched it out, see
+                         * prvSelectHighestPriorityTaskForCore(). */
+                        ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                        prvSetPartitionCore( pxTCB, pxTCB->xSplitCore );
+                        prvAddTaskToReadyList( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+    #endif /* configUSE_TASK_SPLITTING */
 
-    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+    UBaseType_t uxTaskGetCoreUtilisation( BaseType_t xCoreID )
     {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
+        uint32_t ulUtilisation;
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
         taskENTER_CRITICAL();
         {
-            xReturn = pxTCB->pxTaskTag;
+            ulUtilisation = xCorePartitions[ xCoreID ].ulUtilisation;
         }
         taskEXIT_CRITICAL();
 
-        return xReturn;
+        return taskUTILISATION_PERMILLE( ulUtilisation );
     }
-
-#endif /* configUSE_APPLICATION_TASK_TAG */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
-
-    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    void vTaskGetPartition( TaskHandle_t xTask,
+                            TaskPartition_t * pxPartition )
     {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
-        UBaseType_t uxSavedInterruptStatus;
+        const TCB_t * pxTCB;
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        configASSERT( pxPartition );
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        taskENTER_CRITICAL();
         {
-            xReturn = pxTCB->pxTaskTag;
-        }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+            pxTCB = prvGetTCBFromHandle( xTask );
+            pxPartition->uxPermille = taskUTILISATION_PERMILLE( pxTCB->ulPartitionLoad );
 
-        return xReturn;
+            #if ( configUSE_TASK_SPLITTING == 1 )
+            {
+                pxPartition->xCore = pxTCB->xHomeCore;
+                pxPartition->xSplitCore = pxTCB->xSplitCore;
+                pxPartition->xSplitBudget = pxTCB->xSplitBudget;
+            }
+            #else
+            {
+                pxPartition->xCore = pxTCB->xPartitionCore;
+                pxPartition->xSplitCore = ( BaseType_t ) -1;
+                pxPartition->xSplitBudget = ( TickType_t ) 0U;
+            }
+            #endif
+        }
+        taskEXIT_CRITICAL();
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+#endif /* configUSE_PARTITIONED_SCHEDULING */
+/*----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
 
-    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
-                                             void * pvParameter )
+/* This conditional compilation should use inequality to 0, not equality to 1.
+ * This is to ensure vTaskStepTick() is available when user defined low power mode
+ * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
+ * 1. */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    void vTaskStepTick( TickType_t xTicksToJump )
     {
-        TCB_t * xTCB;
-        BaseType_t xReturn;
+        const TickType_t xTicksToNextEvent = prvGetTicksToNextEvent();
 
-        /* If xTask is NULL then we are calling our own task hook. */
-        if( xTask == NULL )
+        /* Correct the tick count value after a period during which the tick
+         * was suppressed.  Note this does *not* call the tick hook function for
+         * each stepped tick.  The ticks stepped over must not include one that
+         * wakes a task, releases a periodic job, replenishes the server or
+         * expires an ISR timer, as xTaskIncrementTick() acts on each of those
+         * at its own tick. */
+        configASSERT( xTicksToJump <= xTicksToNextEvent );
+
+        if( xTicksToJump == xTicksToNextEvent )
         {
-            xTCB = pxCurrentTCB;
+            /* Arrange for xTickCount to reach the time of the next event in
+             * xTaskIncrementTick() when the scheduler resumes.  This ensures
+             * that any delayed tasks are resumed, and periodic jobs released,
+             * at the correct time. */
+            configASSERT( uxSchedulerSuspended );
+            configASSERT( xTicksToJump != ( TickType_t ) 0 );
+
+            /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
+            taskENTER_CRITICAL();
+            {
+                xPendedTicks++;
+            }
+            taskEXIT_CRITICAL();
+            xTicksToJump--;
         }
         else
         {
-            xTCB = xTask;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        if( xTCB->pxTaskTag != NULL )
-        {
-            xReturn = xTCB->pxTaskTag( pvParameter );
-        }
-        else
+        #if ( configUSE_APERIODIC_SERVER == 1 )
         {
-            xReturn = pdFAIL;
+            prvServerStepTick( xTicksToJump );
         }
+        #endif
 
-        return xReturn;
+        xTickCount += xTicksToJump;
+        traceINCREASE_TICK_COUNT( xTicksToJump );
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
-/*-----------------------------------------------------------*/
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
+BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
 {
-    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+    BaseType_t xYieldOccurred;
+
+    /* Must not be called with the scheduler suspended as the implementation
+     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
+    configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
+
+    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
+     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
+    vTaskSuspendAll();
+
+    /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
+    taskENTER_CRITICAL();
     {
-        /* The scheduler is currently suspended - do not allow a context
-         * switch. */
-        xYieldPending = pdTRUE;
+        xPendedTicks += xTicksToCatchUp;
     }
-    else
+    taskEXIT_CRITICAL();
+    xYieldOccurred = xTaskResumeAll();
+
+    return xYieldOccurred;
+}
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskAbortDelay == 1 )
+
+    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
     {
-        xYieldPending = pdFALSE;
-        traceTASK_SWITCHED_OUT();
+        TCB_t * pxTCB = xTask;
+        BaseType_t xReturn;
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
-        {
-            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-            #else
-                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-            #endif
+        configASSERT( pxTCB );
 
-            /* Add the amount of time the task has been running to the
-             * accumulated time so far.  The time the task started running was
-             * stored in ulTaskSwitchedInTime.  Note that there is no overflow
-             * protection here so count values are only valid until the timer
-             * overflows.  The guard against negative values is to protect
-             * against suspect run time stat counter implementations - which
-             * are provided by the application, not the kernel. */
-            if( ulTotalRunTime > ulTaskSwitchedInTime )
+        vTaskSuspendAll();
+        {
+            /* A task can only be prematurely removed from the Blocked state if
+             * it is actually in the Blocked state. */
+            if( eTaskGetState( xTask ) == eBlocked )
             {
-                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+                xReturn = pdPASS;
+
+                /* Remove the reference to the task from the blocked list.  An
+                 * interrupt won't touch the xStateListItem because the
+                 * scheduler is suspended. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                /* Is the task waiting on an event also?  If so remove it from
+                 * the event list too.  Interrupts can touch the event list item,
+                 * even though the scheduler is suspended, so a critical section
+                 * is used. */
+                taskENTER_CRITICAL();
+                {
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    {
+                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+
+                        /* This lets the task know it was forcibly removed from the
+                         * blocked state so it should not re-evaluate its block time and
+                         * then block again. */
+                        pxTCB->ucDelayAborted = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                /* Place the unblocked task into the appropriate ready list. */
+                prvAddTaskToReadyList( pxTCB );
+
+                /* A task being unblocked cannot cause an immediate context
+                 * switch if preemption is turned off. */
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    /* Preemption is on, but a context switch should only be
+                     * performed if the unblocked task has a priority that is
+                     * higher than the currently executing task. */
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        /* Pend the yield to be performed when the scheduler
+                         * is unsuspended. */
+                        xYieldPending = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_PREEMPTION */
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                xReturn = pdFAIL;
             }
-
-            ulTaskSwitchedInTime = ulTotalRunTime;
         }
-        #endif /* configGENERATE_RUN_TIME_STATS */
+        ( void ) xTaskResumeAll();
 
-        /* Check for stack overflow, if configured. */
-        taskCHECK_FOR_STACK_OVERFLOW();
+        return xReturn;
+    }
 
-        /* Before the currently running task is switched out, save its errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
+#endif /* INCLUDE_xTaskAbortDelay */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskIncrementTick( void )
+{
+    TCB_t * pxTCB;
+    TickType_t xItemValue;
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    /* Called by the portable layer each time a tick interrupt occurs.
+     * Increments the tick then checks to see if the new tick value will cause any
+     * tasks to be unblocked. */
+    traceTASK_INCREMENT_TICK( xTickCount );
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        /* Minor optimisation.  The tick count cannot change in this
+         * block. */
+        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+
+        /* Increment the RTOS tick, switching the delayed and overflowed
+         * delayed lists if it wraps to 0. */
+        xTickCount = xConstTickCount;
+
+        #if ( configUSE_SCHEDULER_STATS == 1 )
         {
-            pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+            ulTickStatsTime = portGET_SCHEDULER_STATS_TIME();
         }
         #endif
 
-        /* Select a new task to run using either the generic C or port
-         * optimised asm code. */
-        #if ( configUSE_POLLING_SERVER ==  1 )
+        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
         {
-            if( listLIST_IS_EMPTY( &xReadyPeriodicTasksLists ) == pdFALSE )
-            {
-                pxCurrentTCB = (TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( &(xReadyPeriodicTasksLists) );
-            }
-            else
+            taskSWITCH_DELAYED_LISTS();
+
+            #if ( INCLUDE_vTaskEndJob == 1 )
             {
-                #if ( configUSE_APERIODIC_PREEMPTION == 1 )
-                    taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                #else // ( configUSE_APERIODIC_PREEMPTION == 1 )
-                    taskSELECT_OLD_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                #endif // ( configUSE_APERIODIC_PREEMPTION == 1 )
+                taskSWITCH_PENDING_PERIODIC_LISTS();
             }
+            #endif
         }
-        #else
+        else
         {
-            taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif // ( configUSE_POLLING_SERVER ==  1 )
-        traceTASK_SWITCHED_IN();
 
-        /* After the new task is switched in, update the global errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
+        #if ( configUSE_EDF_SCHEDULER == 1 )
         {
-            FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+            if( ( TickType_t ) ( xConstTickCount - xEDFTimeBase ) >= taskEDF_REBASE_INTERVAL )
+            {
+                prvEDFRebase();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        #endif
+        #endif /* configUSE_EDF_SCHEDULER */
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        #if ( INCLUDE_vTaskEndJob == 1 )
         {
-            /* Switch C-Runtime's TLS Block to point to the TLS
-             * Block specific to this task. */
-            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
-        }
-        #endif
-    }
-}
-/*-----------------------------------------------------------*/
+            if( xConstTickCount >= xNextPeriodicReleaseTime )
+            {
+                if( prvReleasePeriodicJobs( xConstTickCount ) != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-void vTaskPlaceOnEventList( List_t * const pxEventList,
-                            const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+            #if ( configUSE_TASK_SPLITTING == 1 )
+            {
+                prvChargeSplitJobs();
+            }
+            #endif
 
-    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
-     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+            /* The running job is the one with the earliest deadline, so it is
+             * the first one that can miss it. */
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                BaseType_t xCoreID;
 
-    /* Place the event list item of the TCB in the appropriate event list.
-     * This is placed in the list in priority order so the highest priority task
-     * is the first to be woken by the event.
-     *
-     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
-     * Normally, the xItemValue of a TCB's ListItem_t members is:
-     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
-     * Therefore, the event list is sorted in descending priority order.
-     *
-     * The queue that contains the event list is locked, preventing
-     * simultaneous access from interrupts. */
-    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+                /* One running job per core. */
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    if( pxCurrentTCBs[ xCoreID ] != NULL )
+                    {
+                        prvCheckDeadlineMiss( pxCurrentTCBs[ xCoreID ], xConstTickCount );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            #else
+            {
+                prvCheckDeadlineMiss( pxCurrentTCB, xConstTickCount );
+            }
+            #endif
+        }
+        #endif /* INCLUDE_vTaskEndJob */
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
-/*-----------------------------------------------------------*/
+        #if ( configUSE_APERIODIC_SERVER == 1 )
+        {
+            if( prvServerTick( xConstTickCount ) != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_APERIODIC_SERVER */
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
-                                     const TickType_t xItemValue,
-                                     const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+        #if ( configUSE_APERIODIC_BUDGET == 1 )
+        {
+            /* Charge the tick that has just elapsed to the running aperiodic
+             * task.  This is done before the delayed list is processed so a
+             * throttled task is placed in the delayed list before
+             * xNextTaskUnblockTime is next evaluated.  A uxDuration of zero
+             * means the task has no budget, and a task that has already been
+             * demoted keeps running in the background with its budget at
+             * zero. */
+            if( ( taskIS_APERIODIC( pxCurrentTCB ) != pdFALSE ) && ( pxCurrentTCB->xBudgetRemaining > ( TickType_t ) 0U ) )
+            {
+                pxCurrentTCB->xBudgetRemaining--;
 
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+                if( pxCurrentTCB->xBudgetRemaining == ( TickType_t ) 0U )
+                {
+                    if( prvAperiodicBudgetExhausted() != pdFALSE )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            #if ( configAPERIODIC_OVERRUN_POLICY == tskAPERIODIC_OVERRUN_THROTTLE )
+                else if( ( taskIS_APERIODIC( pxCurrentTCB ) != pdFALSE ) &&
+                         ( pxCurrentTCB->xThrottlePending != pdFALSE ) &&
+                         ( prvAperiodicIsReady( pxCurrentTCB ) != pdFALSE ) )
+                {
+                    /* The budget ran out while the task was blocking.  It has
+                     * been readied since, so the throttle is applied now. */
+                    prvAperiodicThrottle();
+                    xSwitchRequired = pdTRUE;
+                }
+            #endif
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_APERIODIC_BUDGET */
+
+        /* See if this tick has made a timeout expire.  Tasks are stored in
+         * the  queue in the order of their wake time - meaning once one task
+         * has been found whose block time has not expired there is no need to
+         * look any further down the list. */
+        if( xConstTickCount >= xNextTaskUnblockTime )
+        {
+            for( ; ; )
+            {
+                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                {
+                    /* The delayed list is empty.  Set xNextTaskUnblockTime
+                     * to the maximum possible value so it is extremely
+                     * unlikely that the
+                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                     * next time through. */
+                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    break;
+                }
+                else
+                {
+                    /* The delayed list is not empty, get the value of the
+                     * item at the head of the delayed list.  This is the time
+                     * at which the task at the head of the delayed list must
+                     * be removed from the Blocked state. */
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+                    if( xConstTickCount < xItemValue )
+                    {
+                        /* It is not time to unblock this item yet, but the
+                         * item value is the time at which the task at the head
+                         * of the blocked list must be removed from the Blocked
+                         * state -  so record the item value in
+                         * xNextTaskUnblockTime. */
+                        xNextTaskUnblockTime = xItemValue;
+                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* It is time to remove the item from the Blocked state. */
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+                    /* Is the task waiting on an event also?  If so remove
+                     * it from the event list. */
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    {
+                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Place the unblocked task into the appropriate ready
+                     * list. */
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* A task being unblocked cannot cause an immediate
+                     * context switch if preemption is turned off. */
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        /* Preemption is on, but a context switch should
+                         * only be performed if the unblocked task's
+                         * priority is higher than the currently executing
+                         * task.
+                         * The case of equal priority tasks sharing
+                         * processing time (which happens when both
+                         * preemption and time slicing are on) is
+                         * handled below.*/
+                        #if ( configUSE_POLLING_SERVER == 1 )
+                        {
+                            if( taskUNBLOCKED_PREEMPTS( pxTCB ) )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            #if ( configUSE_APERIODIC_SERVER == 1 )
+                                else if( taskSERVER_PREEMPTS() )
+                                {
+                                    xSwitchRequired = pdTRUE;
+                                }
+                            #endif
+                            else if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #else
+                        {
+                            if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                            {
+                                xSwitchRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif // (configUSE_POLLING_SERVER == 1)
+                    }
+                    #endif /* configUSE_PREEMPTION */
+                }
+            }
+        }
+
+        /* Tasks of equal priority to the currently running task will share
+         * processing time (time slice) if preemption is on, and the application
+         * writer has not explicitly turned time slicing off. */
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+        {
+            #if ( configUSE_POLLING_SERVER != 1 )
+            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+            #else
+                mtCOVERAGE_TEST_MARKER();
+            #endif
+        }
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+
+        #if ( configUSE_ISR_TIMERS == 1 )
+        {
+            /* Expire the ISR timers that are due.  A task their callbacks
+             * unblock from here sets xYieldPending if it should preempt. */
+            vTimerProcessISRTimers( xConstTickCount );
+        }
+        #endif /* configUSE_ISR_TIMERS */
+
+        #if ( configUSE_TICK_HOOK == 1 )
+        {
+            /* Guard against the tick hook being called when the pended tick
+             * count is being unwound (when the scheduler is being unlocked). */
+            if( xPendedTicks == ( TickType_t ) 0 )
+            {
+                vApplicationTickHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TICK_HOOK */
+
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            if( xYieldPending != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_PREEMPTION */
+    }
+    else
+    {
+        ++xPendedTicks;
+
+        /* ISR timers do not wait for the scheduler to resume.  The tick is
+         * not acted on again when the pended ticks are wound down. */
+        #if ( configUSE_ISR_TIMERS == 1 )
+        {
+            vTimerProcessISRTimers( xTickCount + xPendedTicks );
+        }
+        #endif
+
+        /* The tick hook gets called at regular intervals, even if the
+         * scheduler is locked. */
+        #if ( configUSE_TICK_HOOK == 1 )
+        {
+            vApplicationTickHook();
+        }
+        #endif
+    }
+
+    return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APERIODIC_BUDGET == 1 )
+
+    static BaseType_t prvAperiodicBudgetExhausted( void )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+
+        traceTASK_APERIODIC_OVERRUN( pxTCB );
+
+        #if ( configUSE_APERIODIC_OVERRUN_HOOK == 1 )
+        {
+            vApplicationAperiodicOverrunHook( pxTCB );
+        }
+        #endif
+
+        #if ( configAPERIODIC_OVERRUN_POLICY == tskAPERIODIC_OVERRUN_ABORT )
+        {
+            /* Same steps as vTaskDelete( NULL ), except that the yield is left
+             * to the caller as this runs inside the tick interrupt. */
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            taskREADY_HEAP_FORGET( pxTCB );
+            taskADMISSION_RELEASE( pxTCB );
+            taskPARTITION_RELEASE( pxTCB );
+
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxTaskNumber++;
+            prvAddTaskToTerminationList( pxTCB );
+            traceTASK_DELETE( pxTCB );
+            portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+        }
+        #elif ( configAPERIODIC_OVERRUN_POLICY == tskAPERIODIC_OVERRUN_DEMOTE )
+        {
+            /* A task that is already blocking is left on its delayed or event
+             * list and only given the idle priority, as vTaskPrioritySet()
+             * does, so it is readied at that priority. */
+            const BaseType_t xIsReady = prvAperiodicIsReady( pxTCB );
+
+            if( xIsReady != pdFALSE )
+            {
+                if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                {
+                    taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            #if ( configUSE_MUTEXES == 1 )
+            {
+                /* If the task is running at an inherited priority, leave that
+                 * in place - it drops to the idle priority when the mutex is
+                 * given back. */
+                if( pxTCB->uxBasePriority == pxTCB->uxPriority )
+                {
+                    pxTCB->uxPriority = tskIDLE_PRIORITY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxTCB->uxBasePriority = tskIDLE_PRIORITY;
+            }
+            #else
+            {
+                pxTCB->uxPriority = tskIDLE_PRIORITY;
+            }
+            #endif
+
+            if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+            {
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - pxTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xIsReady != pdFALSE )
+            {
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* Under EDF the deadline list outranks every priority, so
+                     * the task is put in the priority list for its new
+                     * priority. */
+                    prvAddTaskToPriorityReadyList( pxTCB );
+                }
+                #else
+                {
+                    prvAddTaskByDeadlineToReadyList( pxTCB );
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* tskAPERIODIC_OVERRUN_THROTTLE */
+        {
+            if( prvAperiodicIsReady( pxTCB ) != pdFALSE )
+            {
+                prvAperiodicThrottle();
+            }
+            else
+            {
+                /* Blocking the task again would overwrite the timeout it has
+                 * just blocked with, so the tick throttles it once it is
+                 * ready to run again. */
+                pxTCB->xThrottlePending = pdTRUE;
+            }
+        }
+        #endif /* configAPERIODIC_OVERRUN_POLICY */
+
+        return pdTRUE;
+    }
+
+#endif /* configUSE_APERIODIC_BUDGET */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_APERIODIC_BUDGET == 1 ) && ( configAPERIODIC_OVERRUN_POLICY != tskAPERIODIC_OVERRUN_ABORT ) )
+
+    static BaseType_t prvAperiodicIsReady( const TCB_t * pxTCB )
+    {
+        const List_t * const pxContainer = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxContainer == &( pxReadyTasksLists[ pxTCB->uxPriority ] ) )
+        {
+            xReturn = pdTRUE;
+        }
+
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+            else if( pxContainer == taskPERIODIC_READY_LIST( taskPARTITION_OF( pxTCB ) ) )
+            {
+                xReturn = pdTRUE;
+            }
+        #endif
+
+        #if ( configUSE_APERIODIC_SERVER == 1 )
+            else if( pxContainer == &( xAperiodicServer.xJobList ) )
+            {
+                xReturn = pdTRUE;
+            }
+        #endif
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APERIODIC_BUDGET && configAPERIODIC_OVERRUN_POLICY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_APERIODIC_BUDGET == 1 ) && ( configAPERIODIC_OVERRUN_POLICY == tskAPERIODIC_OVERRUN_THROTTLE ) )
+
+    static void prvAperiodicThrottle( void )
+    {
+        /* Block for the throttle period, then resume with a full budget. */
+        pxCurrentTCB->xThrottlePending = pdFALSE;
+        pxCurrentTCB->xBudgetRemaining = ( TickType_t ) pxCurrentTCB->uxDuration;
+        prvAddCurrentTaskToDelayedList( configAPERIODIC_THROTTLE_TICKS, pdFALSE );
+    }
+
+#endif /* configUSE_APERIODIC_BUDGET && configAPERIODIC_OVERRUN_POLICY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APERIODIC_SERVER == 1 )
+
+    BaseType_t xTaskServerCreate( eServerPolicy ePolicy,
+                                  TickType_t xCapacity,
+                                  TickType_t xPeriod )
+    {
+        AperiodicServer_t * const pxServer = &xAperiodicServer;
+        BaseType_t xReturn = pdFAIL;
+
+        taskENTER_CRITICAL();
+        {
+            /* The server can only be (re)configured while it has no queued
+             * jobs, so the jobs it already accepted keep the guarantees they
+             * were accepted under. */
+            if( ( xCapacity > ( TickType_t ) 0U ) &&
+                ( xCapacity <= xPeriod ) &&
+                ( listCURRENT_LIST_LENGTH( &( pxServer->xJobList ) ) == ( UBaseType_t ) 0U ) )
+            {
+                #if ( configUSE_ADMISSION_CONTROL == 1 )
+                {
+                    /* The server is tested like a periodic task, in place of
+                     * its previous configuration. */
+                    const uint32_t ulPrevious = xAdmissionControl.ulServerUtilisation;
+                    const uint32_t ulUtilisation = taskUTILISATION( xCapacity, xPeriod );
+
+                    prvRemoveUtilisation( ulPrevious );
+
+                    if( prvUtilisationFits( ulUtilisation ) != pdFALSE )
+                    {
+                        prvAddUtilisation( ulUtilisation );
+                        xAdmissionControl.ulServerUtilisation = ulUtilisation;
+                        xReturn = pdPASS;
+                    }
+                    else
+                    {
+                        prvAddUtilisation( ulPrevious );
+                        xReturn = errSCHEDULE_NOT_ADMITTED;
+                    }
+                }
+                #else
+                {
+                    xReturn = pdPASS;
+                }
+                #endif /* configUSE_ADMISSION_CONTROL */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xReturn == pdPASS )
+            {
+                if( listLIST_ITEM_CONTAINER( &( pxServer->xServerListItem ) ) != NULL )
+                {
+                    ( void ) uxListRemove( &( pxServer->xServerListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxServer->ePolicy = ePolicy;
+                pxServer->xCapacity = xCapacity;
+                pxServer->xPeriod = xPeriod;
+                pxServer->xBudget = xCapacity;
+                pxServer->xNextReplenishTime = xTickCount + xPeriod;
+                pxServer->xConsumed = ( TickType_t ) 0U;
+                pxServer->uxReplenishHead = ( UBaseType_t ) 0U;
+                pxServer->uxReplenishCount = ( UBaseType_t ) 0U;
+                pxServer->xRunning = pdFALSE;
+
+                /* The server competes with the periodic tasks at the priority
+                 * its period gives it.  A NULL owner marks the item as the
+                 * server's. */
+                listSET_LIST_ITEM_VALUE( &( pxServer->xServerListItem ), xPeriod );
+                listSET_LIST_ITEM_OWNER( &( pxServer->xServerListItem ), NULL );
+
+                /* Creating the server counts as its first release. */
+                prvServerUpdateReadyState();
+                traceSERVER_REPLENISHED( pxServer->xBudget );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvServerUpdateReadyState( void )
+    {
+        AperiodicServer_t * const pxServer = &xAperiodicServer;
+
+        if( ( pxServer->xBudget > ( TickType_t ) 0U ) && ( listLIST_IS_EMPTY( &( pxServer->xJobList ) ) == pdFALSE ) )
+        {
+            if( listLIST_ITEM_CONTAINER( &( pxServer->xServerListItem ) ) == NULL )
+            {
+                taskPERIODIC_READY_INSERT( 0, &( pxServer->xServerListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            if( listLIST_ITEM_CONTAINER( &( pxServer->xServerListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxServer->xServerListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* A polling server gives up whatever capacity it has left as soon
+             * as it finds no work, and only gets it back at the start of its
+             * next period. */
+            if( ( pxServer->ePolicy == eServerPolling ) && ( listLIST_IS_EMPTY( &( pxServer->xJobList ) ) != pdFALSE ) )
+            {
+                pxServer->xBudget = ( TickType_t ) 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvServerSetRunning( BaseType_t xRunning )
+    {
+        AperiodicServer_t * const pxServer = &xAperiodicServer;
+
+        if( xRunning != pxServer->xRunning )
+        {
+            if( xRunning != pdFALSE )
+            {
+                pxServer->xActivationTime = xTickCount;
+            }
+            else if( ( pxServer->ePolicy == eServerSporadic ) && ( pxServer->xConsumed > ( TickType_t ) 0U ) )
+            {
+                /* The busy interval ends when the server is switched out.
+                 * Starting a new interval each time the server is switched
+                 * back in places replenishments no earlier than the sporadic
+                 * server rule allows, so the bound on the interference
+                 * suffered by the periodic tasks is kept. */
+                prvServerScheduleReplenishment();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxServer->xRunning = xRunning;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvServerScheduleReplenishment( void )
+    {
+        AperiodicServer_t * const pxServer = &xAperiodicServer;
+        UBaseType_t uxSlot;
+
+        if( pxServer->uxReplenishCount < ( UBaseType_t ) configSERVER_MAX_REPLENISHMENTS )
+        {
+            uxSlot = ( pxServer->uxReplenishHead + pxServer->uxReplenishCount ) % ( UBaseType_t ) configSERVER_MAX_REPLENISHMENTS;
+            pxServer->xReplenishAmount[ uxSlot ] = pxServer->xConsumed;
+            pxServer->uxReplenishCount++;
+        }
+        else
+        {
+            /* No free slot.  Fold the capacity into the newest replenishment
+             * and move that to the later time, which returns capacity late
+             * rather than early. */
+            uxSlot = ( pxServer->uxReplenishHead + pxServer->uxReplenishCount - ( UBaseType_t ) 1U ) % ( UBaseType_t ) configSERVER_MAX_REPLENISHMENTS;
+            pxServer->xReplenishAmount[ uxSlot ] += pxServer->xConsumed;
+        }
+
+        pxServer->xReplenishTime[ uxSlot ] = pxServer->xActivationTime + pxServer->xPeriod;
+        pxServer->xConsumed = ( TickType_t ) 0U;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvServerTick( TickType_t xConstTickCount )
+    {
+        AperiodicServer_t * const pxServer = &xAperiodicServer;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        if( pxServer->xPeriod != ( TickType_t ) 0U )
+        {
+            /* Charge the tick that has just elapsed if it was spent running
+             * one of the server's jobs. */
+            if( ( pxServer->xRunning != pdFALSE ) && ( pxServer->xBudget > ( TickType_t ) 0U ) )
+            {
+                pxServer->xBudget--;
+                pxServer->xConsumed++;
+
+                if( pxServer->xBudget == ( TickType_t ) 0U )
+                {
+                    traceSERVER_BUDGET_EXHAUSTED();
+
+                    if( pxServer->ePolicy == eServerSporadic )
+                    {
+                        prvServerScheduleReplenishment();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxServer->ePolicy == eServerSporadic )
+            {
+                while( ( pxServer->uxReplenishCount > ( UBaseType_t ) 0U ) &&
+                       ( pxServer->xReplenishTime[ pxServer->uxReplenishHead ] == xConstTickCount ) )
+                {
+                    prvServerApplyReplenishment();
+                }
+            }
+            else if( xConstTickCount == pxServer->xNextReplenishTime )
+            {
+                /* Polling and deferrable servers get their full capacity back
+                 * at every period boundary.  Unused capacity does not carry
+                 * over. */
+                pxServer->xNextReplenishTime += pxServer->xPeriod;
+                pxServer->xBudget = pxServer->xCapacity;
+                traceSERVER_REPLENISHED( pxServer->xBudget );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvServerUpdateReadyState();
+
+            if( taskSERVER_PREEMPTS() )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xSwitchRequired;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvServerApplyReplenishment( void )
+    {
+        AperiodicServer_t * const pxServer = &xAperiodicServer;
+
+        pxServer->xBudget += pxServer->xReplenishAmount[ pxServer->uxReplenishHead ];
+
+        if( pxServer->xBudget > pxServer->xCapacity )
+        {
+            pxServer->xBudget = pxServer->xCapacity;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxServer->uxReplenishHead = ( pxServer->uxReplenishHead + ( UBaseType_t ) 1U ) % ( UBaseType_t ) configSERVER_MAX_REPLENISHMENTS;
+        pxServer->uxReplenishCount--;
+        traceSERVER_REPLENISHED( pxServer->xBudget );
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+
+        static TickType_t prvServerTicksToNextEvent( void )
+        {
+            const AperiodicServer_t * const pxServer = &xAperiodicServer;
+            TickType_t xReturn = portMAX_DELAY;
+
+            /* A replenishment only changes what runs when the server has a
+             * job waiting for budget.  Without one the idle time can run past
+             * it, prvServerStepTick() applies it afterwards. */
+            if( ( pxServer->xPeriod != ( TickType_t ) 0U ) && ( listLIST_IS_EMPTY( &( pxServer->xJobList ) ) == pdFALSE ) )
+            {
+                if( pxServer->ePolicy != eServerSporadic )
+                {
+                    xReturn = pxServer->xNextReplenishTime - xTickCount;
+                }
+                else if( pxServer->uxReplenishCount > ( UBaseType_t ) 0U )
+                {
+                    xReturn = pxServer->xReplenishTime[ pxServer->uxReplenishHead ] - xTickCount;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvServerStepTick( TickType_t xTicksToJump )
+        {
+            AperiodicServer_t * const pxServer = &xAperiodicServer;
+            TickType_t xTicksToBoundary;
+
+            if( pxServer->xPeriod != ( TickType_t ) 0U )
+            {
+                if( pxServer->ePolicy == eServerSporadic )
+                {
+                    while( ( pxServer->uxReplenishCount > ( UBaseType_t ) 0U ) &&
+                           ( ( TickType_t ) ( pxServer->xReplenishTime[ pxServer->uxReplenishHead ] - xTickCount ) <= xTicksToJump ) )
+                    {
+                        prvServerApplyReplenishment();
+                    }
+                }
+                else
+                {
+                    /* Move to the first period boundary after the jump, the
+                     * skipped boundaries all give the same full capacity. */
+                    xTicksToBoundary = pxServer->xNextReplenishTime - xTickCount;
+
+                    if( xTicksToJump >= xTicksToBoundary )
+                    {
+                        pxServer->xNextReplenishTime += ( ( ( xTicksToJump - xTicksToBoundary ) / pxServer->xPeriod ) + ( TickType_t ) 1U ) * pxServer->xPeriod;
+                        pxServer->xBudget = pxServer->xCapacity;
+                        traceSERVER_REPLENISHED( pxServer->xBudget );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                /* A polling server without jobs gives its capacity up again. */
+                prvServerUpdateReadyState();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+    #endif /* configUSE_TICKLESS_IDLE */
+
+#endif /* configUSE_APERIODIC_SERVER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
+                                     TaskHookFunction_t pxHookFunction )
+    {
+        TCB_t * xTCB;
+
+        /* If xTask is NULL then it is the task hook of the calling task that is
+         * getting set. */
+        if( xTask == NULL )
+        {
+            xTCB = ( TCB_t * ) pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xTCB->pxTaskTag = pxHookFunction;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
+                                             void * pvParameter )
+    {
+        TCB_t * xTCB;
+        BaseType_t xReturn;
+
+        /* If xTask is NULL then we are calling our own task hook. */
+        if( xTask == NULL )
+        {
+            xTCB = pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        if( xTCB->pxTaskTag != NULL )
+        {
+            xReturn = xTCB->pxTaskTag( pvParameter );
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    static TCB_t * prvSelectFromReadyList( List_t * const pxList,
+                                           BaseType_t xCoreID )
+    {
+        TCB_t * pxReturn = NULL;
+        ListItem_t * pxItem;
+        UBaseType_t uxItemsLeft = listCURRENT_LIST_LENGTH( pxList );
+
+        #if ( configUSE_POLLING_SERVER == 1 ) && ( configUSE_APERIODIC_PREEMPTION == 0 )
+        {
+            /* As taskSELECT_OLD_HIGHEST_PRIORITY_TASK(), from the head of the
+             * list, so tasks of the same priority do not preempt each other. */
+            pxItem = ( ListItem_t * ) &( pxList->xListEnd );
+        }
+        #else
+        {
+            /* As listGET_OWNER_OF_NEXT_ENTRY(), from the task after the last
+             * one selected, so tasks of the same priority share the cores. */
+            pxItem = pxList->pxIndex;
+        }
+        #endif
+
+        while( ( pxReturn == NULL ) && ( uxItemsLeft > ( UBaseType_t ) 0U ) )
+        {
+            pxItem = listGET_NEXT( pxItem );
+
+            if( pxItem != ( ListItem_t * ) &( pxList->xListEnd ) )
+            {
+                TCB_t * const pxTCB = listGET_LIST_ITEM_OWNER( pxItem );
+
+                if( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) )
+                {
+                    pxReturn = pxTCB;
+
+                    #if ( configUSE_POLLING_SERVER == 0 ) || ( configUSE_APERIODIC_PREEMPTION == 1 )
+                    {
+                        pxList->pxIndex = pxItem;
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxItemsLeft--;
+            }
+        }
+
+        return pxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSelectHighestPriorityTaskForCore( BaseType_t xCoreID )
+    {
+        TCB_t * pxTCB = NULL;
+        TCB_t * const pxPrevious = pxCurrentTCBs[ xCoreID ];
+
+        /* The task the core ran so far can be selected by any core again. */
+        if( pxPrevious != NULL )
+        {
+            pxPrevious->xTaskRunState = taskTASK_NOT_RUNNING;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_POLLING_SERVER == 1 )
+        {
+            const ListItem_t * pxItem;
+            const ListItem_t * const pxEnd = listGET_END_MARKER( taskPERIODIC_READY_LIST( xCoreID ) );
+
+            /* The periodic tasks outrank the others.  The most urgent one is
+             * taken when it is free, which also drops the heap entries of the
+             * tasks that left the list with configUSE_READY_HEAP.  With
+             * configUSE_PARTITIONED_SCHEDULING the core only looks at its own
+             * list, whose head is only taken elsewhere while a split job moves
+             * between cores. */
+            pxItem = taskPERIODIC_READY_HEAD( xCoreID );
+
+            if( ( pxItem != pxEnd ) && taskCAN_RUN_ON_CORE( ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem ), xCoreID ) )
+            {
+                pxTCB = listGET_LIST_ITEM_OWNER( pxItem );
+                pxItem = pxEnd;
+            }
+            else
+            {
+                /* Otherwise the list is searched, all of it with
+                 * configUSE_READY_HEAP as the heap keeps the order then, not
+                 * the list. */
+                pxItem = listGET_HEAD_ENTRY( taskPERIODIC_READY_LIST( xCoreID ) );
+            }
+
+            for( ; pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+            {
+                TCB_t * const pxCandidate = listGET_LIST_ITEM_OWNER( pxItem );
+
+                if( taskCAN_RUN_ON_CORE( pxCandidate, xCoreID ) &&
+                    ( ( pxTCB == NULL ) || ( listGET_LIST_ITEM_VALUE( pxItem ) < listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) ) ) )
+                {
+                    pxTCB = pxCandidate;
+
+                    #if ( configUSE_READY_HEAP == 0 )
+                    {
+                        break;
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        #endif /* configUSE_POLLING_SERVER */
+
+        if( pxTCB == NULL )
+        {
+            UBaseType_t uxPriority = uxTopReadyPriority;
+            BaseType_t xTopFound = pdFALSE;
+
+            for( ; ; )
+            {
+                if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxPriority ] ) ) == pdFALSE )
+                {
+                    if( xTopFound == pdFALSE )
+                    {
+                        /* As in taskSELECT_HIGHEST_PRIORITY_TASK(). */
+                        uxTopReadyPriority = uxPriority;
+                        xTopFound = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxTCB = prvSelectFromReadyList( &( pxReadyTasksLists[ uxPriority ] ), xCoreID );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( ( pxTCB != NULL ) || ( uxPriority == ( UBaseType_t ) tskIDLE_PRIORITY ) )
+                {
+                    break;
+                }
+
+                --uxPriority;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* There is an idle task per core, so one of them is always free. */
+        configASSERT( pxTCB != NULL );
+
+        if( ( pxTCB->xLastRunCore != xCoreID ) && ( pxTCB->xLastRunCore != taskTASK_NOT_RUNNING ) )
+        {
+            ( pxTCB->uxMigrations )++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxTCB->xLastRunCore = xCoreID;
+        pxTCB->xTaskRunState = xCoreID;
+        pxCurrentTCBs[ xCoreID ] = pxTCB;
+
+        #if ( configUSE_TASK_SPLITTING == 1 )
+        {
+            /* A split job that moved on to its second core while it ran here
+             * can be taken by that core now. */
+            if( ( pxPrevious != NULL ) && ( pxPrevious != pxTCB ) && ( pxPrevious->xPartitionCore != xCoreID ) &&
+                ( listIS_CONTAINED_WITHIN( taskPERIODIC_READY_LIST( taskPARTITION_OF( pxPrevious ) ), &( pxPrevious->xStateListItem ) ) != pdFALSE ) )
+            {
+                prvYieldForTask( pxPrevious );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvTaskPrecedes( const TCB_t * const pxTCB,
+                                       const TCB_t * const pxOther )
+    {
+        BaseType_t xReturn;
+
+        #if ( configUSE_POLLING_SERVER == 1 )
+            #if ( configUSE_EDF_SCHEDULER == 1 )
+                if( taskHAS_ABSOLUTE_DEADLINE( pxTCB ) || taskHAS_ABSOLUTE_DEADLINE( pxOther ) )
+                {
+                    /* As taskEDF_PREEMPTS(). */
+                    xReturn = ( taskHAS_ABSOLUTE_DEADLINE( pxTCB ) &&
+                                ( ( taskHAS_ABSOLUTE_DEADLINE( pxOther ) == pdFALSE ) ||
+                                  ( taskEDF_KEY( pxTCB ) < taskEDF_KEY( pxOther ) ) ) ) ? pdTRUE : pdFALSE;
+                }
+            #else
+                if( taskIS_PERIODIC( pxTCB ) || taskIS_PERIODIC( pxOther ) )
+                {
+                    /* Rate monotonic, as taskPERIODIC_PREEMPTS(). */
+                    xReturn = ( taskIS_PERIODIC( pxTCB ) &&
+                                ( ( taskIS_PERIODIC( pxOther ) == pdFALSE ) ||
+                                  ( pxTCB->uxPeriod < pxOther->uxPeriod ) ) ) ? pdTRUE : pdFALSE;
+                }
+            #endif
+            else
+        #endif /* configUSE_POLLING_SERVER */
+        {
+            xReturn = ( pxTCB->uxPriority > pxOther->uxPriority ) ? pdTRUE : pdFALSE;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvYieldCore( BaseType_t xCoreID )
+    {
+        xYieldPendings[ xCoreID ] = pdTRUE;
+
+        if( xCoreID != portGET_CORE_ID() )
+        {
+            portYIELD_CORE( xCoreID );
+        }
+        else
+        {
+            /* The calling core switches when it leaves the critical section,
+             * see vTaskExitCritical(), or at the end of the interrupt. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvYieldForTask( const TCB_t * const pxTCB )
+    {
+        BaseType_t xCoreID;
+        BaseType_t xLeastUrgentCore = taskTASK_NOT_RUNNING;
+        const TCB_t * pxLeastUrgent = NULL;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( taskTASK_IS_RUNNING( pxTCB ) )
+            {
+                /* Put back in a ready list while it runs, after a priority
+                 * change for example, so its core selects again. */
+                prvYieldCore( pxTCB->xTaskRunState );
+            }
+            else
+            {
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    const TCB_t * const pxRunning = pxCurrentTCBs[ xCoreID ];
+
+                    if( taskMAY_RUN_ON_CORE( pxTCB, xCoreID ) == pdFALSE )
+                    {
+                        continue;
+                    }
+
+                    /* A core that is already to select again is left out, so
+                     * tasks made ready together preempt different cores. */
+                    if( ( pxRunning != NULL ) && ( xYieldPendings[ xCoreID ] == pdFALSE ) &&
+                        ( ( pxLeastUrgent == NULL ) || ( prvTaskPrecedes( pxLeastUrgent, pxRunning ) != pdFALSE ) ) )
+                    {
+                        pxLeastUrgent = pxRunning;
+                        xLeastUrgentCore = xCoreID;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( ( pxLeastUrgent != NULL ) && ( prvTaskPrecedes( pxTCB, pxLeastUrgent ) != pdFALSE ) )
+                {
+                    prvYieldCore( xLeastUrgentCore );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
+void vTaskSwitchContext( void )
+{
+    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+    {
+        /* The scheduler is currently suspended - do not allow a context
+         * switch. */
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xYieldPending = pdFALSE;
+        traceTASK_SWITCHED_OUT();
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+            #else
+                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+            #endif
+
+            /* Add the amount of time the task has been running to the
+             * accumulated time so far.  The time the task started running was
+             * stored in ulTaskSwitchedInTime.  Note that there is no overflow
+             * protection here so count values are only valid until the timer
+             * overflows.  The guard against negative values is to protect
+             * against suspect run time stat counter implementations - which
+             * are provided by the application, not the kernel. */
+            if( ulTotalRunTime > ulTaskSwitchedInTime )
+            {
+                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            ulTaskSwitchedInTime = ulTotalRunTime;
+        }
+        #endif /* configGENERATE_RUN_TIME_STATS */
+
+        /* Check for stack overflow, if configured. */
+        taskCHECK_FOR_STACK_OVERFLOW();
+
+        /* Before the currently running task is switched out, save its errno. */
+        #if ( configUSE_POSIX_ERRNO == 1 )
+        {
+            pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+        }
+        #endif
+
+        /* Select a new task to run using either the generic C or port
+         * optimised asm code. */
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            prvSelectHighestPriorityTaskForCore( portGET_CORE_ID() );
+        }
+        #elif ( configUSE_POLLING_SERVER ==  1 )
+        {
+            BaseType_t xViaServer = pdFALSE;
+
+            #if ( configUSE_APERIODIC_SERVER == 1 )
+            {
+                /* A job that blocked or deleted itself may have left the server
+                 * with nothing to do. */
+                prvServerUpdateReadyState();
+            }
+            #endif
+
+            if( listLIST_IS_EMPTY( &xReadyPeriodicTasksLists ) == pdFALSE )
+            {
+                pxCurrentTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( taskPERIODIC_READY_HEAD( 0 ) );
+
+                #if ( configUSE_APERIODIC_SERVER == 1 )
+                {
+                    if( pxCurrentTCB == NULL )
+                    {
+                        /* The server is the highest priority periodic entity -
+                         * run its most urgent job. */
+                        pxCurrentTCB = ( TCB_t * ) listGET_LIST_ITEM_OWNER( taskSERVER_JOB_HEAD() );
+                        xViaServer = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+            }
+            else
+            {
+                #if ( configUSE_APERIODIC_PREEMPTION == 1 )
+                    taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                #else // ( configUSE_APERIODIC_PREEMPTION == 1 )
+                    taskSELECT_OLD_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                #endif // ( configUSE_APERIODIC_PREEMPTION == 1 )
+            }
+
+            #if ( configUSE_STACK_RESOURCE_POLICY == 1 )
+            {
+                xViaServer = prvResourceCeilingSelect( xViaServer );
+            }
+            #endif
+
+            #if ( configUSE_APERIODIC_SERVER == 1 )
+            {
+                prvServerSetRunning( xViaServer );
+            }
+            #else
+            {
+                ( void ) xViaServer;
+            }
+            #endif
+        }
+        #else
+        {
+            taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        }
+        #endif // ( configNUMBER_OF_CORES > 1 )
+        traceTASK_SWITCHED_IN();
+
+        /* After the new task is switched in, update the global errno. */
+        #if ( configUSE_POSIX_ERRNO == 1 )
+        {
+            FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+        }
+        #endif
+
+        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        {
+            /* Switch C-Runtime's TLS Block to point to the TLS
+             * Block specific to this task. */
+            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+        }
+        #endif
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( List_t * const pxEventList,
+                            const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+    /* Place the event list item of the TCB in the appropriate event list.
+     * This is placed in the list in priority order so the highest priority task
+     * is the first to be woken by the event.
+     *
+     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
+     * Normally, the xItemValue of a TCB's ListItem_t members is:
+     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
+     * Therefore, the event list is sorted in descending priority order.
+     *
+     * The queue that contains the event list is locked, preventing
+     * simultaneous access from interrupts. */
+    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
+                                     const TickType_t xItemValue,
+                                     const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
      * the event groups implementation. */
     configASSERT( uxSchedulerSuspended != 0 );
 
-    /* Store the item value in the event list item.  It is safe to access the
-     * event list item here as interrupts won't access the event list item of a
-     * task that is not in the Blocked state. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+    /* Store the item value in the event list item.  It is safe to access the
+     * event list item here as interrupts won't access the event list item of a
+     * task that is not in the Blocked state. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Place the event list item of the TCB at the end of the appropriate event
+     * list.  It is safe to access the event list here because it is part of an
+     * event group implementation - and interrupts don't access event groups
+     * directly (instead they access them indirectly by pending function calls to
+     * the task level). */
+    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 )
+
+    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
+                                          TickType_t xTicksToWait,
+                                          const BaseType_t xWaitIndefinitely )
+    {
+        configASSERT( pxEventList );
+
+        /* This function should not be called by application code hence the
+         * 'Restricted' in its name.  It is not part of the public API.  It is
+         * designed for use by kernel code, and has special calling requirements -
+         * it should be called with the scheduler suspended. */
+
+
+        /* Place the event list item of the TCB in the appropriate event list.
+         * In this case it is assume that this is the only task that is going to
+         * be waiting on this event list, so the faster vListInsertEnd() function
+         * can be used in place of vListInsert. */
+        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+        /* If the task should block indefinitely then set the block time to a
+         * value that will be recognised as an indefinite delay inside the
+         * prvAddCurrentTaskToDelayedList() function. */
+        if( xWaitIndefinitely != pdFALSE )
+        {
+            xTicksToWait = portMAX_DELAY;
+        }
+
+        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
+        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+    }
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+    TCB_t * pxUnblockedTCB;
+    BaseType_t xReturn;
+
+    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+     * called from a critical section within an ISR. */
+
+    /* The event list is sorted in priority order, so the first in the list can
+     * be removed as it is known to be the highest priority.  Remove the TCB from
+     * the delayed list, and add it to the ready list.
+     *
+     * If an event is for a queue that is locked then this function will never
+     * get called - the lock count on the queue will get modified instead.  This
+     * means exclusive access to the event list is guaranteed here.
+     *
+     * This function assumes that a check has already been made to ensure that
+     * pxEventList is not empty. */
+    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+        prvAddTaskToReadyList( pxUnblockedTCB );
+
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+             * might be set to the blocked task's time out time.  If the task is
+             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+             * normally left unchanged, because it is automatically reset to a new
+             * value when the tick count equals xNextTaskUnblockTime.  However if
+             * tickless idling is used it might be more important to enter sleep mode
+             * at the earliest possible time - so reset xNextTaskUnblockTime here to
+             * ensure it is updated at the earliest possible time. */
+            prvResetNextTaskUnblockTime();
+        }
+        #endif
+    }
+    else
+    {
+        /* The delayed and ready lists cannot be accessed, so hold this task
+         * pending until the scheduler is resumed. */
+        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+    }
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        if( ( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority ) || taskEDF_PREEMPTS( pxUnblockedTCB ) )
+    #else
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #endif
+    {
+        /* Return true if the task removed from the event list has a higher
+         * priority than the calling task.  This allows the calling task to know if
+         * it should force a context switch now. */
+        xReturn = pdTRUE;
+
+        /* Mark that a yield is pending in case the user is not using the
+         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+        xYieldPending = pdTRUE;
+    }
+    else
+    {
+        xReturn = pdFALSE;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
+                                        const TickType_t xItemValue )
+{
+    TCB_t * pxUnblockedTCB;
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event flags implementation. */
+    configASSERT( uxSchedulerSuspended != pdFALSE );
+
+    /* Store the new item value in the event list. */
+    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Remove the event list form the event flag.  Interrupts do not access
+     * event flags. */
+    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( pxEventListItem );
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+    {
+        /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+         * might be set to the blocked task's time out time.  If the task is
+         * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+         * normally left unchanged, because it is automatically reset to a new
+         * value when the tick count equals xNextTaskUnblockTime.  However if
+         * tickless idling is used it might be more important to enter sleep mode
+         * at the earliest possible time - so reset xNextTaskUnblockTime here to
+         * ensure it is updated at the earliest possible time. */
+        prvResetNextTaskUnblockTime();
+    }
+    #endif
+
+    /* Remove the task from the delayed list and add it to the ready list.  The
+     * scheduler is suspended so interrupts will not be accessing the ready
+     * lists. */
+    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+    prvAddTaskToReadyList( pxUnblockedTCB );
+
+    #if ( configUSE_EDF_SCHEDULER == 1 )
+        if( ( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority ) || taskEDF_PREEMPTS( pxUnblockedTCB ) )
+    #else
+        if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    #endif
+    {
+        /* The unblocked task has a priority above that of the calling task, so
+         * a context switch is required.  This function is called with the
+         * scheduler suspended so xYieldPending is set so the context switch
+         * occurs immediately that the scheduler is resumed (unsuspended). */
+        xYieldPending = pdTRUE;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    configASSERT( pxTimeOut );
+    taskENTER_CRITICAL();
+    {
+        pxTimeOut->xOverflowCount = xNumOfOverflows;
+        pxTimeOut->xTimeOnEntering = xTickCount;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    /* For internal use only as it does not use a critical section. */
+    pxTimeOut->xOverflowCount = xNumOfOverflows;
+    pxTimeOut->xTimeOnEntering = xTickCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
+    BaseType_t xReturn;
+
+    configASSERT( pxTimeOut );
+    configASSERT( pxTicksToWait );
+
+    taskENTER_CRITICAL();
+    {
+        /* Minor optimisation.  The tick count cannot change in this block. */
+        const TickType_t xConstTickCount = xTickCount;
+        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+
+        #if ( INCLUDE_xTaskAbortDelay == 1 )
+            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+            {
+                /* The delay was aborted, which is not the same as a time out,
+                 * but has the same result. */
+                pxCurrentTCB->ucDelayAborted = pdFALSE;
+                xReturn = pdTRUE;
+            }
+            else
+        #endif
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            if( *pxTicksToWait == portMAX_DELAY )
+            {
+                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
+                 * specified is the maximum block time then the task should block
+                 * indefinitely, and therefore never time out. */
+                xReturn = pdFALSE;
+            }
+            else
+        #endif
+
+        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+        {
+            /* The tick count is greater than the time at which
+             * vTaskSetTimeout() was called, but has also overflowed since
+             * vTaskSetTimeOut() was called.  It must have wrapped all the way
+             * around and gone past again. This passed since vTaskSetTimeout()
+             * was called. */
+            xReturn = pdTRUE;
+            *pxTicksToWait = ( TickType_t ) 0;
+        }
+        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+        {
+            /* Not a genuine timeout. Adjust parameters for time remaining. */
+            *pxTicksToWait -= xElapsedTime;
+            vTaskInternalSetTimeOutState( pxTimeOut );
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            *pxTicksToWait = ( TickType_t ) 0;
+            xReturn = pdTRUE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskMissedYield( void )
+{
+    xYieldPending = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+    {
+        UBaseType_t uxReturn;
+        TCB_t const * pxTCB;
+
+        if( xTask != NULL )
+        {
+            pxTCB = xTask;
+            uxReturn = pxTCB->uxTaskNumber;
+        }
+        else
+        {
+            uxReturn = 0U;
+        }
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vTaskSetTaskNumber( TaskHandle_t xTask,
+                             const UBaseType_t uxHandle )
+    {
+        TCB_t * pxTCB;
+
+        if( xTask != NULL )
+        {
+            pxTCB = xTask;
+            pxTCB->uxTaskNumber = uxHandle;
+        }
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+
+/*
+ * -----------------------------------------------------------
+ * The Idle task.
+ * ----------------------------------------------------------
+ *
+ * The portTASK_FUNCTION() macro is used to allow port/compiler specific
+ * language extensions.  The equivalent prototype for this function is:
+ *
+ * void prvIdleTask( void *pvParameters );
+ *
+ */
+static portTASK_FUNCTION( prvIdleTask, pvParameters )
+{
+    /* Stop warnings. */
+    ( void ) pvParameters;
+
+    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
+     * SCHEDULER IS STARTED. **/
+
+    /* In case a task that has a secure context deletes itself, in which case
+     * the idle task is responsible for deleting the task's secure context, if
+     * any. */
+    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+
+    for( ; ; )
+    {
+        /* See if any tasks have deleted themselves - if so then the idle task
+         * is responsible for freeing the deleted task's TCB and stack. */
+        prvCheckTasksWaitingTermination();
+
+        #if ( configUSE_PREEMPTION == 0 )
+        {
+            /* If we are not using preemption we keep forcing a task switch to
+             * see if any other task has become available.  If we are using
+             * preemption we don't need to do this as any task becoming available
+             * will automatically get the processor anyway. */
+            taskYIELD();
+        }
+        #endif /* configUSE_PREEMPTION */
+
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+        {
+            /* When using preemption tasks of equal priority will be
+             * timesliced.  If a task that is sharing the idle priority is ready
+             * to run then the idle task should yield before the end of the
+             * timeslice.
+             *
+             * A critical region is not required here as we are just reading from
+             * the list, and an occasional incorrect value will not matter.  If
+             * the ready list at the idle priority contains more than one task
+             * then a task other than the idle task is ready to execute. */
+            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+            {
+                taskYIELD();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+        #if ( configUSE_IDLE_HOOK == 1 )
+        {
+            extern void vApplicationIdleHook( void );
+
+            /* Call the user defined function from within the idle task.  This
+             * allows the application designer to add background functionality
+             * without the overhead of a separate task.
+             * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
+             * CALL A FUNCTION THAT MIGHT BLOCK. */
+            vApplicationIdleHook();
+        }
+        #endif /* configUSE_IDLE_HOOK */
+
+        /* This conditional compilation should use inequality to 0, not equality
+         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
+         * user defined low power mode  implementations require
+         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            TickType_t xExpectedIdleTime;
+
+            /* It is not desirable to suspend then resume the scheduler on
+             * each iteration of the idle task.  Therefore, a preliminary
+             * test of the expected idle time is performed without the
+             * scheduler suspended.  The result here is not necessarily
+             * valid. */
+            xExpectedIdleTime = prvGetExpectedIdleTime();
+
+            if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+            {
+                vTaskSuspendAll();
+                {
+                    /* Now the scheduler is suspended, the expected idle
+                     * time can be sampled again, and this time its value can
+                     * be used. */
+                    configASSERT( xNextTaskUnblockTime >= xTickCount );
+                    xExpectedIdleTime = prvGetExpectedIdleTime();
+
+                    /* Define the following macro to set xExpectedIdleTime to 0
+                     * if the application does not want
+                     * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
+                    configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+
+                    if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+                    {
+                        traceLOW_POWER_IDLE_BEGIN();
+                        portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+                        traceLOW_POWER_IDLE_END();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TICKLESS_IDLE */
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+    {
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            /* The idle task exists in addition to the application tasks. */
+            const UBaseType_t uxNonApplicationTasks = 1;
+        #endif /* INCLUDE_vTaskSuspend */
+
+        eSleepModeStatus eReturn = eStandardSleep;
+
+        /* This function must be called from a critical section. */
+
+        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+        {
+            /* A task was made ready while the scheduler was suspended. */
+            eReturn = eAbortSleep;
+        }
+        else if( xYieldPending != pdFALSE )
+        {
+            /* A yield was pended while the scheduler was suspended. */
+            eReturn = eAbortSleep;
+        }
+        else if( xPendedTicks != 0 )
+        {
+            /* A tick interrupt has already occurred but was held pending
+             * because the scheduler is suspended. */
+            eReturn = eAbortSleep;
+        }
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            else if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            {
+                /* If all the tasks are in the suspended list (which might mean they
+                 * have an infinite block time rather than actually being suspended)
+                 * then it is safe to turn all clocks off and just wait for external
+                 * interrupts. */
+                eReturn = eNoTasksWaitingTimeout;
+            }
+        #endif /* INCLUDE_vTaskSuspend */
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return eReturn;
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
+                                            BaseType_t xIndex,
+                                            void * pvValue )
+    {
+        TCB_t * pxTCB;
+
+        if( ( xIndex >= 0 ) &&
+            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToSet );
+            configASSERT( pxTCB != NULL );
+            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+        }
+    }
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
+                                               BaseType_t xIndex )
+    {
+        void * pvReturn = NULL;
+        TCB_t * pxTCB;
+
+        if( ( xIndex >= 0 ) &&
+            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+        }
+        else
+        {
+            pvReturn = NULL;
+        }
+
+        return pvReturn;
+    }
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_MPU_WRAPPERS == 1 )
+
+    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
+                                  const MemoryRegion_t * const xRegions )
+    {
+        TCB_t * pxTCB;
+
+        /* If null is passed in here then we are modifying the MPU settings of
+         * the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTaskToModify );
+
+        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+    }
+
+#endif /* portUSING_MPU_WRAPPERS */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseTaskLists( void )
+{
+    UBaseType_t uxPriority;
+
+    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    {
+        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+    }
+
+    vListInitialise( &xDelayedTaskList1 );
+    vListInitialise( &xDelayedTaskList2 );
+    vListInitialise( &xPendingReadyList );
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+    {
+        vListInitialise( &xTasksWaitingTermination );
+    }
+    #endif /* INCLUDE_vTaskDelete */
+
+    #if ( INCLUDE_vTaskSuspend == 1 )
+    {
+        vListInitialise( &xSuspendedTaskList );
+    }
+    #endif /* INCLUDE_vTaskSuspend */
+
+    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+     * using list2. */
+    pxDelayedTaskList = &xDelayedTaskList1;
+    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+#if ( configUSE_POLLING_SERVER == 1 )
+    {
+        UBaseType_t uxList;
+
+        for( uxList = ( UBaseType_t ) 0U; uxList < ( UBaseType_t ) taskPERIODIC_READY_LISTS; uxList++ )
+        {
+            vListInitialise( taskPERIODIC_READY_LIST( uxList ) );
+
+            #if ( configUSE_READY_HEAP == 1 )
+            {
+                taskPERIODIC_READY_HEAP( uxList )->pxList = taskPERIODIC_READY_LIST( uxList );
+            }
+            #endif
+        }
+
+        vListInitialise( &xPendingPeriodicReadyList );
+
+        #if ( ( configUSE_READY_HEAP == 1 ) && ( configUSE_APERIODIC_SERVER == 1 ) )
+        {
+            xServerJobHeap.pxList = &( xAperiodicServer.xJobList );
+        }
+        #endif
+
+        #if ( INCLUDE_vTaskEndJob == 1 )
+        {
+            vListInitialise( &xPendingPeriodicReadyList2 );
+            pxPendingPeriodicList = &xPendingPeriodicReadyList;
+            pxOverflowPendingPeriodicList = &xPendingPeriodicReadyList2;
+        }
+        #endif
+
+        #if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+        {
+            vListInitialise( &xWaitingReleaseList );
+        }
+        #endif
+
+        #if ( configUSE_APERIODIC_JOBS == 1 )
+        {
+            vListInitialise( &( xJobQueue.xIdleWorkers ) );
+            vListInitialise( &( xJobQueue.xWakingWorkers ) );
+        }
+        #endif
+
+        #if ( configUSE_PARTITIONED_SCHEDULING == 1 )
+        {
+            for( uxList = ( UBaseType_t ) 0U; uxList < ( UBaseType_t ) configNUMBER_OF_CORES; uxList++ )
+            {
+                xCorePartitions[ uxList ].ulHyperbolicProduct = taskUTILISATION_ONE;
+            }
+        }
+        #endif
+    }
+#endif // ( configUSE_POLLING_SERVER == 1 )
+
+    #if ( configUSE_APERIODIC_SERVER == 1 )
+    {
+        vListInitialise( &( xAperiodicServer.xJobList ) );
+        vListInitialiseItem( &( xAperiodicServer.xServerListItem ) );
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+static void prvCheckTasksWaitingTermination( void )
+{
+    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+    {
+        TCB_t * pxTCB;
+
+        /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
+         * being called too often in the idle task. */
+        while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                #if ( configNUMBER_OF_CORES > 1 )
+                    if( taskTASK_IS_RUNNING( pxTCB ) )
+                    {
+                        /* The core that runs the task has yet to leave it. */
+                        pxTCB = NULL;
+                    }
+                    else
+                #endif
+                {
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    --uxCurrentNumberOfTasks;
+                    --uxDeletedTasksWaitingCleanUp;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( pxTCB == NULL )
+            {
+                break;
+            }
+
+            prvDeleteTCB( pxTCB );
+        }
+    }
+    #endif /* INCLUDE_vTaskDelete */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vTaskGetInfo( TaskHandle_t xTask,
+                       TaskStatus_t * pxTaskStatus,
+                       BaseType_t xGetFreeStackSpace,
+                       eTaskState eState )
+    {
+        TCB_t * pxTCB;
+
+        /* xTask is NULL then get the state of the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
+        pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
+        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+        pxTaskStatus->pxStackBase = pxTCB->pxStack;
+        #if ( ( portSTACK_GROWTH > 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+            pxTaskStatus->pxTopOfStack = pxTCB->pxTopOfStack;
+            pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
+        #endif
+        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+        }
+        #else
+        {
+            pxTaskStatus->uxBasePriority = 0;
+        }
+        #endif
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+        }
+        #else
+        {
+            pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+        }
+        #endif
+
+        /* Obtaining the task state is a little fiddly, so is only done if the
+         * value of eState passed into this function is eInvalid - otherwise the
+         * state is just set to whatever is passed in. */
+        if( eState != eInvalid )
+        {
+            if( taskTASK_IS_RUNNING( pxTCB ) )
+            {
+                pxTaskStatus->eCurrentState = eRunning;
+            }
+            else
+            {
+                pxTaskStatus->eCurrentState = eState;
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    /* If the task is in the suspended list then there is a
+                     *  chance it is actually just blocked indefinitely - so really
+                     *  it should be reported as being in the Blocked state. */
+                    if( eState == eSuspended )
+                    {
+                        vTaskSuspendAll();
+                        {
+                            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                            {
+                                pxTaskStatus->eCurrentState = eBlocked;
+                            }
+                        }
+                        ( void ) xTaskResumeAll();
+                    }
+                }
+                #endif /* INCLUDE_vTaskSuspend */
+            }
+        }
+        else
+        {
+            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+        }
+
+        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
+         * parameter is provided to allow it to be skipped. */
+        if( xGetFreeStackSpace != pdFALSE )
+        {
+            #if ( portSTACK_GROWTH > 0 )
+            {
+                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+            }
+            #else
+            {
+                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+            }
+            #endif
+        }
+        else
+        {
+            pxTaskStatus->usStackHighWaterMark = 0;
+        }
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                     List_t * pxList,
+                                                     eTaskState eState )
+    {
+        configLIST_VOLATILE TCB_t * pxNextTCB;
+        configLIST_VOLATILE TCB_t * pxFirstTCB;
+        UBaseType_t uxTask = 0;
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* Populate an TaskStatus_t structure within the
+             * pxTaskStatusArray array for each task that is referenced from
+             * pxList.  See the definition of TaskStatus_t in task.h for the
+             * meaning of each TaskStatus_t structure member. */
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+                uxTask++;
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+
+    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    {
+        uint32_t ulCount = 0U;
+
+        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        {
+            pucStackByte -= portSTACK_GROWTH;
+            ulCount++;
+        }
+
+        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+
+        return ( configSTACK_DEPTH_TYPE ) ulCount;
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+
+/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
+ * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
+ * user to determine the return type.  It gets around the problem of the value
+ * overflowing on 8-bit types without breaking backward compatibility for
+ * applications that expect an 8-bit return type. */
+    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        configSTACK_DEPTH_TYPE uxReturn;
+
+        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
+         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
+         * allows the user to determine the return type.  It gets around the
+         * problem of the value overflowing on 8-bit types without breaking
+         * backward compatibility for applications that expect an 8-bit return
+         * type. */
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        #if portSTACK_GROWTH < 0
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+        }
+        #else
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+        }
+        #endif
+
+        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+
+    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        uint8_t * pucEndOfStack;
+        UBaseType_t uxReturn;
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        #if portSTACK_GROWTH < 0
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+        }
+        #else
+        {
+            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+        }
+        #endif
+
+        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+    static void prvDeleteTCB( TCB_t * pxTCB )
+    {
+        /* This call is required specifically for the TriCore port.  It must be
+         * above the vPortFree() calls.  The call is also used by ports/demos that
+         * want to allocate and clean RAM statically. */
+        portCLEAN_UP_TCB( pxTCB );
+
+        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        {
+            /* Free up the memory allocated for the task's TLS Block. */
+            configDEINIT_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+        }
+        #endif
+
+        #if ( configUSE_TASK_POOL == 1 )
+        {
+            if( pxTCB->pxTaskPool != NULL )
+            {
+                /* Nothing was allocated for the task, the slot goes back to
+                 * its pool. */
+                taskENTER_CRITICAL();
+                {
+                    vListInsertEnd( &( pxTCB->pxTaskPool->xFreeSlots ), &( pxTCB->xStateListItem ) );
+                }
+                taskEXIT_CRITICAL();
+
+                return;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TASK_POOL */
+
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+        {
+            /* The task can only have been allocated dynamically - free both
+             * the stack and TCB. */
+            vPortFreeStack( pxTCB->pxStack );
+            vPortFree( pxTCB );
+        }
+        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+        {
+            /* The task could have been allocated statically or dynamically, so
+             * check what was statically allocated before trying to free the
+             * memory. */
+            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+            {
+                /* Both the stack and TCB were allocated dynamically, so both
+                 * must be freed. */
+                vPortFreeStack( pxTCB->pxStack );
+                vPortFree( pxTCB );
+            }
+            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+            {
+                /* Only the stack was statically allocated, so the TCB is the
+                 * only memory that must be freed. */
+                vPortFree( pxTCB );
+            }
+            else
+            {
+                /* Neither the stack nor the TCB were allocated dynamically, so
+                 * nothing needs to be freed. */
+                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+    }
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+    static void prvAddTaskToTerminationList( TCB_t * pxTCB )
+    {
+        #if ( configUSE_TASK_POOL == 1 )
+        {
+            if( pxTCB->pxTaskPool != NULL )
+            {
+                /* The next task created from the pool runs in place of this
+                 * one, so it can release the slot without the idle task. */
+                vListInsertEnd( &( pxTCB->pxTaskPool->xSlotsWaitingRelease ), &( pxTCB->xStateListItem ) );
+
+                return;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TASK_POOL */
+
+        vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+
+        /* Increment the ucTasksDeleted variable so the idle task knows
+         * there is a task that has been deleted and that it should therefore
+         * check the xTasksWaitingTermination list. */
+        ++uxDeletedTasksWaitingCleanUp;
+    }
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+static void prvResetNextTaskUnblockTime( void )
+{
+    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+    {
+        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+         * the maximum possible value so it is  extremely unlikely that the
+         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+         * there is an item in the delayed list. */
+        xNextTaskUnblockTime = portMAX_DELAY;
+    }
+    else
+    {
+        /* The new current delayed list is not empty, get the value of
+         * the item at the head of the delayed list.  This is the time at
+         * which the task at the head of the delayed list should be removed
+         * from the Blocked state. */
+        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskEndJob == 1 )
+
+    static void prvResetNextPeriodicReleaseTime( void )
+    {
+        if( listLIST_IS_EMPTY( pxPendingPeriodicList ) != pdFALSE )
+        {
+            xNextPeriodicReleaseTime = portMAX_DELAY;
+        }
+        else
+        {
+            xNextPeriodicReleaseTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxPendingPeriodicList );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReleaseJob( TCB_t * pxTCB,
+                               TickType_t xReleaseTime )
+    {
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            /* Longer deadlines cannot be keyed in the EDF ready list. */
+            configASSERT( taskRELATIVE_DEADLINE( pxTCB ) <= taskEDF_REBASE_INTERVAL );
+        }
+        #endif
+
+        pxTCB->xReleaseTime = xReleaseTime;
+        pxTCB->xAbsoluteDeadline = xReleaseTime + taskRELATIVE_DEADLINE( pxTCB );
+        ( pxTCB->uxJobNumber )++;
+
+        #if ( configUSE_TASK_SPLITTING == 1 )
+        {
+            /* Every job of a split task starts with its first share.  The
+             * task is not in a ready list when a job is released. */
+            pxTCB->xJobTicks = ( TickType_t ) 0U;
+
+            if( ( pxTCB->xSplitCore != taskTASK_NOT_RUNNING ) && ( pxTCB->xPartitionCore != pxTCB->xHomeCore ) )
+            {
+                prvSetPartitionCore( pxTCB, pxTCB->xHomeCore );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        traceTASK_JOB_RELEASED( pxTCB );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCheckDeadlineMiss( TCB_t * pxTCB,
+                                      TickType_t xTime )
+    {
+        if( ( taskHAS_ABSOLUTE_DEADLINE( pxTCB ) != pdFALSE ) &&
+            ( pxTCB->uxLastMissedJob != pxTCB->uxJobNumber ) &&
+            ( ( TickType_t ) ( xTime - pxTCB->xAbsoluteDeadline ) - ( TickType_t ) 1U < ( portMAX_DELAY >> 1 ) ) )
+        {
+            /* xTime is past the deadline. */
+            pxTCB->uxLastMissedJob = pxTCB->uxJobNumber;
+            ( pxTCB->uxDeadlineMisses )++;
+            traceTASK_DEADLINE_MISSED( pxTCB );
+
+            #if ( configUSE_DEADLINE_MISS_HOOK == 1 )
+            {
+                vApplicationDeadlineMissHook( pxTCB );
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvReleasePeriodicJobs( TickType_t xConstTickCount )
+    {
+        TCB_t * pxTCB;
+        TickType_t xItemValue;
+        BaseType_t xSwitchRequired = pdFALSE;
+
+        /* Pending tasks are stored in the order of their next release time,
+         * so once one task has been found whose release time has not been
+         * reached there is no need to look any further down the list. */
+        for( ; ; )
+        {
+            if( listLIST_IS_EMPTY( pxPendingPeriodicList ) != pdFALSE )
+            {
+                xNextPeriodicReleaseTime = portMAX_DELAY;
+                break;
+            }
+
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxPendingPeriodicList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+            if( xConstTickCount < xItemValue )
+            {
+                xNextPeriodicReleaseTime = xItemValue;
+                break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+            }
+
+            listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+            prvReleaseJob( pxTCB, xItemValue );
+            prvAddTaskToReadyList( pxTCB );
+
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                if( taskPERIODIC_PREEMPTS( pxTCB ) )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_PREEMPTION */
+        }
 
-    /* Place the event list item of the TCB at the end of the appropriate event
-     * list.  It is safe to access the event list here because it is part of an
-     * event group implementation - and interrupts don't access event groups
-     * directly (instead they access them indirectly by pending function calls to
-     * the task level). */
-    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        return xSwitchRequired;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskEndJob( void )
+    {
+        TCB_t * pxTCB;
+        TickType_t xNextRelease;
+        const TickType_t xConstTickCount = xTaskGetTickCount();
+
+        configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = pxCurrentTCB;
+            xNextRelease = pxTCB->xReleaseTime + pxTCB->uxPeriod;
+            prvCompleteJob( pxTCB, xConstTickCount );
+
+            if( ( TickType_t ) ( xConstTickCount - pxTCB->xReleaseTime ) >= pxTCB->uxPeriod )
+            {
+                /* The job overran its period, so the next job is already due.
+                 * Release it now, keeping the original release phase so the
+                 * task catches up rather than drifting. */
+                prvReleaseJob( pxTCB, xNextRelease );
+                prvAddTaskToReadyList( pxTCB );
+            }
+            else
+            {
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xNextRelease );
+
+                if( xNextRelease < xConstTickCount )
+                {
+                    /* The release time has overflowed the tick count. */
+                    vListInsert( pxOverflowPendingPeriodicList, &( pxTCB->xStateListItem ) );
+                }
+                else
+                {
+                    vListInsert( pxPendingPeriodicList, &( pxTCB->xStateListItem ) );
+
+                    if( xNextRelease < xNextPeriodicReleaseTime )
+                    {
+                        xNextPeriodicReleaseTime = xNextRelease;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        portYIELD_WITHIN_API();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCompleteJob( TCB_t * pxTCB,
+                                TickType_t xConstTickCount )
+    {
+        configASSERT( taskIS_PERIODIC( pxTCB ) );
+
+        pxTCB->xCompletionTime = xConstTickCount;
+        pxTCB->xResponseTime = xConstTickCount - pxTCB->xReleaseTime;
+        traceTASK_JOB_COMPLETED( pxTCB );
+        prvCheckDeadlineMiss( pxTCB, xConstTickCount );
+
+        #if ( configUSE_SCHEDULER_STATS == 1 )
+        {
+            prvRecordJobStats( pxTCB );
+        }
+        #endif
+
+        /* Remove the task from the ready list before adding it to the
+         * pending list as the same list item is used for both lists. */
+        ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskGetJobStatus( TaskHandle_t xTask,
+                            TaskJobStatus_t * pxJobStatus )
+    {
+        TCB_t * pxTCB;
+
+        configASSERT( pxJobStatus );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            pxJobStatus->uxJobNumber = pxTCB->uxJobNumber;
+            pxJobStatus->xReleaseTime = pxTCB->xReleaseTime;
+            pxJobStatus->xAbsoluteDeadline = pxTCB->xAbsoluteDeadline;
+            pxJobStatus->xCompletionTime = pxTCB->xCompletionTime;
+            pxJobStatus->xResponseTime = pxTCB->xResponseTime;
+            pxJobStatus->uxDeadlineMisses = pxTCB->uxDeadlineMisses;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* INCLUDE_vTaskEndJob */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+
+    void vTaskWaitForRelease( void )
+    {
+        TCB_t * pxTCB;
+        const TickType_t xConstTickCount = xTaskGetTickCount();
+
+        configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = pxCurrentTCB;
+            prvCompleteJob( pxTCB, xConstTickCount );
+
+            if( pxTCB->uxPendingReleases > ( UBaseType_t ) 0U )
+            {
+                /* The next job was released while this one was running. */
+                ( pxTCB->uxPendingReleases )--;
+                prvReleaseJob( pxTCB, xConstTickCount );
+                prvAddTaskToReadyList( pxTCB );
+            }
+            else
+            {
+                listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xConstTickCount );
+                vListInsertEnd( &xWaitingReleaseList, &( pxTCB->xStateListItem ) );
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        portYIELD_WITHIN_API();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskReleaseJobFromISR( TaskHandle_t xTaskToRelease,
+                                       BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        TCB_t * const pxTCB = xTaskToRelease;
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxTCB );
+        configASSERT( taskIS_PERIODIC( pxTCB ) );
+
+        /* See the comment on portASSERT_IF_INTERRUPT_PRIORITY_INVALID() in
+         * xTaskResumeFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            /* A task already in xPendingReadyList has been released and has
+             * yet to reach the ready list. */
+            if( ( listIS_CONTAINED_WITHIN( &xWaitingReleaseList, &( pxTCB->xStateListItem ) ) != pdFALSE ) &&
+                ( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL ) )
+            {
+                prvReleaseJob( pxTCB, xTickCount );
+
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        if( taskPERIODIC_PREEMPTS( pxTCB ) )
+                        {
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+
+                            /* Mark that a yield is pending in case the user is
+                             * not using the "xHigherPriorityTaskWoken"
+                             * parameter to an ISR safe FreeRTOS function. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_PREEMPTION */
+                }
+                else
+                {
+                    /* The ready lists cannot be accessed, xTaskResumeAll()
+                     * moves the task there. */
+                    vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
+
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                ( pxTCB->uxPendingReleases )++;
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* INCLUDE_xTaskReleaseJobFromISR */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SCHEDULER_STATS == 1 )
+
+    static void prvRecordJobStats( TCB_t * pxTCB )
+    {
+        configSCHEDULER_STATS_COUNTER_TYPE ulResponse;
+        int64_t llLateness;
+
+        /* Whole ticks since the release, plus the time since the last tick.
+         * xTickCount and ulTickStatsTime cannot change in the critical
+         * section, so they always refer to the same tick. */
+        ulResponse = ( configSCHEDULER_STATS_COUNTER_TYPE ) ( ( configSCHEDULER_STATS_COUNTER_TYPE ) ( xTickCount - pxTCB->xReleaseTime ) * ( configSCHEDULER_STATS_COUNTER_TYPE ) configSCHEDULER_STATS_COUNTS_PER_TICK );
+        ulResponse += ( configSCHEDULER_STATS_COUNTER_TYPE ) ( portGET_SCHEDULER_STATS_TIME() - ulTickStatsTime );
+        llLateness = ( int64_t ) ulResponse - ( ( int64_t ) taskRELATIVE_DEADLINE( pxTCB ) * ( int64_t ) configSCHEDULER_STATS_COUNTS_PER_TICK );
+
+        if( pxTCB->uxCompletedJobs == ( UBaseType_t ) 0U )
+        {
+            pxTCB->ulBestResponse = ulResponse;
+            pxTCB->ulWorstResponse = ulResponse;
+            pxTCB->llWorstLateness = llLateness;
+        }
+        else
+        {
+            if( ulResponse < pxTCB->ulBestResponse )
+            {
+                pxTCB->ulBestResponse = ulResponse;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ulResponse > pxTCB->ulWorstResponse )
+            {
+                pxTCB->ulWorstResponse = ulResponse;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( llLateness > pxTCB->llWorstLateness )
+            {
+                pxTCB->llWorstLateness = llLateness;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        ( pxTCB->uxCompletedJobs )++;
+        pxTCB->ullTotalResponse += ( uint64_t ) ulResponse;
+        pxTCB->llTotalLateness += llLateness;
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvListSchedulerStatsWithinSingleList( TaskSchedulerStats_t * pxStatsArray,
+                                                              UBaseType_t uxArraySize,
+                                                              List_t * pxList )
+    {
+        const ListItem_t * pxEndMarker = listGET_END_MARKER( pxList );
+        ListItem_t * pxIterator;
+        TCB_t * pxTCB;
+        TaskSchedulerStats_t * pxStats;
+        UBaseType_t uxTask = 0;
+        uint64_t ullTotalResponse;
+        int64_t llTotalLateness;
+
+        for( pxIterator = listGET_HEAD_ENTRY( pxList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            if( ( taskIS_PERIODIC( pxTCB ) ) && ( uxTask < uxArraySize ) )
+            {
+                pxStats = &( pxStatsArray[ uxTask ] );
+                pxStats->xHandle = ( TaskHandle_t ) pxTCB;
+                pxStats->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
+
+                /* The tick interrupt counts misses, so only the copy is done
+                 * with interrupts disabled. */
+                taskENTER_CRITICAL();
+                {
+                    pxStats->uxReleasedJobs = pxTCB->uxJobNumber;
+                    pxStats->uxCompletedJobs = pxTCB->uxCompletedJobs;
+                    pxStats->uxDeadlineMisses = pxTCB->uxDeadlineMisses;
+                    pxStats->ulBestResponse = pxTCB->ulBestResponse;
+                    pxStats->ulWorstResponse = pxTCB->ulWorstResponse;
+                    pxStats->llWorstLateness = pxTCB->llWorstLateness;
+                    ullTotalResponse = pxTCB->ullTotalResponse;
+                    llTotalLateness = pxTCB->llTotalLateness;
+                }
+                taskEXIT_CRITICAL();
+
+                if( pxStats->uxCompletedJobs > ( UBaseType_t ) 0U )
+                {
+                    pxStats->ulAverageResponse = ( configSCHEDULER_STATS_COUNTER_TYPE ) ( ullTotalResponse / ( uint64_t ) pxStats->uxCompletedJobs );
+                    pxStats->llAverageLateness = llTotalLateness / ( int64_t ) pxStats->uxCompletedJobs;
+                }
+                else
+                {
+                    pxStats->ulAverageResponse = 0;
+                    pxStats->llAverageLateness = 0;
+                }
+
+                uxTask++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return uxTask;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskGetSchedulerStats( TaskSchedulerStats_t * const pxStatsArray,
+                                         const UBaseType_t uxArraySize )
+    {
+        UBaseType_t uxTask = 0;
+        UBaseType_t uxList;
+
+        configASSERT( pxStatsArray );
+
+        /* With the scheduler suspended no task can change list, as the tick
+         * and any task readied from an interrupt are held pending, so every
+         * periodic task is found exactly once. */
+        vTaskSuspendAll();
+        {
+            for( uxList = ( UBaseType_t ) 0U; uxList < ( UBaseType_t ) taskPERIODIC_READY_LISTS; uxList++ )
+            {
+                uxTask += prvListSchedulerStatsWithinSingleList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, taskPERIODIC_READY_LIST( uxList ) );
+            }
+
+            uxTask += prvListSchedulerStatsWithinSingleList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, ( List_t * ) pxPendingPeriodicList );
+            uxTask += prvListSchedulerStatsWithinSingleList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, ( List_t * ) pxOverflowPendingPeriodicList );
+            uxTask += prvListSchedulerStatsWithinSingleList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, ( List_t * ) pxDelayedTaskList );
+            uxTask += prvListSchedulerStatsWithinSingleList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, ( List_t * ) pxOverflowDelayedTaskList );
+
+            #if ( INCLUDE_xTaskReleaseJobFromISR == 1 )
+            {
+                uxTask += prvListSchedulerStatsWithinSingleList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, &xWaitingReleaseList );
+            }
+            #endif
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+            {
+                uxTask += prvListSchedulerStatsWithinSingleList( &( pxStatsArray[ uxTask ] ), uxArraySize - uxTask, &xSuspendedTaskList );
+            }
+            #endif
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxTask;
+    }
+
+#endif /* configUSE_SCHEDULER_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_BUFFER == 1 )
+
+    static void prvTraceBufferRecord( uint32_t ulEvent,
+                                      const TCB_t * pxTCB,
+                                      uint32_t ulArgument )
+    {
+        const uint32_t ulHead = xTraceBuffer.ulHead;
+        uint32_t ulTaskNumber = 0U;
+
+        if( pxTCB != NULL )
+        {
+            ulTaskNumber = ( uint32_t ) pxTCB->uxTCBNumber;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xTraceBuffer.ullEvents[ ulHead & ( uint32_t ) ( configTRACE_BUFFER_LENGTH - 1 ) ] =
+            ( ( uint64_t ) ( uint32_t ) portGET_TRACE_BUFFER_TIME() << 32 ) |
+            ( uint64_t ) ( ( ( ulEvent & 0xFFUL ) << 24 ) | ( ( ulTaskNumber & 0xFFUL ) << 16 ) | ( ulArgument & 0xFFFFUL ) );
+        xTraceBuffer.ulHead = ulHead + 1U;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTraceBufferCreate( const TCB_t * pxNewTCB )
+    {
+        char * pcName = xTraceBuffer.cTaskNames[ pxNewTCB->uxTCBNumber % ( UBaseType_t ) configTRACE_BUFFER_MAX_TASKS ];
+        UBaseType_t x;
+
+        for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+        {
+            pcName[ x ] = pxNewTCB->pcTaskName[ x ];
+        }
+
+        prvTraceBufferRecord( taskTRACE_EVENT_CREATE, pxNewTCB, ( uint32_t ) pxNewTCB->uxPriority );
+    }
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
+#endif /* configUSE_TRACE_BUFFER */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TIMERS == 1 )
+#if ( configUSE_EDF_SCHEDULER == 1 )
 
-    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
-                                          TickType_t xTicksToWait,
-                                          const BaseType_t xWaitIndefinitely )
+    static void prvEDFRebase( void )
     {
-        configASSERT( pxEventList );
+        ListItem_t * pxItem;
+        UBaseType_t uxList;
 
-        /* This function should not be called by application code hence the
-         * 'Restricted' in its name.  It is not part of the public API.  It is
-         * designed for use by kernel code, and has special calling requirements -
-         * it should be called with the scheduler suspended. */
+        /* Subtracting the same amount from every key, with deadlines that are
+         * already past clamped to 0, keeps the keys in the same order, so the
+         * lists do not need to be sorted again. */
+        for( uxList = ( UBaseType_t ) 0U; uxList < ( UBaseType_t ) taskPERIODIC_READY_LISTS; uxList++ )
+        {
+            const ListItem_t * const pxEnd = listGET_END_MARKER( taskPERIODIC_READY_LIST( uxList ) );
 
+            for( pxItem = listGET_HEAD_ENTRY( taskPERIODIC_READY_LIST( uxList ) ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+            {
+                if( listGET_LIST_ITEM_VALUE( pxItem ) > taskEDF_REBASE_INTERVAL )
+                {
+                    listSET_LIST_ITEM_VALUE( pxItem, listGET_LIST_ITEM_VALUE( pxItem ) - taskEDF_REBASE_INTERVAL );
+                }
+                else
+                {
+                    listSET_LIST_ITEM_VALUE( pxItem, ( TickType_t ) 0U );
+                }
+            }
 
-        /* Place the event list item of the TCB in the appropriate event list.
-         * In this case it is assume that this is the only task that is going to
-         * be waiting on this event list, so the faster vListInsertEnd() function
-         * can be used in place of vListInsert. */
-        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+            #if ( configUSE_READY_HEAP == 1 )
+            {
+                ReadyHeap_t * const pxHeap = taskPERIODIC_READY_HEAP( uxList );
+                UBaseType_t ux;
 
-        /* If the task should block indefinitely then set the block time to a
-         * value that will be recognised as an indefinite delay inside the
-         * prvAddCurrentTaskToDelayedList() function. */
-        if( xWaitIndefinitely != pdFALSE )
-        {
-            xTicksToWait = portMAX_DELAY;
+                for( ux = ( UBaseType_t ) 0U; ux < pxHeap->uxCount; ux++ )
+                {
+                    if( pxHeap->xEntries[ ux ].xKey > taskEDF_REBASE_INTERVAL )
+                    {
+                        pxHeap->xEntries[ ux ].xKey -= taskEDF_REBASE_INTERVAL;
+                    }
+                    else
+                    {
+                        pxHeap->xEntries[ ux ].xKey = ( TickType_t ) 0U;
+                    }
+                }
+            }
+            #endif /* configUSE_READY_HEAP */
         }
 
-        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
-        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+        xEDFTimeBase += taskEDF_REBASE_INTERVAL;
     }
 
-#endif /* configUSE_TIMERS */
+#endif /* configUSE_EDF_SCHEDULER */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
-{
-    TCB_t * pxUnblockedTCB;
-    BaseType_t xReturn;
+#if ( configUSE_READY_HEAP == 1 )
 
-    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
-     * called from a critical section within an ISR. */
+    static UBaseType_t * prvReadyHeapIndexOf( const ListItem_t * pxItem )
+    {
+        UBaseType_t * puxIndex;
+        TCB_t * pxTCB = listGET_LIST_ITEM_OWNER( pxItem );
 
-    /* The event list is sorted in priority order, so the first in the list can
-     * be removed as it is known to be the highest priority.  Remove the TCB from
-     * the delayed list, and add it to the ready list.
-     *
-     * If an event is for a queue that is locked then this function will never
-     * get called - the lock count on the queue will get modified instead.  This
-     * means exclusive access to the event list is guaranteed here.
-     *
-     * This function assumes that a check has already been made to ensure that
-     * pxEventList is not empty. */
-    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+        #if ( configUSE_APERIODIC_SERVER == 1 )
+            if( pxTCB == NULL )
+            {
+                /* Only the server's list item has no owner. */
+                puxIndex = &( xAperiodicServer.uxReadyHeapIndex );
+            }
+            else
+        #endif
+        {
+            puxIndex = &( pxTCB->uxReadyHeapIndex );
+        }
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        return puxIndex;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvReadyHeapLess( const ReadyHeapEntry_t * pxA,
+                                        const ReadyHeapEntry_t * pxB )
     {
-        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-        prvAddTaskToReadyList( pxUnblockedTCB );
+        BaseType_t xReturn;
 
-        #if ( configUSE_TICKLESS_IDLE != 0 )
+        if( pxA->xKey != pxB->xKey )
         {
-            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-             * might be set to the blocked task's time out time.  If the task is
-             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-             * normally left unchanged, because it is automatically reset to a new
-             * value when the tick count equals xNextTaskUnblockTime.  However if
-             * tickless idling is used it might be more important to enter sleep mode
-             * at the earliest possible time - so reset xNextTaskUnblockTime here to
-             * ensure it is updated at the earliest possible time. */
-            prvResetNextTaskUnblockTime();
+            xReturn = ( pxA->xKey < pxB->xKey ) ? pdTRUE : pdFALSE;
         }
-        #endif
+        else
+        {
+            /* The difference is taken so the comparison survives the sequence
+             * number wrapping. */
+            xReturn = ( ( BaseType_t ) ( pxA->uxOrder - pxB->uxOrder ) < 0 ) ? pdTRUE : pdFALSE;
+        }
+
+        return xReturn;
     }
-    else
+/*-----------------------------------------------------------*/
+
+    static void prvReadyHeapPlace( ReadyHeap_t * pxHeap,
+                                   UBaseType_t uxIndex,
+                                   const ReadyHeapEntry_t * pxEntry )
     {
-        /* The delayed and ready lists cannot be accessed, so hold this task
-         * pending until the scheduler is resumed. */
-        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+        pxHeap->xEntries[ uxIndex ] = *pxEntry;
+        *prvReadyHeapIndexOf( pxEntry->pxItem ) = uxIndex;
     }
+/*-----------------------------------------------------------*/
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    static void prvReadyHeapSift( ReadyHeap_t * pxHeap,
+                                  UBaseType_t uxIndex )
     {
-        /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
-        xReturn = pdTRUE;
+        ReadyHeapEntry_t xEntry = pxHeap->xEntries[ uxIndex ];
+        UBaseType_t uxParent, uxChild;
 
-        /* Mark that a yield is pending in case the user is not using the
-         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-        xYieldPending = pdTRUE;
+        /* Move the entry up while it is smaller than its parent... */
+        while( uxIndex > ( UBaseType_t ) 0U )
+        {
+            uxParent = ( uxIndex - ( UBaseType_t ) 1U ) / ( UBaseType_t ) 2U;
+
+            if( prvReadyHeapLess( &xEntry, &( pxHeap->xEntries[ uxParent ] ) ) == pdFALSE )
+            {
+                break;
+            }
+
+            prvReadyHeapPlace( pxHeap, uxIndex, &( pxHeap->xEntries[ uxParent ] ) );
+            uxIndex = uxParent;
+        }
+
+        /* ...then down while one of its children is smaller than it. */
+        for( ; ; )
+        {
+            uxChild = ( uxIndex * ( UBaseType_t ) 2U ) + ( UBaseType_t ) 1U;
+
+            if( uxChild >= pxHeap->uxCount )
+            {
+                break;
+            }
+
+            if( ( ( uxChild + ( UBaseType_t ) 1U ) < pxHeap->uxCount ) &&
+                ( prvReadyHeapLess( &( pxHeap->xEntries[ uxChild + ( UBaseType_t ) 1U ] ), &( pxHeap->xEntries[ uxChild ] ) ) != pdFALSE ) )
+            {
+                uxChild++;
+            }
+
+            if( prvReadyHeapLess( &( pxHeap->xEntries[ uxChild ] ), &xEntry ) == pdFALSE )
+            {
+                break;
+            }
+
+            prvReadyHeapPlace( pxHeap, uxIndex, &( pxHeap->xEntries[ uxChild ] ) );
+            uxIndex = uxChild;
+        }
+
+        prvReadyHeapPlace( pxHeap, uxIndex, &xEntry );
     }
-    else
+/*-----------------------------------------------------------*/
+
+    static void prvReadyHeapRemoveAt( ReadyHeap_t * pxHeap,
+                                      UBaseType_t uxIndex )
     {
-        xReturn = pdFALSE;
+        ( pxHeap->uxCount )--;
+
+        if( uxIndex != pxHeap->uxCount )
+        {
+            prvReadyHeapPlace( pxHeap, uxIndex, &( pxHeap->xEntries[ pxHeap->uxCount ] ) );
+            prvReadyHeapSift( pxHeap, uxIndex );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
+/*-----------------------------------------------------------*/
 
-    return xReturn;
-}
+    static void prvReadyHeapInsert( ReadyHeap_t * pxHeap,
+                                    ListItem_t * pxItem )
+    {
+        ReadyHeapEntry_t xEntry;
+        UBaseType_t uxIndex = *prvReadyHeapIndexOf( pxItem );
+
+        xEntry.pxItem = pxItem;
+        xEntry.xKey = listGET_LIST_ITEM_VALUE( pxItem );
+        xEntry.uxOrder = pxHeap->uxNextOrder;
+        ( pxHeap->uxNextOrder )++;
+
+        if( ( uxIndex < pxHeap->uxCount ) && ( pxHeap->xEntries[ uxIndex ].pxItem == pxItem ) )
+        {
+            /* The item still has the stale entry from when it was last in the
+             * list - reuse it. */
+            pxHeap->xEntries[ uxIndex ] = xEntry;
+        }
+        else
+        {
+            /* configREADY_HEAP_LENGTH must be at least the number of tasks that
+             * can be in this list, plus one for the server. */
+            configASSERT( pxHeap->uxCount < ( UBaseType_t ) configREADY_HEAP_LENGTH );
+
+            uxIndex = pxHeap->uxCount;
+            ( pxHeap->uxCount )++;
+            pxHeap->xEntries[ uxIndex ] = xEntry;
+        }
+
+        prvReadyHeapSift( pxHeap, uxIndex );
+    }
 /*-----------------------------------------------------------*/
 
-void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
-                                        const TickType_t xItemValue )
-{
-    TCB_t * pxUnblockedTCB;
+    static ListItem_t * prvReadyHeapPeek( ReadyHeap_t * pxHeap )
+    {
+        ListItem_t * pxItem;
 
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event flags implementation. */
-    configASSERT( uxSchedulerSuspended != pdFALSE );
+        for( ; ; )
+        {
+            if( pxHeap->uxCount == ( UBaseType_t ) 0U )
+            {
+                pxItem = ( ListItem_t * ) listGET_END_MARKER( pxHeap->pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+                break;
+            }
 
-    /* Store the new item value in the event list. */
-    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+            pxItem = pxHeap->xEntries[ 0 ].pxItem;
 
-    /* Remove the event list form the event flag.  Interrupts do not access
-     * event flags. */
-    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( pxEventListItem );
+            if( listIS_CONTAINED_WITHIN( pxHeap->pxList, pxItem ) != pdFALSE )
+            {
+                break;
+            }
 
-    #if ( configUSE_TICKLESS_IDLE != 0 )
+            /* The item left the list since it was inserted. */
+            prvReadyHeapRemoveAt( pxHeap, ( UBaseType_t ) 0U );
+        }
+
+        return pxItem;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReadyHeapRemove( ReadyHeap_t * pxHeap,
+                                    const ListItem_t * pxItem )
     {
-        /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-         * might be set to the blocked task's time out time.  If the task is
-         * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-         * normally left unchanged, because it is automatically reset to a new
-         * value when the tick count equals xNextTaskUnblockTime.  However if
-         * tickless idling is used it might be more important to enter sleep mode
-         * at the earliest possible time - so reset xNextTaskUnblockTime here to
-         * ensure it is updated at the earliest possible time. */
-        prvResetNextTaskUnblockTime();
+        const UBaseType_t uxIndex = *prvReadyHeapIndexOf( pxItem );
+
+        if( ( uxIndex < pxHeap->uxCount ) && ( pxHeap->xEntries[ uxIndex ].pxItem == pxItem ) )
+        {
+            prvReadyHeapRemoveAt( pxHeap, uxIndex );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
-    #endif
 
-    /* Remove the task from the delayed list and add it to the ready list.  The
-     * scheduler is suspended so interrupts will not be accessing the ready
-     * lists. */
-    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-    prvAddTaskToReadyList( pxUnblockedTCB );
+#endif /* configUSE_READY_HEAP */
+/*-----------------------------------------------------------*/
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+#if ( configUSE_ADMISSION_CONTROL == 1 )
+
+    static BaseType_t prvAdmitTask( BaseType_t xPeriodic,
+                                    TickType_t xDuration,
+                                    TickType_t xInterval,
+                                    uint32_t * pulLoad )
     {
-        /* The unblocked task has a priority above that of the calling task, so
-         * a context switch is required.  This function is called with the
-         * scheduler suspended so xYieldPending is set so the context switch
-         * occurs immediately that the scheduler is resumed (unsuspended). */
-        xYieldPending = pdTRUE;
+        BaseType_t xReturn = errSCHEDULE_NOT_ADMITTED;
+        uint32_t ulUtilisation;
+
+        *pulLoad = 0U;
+
+        if( xDuration == ( TickType_t ) 0U )
+        {
+            /* Nothing is known about the execution time, so there is nothing
+             * to account for. */
+            xReturn = pdPASS;
+        }
+        else if( ( xInterval == ( TickType_t ) 0U ) || ( xDuration > xInterval ) )
+        {
+            /* The job cannot complete within its own period or deadline. */
+            mtCOVERAGE_TEST_MARKER();
+        }
+        else
+        {
+            ulUtilisation = taskUTILISATION( xDuration, xInterval );
+
+            taskENTER_CRITICAL();
+            {
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* Under EDF the density of an aperiodic job counts towards
+                     * the same bound as the utilisation of the periodic tasks. */
+                    ( void ) xPeriodic;
+
+                    if( prvUtilisationFits( ulUtilisation ) != pdFALSE )
+                    {
+                        prvAddUtilisation( ulUtilisation );
+                        *pulLoad = ulUtilisation;
+                        xReturn = pdPASS;
+                    }
+                }
+                #else /* configUSE_EDF_SCHEDULER */
+                {
+                    if( xPeriodic != pdFALSE )
+                    {
+                        if( prvUtilisationFits( ulUtilisation ) != pdFALSE )
+                        {
+                            prvAddUtilisation( ulUtilisation );
+                            *pulLoad = ulUtilisation;
+                            xReturn = pdPASS;
+                        }
+                    }
+                    else
+                    {
+                        #if ( configUSE_APERIODIC_SERVER == 1 )
+                        {
+                            const AperiodicServer_t * const pxServer = &xAperiodicServer;
+
+                            if( pxServer->xPeriod == ( TickType_t ) 0U )
+                            {
+                                /* No server yet, so the task runs in the
+                                 * background and nothing is guaranteed. */
+                                xReturn = pdPASS;
+                            }
+                            else if( ( xAdmissionControl.xServerBacklog + xDuration ) <= ( ( xInterval / pxServer->xPeriod ) * pxServer->xCapacity ) )
+                            {
+                                /* The queued work and the new job fit in the
+                                 * capacity of the server periods that end
+                                 * before the deadline. */
+                                xAdmissionControl.xServerBacklog += xDuration;
+                                *pulLoad = ( uint32_t ) xDuration;
+                                xReturn = pdPASS;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #else
+                        {
+                            /* Aperiodic tasks only use the time the periodic
+                             * tasks leave, so they cannot make them miss. */
+                            xReturn = pdPASS;
+                        }
+                        #endif /* configUSE_APERIODIC_SERVER */
+                    }
+                }
+                #endif /* configUSE_EDF_SCHEDULER */
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        return xReturn;
     }
-}
 /*-----------------------------------------------------------*/
 
-void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    configASSERT( pxTimeOut );
-    taskENTER_CRITICAL();
+    static void prvAdmissionRelease( BaseType_t xPeriodic,
+                                     uint32_t ulLoad )
     {
-        pxTimeOut->xOverflowCount = xNumOfOverflows;
-        pxTimeOut->xTimeOnEntering = xTickCount;
+        #if ( ( configUSE_APERIODIC_SERVER == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
+        {
+            if( xPeriodic == pdFALSE )
+            {
+                xAdmissionControl.xServerBacklog -= ( TickType_t ) ulLoad;
+            }
+            else
+            {
+                prvRemoveUtilisation( ulLoad );
+            }
+        }
+        #else
+        {
+            /* Aperiodic tasks only hold a utilisation under EDF, and no load
+             * at all otherwise. */
+            ( void ) xPeriodic;
+            prvRemoveUtilisation( ulLoad );
+        }
+        #endif
     }
-    taskEXIT_CRITICAL();
-}
-/*-----------------------------------------------------------*/
-
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    /* For internal use only as it does not use a critical section. */
-    pxTimeOut->xOverflowCount = xNumOfOverflows;
-    pxTimeOut->xTimeOnEntering = xTickCount;
-}
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
-                                 TickType_t * const pxTicksToWait )
-{
-    BaseType_t xReturn;
-
-    configASSERT( pxTimeOut );
-    configASSERT( pxTicksToWait );
-
-    taskENTER_CRITICAL();
+    static BaseType_t prvUtilisationFits( uint32_t ulUtilisation )
     {
-        /* Minor optimisation.  The tick count cannot change in this block. */
-        const TickType_t xConstTickCount = xTickCount;
-        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+        BaseType_t xReturn;
 
-        #if ( INCLUDE_xTaskAbortDelay == 1 )
-            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            xReturn = ( ( xAdmissionControl.ulUtilisation + ulUtilisation ) <= taskUTILISATION_ONE ) ? pdTRUE : pdFALSE;
+        }
+        #elif ( configADMISSION_RM_TEST == tskADMISSION_LIU_LAYLAND )
+        {
+            const UBaseType_t uxTasks = xAdmissionControl.uxAdmittedTasks + ( UBaseType_t ) 1U;
+            uint32_t ulBound;
+
+            if( uxTasks <= ( UBaseType_t ) ( sizeof( ulLiuLaylandBound ) / sizeof( ulLiuLaylandBound[ 0 ] ) ) )
             {
-                /* The delay was aborted, which is not the same as a time out,
-                 * but has the same result. */
-                pxCurrentTCB->ucDelayAborted = pdFALSE;
-                xReturn = pdTRUE;
+                ulBound = ulLiuLaylandBound[ uxTasks - ( UBaseType_t ) 1U ];
             }
             else
-        #endif
-
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            if( *pxTicksToWait == portMAX_DELAY )
             {
-                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
-                 * specified is the maximum block time then the task should block
-                 * indefinitely, and therefore never time out. */
-                xReturn = pdFALSE;
+                ulBound = taskLIU_LAYLAND_LIMIT;
             }
-            else
-        #endif
 
-        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+            xReturn = ( ( xAdmissionControl.ulUtilisation + ulUtilisation ) <= ulBound ) ? pdTRUE : pdFALSE;
+        }
+        #else /* tskADMISSION_HYPERBOLIC */
         {
-            /* The tick count is greater than the time at which
-             * vTaskSetTimeout() was called, but has also overflowed since
-             * vTaskSetTimeOut() was called.  It must have wrapped all the way
-             * around and gone past again. This passed since vTaskSetTimeout()
-             * was called. */
-            xReturn = pdTRUE;
-            *pxTicksToWait = ( TickType_t ) 0;
+            const uint64_t ullProduct = ( uint64_t ) xAdmissionControl.ulHyperbolicProduct * ( uint64_t ) ( taskUTILISATION_ONE + ulUtilisation );
+
+            xReturn = ( ullProduct <= ( ( uint64_t ) 2U * taskUTILISATION_ONE * taskUTILISATION_ONE ) ) ? pdTRUE : pdFALSE;
         }
-        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+        #endif /* configUSE_EDF_SCHEDULER */
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddUtilisation( uint32_t ulUtilisation )
+    {
+        if( ulUtilisation != 0U )
         {
-            /* Not a genuine timeout. Adjust parameters for time remaining. */
-            *pxTicksToWait -= xElapsedTime;
-            vTaskInternalSetTimeOutState( pxTimeOut );
-            xReturn = pdFALSE;
+            xAdmissionControl.ulUtilisation += ulUtilisation;
+            xAdmissionControl.uxAdmittedTasks++;
+
+            /* Rounded up like the utilisations themselves. */
+            xAdmissionControl.ulHyperbolicProduct = ( uint32_t ) ( ( ( uint64_t ) xAdmissionControl.ulHyperbolicProduct * ( uint64_t ) ( taskUTILISATION_ONE + ulUtilisation ) + ( uint64_t ) ( taskUTILISATION_ONE - 1U ) ) >> 16 );
         }
         else
         {
-            *pxTicksToWait = ( TickType_t ) 0;
-            xReturn = pdTRUE;
+            mtCOVERAGE_TEST_MARKER();
         }
     }
-    taskEXIT_CRITICAL();
-
-    return xReturn;
-}
 /*-----------------------------------------------------------*/
 
-void vTaskMissedYield( void )
-{
-    xYieldPending = pdTRUE;
-}
+    static void prvRemoveUtilisation( uint32_t ulUtilisation )
+    {
+        if( ulUtilisation != 0U )
+        {
+            xAdmissionControl.ulUtilisation -= ulUtilisation;
+            xAdmissionControl.uxAdmittedTasks--;
+
+            if( xAdmissionControl.uxAdmittedTasks == ( UBaseType_t ) 0U )
+            {
+                /* Drop the rounding error the divisions have accumulated. */
+                xAdmissionControl.ulHyperbolicProduct = taskUTILISATION_ONE;
+            }
+            else
+            {
+                xAdmissionControl.ulHyperbolicProduct = ( uint32_t ) ( ( ( uint64_t ) xAdmissionControl.ulHyperbolicProduct << 16 ) / ( uint64_t ) ( taskUTILISATION_ONE + ulUtilisation ) );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_ADMISSION_CONTROL */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_STACK_RESOURCE_POLICY == 1 )
 
-    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+    static TickType_t prvPreemptionLevel( const TCB_t * pxTCB )
     {
-        UBaseType_t uxReturn;
-        TCB_t const * pxTCB;
+        TickType_t xLevel;
 
-        if( xTask != NULL )
+        if( taskIS_PERIODIC( pxTCB ) != pdFALSE )
         {
-            pxTCB = xTask;
-            uxReturn = pxTCB->uxTaskNumber;
+            xLevel = pxTCB->uxPeriod;
+        }
+        else if( taskIS_APERIODIC( pxTCB ) != pdFALSE )
+        {
+            #if ( ( configUSE_APERIODIC_SERVER == 1 ) && ( configUSE_EDF_SCHEDULER == 0 ) )
+            {
+                /* Once the server exists every aperiodic job runs at the
+                 * level of the server. */
+                if( xAperiodicServer.xPeriod != ( TickType_t ) 0U )
+                {
+                    xLevel = xAperiodicServer.xPeriod;
+                }
+                else
+                {
+                    xLevel = ( TickType_t ) pxTCB->uxDeadline;
+                }
+            }
+            #else
+            {
+                xLevel = ( TickType_t ) pxTCB->uxDeadline;
+            }
+            #endif
         }
         else
         {
-            uxReturn = 0U;
+            xLevel = portMAX_DELAY;
         }
 
-        return uxReturn;
+        return xLevel;
     }
-
-#endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
-
-    void vTaskSetTaskNumber( TaskHandle_t xTask,
-                             const UBaseType_t uxHandle )
+    static BaseType_t prvResourceCeilingSelect( BaseType_t xViaServer )
     {
-        TCB_t * pxTCB;
+        TCB_t * pxHolder;
+        const List_t * pxContainer;
 
-        if( xTask != NULL )
+        if( pxResourceStackTop != NULL )
         {
-            pxTCB = xTask;
-            pxTCB->uxTaskNumber = uxHandle;
+            pxHolder = pxResourceStackTop->pxHolder;
+
+            if( ( pxCurrentTCB != pxHolder ) && ( prvPreemptionLevel( pxCurrentTCB ) >= xSystemCeiling ) )
+            {
+                /* The holder can only be switched to while it is ready.  A
+                 * holder that blocked broke the protocol, and is left to wait. */
+                pxContainer = listLIST_ITEM_CONTAINER( &( pxHolder->xStateListItem ) );
+
+                if( ( pxContainer == &xReadyPeriodicTasksLists ) ||
+                    ( pxContainer == &( pxReadyTasksLists[ pxHolder->uxPriority ] ) ) )
+                {
+                    traceRESOURCE_CEILING_BLOCKED( pxCurrentTCB );
+                    pxCurrentTCB = pxHolder;
+                    xViaServer = pdFALSE;
+                    xCeilingBlockedTask = pdTRUE;
+                }
+
+                #if ( configUSE_APERIODIC_SERVER == 1 )
+                    else if( pxContainer == &( xAperiodicServer.xJobList ) )
+                    {
+                        traceRESOURCE_CEILING_BLOCKED( pxCurrentTCB );
+                        pxCurrentTCB = pxHolder;
+                        xViaServer = pdTRUE;
+                        xCeilingBlockedTask = pdTRUE;
+                    }
+                #endif
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
+
+        return xViaServer;
     }
+/*-----------------------------------------------------------*/
 
-#endif /* configUSE_TRACE_FACILITY */
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-/*
- * -----------------------------------------------------------
- * The Idle task.
- * ----------------------------------------------------------
- *
- * The portTASK_FUNCTION() macro is used to allow port/compiler specific
- * language extensions.  The equivalent prototype for this function is:
- *
- * void prvIdleTask( void *pvParameters );
- *
- */
-static portTASK_FUNCTION( prvIdleTask, pvParameters )
-{
-    /* Stop warnings. */
-    ( void ) pvParameters;
+        ResourceHandle_t xTaskResourceCreate( void )
+        {
+            Resource_t * pxResource;
 
-    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
-     * SCHEDULER IS STARTED. **/
+            pxResource = ( Resource_t * ) pvPortMalloc( sizeof( Resource_t ) );
 
-    /* In case a task that has a secure context deletes itself, in which case
-     * the idle task is responsible for deleting the task's secure context, if
-     * any. */
-    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+            if( pxResource != NULL )
+            {
+                /* Nobody uses the resource yet, so its ceiling is the lowest
+                 * level until vTaskResourceAddUser() is called. */
+                pxResource->xCeiling = portMAX_DELAY;
+                pxResource->xPreviousSystemCeiling = portMAX_DELAY;
+                pxResource->pxHolder = NULL;
+                pxResource->pxPrevious = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    for( ; ; )
+            return pxResource;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vTaskResourceAddUser( ResourceHandle_t xResource,
+                               TaskHandle_t xTask )
     {
-        /* See if any tasks have deleted themselves - if so then the idle task
-         * is responsible for freeing the deleted task's TCB and stack. */
-        prvCheckTasksWaitingTermination();
+        Resource_t * const pxResource = xResource;
+        TCB_t * pxTCB;
+        TickType_t xLevel;
 
-        #if ( configUSE_PREEMPTION == 0 )
-        {
-            /* If we are not using preemption we keep forcing a task switch to
-             * see if any other task has become available.  If we are using
-             * preemption we don't need to do this as any task becoming available
-             * will automatically get the processor anyway. */
-            taskYIELD();
-        }
-        #endif /* configUSE_PREEMPTION */
+        configASSERT( pxResource );
 
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+        taskENTER_CRITICAL();
         {
-            /* When using preemption tasks of equal priority will be
-             * timesliced.  If a task that is sharing the idle priority is ready
-             * to run then the idle task should yield before the end of the
-             * timeslice.
-             *
-             * A critical region is not required here as we are just reading from
-             * the list, and an occasional incorrect value will not matter.  If
-             * the ready list at the idle priority contains more than one task
-             * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+            /* The ceiling is saved on the stack while the resource is held,
+             * so it must not change then. */
+            configASSERT( pxResource->pxHolder == NULL );
+
+            pxTCB = prvGetTCBFromHandle( xTask );
+            xLevel = prvPreemptionLevel( pxTCB );
+
+            if( xLevel < pxResource->xCeiling )
             {
-                taskYIELD();
+                pxResource->xCeiling = xLevel;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
 
-        #if ( configUSE_IDLE_HOOK == 1 )
+    void vTaskResourceTake( ResourceHandle_t xResource )
+    {
+        Resource_t * const pxResource = xResource;
+
+        configASSERT( pxResource );
+
+        taskENTER_CRITICAL();
         {
-            extern void vApplicationIdleHook( void );
+            /* A task only runs while its level is above the system ceiling,
+             * so a resource it was declared a user of cannot be held by
+             * another task. */
+            configASSERT( pxResource->pxHolder == NULL );
 
-            /* Call the user defined function from within the idle task.  This
-             * allows the application designer to add background functionality
-             * without the overhead of a separate task.
-             * NOTE: vApplicationIdleHook() MUST NOT, UNDER ANY CIRCUMSTANCES,
-             * CALL A FUNCTION THAT MIGHT BLOCK. */
-            vApplicationIdleHook();
+            pxResource->pxHolder = pxCurrentTCB;
+            pxResource->xPreviousSystemCeiling = xSystemCeiling;
+            pxResource->pxPrevious = pxResourceStackTop;
+            pxResourceStackTop = pxResource;
+
+            if( pxResource->xCeiling < xSystemCeiling )
+            {
+                xSystemCeiling = pxResource->xCeiling;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceRESOURCE_TAKE( pxResource );
         }
-        #endif /* configUSE_IDLE_HOOK */
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
 
-        /* This conditional compilation should use inequality to 0, not equality
-         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
-         * user defined low power mode  implementations require
-         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
-        #if ( configUSE_TICKLESS_IDLE != 0 )
-        {
-            TickType_t xExpectedIdleTime;
+    void vTaskResourceGive( ResourceHandle_t xResource )
+    {
+        Resource_t * const pxResource = xResource;
 
-            /* It is not desirable to suspend then resume the scheduler on
-             * each iteration of the idle task.  Therefore, a preliminary
-             * test of the expected idle time is performed without the
-             * scheduler suspended.  The result here is not necessarily
-             * valid. */
-            xExpectedIdleTime = prvGetExpectedIdleTime();
+        configASSERT( pxResource );
 
-            if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
-            {
-                vTaskSuspendAll();
-                {
-                    /* Now the scheduler is suspended, the expected idle
-                     * time can be sampled again, and this time its value can
-                     * be used. */
-                    configASSERT( xNextTaskUnblockTime >= xTickCount );
-                    xExpectedIdleTime = prvGetExpectedIdleTime();
+        taskENTER_CRITICAL();
+        {
+            /* Resources are given back in the reverse order they were taken,
+             * by the task that took them. */
+            configASSERT( pxResourceStackTop == pxResource );
+            configASSERT( pxResource->pxHolder == pxCurrentTCB );
 
-                    /* Define the following macro to set xExpectedIdleTime to 0
-                     * if the application does not want
-                     * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
-                    configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+            pxResourceStackTop = pxResource->pxPrevious;
+            xSystemCeiling = pxResource->xPreviousSystemCeiling;
+            pxResource->pxHolder = NULL;
+            pxResource->pxPrevious = NULL;
 
-                    if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
-                    {
-                        traceLOW_POWER_IDLE_BEGIN();
-                        portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
-                        traceLOW_POWER_IDLE_END();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                ( void ) xTaskResumeAll();
+            traceRESOURCE_GIVE( pxResource );
+
+            /* Let a task the ceiling kept from running take over now. */
+            if( xCeilingBlockedTask != pdFALSE )
+            {
+                xCeilingBlockedTask = pdFALSE;
+                taskYIELD_IF_USING_PREEMPTION();
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configUSE_TICKLESS_IDLE */
+        taskEXIT_CRITICAL();
     }
-}
+
+#endif /* configUSE_STACK_RESOURCE_POLICY */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) )
 
-    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+    TaskHandle_t xTaskGetCurrentTaskHandle( void )
     {
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            /* The idle task exists in addition to the application tasks. */
-            const UBaseType_t uxNonApplicationTasks = 1;
-        #endif /* INCLUDE_vTaskSuspend */
-
-        eSleepModeStatus eReturn = eStandardSleep;
-
-        /* This function must be called from a critical section. */
+        TaskHandle_t xReturn;
 
-        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
-        {
-            /* A task was made ready while the scheduler was suspended. */
-            eReturn = eAbortSleep;
-        }
-        else if( xYieldPending != pdFALSE )
-        {
-            /* A yield was pended while the scheduler was suspended. */
-            eReturn = eAbortSleep;
-        }
-        else if( xPendedTicks != 0 )
+        #if ( configNUMBER_OF_CORES > 1 )
         {
-            /* A tick interrupt has already occurred but was held pending
-             * because the scheduler is suspended. */
-            eReturn = eAbortSleep;
-        }
+            UBaseType_t uxSavedInterruptStatus;
 
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            else if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            /* The calling task could be switched out between reading the core
+             * it runs on and reading the task of that core, and back in on
+             * another core. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
             {
-                /* If all the tasks are in the suspended list (which might mean they
-                 * have an infinite block time rather than actually being suspended)
-                 * then it is safe to turn all clocks off and just wait for external
-                 * interrupts. */
-                eReturn = eNoTasksWaitingTimeout;
+                xReturn = pxCurrentTCB;
             }
-        #endif /* INCLUDE_vTaskSuspend */
-        else
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        #else
         {
-            mtCOVERAGE_TEST_MARKER();
+            /* A critical section is not required as this is not called from
+             * an interrupt and the current TCB will always be the same for any
+             * individual execution thread. */
+            xReturn = pxCurrentTCB;
         }
+        #endif
 
-        return eReturn;
+        return xReturn;
     }
 
-#endif /* configUSE_TICKLESS_IDLE */
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
-                                            BaseType_t xIndex,
-                                            void * pvValue )
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
     {
-        TCB_t * pxTCB;
+        configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
 
-        if( ( xIndex >= 0 ) &&
-            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
-        {
-            pxTCB = prvGetTCBFromHandle( xTaskToSet );
-            configASSERT( pxTCB != NULL );
-            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
-        }
+        return pxCurrentTCBs[ xCoreID ];
     }
-
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
 /*-----------------------------------------------------------*/
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
-
-    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
-                                               BaseType_t xIndex )
+    void vTaskExitCritical( void )
     {
-        void * pvReturn = NULL;
-        TCB_t * pxTCB;
+        BaseType_t xYieldRequired = pdFALSE;
 
-        if( ( xIndex >= 0 ) &&
-            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        /* Decided while the kernel lock is still held, so no other core is
+         * changing xYieldPending.  A core asks another one to yield through
+         * portYIELD_CORE() as well, which the calling core takes once it has
+         * left the critical section if it is not taken here. */
+        if( ( portGET_CRITICAL_NESTING_COUNT() == ( UBaseType_t ) 1U ) &&
+            ( xSchedulerRunning != pdFALSE ) &&
+            ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) &&
+            ( xYieldPending != pdFALSE ) )
         {
-            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+            xYieldRequired = pdTRUE;
         }
         else
         {
-            pvReturn = NULL;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        return pvReturn;
+        portEXIT_CRITICAL();
+
+        if( xYieldRequired != pdFALSE )
+        {
+            portYIELD();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+#endif /* configNUMBER_OF_CORES */
 /*-----------------------------------------------------------*/
 
-#if ( portUSING_MPU_WRAPPERS == 1 )
+#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 
-    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
-                                  const MemoryRegion_t * const xRegions )
+    BaseType_t xTaskGetSchedulerState( void )
     {
-        TCB_t * pxTCB;
+        BaseType_t xReturn;
 
-        /* If null is passed in here then we are modifying the MPU settings of
-         * the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTaskToModify );
+        if( xSchedulerRunning == pdFALSE )
+        {
+            xReturn = taskSCHEDULER_NOT_STARTED;
+        }
+        else
+        {
+            if( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE )
+            {
+                xReturn = taskSCHEDULER_RUNNING;
+            }
+            else
+            {
+                xReturn = taskSCHEDULER_SUSPENDED;
+            }
+        }
 
-        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+        return xReturn;
     }
 
-#endif /* portUSING_MPU_WRAPPERS */
+#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseTaskLists( void )
-{
-    UBaseType_t uxPriority;
+#if ( configUSE_MUTEXES == 1 )
 
-    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
     {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
-    }
+        TCB_t * const pxMutexHolderTCB = pxMutexHolder;
+        BaseType_t xReturn = pdFALSE;
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
-    vListInitialise( &xPendingReadyList );
+        /* If the mutex was given back by an interrupt while the queue was
+         * locked then the mutex holder might now be NULL.  _RB_ Is this still
+         * needed as interrupts can no longer use mutexes? */
+        if( pxMutexHolder != NULL )
+        {
+            /* If the holder of the mutex has a priority below the priority of
+             * the task attempting to obtain the mutex then it will temporarily
+             * inherit the priority of the task attempting to obtain the mutex. */
+            if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+            {
+                /* Adjust the mutex holder state to account for its new
+                 * priority.  Only reset the event list item value if the value is
+                 * not being used for anything else. */
+                if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                {
+                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-    #if ( INCLUDE_vTaskDelete == 1 )
-    {
-        vListInitialise( &xTasksWaitingTermination );
-    }
-    #endif /* INCLUDE_vTaskDelete */
+                /* If the task being modified is in the ready state it will need
+                 * to be moved into a new list. */
+                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+                {
+                    if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                    {
+                        /* It is known that the task is in its ready list so
+                         * there is no need to check again and the port level
+                         * reset macro can be called directly. */
+                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-    #if ( INCLUDE_vTaskSuspend == 1 )
-    {
-        vListInitialise( &xSuspendedTaskList );
-    }
-    #endif /* INCLUDE_vTaskSuspend */
+                    /* Inherit the priority before being moved into the new list. */
+                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+                    prvAddTaskToReadyList( pxMutexHolderTCB );
+                }
+                else
+                {
+                    /* Just inherit the priority. */
+                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+                }
+
+                traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+
+                /* Inheritance occurred. */
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
+                {
+                    /* The base priority of the mutex holder is lower than the
+                     * priority of the task attempting to take the mutex, but the
+                     * current priority of the mutex holder is not lower than the
+                     * priority of the task attempting to take the mutex.
+                     * Therefore the mutex holder must have already inherited a
+                     * priority, but inheritance would have occurred if that had
+                     * not been the case. */
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
-#if ( configUSE_POLLING_SERVER == 1 )
-    {
-        vListInitialise( &xReadyPeriodicTasksLists );
-        vListInitialise( &xPendingPeriodicReadyList );
+        return xReturn;
     }
-#endif // ( configUSE_POLLING_SERVER == 1 )
-}
+
+#endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-static void prvCheckTasksWaitingTermination( void )
-{
-    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+#if ( configUSE_MUTEXES == 1 )
 
-    #if ( INCLUDE_vTaskDelete == 1 )
+    BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
     {
-        TCB_t * pxTCB;
+        TCB_t * const pxTCB = pxMutexHolder;
+        BaseType_t xReturn = pdFALSE;
 
-        /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
-         * being called too often in the idle task. */
-        while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+        if( pxMutexHolder != NULL )
         {
-            taskENTER_CRITICAL();
+            /* A task can only have an inherited priority if it holds the mutex.
+             * If the mutex is held by a task then it cannot be given from an
+             * interrupt, and if a mutex is given by the holding task then it must
+             * be the running state task. */
+            configASSERT( pxTCB == pxCurrentTCB );
+            configASSERT( pxTCB->uxMutexesHeld );
+            ( pxTCB->uxMutexesHeld )--;
+
+            /* Has the holder of the mutex inherited the priority of another
+             * task? */
+            if( pxTCB->uxPriority != pxTCB->uxBasePriority )
             {
-                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                --uxCurrentNumberOfTasks;
-                --uxDeletedTasksWaitingCleanUp;
-            }
-            taskEXIT_CRITICAL();
+                /* Only disinherit if no other mutexes are held. */
+                if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
+                {
+                    /* A task can only have an inherited priority if it holds
+                     * the mutex.  If the mutex is held by a task then it cannot be
+                     * given from an interrupt, and if a mutex is given by the
+                     * holding task then it must be the running state task.  Remove
+                     * the holding task from the ready list. */
+                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                    {
+                        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-            prvDeleteTCB( pxTCB );
+                    /* Disinherit the priority before adding the task into the
+                     * new  ready list. */
+                    traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
+                    pxTCB->uxPriority = pxTCB->uxBasePriority;
+
+                    /* Reset the event list item value.  It cannot be in use for
+                     * any other purpose if this task is running, and it must be
+                     * running to give back the mutex. */
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* Return true to indicate that a context switch is required.
+                     * This is only actually required in the corner case whereby
+                     * multiple mutexes were held and the mutexes were given back
+                     * in an order different to that in which they were taken.
+                     * If a context switch did not occur when the first mutex was
+                     * returned, even if a task was waiting on it, then a context
+                     * switch should occur when the last mutex is returned whether
+                     * a task is waiting on it or not. */
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
+
+        return xReturn;
     }
-    #endif /* INCLUDE_vTaskDelete */
-}
+
+#endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_MUTEXES == 1 )
 
-    void vTaskGetInfo( TaskHandle_t xTask,
-                       TaskStatus_t * pxTaskStatus,
-                       BaseType_t xGetFreeStackSpace,
-                       eTaskState eState )
+    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
+                                              UBaseType_t uxHighestPriorityWaitingTask )
     {
-        TCB_t * pxTCB;
-
-        /* xTask is NULL then get the state of the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTask );
-
-        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
-        pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
-        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
-        pxTaskStatus->pxStackBase = pxTCB->pxStack;
-        #if ( ( portSTACK_GROWTH > 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
-            pxTaskStatus->pxTopOfStack = pxTCB->pxTopOfStack;
-            pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
-        #endif
-        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
-
-        #if ( configUSE_MUTEXES == 1 )
-        {
-            pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
-        }
-        #else
-        {
-            pxTaskStatus->uxBasePriority = 0;
-        }
-        #endif
+        TCB_t * const pxTCB = pxMutexHolder;
+        UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
+        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
-        {
-            pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
-        }
-        #else
+        if( pxMutexHolder != NULL )
         {
-            pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
-        }
-        #endif
+            /* If pxMutexHolder is not NULL then the holder must hold at least
+             * one mutex. */
+            configASSERT( pxTCB->uxMutexesHeld );
 
-        /* Obtaining the task state is a little fiddly, so is only done if the
-         * value of eState passed into this function is eInvalid - otherwise the
-         * state is just set to whatever is passed in. */
-        if( eState != eInvalid )
-        {
-            if( pxTCB == pxCurrentTCB )
+            /* Determine the priority to which the priority of the task that
+             * holds the mutex should be set.  This will be the greater of the
+             * holding task's base priority and the priority of the highest
+             * priority task that is waiting to obtain the mutex. */
+            if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
             {
-                pxTaskStatus->eCurrentState = eRunning;
+                uxPriorityToUse = uxHighestPriorityWaitingTask;
             }
             else
             {
-                pxTaskStatus->eCurrentState = eState;
+                uxPriorityToUse = pxTCB->uxBasePriority;
+            }
 
-                #if ( INCLUDE_vTaskSuspend == 1 )
+            /* Does the priority need to change? */
+            if( pxTCB->uxPriority != uxPriorityToUse )
+            {
+                /* Only disinherit if no other mutexes are held.  This is a
+                 * simplification in the priority inheritance implementation.  If
+                 * the task that holds the mutex is also holding other mutexes then
+                 * the other mutexes may have caused the priority inheritance. */
+                if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
                 {
-                    /* If the task is in the suspended list then there is a
-                     *  chance it is actually just blocked indefinitely - so really
-                     *  it should be reported as being in the Blocked state. */
-                    if( eState == eSuspended )
+                    /* If a task has timed out because it already holds the
+                     * mutex it was trying to obtain then it cannot of inherited
+                     * its own priority. */
+                    configASSERT( pxTCB != pxCurrentTCB );
+
+                    /* Disinherit the priority, remembering the previous
+                     * priority to facilitate determining the subject task's
+                     * state. */
+                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
+                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
+                    pxTCB->uxPriority = uxPriorityToUse;
+
+                    /* Only reset the event list item value if the value is not
+                     * being used for anything else. */
+                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
                     {
-                        vTaskSuspendAll();
+                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* If the running task is not the task that holds the mutex
+                     * then the task that holds the mutex could be in either the
+                     * Ready, Blocked or Suspended states.  Only remove the task
+                     * from its current state list if it is in the Ready state as
+                     * the task's priority is going to change and there is one
+                     * Ready list per priority. */
+                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    {
+                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
                         {
-                            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                            {
-                                pxTaskStatus->eCurrentState = eBlocked;
-                            }
+                            /* It is known that the task is in its ready list so
+                             * there is no need to check again and the port level
+                             * reset macro can be called directly. */
+                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
                         }
-                        ( void ) xTaskResumeAll();
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        prvAddTaskToReadyList( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                #endif /* INCLUDE_vTaskSuspend */
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
         }
         else
         {
-            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+            mtCOVERAGE_TEST_MARKER();
         }
+    }
 
-        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
-         * parameter is provided to allow it to be skipped. */
-        if( xGetFreeStackSpace != pdFALSE )
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+    void vTaskEnterCritical( void )
+    {
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
         {
-            #if ( portSTACK_GROWTH > 0 )
-            {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
-            }
-            #else
+            ( pxCurrentTCB->uxCriticalNesting )++;
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so  assert() if it is being called from an interrupt
+             * context.  Only API functions that end in "FromISR" can be used in an
+             * interrupt.  Only assert if the critical nesting count is 1 to
+             * protect against recursive calls if the assert function also uses a
+             * critical section. */
+            if( pxCurrentTCB->uxCriticalNesting == 1 )
             {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+                portASSERT_IF_IN_ISR();
             }
-            #endif
         }
         else
         {
-            pxTaskStatus->usStackHighWaterMark = 0;
+            mtCOVERAGE_TEST_MARKER();
         }
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* portCRITICAL_NESTING_IN_TCB */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
-    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
-                                                     List_t * pxList,
-                                                     eTaskState eState )
+    void vTaskExitCritical( void )
     {
-        configLIST_VOLATILE TCB_t * pxNextTCB;
-        configLIST_VOLATILE TCB_t * pxFirstTCB;
-        UBaseType_t uxTask = 0;
-
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        if( xSchedulerRunning != pdFALSE )
         {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            if( pxCurrentTCB->uxCriticalNesting > 0U )
+            {
+                ( pxCurrentTCB->uxCriticalNesting )--;
 
-            /* Populate an TaskStatus_t structure within the
-             * pxTaskStatusArray array for each task that is referenced from
-             * pxList.  See the definition of TaskStatus_t in task.h for the
-             * meaning of each TaskStatus_t structure member. */
-            do
+                if( pxCurrentTCB->uxCriticalNesting == 0U )
+                {
+                    portENABLE_INTERRUPTS();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
             {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
-                uxTask++;
-            } while( pxNextTCB != pxFirstTCB );
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-
-        return uxTask;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* portCRITICAL_NESTING_IN_TCB */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    static char * prvWriteNameToBuffer( char * pcBuffer,
+                                        const char * pcTaskName )
     {
-        uint32_t ulCount = 0U;
+        size_t x;
 
-        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+        /* Start by copying the entire string. */
+        strcpy( pcBuffer, pcTaskName );
+
+        /* Pad the end of the string with spaces to ensure columns line up when
+         * printed out. */
+        for( x = strlen( pcBuffer ); x < ( size_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
         {
-            pucStackByte -= portSTACK_GROWTH;
-            ulCount++;
+            pcBuffer[ x ] = ' ';
         }
 
-        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+        /* Terminate. */
+        pcBuffer[ x ] = ( char ) 0x00;
 
-        return ( configSTACK_DEPTH_TYPE ) ulCount;
+        /* Return the new end of string. */
+        return &( pcBuffer[ x ] );
     }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+#endif /* ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
-/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
- * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
- * user to determine the return type.  It gets around the problem of the value
- * overflowing on 8-bit types without breaking backward compatibility for
- * applications that expect an 8-bit return type. */
-    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+    void vTaskList( char * pcWriteBuffer )
     {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        configSTACK_DEPTH_TYPE uxReturn;
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize, x;
+        char cStatus;
 
-        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
-         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
-         * allows the user to determine the return type.  It gets around the
-         * problem of the value overflowing on 8-bit types without breaking
-         * backward compatibility for applications that expect an 8-bit return
-         * type. */
+        /*
+         * PLEASE NOTE:
+         *
+         * This function is provided for convenience only, and is used by many
+         * of the demo applications.  Do not consider it to be part of the
+         * scheduler.
+         *
+         * vTaskList() calls uxTaskGetSystemState(), then formats part of the
+         * uxTaskGetSystemState() output into a human readable table that
+         * displays task: names, states, priority, stack usage and task number.
+         * Stack usage specified as the number of unused StackType_t words stack can hold
+         * on top of stack - not the number of bytes.
+         *
+         * vTaskList() has a dependency on the sprintf() C library function that
+         * might bloat the code size, use a lot of stack, and provide different
+         * results on different platforms.  An alternative, tiny, third party,
+         * and limited functionality implementation of sprintf() is provided in
+         * many of the FreeRTOS/Demo sub-directories in a file called
+         * printf-stdarg.c (note printf-stdarg.c does not provide a full
+         * snprintf() implementation!).
+         *
+         * It is recommended that production systems call uxTaskGetSystemState()
+         * directly to get access to raw stats data, rather than indirectly
+         * through a call to vTaskList().
+         */
 
-        pxTCB = prvGetTCBFromHandle( xTask );
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-        }
-        #else
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
+
+        /* Take a snapshot of the number of tasks in case it changes while this
+         * function is executing. */
+        uxArraySize = uxCurrentNumberOfTasks;
+
+        /* Allocate an array index for each task.  NOTE!  if
+         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+         * equate to NULL. */
+        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+        if( pxTaskStatusArray != NULL )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
+            /* Generate the (binary) data. */
+            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
 
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+            /* Create a human readable table from the binary data. */
+            for( x = 0; x < uxArraySize; x++ )
+            {
+                switch( pxTaskStatusArray[ x ].eCurrentState )
+                {
+                    case eRunning:
+                        cStatus = tskRUNNING_CHAR;
+                        break;
 
-        return uxReturn;
-    }
+                    case eReady:
+                        cStatus = tskREADY_CHAR;
+                        break;
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
-/*-----------------------------------------------------------*/
+                    case eBlocked:
+                        cStatus = tskBLOCKED_CHAR;
+                        break;
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+                    case eSuspended:
+                        cStatus = tskSUSPENDED_CHAR;
+                        break;
 
-    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
-    {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        UBaseType_t uxReturn;
+                    case eDeleted:
+                        cStatus = tskDELETED_CHAR;
+                        break;
 
-        pxTCB = prvGetTCBFromHandle( xTask );
+                    case eInvalid: /* Fall through. */
+                    default:       /* Should not get here, but it is included
+                                    * to prevent static checking errors. */
+                        cStatus = ( char ) 0x00;
+                        break;
+                }
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+                /* Write the task name to the string, padding with spaces so it
+                 * can be printed in tabular form more easily. */
+                pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+
+                /* Write the rest of the string. */
+                sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                pcWriteBuffer += strlen( pcWriteBuffer );                                                                                                                                                                                                /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+            }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
         }
-        #else
+        else
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif
+    }
 
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+/*----------------------------------------------------------*/
 
-        return uxReturn;
-    }
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configUSE_TRACE_FACILITY == 1 ) )
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
-/*-----------------------------------------------------------*/
+    void vTaskGetRunTimeStats( char * pcWriteBuffer )
+    {
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize, x;
+        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
 
-#if ( INCLUDE_vTaskDelete == 1 )
+        /*
+         * PLEASE NOTE:
+         *
+         * This function is provided for convenience only, and is used by many
+         * of the demo applications.  Do not consider it to be part of the
+         * scheduler.
+         *
+         * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
+         * of the uxTaskGetSystemState() output into a human readable table that
+         * displays the amount of time each task has spent in the Running state
+         * in both absolute and percentage terms.
+         *
+         * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
+         * function that might bloat the code size, use a lot of stack, and
+         * provide different results on different platforms.  An alternative,
+         * tiny, third party, and limited functionality implementation of
+         * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
+         * a file called printf-stdarg.c (note printf-stdarg.c does not provide
+         * a full snprintf() implementation!).
+         *
+         * It is recommended that production systems call uxTaskGetSystemState()
+         * directly to get access to raw stats data, rather than indirectly
+         * through a call to vTaskGetRunTimeStats().
+         */
+
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
+
+        /* Take a snapshot of the number of tasks in case it changes while this
+         * function is executing. */
+        uxArraySize = uxCurrentNumberOfTasks;
 
-    static void prvDeleteTCB( TCB_t * pxTCB )
-    {
-        /* This call is required specifically for the TriCore port.  It must be
-         * above the vPortFree() calls.  The call is also used by ports/demos that
-         * want to allocate and clean RAM statically. */
-        portCLEAN_UP_TCB( pxTCB );
+        /* Allocate an array index for each task.  NOTE!  If
+         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+         * equate to NULL. */
+        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        if( pxTaskStatusArray != NULL )
         {
-            /* Free up the memory allocated for the task's TLS Block. */
-            configDEINIT_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
-        }
-        #endif
+            /* Generate the (binary) data. */
+            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
 
-        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
-        {
-            /* The task can only have been allocated dynamically - free both
-             * the stack and TCB. */
-            vPortFreeStack( pxTCB->pxStack );
-            vPortFree( pxTCB );
-        }
-        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
-        {
-            /* The task could have been allocated statically or dynamically, so
-             * check what was statically allocated before trying to free the
-             * memory. */
-            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
-            {
-                /* Both the stack and TCB were allocated dynamically, so both
-                 * must be freed. */
-                vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
-            }
-            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+            /* For percentage calculations. */
+            ulTotalTime /= 100UL;
+
+            /* Avoid divide by zero errors. */
+            if( ulTotalTime > 0UL )
             {
-                /* Only the stack was statically allocated, so the TCB is the
-                 * only memory that must be freed. */
-                vPortFree( pxTCB );
+                /* Create a human readable table from the binary data. */
+                for( x = 0; x < uxArraySize; x++ )
+                {
+                    /* What percentage of the total run time has the task used?
+                     * This will always be rounded down to the nearest integer.
+                     * ulTotalRunTime has already been divided by 100. */
+                    ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+
+                    /* Write the task name to the string, padding with
+                     * spaces so it can be printed in tabular form more
+                     * easily. */
+                    pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+
+                    if( ulStatsAsPercentage > 0UL )
+                    {
+                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+                        {
+                            sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+                        }
+                        #else
+                        {
+                            /* sizeof( int ) == sizeof( long ) so a smaller
+                             * printf() library can be used. */
+                            sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        /* If the percentage is zero here then the task has
+                         * consumed less than 1% of the total run time. */
+                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+                        {
+                            sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+                        }
+                        #else
+                        {
+                            /* sizeof( int ) == sizeof( long ) so a smaller
+                             * printf() library can be used. */
+                            sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                        }
+                        #endif
+                    }
+
+                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                }
             }
             else
             {
-                /* Neither the stack nor the TCB were allocated dynamically, so
-                 * nothing needs to be freed. */
-                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
                 mtCOVERAGE_TEST_MARKER();
             }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
     }
 
-#endif /* INCLUDE_vTaskDelete */
+#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
+TickType_t uxTaskResetEventItemValue( void )
 {
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-    {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
-    }
-    else
-    {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
-    }
-}
-/*-----------------------------------------------------------*/
-
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
-
-    TaskHandle_t xTaskGetCurrentTaskHandle( void )
-    {
-        TaskHandle_t xReturn;
+    TickType_t uxReturn;
 
-        /* A critical section is not required as this is not called from
-         * an interrupt and the current TCB will always be the same for any
-         * individual execution thread. */
-        xReturn = pxCurrentTCB;
+    uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
 
-        return xReturn;
-    }
+    /* Reset the event list item to its normal value - so it can be used with
+     * queues and semaphores. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+    return uxReturn;
+}
 /*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+#if ( configUSE_MUTEXES == 1 )
 
-    BaseType_t xTaskGetSchedulerState( void )
+    TaskHandle_t pvTaskIncrementMutexHeldCount( void )
     {
-        BaseType_t xReturn;
-
-        if( xSchedulerRunning == pdFALSE )
-        {
-            xReturn = taskSCHEDULER_NOT_STARTED;
-        }
-        else
+        /* If xSemaphoreCreateMutex() is called before any tasks have been created
+         * then pxCurrentTCB will be NULL. */
+        if( pxCurrentTCB != NULL )
         {
-            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-            {
-                xReturn = taskSCHEDULER_RUNNING;
-            }
-            else
-            {
-                xReturn = taskSCHEDULER_SUSPENDED;
-            }
+            ( pxCurrentTCB->uxMutexesHeld )++;
         }
 
-        return xReturn;
+        return pxCurrentTCB;
     }
 
-#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
+#endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+    uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
+                                      BaseType_t xClearCountOnExit,
+                                      TickType_t xTicksToWait )
     {
-        TCB_t * const pxMutexHolderTCB = pxMutexHolder;
-        BaseType_t xReturn = pdFALSE;
+        uint32_t ulReturn;
 
-        /* If the mutex was given back by an interrupt while the queue was
-         * locked then the mutex holder might now be NULL.  _RB_ Is this still
-         * needed as interrupts can no longer use mutexes? */
-        if( pxMutexHolder != NULL )
+        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        taskENTER_CRITICAL();
         {
-            /* If the holder of the mutex has a priority below the priority of
-             * the task attempting to obtain the mutex then it will temporarily
-             * inherit the priority of the task attempting to obtain the mutex. */
-            if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+            /* Only block if the notification count is not already non-zero. */
+            if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
             {
-                /* Adjust the mutex holder state to account for its new
-                 * priority.  Only reset the event list item value if the value is
-                 * not being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                {
-                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                /* Mark this task as waiting for a notification. */
+                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
-                /* If the task being modified is in the ready state it will need
-                 * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+                if( xTicksToWait > ( TickType_t ) 0 )
                 {
-                    if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+                    traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait );
 
-                    /* Inherit the priority before being moved into the new list. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-                    prvAddTaskToReadyList( pxMutexHolderTCB );
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until the
+                     * critical section exits) - but it is not something that
+                     * application code should ever do. */
+                    portYIELD_WITHIN_API();
                 }
                 else
                 {
-                    /* Just inherit the priority. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+                    mtCOVERAGE_TEST_MARKER();
                 }
-
-                traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
-
-                /* Inheritance occurred. */
-                xReturn = pdTRUE;
             }
             else
             {
-                if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
-                {
-                    /* The base priority of the mutex holder is lower than the
-                     * priority of the task attempting to take the mutex, but the
-                     * current priority of the mutex holder is not lower than the
-                     * priority of the task attempting to take the mutex.
-                     * Therefore the mutex holder must have already inherited a
-                     * priority, but inheritance would have occurred if that had
-                     * not been the case. */
-                    xReturn = pdTRUE;
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        taskENTER_CRITICAL();
+        {
+            traceTASK_NOTIFY_TAKE( uxIndexToWait );
+            ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
+
+            if( ulReturn != 0UL )
+            {
+                if( xClearCountOnExit != pdFALSE )
+                {
+                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
                 }
             }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        taskEXIT_CRITICAL();
 
-        return xReturn;
+        return ulReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+    BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait,
+                                       uint32_t ulBitsToClearOnEntry,
+                                       uint32_t ulBitsToClearOnExit,
+                                       uint32_t * pulNotificationValue,
+                                       TickType_t xTicksToWait )
     {
-        TCB_t * const pxTCB = pxMutexHolder;
-        BaseType_t xReturn = pdFALSE;
+        BaseType_t xReturn;
 
-        if( pxMutexHolder != NULL )
-        {
-            /* A task can only have an inherited priority if it holds the mutex.
-             * If the mutex is held by a task then it cannot be given from an
-             * interrupt, and if a mutex is given by the holding task then it must
-             * be the running state task. */
-            configASSERT( pxTCB == pxCurrentTCB );
-            configASSERT( pxTCB->uxMutexesHeld );
-            ( pxTCB->uxMutexesHeld )--;
+        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
-            /* Has the holder of the mutex inherited the priority of another
-             * task? */
-            if( pxTCB->uxPriority != pxTCB->uxBasePriority )
+        taskENTER_CRITICAL();
+        {
+            /* Only block if a notification is not already pending. */
+            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
             {
-                /* Only disinherit if no other mutexes are held. */
-                if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
-                {
-                    /* A task can only have an inherited priority if it holds
-                     * the mutex.  If the mutex is held by a task then it cannot be
-                     * given from an interrupt, and if a mutex is given by the
-                     * holding task then it must be the running state task.  Remove
-                     * the holding task from the ready list. */
-                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                /* Clear bits in the task's notification value as bits may get
+                 * set  by the notifying task or interrupt.  This can be used to
+                 * clear the value to zero. */
+                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
 
-                    /* Disinherit the priority before adding the task into the
-                     * new  ready list. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-                    pxTCB->uxPriority = pxTCB->uxBasePriority;
+                /* Mark this task as waiting for a notification. */
+                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
 
-                    /* Reset the event list item value.  It cannot be in use for
-                     * any other purpose if this task is running, and it must be
-                     * running to give back the mutex. */
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    prvAddTaskToReadyList( pxTCB );
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+                    traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait );
 
-                    /* Return true to indicate that a context switch is required.
-                     * This is only actually required in the corner case whereby
-                     * multiple mutexes were held and the mutexes were given back
-                     * in an order different to that in which they were taken.
-                     * If a context switch did not occur when the first mutex was
-                     * returned, even if a task was waiting on it, then a context
-                     * switch should occur when the last mutex is returned whether
-                     * a task is waiting on it or not. */
-                    xReturn = pdTRUE;
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until the
+                     * critical section exits) - but it is not something that
+                     * application code should ever do. */
+                    portYIELD_WITHIN_API();
                 }
                 else
                 {
@@ -4551,166 +9616,150 @@ static void prvResetNextTaskUnblockTime( void )
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        else
+        taskEXIT_CRITICAL();
+
+        taskENTER_CRITICAL();
         {
-            mtCOVERAGE_TEST_MARKER();
+            traceTASK_NOTIFY_WAIT( uxIndexToWait );
+
+            if( pulNotificationValue != NULL )
+            {
+                /* Output the current notification value, which may or may not
+                 * have changed. */
+                *pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
+            }
+
+            /* If ucNotifyValue is set then either the task never entered the
+             * blocked state (because a notification was already pending) or the
+             * task unblocked because of a notification.  Otherwise the task
+             * unblocked because of a timeout. */
+            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
+            {
+                /* A notification was not received. */
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                /* A notification was already pending or a notification was
+                 * received while the task was waiting. */
+                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
+                xReturn = pdTRUE;
+            }
+
+            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
         }
+        taskEXIT_CRITICAL();
 
         return xReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
-                                              UBaseType_t uxHighestPriorityWaitingTask )
+    BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
+                                   UBaseType_t uxIndexToNotify,
+                                   uint32_t ulValue,
+                                   eNotifyAction eAction,
+                                   uint32_t * pulPreviousNotificationValue )
     {
-        TCB_t * const pxTCB = pxMutexHolder;
-        UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
-        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+        TCB_t * pxTCB;
+        BaseType_t xReturn = pdPASS;
+        uint8_t ucOriginalNotifyState;
 
-        if( pxMutexHolder != NULL )
-        {
-            /* If pxMutexHolder is not NULL then the holder must hold at least
-             * one mutex. */
-            configASSERT( pxTCB->uxMutexesHeld );
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        configASSERT( xTaskToNotify );
+        pxTCB = xTaskToNotify;
 
-            /* Determine the priority to which the priority of the task that
-             * holds the mutex should be set.  This will be the greater of the
-             * holding task's base priority and the priority of the highest
-             * priority task that is waiting to obtain the mutex. */
-            if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
-            {
-                uxPriorityToUse = uxHighestPriorityWaitingTask;
-            }
-            else
+        taskENTER_CRITICAL();
+        {
+            if( pulPreviousNotificationValue != NULL )
             {
-                uxPriorityToUse = pxTCB->uxBasePriority;
+                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
             }
 
-            /* Does the priority need to change? */
-            if( pxTCB->uxPriority != uxPriorityToUse )
+            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+
+            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+
+            switch( eAction )
             {
-                /* Only disinherit if no other mutexes are held.  This is a
-                 * simplification in the priority inheritance implementation.  If
-                 * the task that holds the mutex is also holding other mutexes then
-                 * the other mutexes may have caused the priority inheritance. */
-                if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
-                {
-                    /* If a task has timed out because it already holds the
-                     * mutex it was trying to obtain then it cannot of inherited
-                     * its own priority. */
-                    configASSERT( pxTCB != pxCurrentTCB );
+                case eSetBits:
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+                    break;
 
-                    /* Disinherit the priority, remembering the previous
-                     * priority to facilitate determining the subject task's
-                     * state. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
-                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
-                    pxTCB->uxPriority = uxPriorityToUse;
+                case eIncrement:
+                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+                    break;
 
-                    /* Only reset the event list item value if the value is not
-                     * being used for anything else. */
-                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                    {
-                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                case eSetValueWithOverwrite:
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                    break;
 
-                    /* If the running task is not the task that holds the mutex
-                     * then the task that holds the mutex could be in either the
-                     * Ready, Blocked or Suspended states.  Only remove the task
-                     * from its current state list if it is in the Ready state as
-                     * the task's priority is going to change and there is one
-                     * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
-                    {
-                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                        {
-                            /* It is known that the task is in its ready list so
-                             * there is no need to check again and the port level
-                             * reset macro can be called directly. */
-                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                case eSetValueWithoutOverwrite:
 
-                        prvAddTaskToReadyList( pxTCB );
+                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+                    {
+                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
                     }
                     else
                     {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
+                        /* The value could not be written to the task. */
+                        xReturn = pdFAIL;
+                    }
 
-#endif /* configUSE_MUTEXES */
-/*-----------------------------------------------------------*/
+                    break;
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+                case eNoAction:
 
-    void vTaskEnterCritical( void )
-    {
-        portDISABLE_INTERRUPTS();
+                    /* The task is being notified without its notify value being
+                     * updated. */
+                    break;
 
-        if( xSchedulerRunning != pdFALSE )
-        {
-            ( pxCurrentTCB->uxCriticalNesting )++;
+                default:
 
-            /* This is not the interrupt safe version of the enter critical
-             * function so  assert() if it is being called from an interrupt
-             * context.  Only API functions that end in "FromISR" can be used in an
-             * interrupt.  Only assert if the critical nesting count is 1 to
-             * protect against recursive calls if the assert function also uses a
-             * critical section. */
-            if( pxCurrentTCB->uxCriticalNesting == 1 )
-            {
-                portASSERT_IF_IN_ISR();
-            }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-    }
+                    /* Should not get here if all enums are handled.
+                     * Artificially force an assert by testing a value the
+                     * compiler can't assume is const. */
+                    configASSERT( xTickCount == ( TickType_t ) 0 );
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
-/*-----------------------------------------------------------*/
+                    break;
+            }
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+            traceTASK_NOTIFY( uxIndexToNotify );
 
-    void vTaskExitCritical( void )
-    {
-        if( xSchedulerRunning != pdFALSE )
-        {
-            if( pxCurrentTCB->uxCriticalNesting > 0U )
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
             {
-                ( pxCurrentTCB->uxCriticalNesting )--;
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                prvAddTaskToReadyList( pxTCB );
 
-                if( pxCurrentTCB->uxCriticalNesting == 0U )
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+                #if ( configUSE_TICKLESS_IDLE != 0 )
                 {
-                    portENABLE_INTERRUPTS();
+                    /* If a task is blocked waiting for a notification then
+                     * xNextTaskUnblockTime might be set to the blocked task's time
+                     * out time.  If the task is unblocked for a reason other than
+                     * a timeout xNextTaskUnblockTime is normally left unchanged,
+                     * because it will automatically get reset to a new value when
+                     * the tick count equals xNextTaskUnblockTime.  However if
+                     * tickless idling is used it might be more important to enter
+                     * sleep mode at the earliest possible time - so reset
+                     * xNextTaskUnblockTime here to ensure it is updated at the
+                     * earliest possible time. */
+                    prvResetNextTaskUnblockTime();
+                }
+                #endif
+
+                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                {
+                    /* The notified task has a priority above the currently
+                     * executing task so a yield is required. */
+                    taskYIELD_IF_USING_PREEMPTION();
                 }
                 else
                 {
@@ -4722,1209 +9771,1370 @@ static void prvResetNextTaskUnblockTime( void )
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
     }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    static char * prvWriteNameToBuffer( char * pcBuffer,
-                                        const char * pcTaskName )
+    BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
+                                          UBaseType_t uxIndexToNotify,
+                                          uint32_t ulValue,
+                                          eNotifyAction eAction,
+                                          uint32_t * pulPreviousNotificationValue,
+                                          BaseType_t * pxHigherPriorityTaskWoken )
     {
-        size_t x;
+        TCB_t * pxTCB;
+        uint8_t ucOriginalNotifyState;
+        BaseType_t xReturn = pdPASS;
+        UBaseType_t uxSavedInterruptStatus;
 
-        /* Start by copying the entire string. */
-        strcpy( pcBuffer, pcTaskName );
+        configASSERT( xTaskToNotify );
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
-        /* Pad the end of the string with spaces to ensure columns line up when
-         * printed out. */
-        for( x = strlen( pcBuffer ); x < ( size_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        pxTCB = xTaskToNotify;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
         {
-            pcBuffer[ x ] = ' ';
-        }
+            if( pulPreviousNotificationValue != NULL )
+            {
+                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
+            }
 
-        /* Terminate. */
-        pcBuffer[ x ] = ( char ) 0x00;
+            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
-        /* Return the new end of string. */
-        return &( pcBuffer[ x ] );
-    }
+            switch( eAction )
+            {
+                case eSetBits:
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+                    break;
 
-#endif /* ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
-/*-----------------------------------------------------------*/
+                case eIncrement:
+                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+                    break;
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+                case eSetValueWithOverwrite:
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                    break;
 
-    void vTaskList( char * pcWriteBuffer )
-    {
-        TaskStatus_t * pxTaskStatusArray;
-        UBaseType_t uxArraySize, x;
-        char cStatus;
+                case eSetValueWithoutOverwrite:
 
-        /*
-         * PLEASE NOTE:
-         *
-         * This function is provided for convenience only, and is used by many
-         * of the demo applications.  Do not consider it to be part of the
-         * scheduler.
-         *
-         * vTaskList() calls uxTaskGetSystemState(), then formats part of the
-         * uxTaskGetSystemState() output into a human readable table that
-         * displays task: names, states, priority, stack usage and task number.
-         * Stack usage specified as the number of unused StackType_t words stack can hold
-         * on top of stack - not the number of bytes.
-         *
-         * vTaskList() has a dependency on the sprintf() C library function that
-         * might bloat the code size, use a lot of stack, and provide different
-         * results on different platforms.  An alternative, tiny, third party,
-         * and limited functionality implementation of sprintf() is provided in
-         * many of the FreeRTOS/Demo sub-directories in a file called
-         * printf-stdarg.c (note printf-stdarg.c does not provide a full
-         * snprintf() implementation!).
-         *
-         * It is recommended that production systems call uxTaskGetSystemState()
-         * directly to get access to raw stats data, rather than indirectly
-         * through a call to vTaskList().
-         */
+                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+                    {
+                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                    }
+                    else
+                    {
+                        /* The value could not be written to the task. */
+                        xReturn = pdFAIL;
+                    }
+
+                    break;
+
+                case eNoAction:
+
+                    /* The task is being notified without its notify value being
+                     * updated. */
+                    break;
+
+                default:
+
+                    /* Should not get here if all enums are handled.
+                     * Artificially force an assert by testing a value the
+                     * compiler can't assume is const. */
+                    configASSERT( xTickCount == ( TickType_t ) 0 );
+                    break;
+            }
+
+            traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
+
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            {
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    /* The delayed and ready lists cannot be accessed, so hold
+                     * this task pending until the scheduler is resumed. */
+                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
+
+                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                {
+                    /* The notified task has a priority above the currently
+                     * executing task so a yield is required. */
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+
+                    /* Mark that a yield is pending in case the user is not
+                     * using the "xHigherPriorityTaskWoken" parameter to an ISR
+                     * safe FreeRTOS function. */
+                    xYieldPending = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
+        return xReturn;
+    }
 
-        /* Make sure the write buffer does not contain a string. */
-        *pcWriteBuffer = ( char ) 0x00;
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
 
-        /* Take a snapshot of the number of tasks in case it changes while this
-         * function is executing. */
-        uxArraySize = uxCurrentNumberOfTasks;
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-        /* Allocate an array index for each task.  NOTE!  if
-         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-         * equate to NULL. */
-        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+    void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify,
+                                        UBaseType_t uxIndexToNotify,
+                                        BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        TCB_t * pxTCB;
+        uint8_t ucOriginalNotifyState;
+        UBaseType_t uxSavedInterruptStatus;
 
-        if( pxTaskStatusArray != NULL )
-        {
-            /* Generate the (binary) data. */
-            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+        configASSERT( xTaskToNotify );
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
-            /* Create a human readable table from the binary data. */
-            for( x = 0; x < uxArraySize; x++ )
-            {
-                switch( pxTaskStatusArray[ x ].eCurrentState )
-                {
-                    case eRunning:
-                        cStatus = tskRUNNING_CHAR;
-                        break;
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-                    case eReady:
-                        cStatus = tskREADY_CHAR;
-                        break;
+        pxTCB = xTaskToNotify;
 
-                    case eBlocked:
-                        cStatus = tskBLOCKED_CHAR;
-                        break;
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
-                    case eSuspended:
-                        cStatus = tskSUSPENDED_CHAR;
-                        break;
+            /* 'Giving' is equivalent to incrementing a count in a counting
+             * semaphore. */
+            ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
 
-                    case eDeleted:
-                        cStatus = tskDELETED_CHAR;
-                        break;
+            traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
 
-                    case eInvalid: /* Fall through. */
-                    default:       /* Should not get here, but it is included
-                                    * to prevent static checking errors. */
-                        cStatus = ( char ) 0x00;
-                        break;
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            {
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    /* The delayed and ready lists cannot be accessed, so hold
+                     * this task pending until the scheduler is resumed. */
+                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                /* Write the task name to the string, padding with spaces so it
-                 * can be printed in tabular form more easily. */
-                pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                {
+                    /* The notified task has a priority above the currently
+                     * executing task so a yield is required. */
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
 
-                /* Write the rest of the string. */
-                sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-                pcWriteBuffer += strlen( pcWriteBuffer );                                                                                                                                                                                                /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                    /* Mark that a yield is pending in case the user is not
+                     * using the "xHigherPriorityTaskWoken" parameter in an ISR
+                     * safe FreeRTOS function. */
+                    xYieldPending = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-
-            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-             * is 0 then vPortFree() will be #defined to nothing. */
-            vPortFree( pxTaskStatusArray );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
         }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
     }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
-/*----------------------------------------------------------*/
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configUSE_TRACE_FACILITY == 1 ) )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    void vTaskGetRunTimeStats( char * pcWriteBuffer )
+    BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask,
+                                             UBaseType_t uxIndexToClear )
     {
-        TaskStatus_t * pxTaskStatusArray;
-        UBaseType_t uxArraySize, x;
-        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
-
-        /*
-         * PLEASE NOTE:
-         *
-         * This function is provided for convenience only, and is used by many
-         * of the demo applications.  Do not consider it to be part of the
-         * scheduler.
-         *
-         * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
-         * of the uxTaskGetSystemState() output into a human readable table that
-         * displays the amount of time each task has spent in the Running state
-         * in both absolute and percentage terms.
-         *
-         * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
-         * function that might bloat the code size, use a lot of stack, and
-         * provide different results on different platforms.  An alternative,
-         * tiny, third party, and limited functionality implementation of
-         * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
-         * a file called printf-stdarg.c (note printf-stdarg.c does not provide
-         * a full snprintf() implementation!).
-         *
-         * It is recommended that production systems call uxTaskGetSystemState()
-         * directly to get access to raw stats data, rather than indirectly
-         * through a call to vTaskGetRunTimeStats().
-         */
-
-        /* Make sure the write buffer does not contain a string. */
-        *pcWriteBuffer = ( char ) 0x00;
+        TCB_t * pxTCB;
+        BaseType_t xReturn;
 
-        /* Take a snapshot of the number of tasks in case it changes while this
-         * function is executing. */
-        uxArraySize = uxCurrentNumberOfTasks;
+        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
-        /* Allocate an array index for each task.  NOTE!  If
-         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-         * equate to NULL. */
-        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+        /* If null is passed in here then it is the calling task that is having
+         * its notification state cleared. */
+        pxTCB = prvGetTCBFromHandle( xTask );
 
-        if( pxTaskStatusArray != NULL )
+        taskENTER_CRITICAL();
         {
-            /* Generate the (binary) data. */
-            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
-
-            /* For percentage calculations. */
-            ulTotalTime /= 100UL;
-
-            /* Avoid divide by zero errors. */
-            if( ulTotalTime > 0UL )
+            if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
             {
-                /* Create a human readable table from the binary data. */
-                for( x = 0; x < uxArraySize; x++ )
-                {
-                    /* What percentage of the total run time has the task used?
-                     * This will always be rounded down to the nearest integer.
-                     * ulTotalRunTime has already been divided by 100. */
-                    ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
-
-                    /* Write the task name to the string, padding with
-                     * spaces so it can be printed in tabular form more
-                     * easily. */
-                    pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
-
-                    if( ulStatsAsPercentage > 0UL )
-                    {
-                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-                        {
-                            sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
-                        }
-                        #else
-                        {
-                            /* sizeof( int ) == sizeof( long ) so a smaller
-                             * printf() library can be used. */
-                            sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-                        }
-                        #endif
-                    }
-                    else
-                    {
-                        /* If the percentage is zero here then the task has
-                         * consumed less than 1% of the total run time. */
-                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-                        {
-                            sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
-                        }
-                        #else
-                        {
-                            /* sizeof( int ) == sizeof( long ) so a smaller
-                             * printf() library can be used. */
-                            sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-                        }
-                        #endif
-                    }
-
-                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
-                }
+                pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
+                xReturn = pdPASS;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                xReturn = pdFAIL;
             }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
+                                            UBaseType_t uxIndexToClear,
+                                            uint32_t ulBitsToClear )
+    {
+        TCB_t * pxTCB;
+        uint32_t ulReturn;
 
-            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-             * is 0 then vPortFree() will be #defined to nothing. */
-            vPortFree( pxTaskStatusArray );
-        }
-        else
+        /* If null is passed in here then it is the calling task that is having
+         * its notification state cleared. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        taskENTER_CRITICAL();
         {
-            mtCOVERAGE_TEST_MARKER();
+            /* Return the notification as it was before the bits were cleared,
+             * then clear the bit mask. */
+            ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
+            pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
         }
+        taskEXIT_CRITICAL();
+
+        return ulReturn;
     }
 
-#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-TickType_t uxTaskResetEventItemValue( void )
-{
-    TickType_t uxReturn;
-
-    uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
 
-    /* Reset the event list item to its normal value - so it can be used with
-     * queues and semaphores. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+    {
+        return xIdleTaskHandle->ulRunTimeCounter;
+    }
 
-    return uxReturn;
-}
+#endif
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
 
-    TaskHandle_t pvTaskIncrementMutexHeldCount( void )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
     {
-        /* If xSemaphoreCreateMutex() is called before any tasks have been created
-         * then pxCurrentTCB will be NULL. */
-        if( pxCurrentTCB != NULL )
+        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
+
+        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+
+        /* For percentage calculations. */
+        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+
+        /* Avoid divide by zero errors. */
+        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
         {
-            ( pxCurrentTCB->uxMutexesHeld )++;
+            ulReturn = xIdleTaskHandle->ulRunTimeCounter / ulTotalTime;
+        }
+        else
+        {
+            ulReturn = 0;
         }
 
-        return pxCurrentTCB;
+        return ulReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
+                                            const BaseType_t xCanBlockIndefinitely )
+{
+    TickType_t xTimeToWake;
+    const TickType_t xConstTickCount = xTickCount;
 
-    uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
-                                      BaseType_t xClearCountOnExit,
-                                      TickType_t xTicksToWait )
+    #if ( INCLUDE_xTaskAbortDelay == 1 )
     {
-        uint32_t ulReturn;
+        /* About to enter a delayed list, so ensure the ucDelayAborted flag is
+         * reset to pdFALSE so it can be detected as having been set to pdTRUE
+         * when the task leaves the Blocked state. */
+        pxCurrentTCB->ucDelayAborted = pdFALSE;
+    }
+    #endif
 
-        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+    /* Remove the task from the ready list before adding it to the blocked list
+     * as the same list item is used for both lists. */
+    if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+    {
+        #if ( configUSE_POLLING_SERVER == 1 )
+        {
+            /* Periodic tasks and server jobs are not held in
+             * pxReadyTasksLists, so the list that has just been emptied is not
+             * necessarily the one the priority bit refers to. */
+            taskRESET_READY_PRIORITY( pxCurrentTCB->uxPriority );
+        }
+        #else
+        {
+            /* The current task must be in a ready list, so there is no need to
+             * check, and the port reset macro can be called directly. */
+            portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
+        }
+        #endif
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
-        taskENTER_CRITICAL();
+    #if ( INCLUDE_vTaskSuspend == 1 )
+    {
+        if( ( xTicksToWait == portMAX_DELAY ) && ( xCanBlockIndefinitely != pdFALSE ) )
         {
-            /* Only block if the notification count is not already non-zero. */
-            if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
+            /* Add the task to the suspended task list instead of a delayed task
+             * list to ensure it is not woken by a timing event.  It will block
+             * indefinitely. */
+            listINSERT_END( &xSuspendedTaskList, &( pxCurrentTCB->xStateListItem ) );
+        }
+        else
+        {
+            /* Calculate the time at which the task should be woken if the event
+             * does not occur.  This may overflow but this doesn't matter, the
+             * kernel will manage it correctly. */
+            xTimeToWake = xConstTickCount + xTicksToWait;
+
+            /* The list item will be inserted in wake time order. */
+            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+
+            if( xTimeToWake < xConstTickCount )
             {
-                /* Mark this task as waiting for a notification. */
-                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
+                /* Wake time has overflowed.  Place this item in the overflow
+                 * list. */
+                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            }
+            else
+            {
+                /* The wake time has not overflowed, so the current block list
+                 * is used. */
+                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 
-                if( xTicksToWait > ( TickType_t ) 0 )
+                /* If the task entering the blocked state was placed at the
+                 * head of the list of blocked tasks then xNextTaskUnblockTime
+                 * needs to be updated too. */
+                if( xTimeToWake < xNextTaskUnblockTime )
                 {
-                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-                    traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait );
-
-                    /* All ports are written to allow a yield in a critical
-                     * section (some will yield immediately, others wait until the
-                     * critical section exits) - but it is not something that
-                     * application code should ever do. */
-                    portYIELD_WITHIN_API();
+                    xNextTaskUnblockTime = xTimeToWake;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
         }
-        taskEXIT_CRITICAL();
+    }
+    #else /* INCLUDE_vTaskSuspend */
+    {
+        /* Calculate the time at which the task should be woken if the event
+         * does not occur.  This may overflow but this doesn't matter, the kernel
+         * will manage it correctly. */
+        xTimeToWake = xConstTickCount + xTicksToWait;
 
-        taskENTER_CRITICAL();
+        /* The list item will be inserted in wake time order. */
+        listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+
+        if( xTimeToWake < xConstTickCount )
         {
-            traceTASK_NOTIFY_TAKE( uxIndexToWait );
-            ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
+            /* Wake time has overflowed.  Place this item in the overflow list. */
+            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+        }
+        else
+        {
+            /* The wake time has not overflowed, so the current block list is used. */
+            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 
-            if( ulReturn != 0UL )
+            /* If the task entering the blocked state was placed at the head of the
+             * list of blocked tasks then xNextTaskUnblockTime needs to be updated
+             * too. */
+            if( xTimeToWake < xNextTaskUnblockTime )
             {
-                if( xClearCountOnExit != pdFALSE )
-                {
-                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
-                }
-                else
-                {
-                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
-                }
+                xNextTaskUnblockTime = xTimeToWake;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-
-            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
         }
-        taskEXIT_CRITICAL();
 
-        return ulReturn;
+        /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
+        ( void ) xCanBlockIndefinitely;
     }
+    #endif /* INCLUDE_vTaskSuspend */
+}
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
-/*-----------------------------------------------------------*/
+/* Code below here allows additional code to be inserted into this source file,
+ * especially where access to file scope functions and data is needed (for example
+ * when performing module tests). */
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#ifdef FREERTOS_MODULE_TEST
+    #include "tasks_test_access_functions.h"
+#endif
 
-    BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait,
-                                       uint32_t ulBitsToClearOnEntry,
-                                       uint32_t ulBitsToClearOnExit,
-                                       uint32_t * pulNotificationValue,
-                                       TickType_t xTicksToWait )
-    {
-        BaseType_t xReturn;
 
-        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+#if ( configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H == 1 )
 
-        taskENTER_CRITICAL();
+    #include "freertos_tasks_c_additions.h"
+
+    #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+        static void freertos_tasks_c_additions_init( void )
         {
-            /* Only block if a notification is not already pending. */
-            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
+            FREERTOS_TASKS_C_ADDITIONS_INIT();
+        }
+    #endif
+
+#endif /* if ( configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H == 1 ) */
+
+#if ( (INCLUDE_xTaskCreateAperiodic == 1) && (configUSE_POLLING_SERVER == 1))
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        TaskHandle_t xTaskCreateAperiodicStatic( TaskFunction_t pxTaskCode,
+                                        const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const uint32_t ulStackDepth,
+                                        void * const pvParameters,
+                                        UBaseType_t uxPriority,
+                                        UBaseType_t uxDuration,
+                                        UBaseType_t uxDeadline,
+                                        StackType_t * const puxStackBuffer,
+                                        StaticTask_t * const pxTaskBuffer )
+        {
+            TCB_t * pxNewTCB;
+            TaskHandle_t xReturn;
+
+            #if ( configUSE_ADMISSION_CONTROL == 1 )
+                uint32_t ulAdmittedLoad;
+
+                if( prvAdmitTask( pdFALSE, uxDuration, uxDeadline, &ulAdmittedLoad ) != pdPASS )
+                {
+                    return NULL;
+                }
+            #endif
+
+            configASSERT( puxStackBuffer != NULL );
+            configASSERT( pxTaskBuffer != NULL );
+
+            #if ( configASSERT_DEFINED == 1 )
             {
-                /* Clear bits in the task's notification value as bits may get
-                 * set  by the notifying task or interrupt.  This can be used to
-                 * clear the value to zero. */
-                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticTask_t equals the size of the real task
+                 * structure. */
+                volatile size_t xSize = sizeof( StaticTask_t );
+                configASSERT( xSize == sizeof( TCB_t ) );
+                ( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
+            }
+            #endif /* configASSERT_DEFINED */
 
-                /* Mark this task as waiting for a notification. */
-                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
+            if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
+            {
+                /* The memory used for the task's TCB and stack are passed into this
+                 * function - use them. */
+                pxNewTCB = ( TCB_t * ) pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+                memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+                pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
 
-                if( xTicksToWait > ( TickType_t ) 0 )
+                #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
                 {
-                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-                    traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait );
-
-                    /* All ports are written to allow a yield in a critical
-                     * section (some will yield immediately, others wait until the
-                     * critical section exits) - but it is not something that
-                     * application code should ever do. */
-                    portYIELD_WITHIN_API();
+                    /* Tasks can be created statically or dynamically, so note this
+                     * task was created statically in case the task is later deleted. */
+                    pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
                 }
-                else
+                #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+                prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL );
+                // Assign the missing values to the TCB instead of creating a new function
+                pxNewTCB->uxDuration = uxDuration;
+                pxNewTCB->uxDeadline = uxDeadline;
+                pxNewTCB->uxPeriod = portMAX_DELAY;
+
+                #if ( configUSE_ADMISSION_CONTROL == 1 )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    pxNewTCB->ulAdmittedLoad = ulAdmittedLoad;
                 }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        taskEXIT_CRITICAL();
+                #endif
 
-        taskENTER_CRITICAL();
-        {
-            traceTASK_NOTIFY_WAIT( uxIndexToWait );
+                #if ( configUSE_APERIODIC_BUDGET == 1 )
+                {
+                    pxNewTCB->xBudgetRemaining = ( TickType_t ) uxDuration;
+                }
+                #endif
 
-            if( pulNotificationValue != NULL )
-            {
-                /* Output the current notification value, which may or may not
-                 * have changed. */
-                *pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
-            }
+                #if ( configUSE_EDF_SCHEDULER == 1 )
+                {
+                    /* An aperiodic task is a single job, released when the
+                     * task is created. */
+                    prvReleaseJob( pxNewTCB, xTaskGetTickCount() );
+                }
+                #endif
 
-            /* If ucNotifyValue is set then either the task never entered the
-             * blocked state (because a notification was already pending) or the
-             * task unblocked because of a notification.  Otherwise the task
-             * unblocked because of a timeout. */
-            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
-            {
-                /* A notification was not received. */
-                xReturn = pdFALSE;
+                listSET_LIST_ITEM_VALUE( &( pxNewTCB->xStateListItem ), pxNewTCB->uxDeadline );
+                prvAddNewTaskByDeadlineToReadyList( pxNewTCB );
             }
             else
             {
-                /* A notification was already pending or a notification was
-                 * received while the task was waiting. */
-                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
-                xReturn = pdTRUE;
+                #if ( configUSE_ADMISSION_CONTROL == 1 )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        prvAdmissionRelease( pdFALSE, ulAdmittedLoad );
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                #endif
+
+                xReturn = NULL;
             }
 
-            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
+            return xReturn;
         }
-        taskEXIT_CRITICAL();
 
-        return xReturn;
-    }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
-/*-----------------------------------------------------------*/
+    #endif /* SUPPORT_STATIC_ALLOCATION */
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        BaseType_t xTaskCreateAperiodic( TaskFunction_t pxTaskCode,
+                                const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                const configSTACK_DEPTH_TYPE usStackDepth,
+                                void * const pvParameters,
+                                UBaseType_t uxPriority,
+                                UBaseType_t uxDuration,
+                                UBaseType_t uxDeadline,
+                                TaskHandle_t * const pxCreatedTask )
+        {
+            TCB_t * pxNewTCB;
+            BaseType_t xReturn;
 
-    BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
-                                   UBaseType_t uxIndexToNotify,
-                                   uint32_t ulValue,
-                                   eNotifyAction eAction,
-                                   uint32_t * pulPreviousNotificationValue )
-    {
-        TCB_t * pxTCB;
-        BaseType_t xReturn = pdPASS;
-        uint8_t ucOriginalNotifyState;
+            #if ( configUSE_ADMISSION_CONTROL == 1 )
+                uint32_t ulAdmittedLoad;
 
-        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
-        configASSERT( xTaskToNotify );
-        pxTCB = xTaskToNotify;
+                /* Reserve the share of the task before anything is allocated,
+                 * so a task that is not admitted costs nothing. */
+                if( prvAdmitTask( pdFALSE, uxDuration, uxDeadline, &ulAdmittedLoad ) != pdPASS )
+                {
+                    return errSCHEDULE_NOT_ADMITTED;
+                }
+            #endif
 
-        taskENTER_CRITICAL();
-        {
-            if( pulPreviousNotificationValue != NULL )
+            /* If the stack grows down then allocate the stack then the TCB so the stack
+             * does not grow into the TCB.  Likewise if the stack grows up then allocate
+             * the TCB then the stack. */
+            #if ( portSTACK_GROWTH > 0 )
             {
-                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
-            }
+                /* Allocate space for the TCB.  Where the memory comes from depends on
+                 * the implementation of the port malloc function and whether or not static
+                 * allocation is being used. */
+                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
 
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+                if( pxNewTCB != NULL )
+                {
+                    memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
 
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+                    /* Allocate space for the stack used by the task being created.
+                     * The base of the stack memory stored in the TCB so the task can
+                     * be deleted later if required. */
+                    pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
-            switch( eAction )
+                    if( pxNewTCB->pxStack == NULL )
+                    {
+                        /* Could not allocate the stack.  Delete the allocated TCB. */
+                        vPortFree( pxNewTCB );
+                        pxNewTCB = NULL;
+                    }
+                }
+            }
+            #else /* portSTACK_GROWTH */
             {
-                case eSetBits:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
-                    break;
-
-                case eIncrement:
-                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
-                    break;
+                StackType_t * pxStack;
 
-                case eSetValueWithOverwrite:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    break;
+                /* Allocate space for the stack used by the task being created. */
+                pxStack = pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
 
-                case eSetValueWithoutOverwrite:
+                if( pxStack != NULL )
+                {
+                    /* Allocate space for the TCB. */
+                    pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
 
-                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+                    if( pxNewTCB != NULL )
                     {
-                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                        memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+
+                        /* Store the stack location in the TCB. */
+                        pxNewTCB->pxStack = pxStack;
                     }
                     else
                     {
-                        /* The value could not be written to the task. */
-                        xReturn = pdFAIL;
+                        /* The stack cannot be used as the TCB was not created.  Free
+                         * it again. */
+                        vPortFreeStack( pxStack );
                     }
-
-                    break;
-
-                case eNoAction:
-
-                    /* The task is being notified without its notify value being
-                     * updated. */
-                    break;
-
-                default:
-
-                    /* Should not get here if all enums are handled.
-                     * Artificially force an assert by testing a value the
-                     * compiler can't assume is const. */
-                    configASSERT( xTickCount == ( TickType_t ) 0 );
-
-                    break;
+                }
+                else
+                {
+                    pxNewTCB = NULL;
+                }
             }
+            #endif /* portSTACK_GROWTH */
 
-            traceTASK_NOTIFY( uxIndexToNotify );
-
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            if( pxNewTCB != NULL )
             {
-                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                prvAddTaskToReadyList( pxTCB );
+                #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
+                {
+                    /* Tasks can be created statically or dynamically, so note this
+                     * task was created dynamically in case it is later deleted. */
+                    pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
+                }
+                #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+                prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+                pxNewTCB->uxDuration = uxDuration;
+                pxNewTCB->uxDeadline = uxDeadline;
+                pxNewTCB->uxPeriod = portMAX_DELAY;
 
-                #if ( configUSE_TICKLESS_IDLE != 0 )
+                #if ( configUSE_ADMISSION_CONTROL == 1 )
                 {
-                    /* If a task is blocked waiting for a notification then
-                     * xNextTaskUnblockTime might be set to the blocked task's time
-                     * out time.  If the task is unblocked for a reason other than
-                     * a timeout xNextTaskUnblockTime is normally left unchanged,
-                     * because it will automatically get reset to a new value when
-                     * the tick count equals xNextTaskUnblockTime.  However if
-                     * tickless idling is used it might be more important to enter
-                     * sleep mode at the earliest possible time - so reset
-                     * xNextTaskUnblockTime here to ensure it is updated at the
-                     * earliest possible time. */
-                    prvResetNextTaskUnblockTime();
+                    pxNewTCB->ulAdmittedLoad = ulAdmittedLoad;
                 }
                 #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                #if ( configUSE_APERIODIC_BUDGET == 1 )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    taskYIELD_IF_USING_PREEMPTION();
+                    pxNewTCB->xBudgetRemaining = ( TickType_t ) uxDuration;
                 }
-                else
+                #endif
+
+                #if ( configUSE_EDF_SCHEDULER == 1 )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* An aperiodic task is a single job, released when the
+                     * task is created. */
+                    prvReleaseJob( pxNewTCB, xTaskGetTickCount() );
+                }
+                #endif
+
+                listSET_LIST_ITEM_VALUE( &( pxNewTCB->xStateListItem ), pxNewTCB->uxDeadline );
+                prvAddNewTaskByDeadlineToReadyList( pxNewTCB );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                #if ( configUSE_ADMISSION_CONTROL == 1 )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        prvAdmissionRelease( pdFALSE, ulAdmittedLoad );
+                    }
+                    taskEXIT_CRITICAL();
                 }
+                #endif
+
+                xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
             }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        taskEXIT_CRITICAL();
 
-        return xReturn;
-    }
+            return xReturn;
+        }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
-/*-----------------------------------------------------------*/
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+#endif
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( configUSE_TASK_POOL == 1 )
 
-    BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
-                                          UBaseType_t uxIndexToNotify,
-                                          uint32_t ulValue,
-                                          eNotifyAction eAction,
-                                          uint32_t * pulPreviousNotificationValue,
-                                          BaseType_t * pxHigherPriorityTaskWoken )
+    TaskPoolHandle_t xTaskPoolCreate( UBaseType_t uxSlots,
+                                      configSTACK_DEPTH_TYPE usStackDepth )
     {
-        TCB_t * pxTCB;
-        uint8_t ucOriginalNotifyState;
-        BaseType_t xReturn = pdPASS;
-        UBaseType_t uxSavedInterruptStatus;
+        TaskPool_t * pxTaskPool = NULL;
+        TCB_t * pxTCBs;
+        StackType_t * pxStacks = NULL;
+        UBaseType_t uxSlot;
 
-        configASSERT( xTaskToNotify );
-        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
-
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+        configASSERT( uxSlots > ( UBaseType_t ) 0U );
 
-        pxTCB = xTaskToNotify;
+        /* The TCBs come first so that the pool structure placed after them is
+         * aligned.  The stacks are allocated as those of any other task. */
+        pxTCBs = ( TCB_t * ) pvPortMalloc( ( ( size_t ) uxSlots * sizeof( TCB_t ) ) + sizeof( TaskPool_t ) );
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        if( pxTCBs != NULL )
         {
-            if( pulPreviousNotificationValue != NULL )
+            pxStacks = ( StackType_t * ) pvPortMallocStack( ( size_t ) uxSlots * ( size_t ) usStackDepth * sizeof( StackType_t ) );
+
+            if( pxStacks == NULL )
             {
-                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
+                vPortFree( pxTCBs );
+                pxTCBs = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+        if( pxTCBs != NULL )
+        {
+            pxTaskPool = ( TaskPool_t * ) &( pxTCBs[ uxSlots ] );
+            pxTaskPool->pxTCBs = pxTCBs;
+            pxTaskPool->pxStacks = pxStacks;
+            pxTaskPool->usStackDepth = usStackDepth;
+            vListInitialise( &( pxTaskPool->xFreeSlots ) );
+            vListInitialise( &( pxTaskPool->xSlotsWaitingRelease ) );
 
-            switch( eAction )
+            for( uxSlot = ( UBaseType_t ) 0U; uxSlot < uxSlots; uxSlot++ )
             {
-                case eSetBits:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
-                    break;
-
-                case eIncrement:
-                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
-                    break;
+                vListInitialiseItem( &( pxTCBs[ uxSlot ].xStateListItem ) );
+                listSET_LIST_ITEM_OWNER( &( pxTCBs[ uxSlot ].xStateListItem ), &( pxTCBs[ uxSlot ] ) );
+                vListInsertEnd( &( pxTaskPool->xFreeSlots ), &( pxTCBs[ uxSlot ].xStateListItem ) );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                case eSetValueWithOverwrite:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    break;
+        return pxTaskPool;
+    }
+/*-----------------------------------------------------------*/
 
-                case eSetValueWithoutOverwrite:
+    static TCB_t * prvTaskPoolTakeSlot( TaskPool_t * pxTaskPool )
+    {
+        TCB_t * pxTCB = NULL;
+        TCB_t * pxReleasedTCB = NULL;
+        size_t xSlot;
 
-                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
-                    {
-                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    }
-                    else
-                    {
-                        /* The value could not be written to the task. */
-                        xReturn = pdFAIL;
-                    }
+        taskENTER_CRITICAL();
+        {
+            /* The calling task runs, so a task of the pool that deleted itself
+             * no longer does, unless another core has yet to leave it, and its
+             * slot can be released.  One slot per call keeps the time bounded,
+             * and is enough for this call to find a free slot whenever one of
+             * the tasks of the pool has ended. */
+            if( ( listLIST_IS_EMPTY( &( pxTaskPool->xSlotsWaitingRelease ) ) == pdFALSE ) &&
+                ( taskTASK_IS_RUNNING( ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &( pxTaskPool->xSlotsWaitingRelease ) ) ) ) == pdFALSE ) ) /*lint !e9079 void * is used as this macro is used with timers and co-routines too. */
+            {
+                pxReleasedTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &( pxTaskPool->xSlotsWaitingRelease ) ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                ( void ) uxListRemove( &( pxReleasedTCB->xStateListItem ) );
+                --uxCurrentNumberOfTasks;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
 
-                    break;
+        if( pxReleasedTCB != NULL )
+        {
+            /* Outside of the critical section, as in vTaskDelete(), since the
+             * port may wait for the task to end.  This puts the slot in the
+             * free list. */
+            prvDeleteTCB( pxReleasedTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-                case eNoAction:
+        taskENTER_CRITICAL();
+        {
+            if( listLIST_IS_EMPTY( &( pxTaskPool->xFreeSlots ) ) == pdFALSE )
+            {
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &( pxTaskPool->xFreeSlots ) ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
 
-                    /* The task is being notified without its notify value being
-                     * updated. */
-                    break;
+        if( pxTCB != NULL )
+        {
+            xSlot = ( size_t ) ( pxTCB - pxTaskPool->pxTCBs );
 
-                default:
+            memset( ( void * ) pxTCB, 0x00, sizeof( TCB_t ) );
+            pxTCB->pxStack = &( pxTaskPool->pxStacks[ xSlot * ( size_t ) pxTaskPool->usStackDepth ] );
+            pxTCB->pxTaskPool = pxTaskPool;
 
-                    /* Should not get here if all enums are handled.
-                     * Artificially force an assert by testing a value the
-                     * compiler can't assume is const. */
-                    configASSERT( xTickCount == ( TickType_t ) 0 );
-                    break;
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
+            {
+                /* prvDeleteTCB() gives the slot back to the pool before it
+                 * looks at this, but nothing must be freed either way. */
+                pxTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
             }
+            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
+        return pxTCB;
+    }
+/*-----------------------------------------------------------*/
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
-            {
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+    BaseType_t xTaskCreateFromPool( TaskPoolHandle_t xTaskPool,
+                                    TaskFunction_t pxTaskCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    TaskHandle_t * const pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn;
 
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-                {
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-                }
-                else
-                {
-                    /* The delayed and ready lists cannot be accessed, so hold
-                     * this task pending until the scheduler is resumed. */
-                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
-                }
+        configASSERT( xTaskPool != NULL );
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
-                    {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
-                    }
+        pxNewTCB = prvTaskPoolTakeSlot( xTaskPool );
 
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter to an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
+        if( pxNewTCB != NULL )
+        {
+            prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) xTaskPool->usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+            prvAddNewTaskToReadyList( pxNewTCB );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
         return xReturn;
     }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-
-    void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify,
-                                        UBaseType_t uxIndexToNotify,
-                                        BaseType_t * pxHigherPriorityTaskWoken )
-    {
-        TCB_t * pxTCB;
-        uint8_t ucOriginalNotifyState;
-        UBaseType_t uxSavedInterruptStatus;
-
-        configASSERT( xTaskToNotify );
-        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+    #if ( ( INCLUDE_xTaskCreateAperiodic == 1 ) && ( configUSE_POLLING_SERVER == 1 ) )
 
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+        BaseType_t xTaskCreateAperiodicFromPool( TaskPoolHandle_t xTaskPool,
+                                                 TaskFunction_t pxTaskCode,
+                                                 const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                 void * const pvParameters,
+                                                 UBaseType_t uxPriority,
+                                                 TickType_t uxDuration,
+                                                 TickType_t uxDeadline,
+                                                 TaskHandle_t * const pxCreatedTask )
+        {
+            TCB_t * pxNewTCB;
+            BaseType_t xReturn;
 
-        pxTCB = xTaskToNotify;
+            configASSERT( xTaskPool != NULL );
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
-        {
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+            #if ( configUSE_ADMISSION_CONTROL == 1 )
+                uint32_t ulAdmittedLoad;
 
-            /* 'Giving' is equivalent to incrementing a count in a counting
-             * semaphore. */
-            ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+                if( prvAdmitTask( pdFALSE, uxDuration, uxDeadline, &ulAdmittedLoad ) != pdPASS )
+                {
+                    return errSCHEDULE_NOT_ADMITTED;
+                }
+            #endif
 
-            traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
+            pxNewTCB = prvTaskPoolTakeSlot( xTaskPool );
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            if( pxNewTCB != NULL )
             {
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+                prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) xTaskPool->usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+                pxNewTCB->uxDuration = uxDuration;
+                pxNewTCB->uxDeadline = uxDeadline;
+                pxNewTCB->uxPeriod = portMAX_DELAY;
+
+                #if ( configUSE_ADMISSION_CONTROL == 1 )
+                {
+                    pxNewTCB->ulAdmittedLoad = ulAdmittedLoad;
+                }
+                #endif
 
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                #if ( configUSE_APERIODIC_BUDGET == 1 )
                 {
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                    pxNewTCB->xBudgetRemaining = ( TickType_t ) uxDuration;
                 }
-                else
+                #endif
+
+                #if ( configUSE_EDF_SCHEDULER == 1 )
                 {
-                    /* The delayed and ready lists cannot be accessed, so hold
-                     * this task pending until the scheduler is resumed. */
-                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    /* An aperiodic task is a single job, released when the
+                     * task is created. */
+                    prvReleaseJob( pxNewTCB, xTaskGetTickCount() );
                 }
+                #endif
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                listSET_LIST_ITEM_VALUE( &( pxNewTCB->xStateListItem ), pxNewTCB->uxDeadline );
+                prvAddNewTaskByDeadlineToReadyList( pxNewTCB );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                #if ( configUSE_ADMISSION_CONTROL == 1 )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
+                    taskENTER_CRITICAL();
                     {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
+                        prvAdmissionRelease( pdFALSE, ulAdmittedLoad );
                     }
-
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter in an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
+                    taskEXIT_CRITICAL();
                 }
+                #endif
+
+                xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
             }
-        }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-    }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
-/*-----------------------------------------------------------*/
+            return xReturn;
+        }
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+    #endif /* ( INCLUDE_xTaskCreateAperiodic == 1 ) && ( configUSE_POLLING_SERVER == 1 ) */
 
-    BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask,
-                                             UBaseType_t uxIndexToClear )
-    {
-        TCB_t * pxTCB;
-        BaseType_t xReturn;
+#endif /* configUSE_TASK_POOL */
 
-        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+#if ( configUSE_APERIODIC_JOBS == 1 )
 
-        /* If null is passed in here then it is the calling task that is having
-         * its notification state cleared. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+    BaseType_t xTaskCreateJobWorkers( UBaseType_t uxWorkers,
+                                      configSTACK_DEPTH_TYPE usStackDepth,
+                                      UBaseType_t uxPriority )
+    {
+        BaseType_t xReturn = pdPASS;
+        UBaseType_t uxWorker;
+        TaskHandle_t xWorker;
 
-        taskENTER_CRITICAL();
+        /* A worker cannot be given a job before it has run, so holding the
+         * scheduler is enough to record its priority first. */
+        vTaskSuspendAll();
         {
-            if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
-            {
-                pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
-                xReturn = pdPASS;
-            }
-            else
+            for( uxWorker = ( UBaseType_t ) 0U; ( uxWorker < uxWorkers ) && ( xReturn == pdPASS ); uxWorker++ )
             {
-                xReturn = pdFAIL;
+                /* Without a job the worker has no execution time to account
+                 * for.  It runs once, to reach prvJobWorkerNextJob(), and from
+                 * then on only when it has a job. */
+                xReturn = xTaskCreateAperiodic( prvJobWorkerTask, "JobWorker", usStackDepth, NULL, uxPriority, ( UBaseType_t ) 0U, ( UBaseType_t ) taskJOB_WORKER_DEADLINE, &xWorker );
+
+                if( xReturn == pdPASS )
+                {
+                    ( ( TCB_t * ) xWorker )->uxWorkerPriority = uxPriority;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
         }
-        taskEXIT_CRITICAL();
+        ( void ) xTaskResumeAll();
 
         return xReturn;
     }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
-
-    uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
-                                            UBaseType_t uxIndexToClear,
-                                            uint32_t ulBitsToClear )
+    static portTASK_FUNCTION( prvJobWorkerTask, pvParameters )
     {
-        TCB_t * pxTCB;
-        uint32_t ulReturn;
+        AperiodicJob_t * pxJob;
 
-        /* If null is passed in here then it is the calling task that is having
-         * its notification state cleared. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        ( void ) pvParameters;
 
-        taskENTER_CRITICAL();
+        for( ; ; )
         {
-            /* Return the notification as it was before the bits were cleared,
-             * then clear the bit mask. */
-            ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
-            pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
+            pxJob = prvJobWorkerNextJob();
+            pxJob->pxJobCode( pxJob->pvParameters );
         }
-        taskEXIT_CRITICAL();
-
-        return ulReturn;
     }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
-
-    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+    static AperiodicJob_t * prvJobWorkerNextJob( void )
     {
-        return xIdleTaskHandle->ulRunTimeCounter;
-    }
-
-#endif
-/*-----------------------------------------------------------*/
+        TCB_t * pxTCB;
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) )
+        configASSERT( taskSCHEDULER_SUSPENDED_BY_CALLER() == pdFALSE );
 
-    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
-    {
-        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
+        taskENTER_CRITICAL();
+        {
+            pxTCB = pxCurrentTCB;
 
-        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+            if( pxTCB->pxAperiodicJob != NULL )
+            {
+                pxTCB->pxAperiodicJob->xCompletionTime = xTickCount;
+                pxTCB->pxAperiodicJob->eState = eJobDone;
+                pxTCB->pxAperiodicJob = NULL;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        /* For percentage calculations. */
-        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+            /* The worker goes back to the ready list with the deadline of its
+             * next job, or waits without being scheduled. */
+            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            {
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        /* Avoid divide by zero errors. */
-        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
-        {
-            ulReturn = xIdleTaskHandle->ulRunTimeCounter / ulTotalTime;
-        }
-        else
-        {
-            ulReturn = 0;
+            if( xJobQueue.uxCount > ( UBaseType_t ) 0U )
+            {
+                prvJobWorkerAssign( pxTCB, prvJobQueuePop() );
+                prvAddTaskToReadyList( pxTCB );
+            }
+            else
+            {
+                vListInsertEnd( &( xJobQueue.xIdleWorkers ), &( pxTCB->xStateListItem ) );
+            }
         }
+        taskEXIT_CRITICAL();
 
-        return ulReturn;
-    }
+        /* Let the most urgent task run.  A worker that waits is switched back
+         * in once xTaskSubmitJob() has given it a job. */
+        portYIELD_WITHIN_API();
 
-#endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
+        return pxCurrentTCB->pxAperiodicJob;
+    }
 /*-----------------------------------------------------------*/
 
-static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
-                                            const BaseType_t xCanBlockIndefinitely )
-{
-    TickType_t xTimeToWake;
-    const TickType_t xConstTickCount = xTickCount;
-
-    #if ( INCLUDE_xTaskAbortDelay == 1 )
+    static void prvJobWorkerAssign( TCB_t * pxTCB,
+                                    AperiodicJob_t * pxJob )
     {
-        /* About to enter a delayed list, so ensure the ucDelayAborted flag is
-         * reset to pdFALSE so it can be detected as having been set to pdTRUE
-         * when the task leaves the Blocked state. */
-        pxCurrentTCB->ucDelayAborted = pdFALSE;
-    }
-    #endif
+        pxTCB->pxAperiodicJob = pxJob;
+        pxTCB->uxDuration = ( UBaseType_t ) pxJob->xDuration;
+        pxTCB->uxDeadline = pxJob->xDeadline;
+        pxJob->eState = eJobRunning;
+
+        /* tskAPERIODIC_OVERRUN_DEMOTE drops a worker that overran its last job
+         * to the idle priority.  The worker is not in a ready list here, so its
+         * priority can be given back directly, as for the budget. */
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            /* A priority inherited through a mutex held across jobs is kept
+             * until the mutex is given back. */
+            if( pxTCB->uxBasePriority == pxTCB->uxPriority )
+            {
+                pxTCB->uxPriority = pxTCB->uxWorkerPriority;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    /* Remove the task from the ready list before adding it to the blocked list
-     * as the same list item is used for both lists. */
-    if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-    {
-        /* The current task must be in a ready list, so there is no need to
-         * check, and the port reset macro can be called directly. */
-        portRESET_READY_PRIORITY( pxCurrentTCB->uxPriority, uxTopReadyPriority ); /*lint !e931 pxCurrentTCB cannot change as it is the calling task.  pxCurrentTCB->uxPriority and uxTopReadyPriority cannot change as called with scheduler suspended or in a critical section. */
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+            pxTCB->uxBasePriority = pxTCB->uxWorkerPriority;
+        }
+        #else
+        {
+            pxTCB->uxPriority = pxTCB->uxWorkerPriority;
+        }
+        #endif
 
-    #if ( INCLUDE_vTaskSuspend == 1 )
-    {
-        if( ( xTicksToWait == portMAX_DELAY ) && ( xCanBlockIndefinitely != pdFALSE ) )
+        if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
         {
-            /* Add the task to the suspended task list instead of a delayed task
-             * list to ensure it is not woken by a timing event.  It will block
-             * indefinitely. */
-            listINSERT_END( &xSuspendedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - pxTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
         }
         else
         {
-            /* Calculate the time at which the task should be woken if the event
-             * does not occur.  This may overflow but this doesn't matter, the
-             * kernel will manage it correctly. */
-            xTimeToWake = xConstTickCount + xTicksToWait;
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            /* The list item will be inserted in wake time order. */
-            listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+        #if ( configUSE_APERIODIC_BUDGET == 1 )
+        {
+            pxTCB->xBudgetRemaining = pxJob->xDuration;
 
-            if( xTimeToWake < xConstTickCount )
+            #if ( configAPERIODIC_OVERRUN_POLICY == tskAPERIODIC_OVERRUN_THROTTLE )
             {
-                /* Wake time has overflowed.  Place this item in the overflow
-                 * list. */
-                vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+                /* An overrun of the previous job is not carried over. */
+                pxTCB->xThrottlePending = pdFALSE;
             }
-            else
-            {
-                /* The wake time has not overflowed, so the current block list
-                 * is used. */
-                vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            #endif
+        }
+        #endif
 
-                /* If the task entering the blocked state was placed at the
-                 * head of the list of blocked tasks then xNextTaskUnblockTime
-                 * needs to be updated too. */
-                if( xTimeToWake < xNextTaskUnblockTime )
-                {
-                    xNextTaskUnblockTime = xTimeToWake;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
+        #if ( configUSE_EDF_SCHEDULER == 1 )
+        {
+            /* The deadline runs from the submission, however long the job
+             * waited for the worker. */
+            prvReleaseJob( pxTCB, pxJob->xReleaseTime );
         }
+        #endif
     }
-    #else /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSubmitJob( AperiodicJob_t * pxJob,
+                                    BaseType_t * pxYieldRequired )
     {
-        /* Calculate the time at which the task should be woken if the event
-         * does not occur.  This may overflow but this doesn't matter, the kernel
-         * will manage it correctly. */
-        xTimeToWake = xConstTickCount + xTicksToWait;
+        TCB_t * pxTCB;
+        BaseType_t xReturn = pdPASS;
 
-        /* The list item will be inserted in wake time order. */
-        listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+        *pxYieldRequired = pdFALSE;
+        pxJob->xReleaseTime = xTickCount;
+        pxJob->uxOrder = xJobQueue.uxNextOrder;
+        ( xJobQueue.uxNextOrder )++;
 
-        if( xTimeToWake < xConstTickCount )
+        if( listLIST_IS_EMPTY( &( xJobQueue.xIdleWorkers ) ) == pdFALSE )
         {
-            /* Wake time has overflowed.  Place this item in the overflow list. */
-            vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-        }
-        else
-        {
-            /* The wake time has not overflowed, so the current block list is used. */
-            vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+            /* No job can be queued while a worker waits, so this one is the
+             * most urgent - hand it over. */
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &( xJobQueue.xIdleWorkers ) ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+            prvJobWorkerAssign( pxTCB, pxJob );
 
-            /* If the task entering the blocked state was placed at the head of the
-             * list of blocked tasks then xNextTaskUnblockTime needs to be updated
-             * too. */
-            if( xTimeToWake < xNextTaskUnblockTime )
+            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
             {
-                xNextTaskUnblockTime = xTimeToWake;
+                prvAddTaskToReadyList( pxTCB );
+
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    if( ( xSchedulerRunning != pdFALSE ) && taskAPERIODIC_PREEMPTS( pxTCB ) )
+                    {
+                        *pxYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_PREEMPTION */
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* The ready lists cannot be accessed, xTaskResumeAll() moves
+                 * the worker there. */
+                vListInsertEnd( &( xJobQueue.xWakingWorkers ), &( pxTCB->xStateListItem ) );
+                vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
             }
         }
+        else if( xJobQueue.uxCount < ( UBaseType_t ) configAPERIODIC_JOB_QUEUE_LENGTH )
+        {
+            pxJob->eState = eJobQueued;
+            prvJobQueuePush( pxJob );
+        }
+        else
+        {
+            xReturn = errQUEUE_FULL;
+        }
 
-        /* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
-        ( void ) xCanBlockIndefinitely;
+        return xReturn;
     }
-    #endif /* INCLUDE_vTaskSuspend */
-}
-
-/* Code below here allows additional code to be inserted into this source file,
- * especially where access to file scope functions and data is needed (for example
- * when performing module tests). */
-
-#ifdef FREERTOS_MODULE_TEST
-    #include "tasks_test_access_functions.h"
-#endif
+/*-----------------------------------------------------------*/
 
+    BaseType_t xTaskSubmitJob( AperiodicJob_t * pxJob )
+    {
+        BaseType_t xReturn;
+        BaseType_t xYieldRequired;
 
-#if ( configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H == 1 )
+        configASSERT( pxJob );
+        configASSERT( pxJob->pxJobCode );
 
-    #include "freertos_tasks_c_additions.h"
+        /* A deadline of portMAX_DELAY is what marks a task as periodic. */
+        configASSERT( pxJob->xDeadline != portMAX_DELAY );
 
-    #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
-        static void freertos_tasks_c_additions_init( void )
+        taskENTER_CRITICAL();
         {
-            FREERTOS_TASKS_C_ADDITIONS_INIT();
+            xReturn = prvSubmitJob( pxJob, &xYieldRequired );
+
+            if( xYieldRequired != pdFALSE )
+            {
+                taskYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-    #endif
+        taskEXIT_CRITICAL();
 
-#endif /* if ( configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H == 1 ) */
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-#if ( (INCLUDE_xTaskCreateAperiodic == 1) && (configUSE_POLLING_SERVER == 1))
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    BaseType_t xTaskSubmitJobFromISR( AperiodicJob_t * pxJob,
+                                      BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn;
+        BaseType_t xYieldRequired;
+        UBaseType_t uxSavedInterruptStatus;
 
-        TaskHandle_t xTaskCreateAperiodicStatic( TaskFunction_t pxTaskCode,
-                                        const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                                        const uint32_t ulStackDepth,
-                                        void * const pvParameters,
-                                        UBaseType_t uxPriority,
-                                        UBaseType_t uxDuration,
-                                        UBaseType_t uxDeadline,
-                                        StackType_t * const puxStackBuffer,
-                                        StaticTask_t * const pxTaskBuffer )
-        {
-            TCB_t * pxNewTCB;
-            TaskHandle_t xReturn;
+        configASSERT( pxJob );
+        configASSERT( pxJob->pxJobCode );
+        configASSERT( pxJob->xDeadline != portMAX_DELAY );
 
-            configASSERT( puxStackBuffer != NULL );
-            configASSERT( pxTaskBuffer != NULL );
+        /* See the comment on portASSERT_IF_INTERRUPT_PRIORITY_INVALID() in
+         * xTaskResumeFromISR(). */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-            #if ( configASSERT_DEFINED == 1 )
-            {
-                /* Sanity check that the size of the structure used to declare a
-                 * variable of type StaticTask_t equals the size of the real task
-                 * structure. */
-                volatile size_t xSize = sizeof( StaticTask_t );
-                configASSERT( xSize == sizeof( TCB_t ) );
-                ( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
-            }
-            #endif /* configASSERT_DEFINED */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            xReturn = prvSubmitJob( pxJob, &xYieldRequired );
 
-            if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
+            if( xYieldRequired != pdFALSE )
             {
-                /* The memory used for the task's TCB and stack are passed into this
-                 * function - use them. */
-                pxNewTCB = ( TCB_t * ) pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
-                memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
-                pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
-
-                #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+                if( pxHigherPriorityTaskWoken != NULL )
                 {
-                    /* Tasks can be created statically or dynamically, so note this
-                     * task was created statically in case the task is later deleted. */
-                    pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+                    *pxHigherPriorityTaskWoken = pdTRUE;
                 }
-                #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
-
-                prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL );
-                // Assign the missing values to the TCB instead of creating a new function
-                pxNewTCB->uxDuration = uxDuration;
-                pxNewTCB->uxDeadline = uxDeadline;
-                pxNewTCB->uxPeriod = portMAX_DELAY;
 
-                listSET_LIST_ITEM_VALUE( &( pxNewTCB->xStateListItem ), pxNewTCB->uxDeadline );
-                prvAddNewTaskByDeadlineToReadyList( pxNewTCB );
+                /* Mark that a yield is pending in case the user is not using
+                 * the "xHigherPriorityTaskWoken" parameter to an ISR safe
+                 * FreeRTOS function. */
+                xYieldPending = pdTRUE;
             }
             else
             {
-                xReturn = NULL;
+                mtCOVERAGE_TEST_MARKER();
             }
-
-            return xReturn;
         }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-    #endif /* SUPPORT_STATIC_ALLOCATION */
-    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-        BaseType_t xTaskCreateAperiodic( TaskFunction_t pxTaskCode,
-                                const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                                const configSTACK_DEPTH_TYPE usStackDepth,
-                                void * const pvParameters,
-                                UBaseType_t uxPriority,
-                                UBaseType_t uxDuration,
-                                UBaseType_t uxDeadline,
-                                TaskHandle_t * const pxCreatedTask )
+    static BaseType_t prvJobQueueLess( const AperiodicJob_t * pxA,
+                                       const AperiodicJob_t * pxB )
+    {
+        const TickType_t xDeadlineA = pxA->xReleaseTime + pxA->xDeadline;
+        const TickType_t xDeadlineB = pxB->xReleaseTime + pxB->xDeadline;
+        BaseType_t xReturn;
+
+        if( xDeadlineA != xDeadlineB )
         {
-            TCB_t * pxNewTCB;
-            BaseType_t xReturn;
+            /* Compared through the difference, so that a deadline past an
+             * overflow of the tick count still sorts after one before it. */
+            xReturn = ( ( TickType_t ) ( xDeadlineA - xDeadlineB ) > ( portMAX_DELAY >> 1 ) ) ? pdTRUE : pdFALSE;
+        }
+        else
+        {
+            xReturn = ( ( BaseType_t ) ( pxA->uxOrder - pxB->uxOrder ) < 0 ) ? pdTRUE : pdFALSE;
+        }
 
-            /* If the stack grows down then allocate the stack then the TCB so the stack
-             * does not grow into the TCB.  Likewise if the stack grows up then allocate
-             * the TCB then the stack. */
-            #if ( portSTACK_GROWTH > 0 )
-            {
-                /* Allocate space for the TCB.  Where the memory comes from depends on
-                 * the implementation of the port malloc function and whether or not static
-                 * allocation is being used. */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-                if( pxNewTCB != NULL )
-                {
-                    memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+    static void prvJobQueuePush( AperiodicJob_t * pxJob )
+    {
+        AperiodicJob_t ** const ppxJobs = xJobQueue.pxJobs;
+        UBaseType_t uxIndex = xJobQueue.uxCount;
+        UBaseType_t uxParent;
 
-                    /* Allocate space for the stack used by the task being created.
-                     * The base of the stack memory stored in the TCB so the task can
-                     * be deleted later if required. */
-                    pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+        ( xJobQueue.uxCount )++;
 
-                    if( pxNewTCB->pxStack == NULL )
-                    {
-                        /* Could not allocate the stack.  Delete the allocated TCB. */
-                        vPortFree( pxNewTCB );
-                        pxNewTCB = NULL;
-                    }
-                }
-            }
-            #else /* portSTACK_GROWTH */
+        /* Move the job up from the end while it is more urgent than its
+         * parent. */
+        while( uxIndex > ( UBaseType_t ) 0U )
+        {
+            uxParent = ( uxIndex - ( UBaseType_t ) 1U ) / ( UBaseType_t ) 2U;
+
+            if( prvJobQueueLess( pxJob, ppxJobs[ uxParent ] ) == pdFALSE )
             {
-                StackType_t * pxStack;
+                break;
+            }
 
-                /* Allocate space for the stack used by the task being created. */
-                pxStack = pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+            ppxJobs[ uxIndex ] = ppxJobs[ uxParent ];
+            uxIndex = uxParent;
+        }
 
-                if( pxStack != NULL )
-                {
-                    /* Allocate space for the TCB. */
-                    pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+        ppxJobs[ uxIndex ] = pxJob;
+    }
+/*-----------------------------------------------------------*/
 
-                    if( pxNewTCB != NULL )
-                    {
-                        memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+    static AperiodicJob_t * prvJobQueuePop( void )
+    {
+        AperiodicJob_t ** const ppxJobs = xJobQueue.pxJobs;
+        AperiodicJob_t * const pxHead = ppxJobs[ 0 ];
+        AperiodicJob_t * pxLast;
+        UBaseType_t uxIndex = ( UBaseType_t ) 0U;
+        UBaseType_t uxChild;
 
-                        /* Store the stack location in the TCB. */
-                        pxNewTCB->pxStack = pxStack;
-                    }
-                    else
-                    {
-                        /* The stack cannot be used as the TCB was not created.  Free
-                         * it again. */
-                        vPortFreeStack( pxStack );
-                    }
-                }
-                else
-                {
-                    pxNewTCB = NULL;
-                }
-            }
-            #endif /* portSTACK_GROWTH */
+        ( xJobQueue.uxCount )--;
+        pxLast = ppxJobs[ xJobQueue.uxCount ];
 
-            if( pxNewTCB != NULL )
-            {
-                #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
-                {
-                    /* Tasks can be created statically or dynamically, so note this
-                     * task was created dynamically in case it is later deleted. */
-                    pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
-                }
-                #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+        /* Move the last job down from the root while one of its children is
+         * more urgent than it. */
+        for( ; ; )
+        {
+            uxChild = ( uxIndex * ( UBaseType_t ) 2U ) + ( UBaseType_t ) 1U;
 
-                prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
-                pxNewTCB->uxDuration = uxDuration;
-                pxNewTCB->uxDeadline = uxDeadline;
-                pxNewTCB->uxPeriod = portMAX_DELAY;
+            if( uxChild >= xJobQueue.uxCount )
+            {
+                break;
+            }
 
-                listSET_LIST_ITEM_VALUE( &( pxNewTCB->xStateListItem ), pxNewTCB->uxDeadline );
-                prvAddNewTaskByDeadlineToReadyList( pxNewTCB );
-                xReturn = pdPASS;
+            if( ( ( uxChild + ( UBaseType_t ) 1U ) < xJobQueue.uxCount ) &&
+                ( prvJobQueueLess( ppxJobs[ uxChild + ( UBaseType_t ) 1U ], ppxJobs[ uxChild ] ) != pdFALSE ) )
+            {
+                uxChild++;
             }
-            else
+
+            if( prvJobQueueLess( ppxJobs[ uxChild ], pxLast ) == pdFALSE )
             {
-                xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+                break;
             }
 
-            return xReturn;
+            ppxJobs[ uxIndex ] = ppxJobs[ uxChild ];
+            uxIndex = uxChild;
         }
 
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-#endif
+        ppxJobs[ uxIndex ] = pxLast;
+
+        return pxHead;
+    }
+
+#endif /* configUSE_APERIODIC_JOBS */
 
 #if ( (INCLUDE_xTaskCreatePeriodic == 1) && (configUSE_POLLING_SERVER == 1))
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -5935,12 +11145,22 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                         void * const pvParameters,
                                         UBaseType_t uxPriority,
                                         UBaseType_t uxPeriod,
+                                        TickType_t uxDuration,
                                         StackType_t * const puxStackBuffer,
                                         StaticTask_t * const pxTaskBuffer )
         {
             TCB_t * pxNewTCB;
             TaskHandle_t xReturn;
 
+            #if ( configUSE_ADMISSION_CONTROL == 1 )
+                uint32_t ulAdmittedLoad;
+
+                if( prvAdmitTask( pdTRUE, uxDuration, uxPeriod, &ulAdmittedLoad ) != pdPASS )
+                {
+                    return NULL;
+                }
+            #endif
+
             configASSERT( puxStackBuffer != NULL );
             configASSERT( pxTaskBuffer != NULL );
 
@@ -5975,12 +11195,36 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                 // Assign the missing values to the TCB instead of creating a new function
                 pxNewTCB->uxDeadline = portMAX_DELAY;
                 pxNewTCB->uxPeriod = uxPeriod;
+                pxNewTCB->uxDuration = uxDuration;
+
+                #if ( configUSE_ADMISSION_CONTROL == 1 )
+                {
+                    pxNewTCB->ulAdmittedLoad = ulAdmittedLoad;
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskEndJob == 1 )
+                {
+                    /* The first job is released when the task is created. */
+                    prvReleaseJob( pxNewTCB, xTaskGetTickCount() );
+                }
+                #endif
 
                 listSET_LIST_ITEM_VALUE( &( pxNewTCB->xStateListItem ), pxNewTCB->uxPeriod );
                 prvAddNewTaskToPeriodicReadyList( pxNewTCB );
             }
             else
             {
+                #if ( configUSE_ADMISSION_CONTROL == 1 )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        prvAdmissionRelease( pdTRUE, ulAdmittedLoad );
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                #endif
+
                 xReturn = NULL;
             }
 
@@ -5996,11 +11240,23 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                 void * const pvParameters,
                                 UBaseType_t uxPriority,
                                 UBaseType_t uxPeriod,
+                                TickType_t uxDuration,
                                 TaskHandle_t * const pxCreatedTask )
         {
             TCB_t * pxNewTCB;
             BaseType_t xReturn;
 
+            #if ( configUSE_ADMISSION_CONTROL == 1 )
+                uint32_t ulAdmittedLoad;
+
+                /* Reserve the share of the task before anything is allocated,
+                 * so a task that is not admitted costs nothing. */
+                if( prvAdmitTask( pdTRUE, uxDuration, uxPeriod, &ulAdmittedLoad ) != pdPASS )
+                {
+                    return errSCHEDULE_NOT_ADMITTED;
+                }
+            #endif
+
             /* If the stack grows down then allocate the stack then the TCB so the stack
              * does not grow into the TCB.  Likewise if the stack grows up then allocate
              * the TCB then the stack. */
@@ -6074,6 +11330,20 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                 prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
                 pxNewTCB->uxDeadline = portMAX_DELAY;
                 pxNewTCB->uxPeriod = uxPeriod;
+                pxNewTCB->uxDuration = uxDuration;
+
+                #if ( configUSE_ADMISSION_CONTROL == 1 )
+                {
+                    pxNewTCB->ulAdmittedLoad = ulAdmittedLoad;
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskEndJob == 1 )
+                {
+                    /* The first job is released when the task is created. */
+                    prvReleaseJob( pxNewTCB, xTaskGetTickCount() );
+                }
+                #endif
 
                 listSET_LIST_ITEM_VALUE( &( pxNewTCB->xStateListItem ), pxNewTCB->uxPeriod );
                 prvAddNewTaskToPeriodicReadyList( pxNewTCB );
@@ -6081,6 +11351,16 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             }
             else
             {
+                #if ( configUSE_ADMISSION_CONTROL == 1 )
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        prvAdmissionRelease( pdTRUE, ulAdmittedLoad );
+                    }
+                    taskEXIT_CRITICAL();
+                }
+                #endif
+
                 xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
             }
 
@@ -70,6 +70,23 @@
     #define tmrSTATUS_IS_ACTIVE                  ( ( uint8_t ) 0x01 )
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
+    #define tmrSTATUS_IS_ISR_TIMER               ( ( uint8_t ) 0x08 )
+
+/* How far ahead of the last tick processed an ISR timer can expire.  Used to
+ * tell a time that is ahead of that tick from one that is behind it. */
+    #define tmrISR_TIMER_HORIZON                 ( tmrMAX_TIME_BEFORE_OVERFLOW >> 1 )
+
+/* Geometry of the timer wheel.  Each level has tmrWHEEL_SLOTS slots, and a slot
+ * of a level spans as many ticks as the whole of the level below it, so
+ * tmrWHEEL_LEVELS levels cover every delay a TickType_t can hold. */
+    #if ( configUSE_TIMER_WHEEL == 1 )
+    #define tmrWHEEL_SLOTS                         ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+    #define tmrWHEEL_SLOT_MASK                     ( ( TickType_t ) tmrWHEEL_SLOTS - ( TickType_t ) 1U )
+    #define tmrWHEEL_LEVELS                        ( ( UBaseType_t ) ( ( ( sizeof( TickType_t ) * 8U ) + configTIMER_WHEEL_SLOT_BITS - 1U ) / configTIMER_WHEEL_SLOT_BITS ) )
+    #define tmrWHEEL_SHIFT( uxLevel )              ( ( UBaseType_t ) ( uxLevel ) * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS )
+    #define tmrWHEEL_INDEX( xTime, uxLevel )       ( ( UBaseType_t ) ( ( ( xTime ) >> tmrWHEEL_SHIFT( uxLevel ) ) & tmrWHEEL_SLOT_MASK ) )
+    #define tmrWHEEL_LOW_BITS( xTime, uxLevel )    ( ( xTime ) & ( ( ( TickType_t ) 1U << tmrWHEEL_SHIFT( uxLevel ) ) - ( TickType_t ) 1U ) )
+    #endif
 
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
@@ -128,6 +145,22 @@
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* The wheel in which active timers are stored.  A timer due less than
+ * tmrWHEEL_SLOTS ticks after xWheelTime sits on level 0, in the slot of its
+ * expiry tick.  A timer due later sits on the level whose slots span its delay,
+ * and moves down when the wheel reaches the first tick of its slot.  Starting,
+ * stopping and expiring a timer therefore never walks a list.  Bit n of
+ * ulWheelOccupied[ x ] is set while slot n of level x holds a timer.  Only the
+ * timer service task is allowed to access the wheel. */
+    PRIVILEGED_DATA static List_t xTimerWheel[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ];
+    PRIVILEGED_DATA static uint32_t ulWheelOccupied[ tmrWHEEL_LEVELS ];
+    PRIVILEGED_DATA static TickType_t xWheelTime = ( TickType_t ) 0U; /* The next tick the wheel has to process. */
+    PRIVILEGED_DATA static UBaseType_t uxActiveTimers = ( UBaseType_t ) 0U;
+
+    #else /* configUSE_TIMER_WHEEL */
+
 /* The list in which active timers are stored.  Timers are referenced in expire
  * time order, with the nearest expiry time at the front of the list.  Only the
  * timer service task is allowed to access these lists.
@@ -139,6 +172,25 @@
     PRIVILEGED_DATA static List_t * pxCurrentTimerList;
     PRIVILEGED_DATA static List_t * pxOverflowTimerList;
 
+    #endif /* configUSE_TIMER_WHEEL */
+
+    #if ( configUSE_ISR_TIMERS == 1 )
+
+/* The active ISR timers, in expire time order as the lists of the normal
+ * timers are, but accessed from the tick interrupt, so only within critical
+ * sections.  xISRTimerTime is the last tick count they were processed for, and
+ * xNextISRTimerExpiry the expiry time of the first one, read by the tickless
+ * idle code without a critical section. */
+    PRIVILEGED_DATA static List_t xActiveISRTimerList1;
+    PRIVILEGED_DATA static List_t xActiveISRTimerList2;
+    PRIVILEGED_DATA static List_t * pxCurrentISRTimerList;
+    PRIVILEGED_DATA static List_t * pxOverflowISRTimerList;
+    PRIVILEGED_DATA static TickType_t xISRTimerTime = ( TickType_t ) configINITIAL_TICK_COUNT;
+    PRIVILEGED_DATA static volatile TickType_t xNextISRTimerExpiry = ( TickType_t ) 0U;
+    PRIVILEGED_DATA static volatile UBaseType_t uxActiveISRTimers = ( UBaseType_t ) 0U;
+
+    #endif /* configUSE_ISR_TIMERS */
+
 /* A queue that is used to send commands to the timer service task. */
     PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
     PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
@@ -168,7 +220,9 @@
 
 /*
  * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * depending on if the expire time causes a timer counter overflow, or into the
+ * timer wheel.  Returns pdTRUE, without inserting the timer, if its expiry time
+ * has already been reached.
  */
     static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
                                                   const TickType_t xNextExpiryTime,
@@ -191,6 +245,35 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Link the timer into the slot its expiry time falls in, as seen from
+ * xWheelTime.
+ */
+    static void prvWheelLink( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unlink the timer from its slot, clearing the slot's occupied bit if the
+ * timer was the last one in it.
+ */
+    static void prvWheelUnlink( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the number of ticks from xWheelTime to the first tick the wheel has
+ * work on, either timers to expire or a slot of timers to move down a level.
+ * Must only be called while the wheel holds a timer.
+ */
+    static TickType_t prvWheelNextEvent( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Bring the wheel up to xTimeNow, processing every timer that expired on the
+ * way in a single pass.
+ */
+    static void prvWheelAdvance( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
+    #else /* configUSE_TIMER_WHEEL */
+
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
  * current timer list does not still reference some timers.
@@ -203,6 +286,8 @@
  */
     static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
 
+    #endif /* configUSE_TIMER_WHEEL */
+
 /*
  * If the timer list contains any active timers then return the expire time of
  * the timer that will expire first and set *pxListWasEmpty to false.  If the
@@ -228,6 +313,36 @@
                                        void * const pvTimerID,
                                        TimerCallbackFunction_t pxCallbackFunction,
                                        Timer_t * pxNewTimer ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_ISR_TIMERS == 1 )
+
+/*
+ * Carry out a command on an ISR timer at once, in a critical section, instead
+ * of sending it to the timer service task.
+ */
+    static BaseType_t prvISRTimerCommand( Timer_t * const pxTimer,
+                                          const BaseType_t xCommandID,
+                                          const TickType_t xOptionalValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert the ISR timer into either xActiveISRTimerList1 or xActiveISRTimerList2,
+ * depending on if the expire time is after the next tick count overflow.
+ */
+    static void prvInsertISRTimer( Timer_t * const pxTimer,
+                                   TickType_t xExpiryTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the ISR timer at the head of pxList, reload it if it is an
+ * auto-reload timer, then call its callback.
+ */
+    static void prvExpireISRTimer( List_t * const pxList ) PRIVILEGED_FUNCTION;
+
+/*
+ * Refresh xNextISRTimerExpiry after the ISR timer lists changed.
+ */
+    static void prvUpdateNextISRTimerExpiry( void ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_ISR_TIMERS */
 /*-----------------------------------------------------------*/
 
     BaseType_t xTimerCreateTimerTask( void )
@@ -394,6 +509,16 @@
 
         configASSERT( xTimer );
 
+        #if ( configUSE_ISR_TIMERS == 1 )
+        if( ( xTimer->ucStatus & tmrSTATUS_IS_ISR_TIMER ) != 0 )
+        {
+            /* The timer service task does not manage ISR timers. */
+            xReturn = prvISRTimerCommand( xTimer, xCommandID, xOptionalValue );
+            traceTIMER_COMMAND_SEND( xTimer, xCommandID, xOptionalValue, xReturn );
+        }
+        else
+        #endif /* configUSE_ISR_TIMERS */
+
         /* Send a message to the timer service task to perform a particular action
          * on a particular timer definition. */
         if( xTimerQueue != NULL )
@@ -541,12 +666,21 @@
     static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow )
     {
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( xTimerWheel[ 0 ][ tmrWHEEL_INDEX( xNextExpireTime, 0U ) ] ) ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+        /* Remove the timer from the wheel.  A check has already been
+         * performed to ensure the slot of the expiry time is not empty. */
+        prvWheelUnlink( pxTimer );
+        uxActiveTimers--;
+        #else
         Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
 
         /* Remove the timer from the list of active timers.  A check has already
          * been performed to ensure the list is not empty. */
 
         ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        #endif /* configUSE_TIMER_WHEEL */
 
         /* If the timer is an auto-reload timer then calculate the next
          * expiry time and re-insert the timer in the list of active timers. */
@@ -601,6 +735,236 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+    static void prvWheelLink( Timer_t * const pxTimer )
+    {
+        const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+        const TickType_t xDelay = xExpiryTime - xWheelTime;
+        UBaseType_t uxLevel = 0U;
+        UBaseType_t uxSlot;
+
+        /* Find the lowest level whose slots, from xWheelTime, reach the
+         * expiry time. */
+        while( ( uxLevel < ( tmrWHEEL_LEVELS - 1U ) ) && ( ( xDelay >> tmrWHEEL_SHIFT( uxLevel + 1U ) ) != ( TickType_t ) 0U ) )
+        {
+            uxLevel++;
+        }
+
+        uxSlot = tmrWHEEL_INDEX( xExpiryTime, uxLevel );
+        listINSERT_END( &( xTimerWheel[ uxLevel ][ uxSlot ] ), &( pxTimer->xTimerListItem ) );
+        ulWheelOccupied[ uxLevel ] |= ( 1UL << uxSlot );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWheelUnlink( Timer_t * const pxTimer )
+    {
+        List_t * const pxSlot = listLIST_ITEM_CONTAINER( &( pxTimer->xTimerListItem ) );
+        UBaseType_t uxIndex;
+
+        if( uxListRemove( &( pxTimer->xTimerListItem ) ) == ( UBaseType_t ) 0U )
+        {
+            /* The slot is now empty.  Its position in the wheel gives its
+             * level and index. */
+            uxIndex = ( UBaseType_t ) ( pxSlot - &( xTimerWheel[ 0 ][ 0 ] ) );
+            ulWheelOccupied[ uxIndex / tmrWHEEL_SLOTS ] &= ~( 1UL << ( uxIndex % tmrWHEEL_SLOTS ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvWheelNextEvent( void )
+    {
+        TickType_t xNextEvent = tmrMAX_TIME_BEFORE_OVERFLOW;
+        TickType_t xOffset, xLowBits;
+        UBaseType_t uxLevel, uxStart, uxSteps;
+        uint32_t ulOccupied;
+
+        for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+        {
+            ulOccupied = ulWheelOccupied[ uxLevel ];
+
+            if( ulOccupied != 0UL )
+            {
+                /* On the first tick of its current slot a level has not been
+                 * processed yet, so that slot is due now.  Past it the slot
+                 * has been emptied, and can only hold timers that are a whole
+                 * turn of the level away, so the search starts at the next
+                 * one.  Level 0 is always on the first tick of its slot. */
+                xLowBits = tmrWHEEL_LOW_BITS( xWheelTime, uxLevel );
+                uxStart = tmrWHEEL_INDEX( xWheelTime, uxLevel );
+
+                if( xLowBits != ( TickType_t ) 0U )
+                {
+                    uxStart++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxSteps = 0U;
+
+                while( ( ulOccupied & ( 1UL << ( ( uxStart + uxSteps ) & tmrWHEEL_SLOT_MASK ) ) ) == 0UL )
+                {
+                    uxSteps++;
+                }
+
+                /* The first tick of the slot found.  The arithmetic wraps
+                 * with the tick count on the top level. */
+                if( xLowBits != ( TickType_t ) 0U )
+                {
+                    xOffset = ( ( ( TickType_t ) uxSteps + ( TickType_t ) 1U ) << tmrWHEEL_SHIFT( uxLevel ) ) - xLowBits;
+                }
+                else
+                {
+                    xOffset = ( TickType_t ) uxSteps << tmrWHEEL_SHIFT( uxLevel );
+                }
+
+                if( xOffset < xNextEvent )
+                {
+                    xNextEvent = xOffset;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xNextEvent;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWheelAdvance( const TickType_t xTimeNow )
+    {
+        /* The ticks from xWheelTime up to and including xTimeNow. */
+        TickType_t xTicks = ( TickType_t ) ( xTimeNow - xWheelTime ) + ( TickType_t ) 1U;
+        TickType_t xOffset;
+        UBaseType_t uxLevel;
+        List_t * pxSlot;
+        Timer_t * pxTimer;
+
+        while( uxActiveTimers > ( UBaseType_t ) 0U )
+        {
+            xOffset = prvWheelNextEvent();
+
+            if( xOffset >= xTicks )
+            {
+                break;
+            }
+
+            /* Skip straight to the next tick the wheel has work on. */
+            xWheelTime += xOffset;
+            xTicks -= xOffset;
+
+            /* On the first tick of a slot of level 1, move the timers of that
+             * slot down to level 0, and likewise up the levels for as long as
+             * the tick is also the first of a slot of the next level. */
+            for( uxLevel = 1U; ( uxLevel < tmrWHEEL_LEVELS ) && ( tmrWHEEL_LOW_BITS( xWheelTime, uxLevel ) == ( TickType_t ) 0U ); uxLevel++ )
+            {
+                pxSlot = &( xTimerWheel[ uxLevel ][ tmrWHEEL_INDEX( xWheelTime, uxLevel ) ] );
+
+                while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                {
+                    pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    prvWheelUnlink( pxTimer );
+                    prvWheelLink( pxTimer );
+                }
+            }
+
+            /* Process every timer that expires on this tick.  An auto-reload
+             * timer reloaded into the same slot is due a turn of the level
+             * later, and ends the loop. */
+            pxSlot = &( xTimerWheel[ 0 ][ tmrWHEEL_INDEX( xWheelTime, 0U ) ] );
+
+            while( ( listLIST_IS_EMPTY( pxSlot ) == pdFALSE ) && ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxSlot ) == xWheelTime ) )
+            {
+                prvProcessExpiredTimer( xWheelTime, xTimeNow );
+            }
+
+            xWheelTime++;
+            xTicks--;
+        }
+
+        xWheelTime += xTicks;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+                                            BaseType_t xListWasEmpty )
+    {
+        TickType_t xTimeNow;
+
+        vTaskSuspendAll();
+        {
+            xTimeNow = xTaskGetTickCount();
+
+            /* Is the wheel's next tick of work at or before xTimeNow?  Both
+             * are measured from xWheelTime, so an overflow of the tick count
+             * cannot reorder them. */
+            if( ( xListWasEmpty == pdFALSE ) &&
+                ( ( TickType_t ) ( xNextExpireTime - xWheelTime ) < ( TickType_t ) ( ( TickType_t ) ( xTimeNow - xWheelTime ) + ( TickType_t ) 1U ) ) )
+            {
+                ( void ) xTaskResumeAll();
+
+                /* Process everything that became due since the last wake up
+                 * in one pass, rather than one timer per loop. */
+                prvWheelAdvance( xTimeNow );
+            }
+            else
+            {
+                /* Block until the next tick the wheel has work on, or until
+                 * a command is received.  An empty wheel has nothing due, so
+                 * the task waits for a command only. */
+                vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    /* Yield to wait for either a command to arrive, or the
+                     * block time to expire.  If a command arrived between the
+                     * critical section being exited and this yield then the yield
+                     * will not cause the task to block. */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
+    {
+        TickType_t xNextExpireTime;
+
+        /* The next expire time is the next tick the wheel has work on, which
+         * can also be a slot of timers moving down a level. */
+        *pxListWasEmpty = ( uxActiveTimers == ( UBaseType_t ) 0U ) ? pdTRUE : pdFALSE;
+
+        if( *pxListWasEmpty == pdFALSE )
+        {
+            xNextExpireTime = xWheelTime + prvWheelNextEvent();
+        }
+        else
+        {
+            xNextExpireTime = ( TickType_t ) 0U;
+        }
+
+        return xNextExpireTime;
+    }
+
+    #else /* configUSE_TIMER_WHEEL */
+
     static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty )
     {
@@ -711,6 +1075,8 @@
 
         return xTimeNow;
     }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
@@ -723,6 +1089,20 @@
         listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
         listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
 
+        #if ( configUSE_TIMER_WHEEL == 1 )
+        /* Measure both times from the command, so a tick count overflow in
+         * between needs no special case.  Has the expiry time been reached
+         * between the command being issued and being processed? */
+        if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= ( ( TickType_t ) ( xNextExpiryTime - xCommandTime ) ) ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+        {
+            xProcessTimerNow = pdTRUE;
+        }
+        else
+        {
+            prvWheelLink( pxTimer );
+            uxActiveTimers++;
+        }
+        #else /* configUSE_TIMER_WHEEL */
         if( xNextExpiryTime <= xTimeNow )
         {
             /* Has the expiry time elapsed between the command to start/reset a
@@ -752,6 +1132,7 @@
                 vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
             }
         }
+        #endif /* configUSE_TIMER_WHEEL */
 
         return xProcessTimerNow;
     }
@@ -761,9 +1142,12 @@
     {
         DaemonTaskMessage_t xMessage;
         Timer_t * pxTimer;
-        BaseType_t xTimerListsWereSwitched;
         TickType_t xTimeNow;
 
+        #if ( configUSE_TIMER_WHEEL == 0 )
+        BaseType_t xTimerListsWereSwitched;
+        #endif
+
         while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
         {
             #if ( INCLUDE_xTimerPendFunctionCall == 1 )
@@ -799,7 +1183,12 @@
                 if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
                 {
                     /* The timer is in a list, remove it. */
+                    #if ( configUSE_TIMER_WHEEL == 1 )
+                    prvWheelUnlink( pxTimer );
+                    uxActiveTimers--;
+                    #else
                     ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    #endif
                 }
                 else
                 {
@@ -814,7 +1203,25 @@
                  *  possibility of a higher priority task adding a message to the message
                  *  queue with a time that is ahead of the timer daemon task (because it
                  *  pre-empted the timer daemon task after the xTimeNow value was set). */
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                /* The wheel is indexed modulo the tick count, so there are
+                 * no lists to switch on an overflow. */
+                xTimeNow = xTaskGetTickCount();
+
+                /* An empty wheel has nothing left to bring up to date, so it
+                 * restarts from now rather than from the tick it last
+                 * processed, which can be any time ago. */
+                if( uxActiveTimers == ( UBaseType_t ) 0U )
+                {
+                    xWheelTime = xTimeNow + ( TickType_t ) 1U;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+                #else
                 xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+                #endif /* configUSE_TIMER_WHEEL */
 
                 switch( xMessage.xMessageID )
                 {
@@ -905,6 +1312,8 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
     static void prvSwitchTimerLists( void )
     {
         TickType_t xNextExpireTime;
@@ -928,6 +1337,8 @@
         pxCurrentTimerList = pxOverflowTimerList;
         pxOverflowTimerList = pxTemp;
     }
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     static void prvCheckForValidListAndQueue( void )
@@ -939,10 +1350,31 @@
         {
             if( xTimerQueue == NULL )
             {
+                #if ( configUSE_TIMER_WHEEL == 1 )
+                UBaseType_t uxLevel, uxSlot;
+
+                for( uxLevel = 0U; uxLevel < tmrWHEEL_LEVELS; uxLevel++ )
+                {
+                    for( uxSlot = 0U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                    {
+                        vListInitialise( &( xTimerWheel[ uxLevel ][ uxSlot ] ) );
+                    }
+
+                    ulWheelOccupied[ uxLevel ] = 0UL;
+                }
+                #else
                 vListInitialise( &xActiveTimerList1 );
                 vListInitialise( &xActiveTimerList2 );
                 pxCurrentTimerList = &xActiveTimerList1;
                 pxOverflowTimerList = &xActiveTimerList2;
+                #endif /* configUSE_TIMER_WHEEL */
+
+                #if ( configUSE_ISR_TIMERS == 1 )
+                vListInitialise( &xActiveISRTimerList1 );
+                vListInitialise( &xActiveISRTimerList2 );
+                pxCurrentISRTimerList = &xActiveISRTimerList1;
+                pxOverflowISRTimerList = &xActiveISRTimerList2;
+                #endif /* configUSE_ISR_TIMERS */
 
                 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
                 {
@@ -981,6 +1413,292 @@
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_ISR_TIMERS == 1 )
+
+    void vTimerSetISRContext( TimerHandle_t xTimer,
+                              const BaseType_t xISRContext )
+    {
+        Timer_t * pxTimer = xTimer;
+
+        configASSERT( xTimer );
+        taskENTER_CRITICAL();
+        {
+            /* A timer cannot change lists while it is in one. */
+            configASSERT( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) != pdFALSE );
+
+            if( xISRContext != pdFALSE )
+            {
+                pxTimer->ucStatus |= tmrSTATUS_IS_ISR_TIMER;
+            }
+            else
+            {
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ISR_TIMER );
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvISRTimerCommand( Timer_t * const pxTimer,
+                                          const BaseType_t xCommandID,
+                                          const TickType_t xOptionalValue )
+    {
+        UBaseType_t uxSavedInterruptStatus = ( UBaseType_t ) 0U;
+        BaseType_t xFreeTimer = pdFALSE;
+
+        if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+        {
+            taskENTER_CRITICAL();
+        }
+        else
+        {
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        }
+
+        {
+            /* As the timer service task does, take the timer out of its
+             * list before acting on the command. */
+            if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+            {
+                ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                uxActiveISRTimers--;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            switch( xCommandID )
+            {
+                case tmrCOMMAND_START:
+                case tmrCOMMAND_START_FROM_ISR:
+                case tmrCOMMAND_RESET:
+                case tmrCOMMAND_RESET_FROM_ISR:
+                    pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                    prvInsertISRTimer( pxTimer, xOptionalValue + pxTimer->xTimerPeriodInTicks );
+                    break;
+
+                case tmrCOMMAND_STOP:
+                case tmrCOMMAND_STOP_FROM_ISR:
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    break;
+
+                case tmrCOMMAND_CHANGE_PERIOD:
+                case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                    pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                    pxTimer->xTimerPeriodInTicks = xOptionalValue;
+                    configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+                    prvInsertISRTimer( pxTimer, xISRTimerTime + pxTimer->xTimerPeriodInTicks );
+                    break;
+
+                case tmrCOMMAND_DELETE:
+                    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                    {
+                        /* The memory is freed once out of the critical
+                         * section. */
+                        if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                        {
+                            xFreeTimer = pdTRUE;
+                        }
+                        else
+                        {
+                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        }
+                    }
+                    #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+                    {
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                    }
+                    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                    break;
+
+                default:
+                    /* Don't expect to get here. */
+                    break;
+            }
+
+            prvUpdateNextISRTimerExpiry();
+        }
+
+        if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+        {
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        }
+
+        if( xFreeTimer != pdFALSE )
+        {
+            vPortFree( pxTimer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInsertISRTimer( Timer_t * const pxTimer,
+                                   TickType_t xExpiryTime )
+    {
+        /* An expiry time that is not after the last tick processed, which
+         * a command issued before that tick or a backlogged reload can ask
+         * for, is taken on the next tick. */
+        if( ( TickType_t ) ( ( TickType_t ) ( xExpiryTime - xISRTimerTime ) - ( TickType_t ) 1U ) >= tmrISR_TIMER_HORIZON )
+        {
+            xExpiryTime = xISRTimerTime + ( TickType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xExpiryTime );
+        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+        if( xExpiryTime < xISRTimerTime )
+        {
+            /* The expiry time is after the next tick count overflow. */
+            vListInsert( pxOverflowISRTimerList, &( pxTimer->xTimerListItem ) );
+        }
+        else
+        {
+            vListInsert( pxCurrentISRTimerList, &( pxTimer->xTimerListItem ) );
+        }
+
+        uxActiveISRTimers++;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvExpireISRTimer( List_t * const pxList )
+    {
+        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        const TickType_t xExpiredTime = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+
+        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+        uxActiveISRTimers--;
+
+        /* Reload from the expiry time, not from the tick count, so the
+         * releases of an auto-reload timer do not drift. */
+        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+        {
+            prvInsertISRTimer( pxTimer, xExpiredTime + pxTimer->xTimerPeriodInTicks );
+        }
+        else
+        {
+            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+        }
+
+        traceTIMER_EXPIRED( pxTimer );
+        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUpdateNextISRTimerExpiry( void )
+    {
+        if( listLIST_IS_EMPTY( pxCurrentISRTimerList ) == pdFALSE )
+        {
+            xNextISRTimerExpiry = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentISRTimerList );
+        }
+        else if( listLIST_IS_EMPTY( pxOverflowISRTimerList ) == pdFALSE )
+        {
+            xNextISRTimerExpiry = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxOverflowISRTimerList );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTimerProcessISRTimers( const TickType_t xTimeNow )
+    {
+        const TickType_t xLastTime = xISRTimerTime;
+        List_t * pxTemp;
+
+        /* The ticks wound down when the scheduler resumes were processed
+         * when their interrupts occurred, so only a tick count ahead of the
+         * last one processed is acted on. */
+        if( ( TickType_t ) ( ( TickType_t ) ( xTimeNow - xLastTime ) - ( TickType_t ) 1U ) < tmrISR_TIMER_HORIZON )
+        {
+            xISRTimerTime = xTimeNow;
+
+            if( uxActiveISRTimers > ( UBaseType_t ) 0U )
+            {
+                if( xTimeNow < xLastTime )
+                {
+                    /* The tick count overflowed.  Switch the lists first,
+                     * so the timers the callbacks start go in the right
+                     * one, then process every timer left in the old list,
+                     * all of which are due. */
+                    pxTemp = pxCurrentISRTimerList;
+                    pxCurrentISRTimerList = pxOverflowISRTimerList;
+                    pxOverflowISRTimerList = pxTemp;
+
+                    while( listLIST_IS_EMPTY( pxOverflowISRTimerList ) == pdFALSE )
+                    {
+                        prvExpireISRTimer( pxOverflowISRTimerList );
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                while( ( listLIST_IS_EMPTY( pxCurrentISRTimerList ) == pdFALSE ) &&
+                       ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentISRTimerList ) <= xTimeNow ) )
+                {
+                    prvExpireISRTimer( pxCurrentISRTimerList );
+                }
+
+                prvUpdateNextISRTimerExpiry();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    TickType_t xTimerGetTicksToNextISRTimer( const TickType_t xTimeNow )
+    {
+        TickType_t xReturn = portMAX_DELAY;
+
+        if( uxActiveISRTimers > ( UBaseType_t ) 0U )
+        {
+            xReturn = xNextISRTimerExpiry - xTimeNow;
+
+            if( xReturn >= tmrISR_TIMER_HORIZON )
+            {
+                /* The expiry time is not after xTimeNow: a pended tick has
+                 * still to process it. */
+                xReturn = ( TickType_t ) 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+    #endif /* configUSE_ISR_TIMERS */
+/*-----------------------------------------------------------*/
+
     BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer )
     {
         BaseType_t xReturn;